@@ -12,6 +12,7 @@
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/nstime.h"
+#include "ns3/packet-accounting.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
@@ -210,6 +211,7 @@ void
 BulkSendApplication::SendData(const Address& from, const Address& to)
 {
     NS_LOG_FUNCTION(this);
+    PacketAccounting::Scope scope(GetInstanceTypeId());
 
     while (m_maxBytes == 0 || m_totBytes < m_maxBytes)
     { // Time to send more
@@ -19,6 +19,7 @@
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/nstime.h"
+#include "ns3/packet-accounting.h"
 #include "ns3/packet-socket-address.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
@@ -331,6 +332,7 @@ void
 OnOffApplication::SendPacket()
 {
     NS_LOG_FUNCTION(this);
+    PacketAccounting::Scope scope(GetInstanceTypeId());
 
     NS_ASSERT(m_sendEvent.IsExpired());
 
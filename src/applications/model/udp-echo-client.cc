@@ -8,6 +8,7 @@
 #include "ns3/address-utils.h"
 #include "ns3/log.h"
 #include "ns3/nstime.h"
+#include "ns3/packet-accounting.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
@@ -349,6 +350,7 @@ void
 UdpEchoClient::Send()
 {
     NS_LOG_FUNCTION(this);
+    PacketAccounting::Scope scope(GetInstanceTypeId());
 
     NS_ASSERT(m_sendEvent.IsExpired());
 
@@ -11,9 +11,11 @@
 
 #include "assert.h"
 #include "boolean.h"
+#include "double.h"
 #include "event-impl.h"
 #include "log.h"
 #include "type-id.h"
+#include "uinteger.h"
 
 #include <list>
 #include <string>
@@ -44,7 +46,19 @@ CalendarScheduler::GetTypeId()
                                           TypeId::ATTR_CONSTRUCT,
                                           BooleanValue(false),
                                           MakeBooleanAccessor(&CalendarScheduler::SetReverse),
-                                          MakeBooleanChecker());
+                                          MakeBooleanChecker())
+                            .AddAttribute("CompactionRatio",
+                                          "Purge the cancelled events once they make up "
+                                          "more than this share of the event list",
+                                          DoubleValue(0.5),
+                                          MakeDoubleAccessor(&CalendarScheduler::m_compactionRatio),
+                                          MakeDoubleChecker<double>(0, 1))
+                            .AddAttribute(
+                                "CompactionMinimum",
+                                "The minimum number of cancelled events to purge",
+                                UintegerValue(64),
+                                MakeUintegerAccessor(&CalendarScheduler::m_compactionMinimum),
+                                MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
@@ -53,6 +67,11 @@ CalendarScheduler::CalendarScheduler()
     NS_LOG_FUNCTION(this);
     Init(2, 1, 0);
     m_qSize = 0;
+    m_cancelled = 0;
+    m_compactions = 0;
+    m_purged = 0;
+    m_compactionRatio = 0.5;
+    m_compactionMinimum = 64;
 }
 
 CalendarScheduler::~CalendarScheduler()
@@ -245,6 +264,10 @@ CalendarScheduler::RemoveNext()
                               << ", from bucket=" << m_lastBucket);
     m_qSize--;
     ResizeDown();
+    if (m_cancelled > 0 && ev.impl->IsCancelled())
+    {
+        m_cancelled--;
+    }
     return ev;
 }
 
@@ -272,6 +295,67 @@ CalendarScheduler::Remove(const Event& ev)
     NS_ASSERT(false);
 }
 
+std::vector<Scheduler::Event>
+CalendarScheduler::NotifyCancel(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_uid);
+    m_cancelled++;
+    if (m_cancelled >= m_compactionMinimum && m_cancelled > m_compactionRatio * m_qSize)
+    {
+        return Compact();
+    }
+    return {};
+}
+
+Scheduler::CancelStatistics
+CalendarScheduler::GetCancelStatistics() const
+{
+    NS_LOG_FUNCTION(this);
+    return {m_qSize, m_cancelled, m_compactions, m_purged};
+}
+
+std::vector<Scheduler::Event>
+CalendarScheduler::Compact()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<Event> purged;
+    purged.reserve(m_cancelled);
+    for (uint32_t i = 0; i < m_nBuckets; i++)
+    {
+        auto& bucket = m_buckets[i];
+        for (auto j = bucket.begin(); j != bucket.end();)
+        {
+            if (j->impl->IsCancelled())
+            {
+                purged.push_back(*j);
+                j = bucket.erase(j);
+            }
+            else
+            {
+                ++j;
+            }
+        }
+    }
+    m_qSize -= purged.size();
+
+    // Halve the number of buckets as many times as ResizeDown() would
+    uint32_t nBuckets = m_nBuckets;
+    while (m_qSize < nBuckets / 2)
+    {
+        nBuckets /= 2;
+    }
+    if (nBuckets != m_nBuckets)
+    {
+        Resize(nBuckets);
+    }
+
+    NS_LOG_INFO("purged " << purged.size() << " cancelled events, " << m_qSize << " left");
+    m_cancelled = 0;
+    m_compactions++;
+    m_purged += purged.size();
+    return purged;
+}
+
 void
 CalendarScheduler::ResizeUp()
 {
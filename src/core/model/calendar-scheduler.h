@@ -46,6 +46,12 @@ class EventImpl;
  * Buckets themselves are implemented as a `std::list<>`, and events are
  * kept sorted within the buckets.
  *
+ * Cancelled events are counted when notified by NotifyCancel().  Once
+ * there are at least \c CompactionMinimum of them and they make up more
+ * than \c CompactionRatio of the queue, they are purged from all the
+ * buckets, and the number of buckets is reduced to match the remaining
+ * events.
+ *
  * @par Time Complexity
  *
  * Operation    | Amortized %Time | Reason
@@ -55,6 +61,7 @@ class EventImpl;
  * PeekNext()   | ~Constant       | Search buckets
  * Remove()     | ~Constant       | Search within bucket; possible resize
  * RemoveNext() | ~Constant       | Search buckets; possible resize
+ * NotifyCancel() | Constant      | Purge amortized over the cancellations
  *
  * @par Memory Complexity
  *
@@ -99,6 +106,8 @@ class CalendarScheduler : public Scheduler
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
     void Remove(const Scheduler::Event& ev) override;
+    std::vector<Scheduler::Event> NotifyCancel(const Scheduler::Event& ev) override;
+    CancelStatistics GetCancelStatistics() const override;
 
   private:
     /** Double the number of buckets if necessary. */
@@ -153,6 +162,13 @@ class CalendarScheduler : public Scheduler
      * @param [in] ev The new Event.
      */
     void DoInsert(const Scheduler::Event& ev);
+    /**
+     * Remove all the cancelled events from the buckets, and shrink
+     * the number of buckets accordingly.
+     *
+     * @returns The cancelled events.
+     */
+    std::vector<Scheduler::Event> Compact();
 
     /** Calendar bucket type: a list of Events. */
     typedef std::list<Scheduler::Event> Bucket;
@@ -171,6 +187,16 @@ class CalendarScheduler : public Scheduler
     uint64_t m_lastPrio;
     /** Number of events in queue. */
     uint32_t m_qSize;
+    /** Number of cancelled events in queue. */
+    uint64_t m_cancelled;
+    /** Number of compactions. */
+    uint64_t m_compactions;
+    /** Number of cancelled events purged by the compactions. */
+    uint64_t m_purged;
+    /** Share of cancelled events of the queue triggering a compaction. */
+    double m_compactionRatio;
+    /** Minimum number of cancelled events triggering a compaction. */
+    uint32_t m_compactionMinimum;
 
     /**
      * Set the insertion order.
@@ -0,0 +1,116 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "checkpoint.h"
+
+#include "abort.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::Checkpoint implementation, with fork().
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Checkpoint");
+
+/**
+ * @relates Checkpoint
+ * The branch run by this process.
+ */
+static uint32_t g_branch = Checkpoint::PARENT;
+/**
+ * @relates Checkpoint
+ * The exit codes of the branches of the last fork.
+ */
+static std::vector<int> g_exitCodes;
+
+uint32_t
+Checkpoint::Fork(uint32_t branches, uint32_t concurrency)
+{
+    NS_LOG_FUNCTION(branches << concurrency);
+    NS_ABORT_MSG_IF(g_branch != PARENT, "A branch cannot fork again");
+    if (concurrency == 0)
+    {
+        concurrency = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    // The buffered output would be written by every branch
+    std::cout.flush();
+    std::cerr.flush();
+    std::clog.flush();
+    std::fflush(nullptr);
+
+    g_exitCodes.assign(branches, -1);
+    std::map<pid_t, uint32_t> running;
+    uint32_t next = 0;
+    while (next < branches || !running.empty())
+    {
+        if (next < branches && running.size() < concurrency)
+        {
+            pid_t pid = ::fork();
+            NS_ABORT_MSG_IF(pid == -1, "fork() failed: " << std::strerror(errno));
+            if (pid == 0)
+            {
+                g_branch = next;
+                g_exitCodes.clear();
+                NS_LOG_LOGIC("Running branch " << next << " at " << Simulator::Now().As());
+                return next;
+            }
+            running[pid] = next++;
+            continue;
+        }
+
+        int status;
+        pid_t pid = ::waitpid(-1, &status, 0);
+        if (pid == -1)
+        {
+            NS_ABORT_MSG_IF(errno != EINTR, "waitpid() failed: " << std::strerror(errno));
+            continue;
+        }
+        auto it = running.find(pid);
+        if (it == running.end())
+        {
+            // Not a branch
+            continue;
+        }
+        int code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+        NS_LOG_LOGIC("Branch " << it->second << " exited with " << code);
+        g_exitCodes[it->second] = code;
+        running.erase(it);
+    }
+
+    // When called by an event, the simulation of the parent ends here
+    Simulator::Stop();
+    return PARENT;
+}
+
+uint32_t
+Checkpoint::GetBranch()
+{
+    return g_branch;
+}
+
+std::vector<int>
+Checkpoint::GetExitCodes()
+{
+    return g_exitCodes;
+}
+
+} // namespace ns3
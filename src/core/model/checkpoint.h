@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::Checkpoint declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup simulator
+ * @brief Fork a warmed-up simulation into several branches.
+ *
+ * Parameter sweeps often repeat the same warm-up (route convergence,
+ * association, TCP slow start) before the part which is measured.
+ * Fork() checkpoints the whole state of the simulation, that is the
+ * pending events, the random number streams and every object, by
+ * forking the process: each child process is a branch, which continues
+ * the simulation from the state of the parent at the time of the fork.
+ *
+ * A typical script runs the warm-up, forks, and reconfigures each
+ * branch, for instance with Config::Set():
+ *
+ * @code
+ *   Simulator::Stop(Seconds(30));
+ *   Simulator::Run();
+ *   uint32_t branch = Checkpoint::Fork(rates.size());
+ *   if (branch == Checkpoint::PARENT)
+ *   {
+ *       Simulator::Destroy();
+ *       return 0;
+ *   }
+ *   Config::Set("/NodeList/0/ApplicationList/0/$ns3::OnOffApplication/DataRate",
+ *               DataRateValue(rates[branch]));
+ *   Simulator::Stop(Seconds(60));
+ *   Simulator::Run();
+ * @endcode
+ *
+ * Fork() can also be called by an event: the parent then stops its
+ * simulation once the branches exited, and Simulator::Run() returns.
+ *
+ * All the branches continue with the same random number streams, so
+ * that they are compared with common random numbers.  The files opened
+ * before the fork are shared by the branches: the output of each branch
+ * should be written to files opened after the fork, named after the
+ * branch.  The standard streams are flushed before forking.
+ *
+ * The process must be single threaded when it forks: with the
+ * MultithreadedSimulatorImpl, Fork() must be called outside of
+ * Simulator::Run().  Fork() is not available on Windows.
+ */
+class Checkpoint
+{
+  public:
+    /** The value returned by Fork() to the parent process. */
+    static constexpr uint32_t PARENT = 0xffffffff;
+
+    /**
+     * Fork the simulation into branches, and wait for them in the parent.
+     *
+     * @param [in] branches The number of branches.
+     * @param [in] concurrency The maximum number of branches running at
+     *             the same time, or 0 for the number of processors.
+     * @returns In each branch, the index of the branch; in the parent,
+     *          once all the branches exited, PARENT.
+     */
+    static uint32_t Fork(uint32_t branches, uint32_t concurrency = 0);
+
+    /**
+     * Get the branch run by this process.
+     *
+     * @returns The index of the branch, or PARENT if the process did not fork.
+     */
+    static uint32_t GetBranch();
+
+    /**
+     * Get the exit codes of the branches of the last Fork(), in the parent.
+     *
+     * A branch killed by a signal has an exit code of 128 plus the signal.
+     *
+     * @returns The exit code of each branch.
+     */
+    static std::vector<int> GetExitCodes();
+};
+
+} // namespace ns3
+
+#endif /* CHECKPOINT_H */
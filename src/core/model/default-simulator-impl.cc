@@ -12,6 +12,7 @@
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
 
 #include <cmath>
 
@@ -31,13 +32,61 @@ NS_LOG_COMPONENT_DEFINE("DefaultSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 
+/**
+ * @ingroup simulator
+ * The single event list entry of a batch of events.
+ */
+class DefaultSimulatorImpl::BatchEvent : public EventImpl
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] impl The simulator running the events.
+     * @param [in] events The events of the batch.
+     */
+    BatchEvent(DefaultSimulatorImpl* impl, EventBatch events)
+        : m_impl(impl),
+          m_events(std::move(events))
+    {
+    }
+
+  protected:
+    ~BatchEvent() override
+    {
+        // Release the events which did not run
+        for (const auto& [context, event] : m_events)
+        {
+            if (event != nullptr)
+            {
+                event->Unref();
+            }
+        }
+    }
+
+  private:
+    void Notify() override
+    {
+        m_impl->InvokeBatch(m_events);
+    }
+
+    DefaultSimulatorImpl* m_impl; //!< The simulator running the events.
+    EventBatch m_events;          //!< The events of the batch.
+};
+
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
     static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
                             .SetParent<SimulatorImpl>()
                             .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+                            .AddConstructor<DefaultSimulatorImpl>()
+                            .AddAttribute("TraceFile",
+                                          "If set, record every operation on the event queue "
+                                          "in this file, to be replayed by replay-event-trace",
+                                          StringValue(""),
+                                          MakeStringAccessor(&DefaultSimulatorImpl::SetTraceFile),
+                                          MakeStringChecker());
     return tid;
 }
 
@@ -51,7 +100,6 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
     m_mainThreadId = std::this_thread::get_id();
 }
 
@@ -72,6 +120,7 @@ DefaultSimulatorImpl::DoDispose()
         next.impl->Unref();
     }
     m_events = nullptr;
+    m_trace.Close();
     SimulatorImpl::DoDispose();
 }
 
@@ -91,6 +140,29 @@ DefaultSimulatorImpl::Destroy()
     }
 }
 
+void
+DefaultSimulatorImpl::SetTraceFile(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    m_trace.Close();
+    if (!filename.empty())
+    {
+        m_trace.Open(filename, std::ios::out);
+    }
+}
+
+void
+DefaultSimulatorImpl::Trace(EventTraceFile::Operation operation, const Scheduler::EventKey& key)
+{
+    EventTraceFile::Record record;
+    record.operation = operation;
+    record.context = key.m_context;
+    record.uid = key.m_uid;
+    record.now = m_currentTs;
+    record.delay = key.m_ts - m_currentTs;
+    m_trace.Write(record);
+}
+
 void
 DefaultSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
 {
@@ -119,6 +191,10 @@ void
 DefaultSimulatorImpl::ProcessOneEvent()
 {
     Scheduler::Event next = m_events->RemoveNext();
+    if (m_trace.IsOpen())
+    {
+        Trace(EventTraceFile::EXECUTE, next.key);
+    }
 
     PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
 
@@ -136,6 +212,45 @@ DefaultSimulatorImpl::ProcessOneEvent()
     ProcessEventsWithContext();
 }
 
+void
+DefaultSimulatorImpl::InvokeBatch(EventBatch& events)
+{
+    // The first event of the batch is the current event; the next ones
+    // take the uids reserved for them, as if they had been scheduled one
+    // by one.
+    uint32_t uid = m_currentUid;
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+        auto [context, event] = events[i];
+        if (i > 0)
+        {
+            if (m_stop)
+            {
+                Scheduler::Event ev;
+                ev.key.m_ts = m_currentTs;
+                ev.key.m_context = context;
+                ev.key.m_uid = uid + i;
+                ev.impl = new BatchEvent(this, EventBatch(events.begin() + i, events.end()));
+                events.resize(i);
+                m_unscheduledEvents++;
+                m_events->Insert(ev);
+                if (m_trace.IsOpen())
+                {
+                    Trace(EventTraceFile::INSERT, ev.key);
+                }
+                return;
+            }
+            PreEventHook(EventId(event, m_currentTs, context, uid + i));
+            m_eventCount++;
+            m_currentContext = context;
+            m_currentUid = uid + i;
+        }
+        event->Invoke();
+        event->Unref();
+        events[i].second = nullptr;
+    }
+}
+
 bool
 DefaultSimulatorImpl::IsFinished() const
 {
@@ -145,22 +260,7 @@ DefaultSimulatorImpl::IsFinished() const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
-    {
-        return;
-    }
-
-    // swap queues
-    EventsWithContext eventsWithContext;
-    {
-        std::unique_lock lock{m_eventsWithContextMutex};
-        m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
-    }
-    while (!eventsWithContext.empty())
-    {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
+    m_eventsWithContext.Drain([this](const EventWithContext& event) {
         Scheduler::Event ev;
         ev.impl = event.event;
         ev.key.m_ts = m_currentTs + event.timestamp;
@@ -169,7 +269,11 @@ DefaultSimulatorImpl::ProcessEventsWithContext()
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
-    }
+        if (m_trace.IsOpen())
+        {
+            Trace(EventTraceFile::INSERT, ev.key);
+        }
+    });
 }
 
 void
@@ -226,6 +330,10 @@ DefaultSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
     m_uid++;
     m_unscheduledEvents++;
     m_events->Insert(ev);
+    if (m_trace.IsOpen())
+    {
+        Trace(EventTraceFile::INSERT, ev.key);
+    }
     return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
 
@@ -245,6 +353,10 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
+        if (m_trace.IsOpen())
+        {
+            Trace(EventTraceFile::INSERT, ev.key);
+        }
     }
     else
     {
@@ -253,11 +365,34 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         // Current time added in ProcessEventsWithContext()
         ev.timestamp = delay.GetTimeStep();
         ev.event = event;
-        {
-            std::unique_lock lock{m_eventsWithContextMutex};
-            m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
-        }
+        m_eventsWithContext.Push(ev);
+    }
+}
+
+void
+DefaultSimulatorImpl::ScheduleWithContextBatch(const Time& delay, EventBatch events)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << events.size());
+
+    if (events.size() < 2 || m_mainThreadId != std::this_thread::get_id())
+    {
+        SimulatorImpl::ScheduleWithContextBatch(delay, std::move(events));
+        return;
+    }
+
+    Time tAbsolute = delay + TimeStep(m_currentTs);
+    Scheduler::Event ev;
+    ev.key.m_ts = (uint64_t)tAbsolute.GetTimeStep();
+    ev.key.m_context = events.front().first;
+    ev.key.m_uid = m_uid;
+    // Reserve a uid for each event of the batch
+    m_uid += events.size();
+    m_unscheduledEvents++;
+    ev.impl = new BatchEvent(this, std::move(events));
+    m_events->Insert(ev);
+    if (m_trace.IsOpen())
+    {
+        Trace(EventTraceFile::INSERT, ev.key);
     }
 }
 
@@ -328,6 +463,10 @@ DefaultSimulatorImpl::Remove(const EventId& id)
     event.key.m_context = id.GetContext();
     event.key.m_uid = id.GetUid();
     m_events->Remove(event);
+    if (m_trace.IsOpen())
+    {
+        Trace(EventTraceFile::REMOVE, event.key);
+    }
     event.impl->Cancel();
     // whenever we remove an event from the event list, we have to unref it.
     event.impl->Unref();
@@ -341,6 +480,29 @@ DefaultSimulatorImpl::Cancel(const EventId& id)
     if (!IsExpired(id))
     {
         id.PeekEventImpl()->Cancel();
+        if (id.GetUid() == EventId::UID::DESTROY)
+        {
+            return;
+        }
+        Scheduler::Event event;
+        event.impl = id.PeekEventImpl();
+        event.key.m_ts = id.GetTs();
+        event.key.m_context = id.GetContext();
+        event.key.m_uid = id.GetUid();
+        if (m_trace.IsOpen())
+        {
+            Trace(EventTraceFile::CANCEL, event.key);
+        }
+        // The scheduler may purge the cancelled events, which are then released here
+        for (const auto& purged : m_events->NotifyCancel(event))
+        {
+            if (m_trace.IsOpen())
+            {
+                Trace(EventTraceFile::REMOVE, purged.key);
+            }
+            purged.impl->Unref();
+            m_unscheduledEvents--;
+        }
     }
 }
 
@@ -386,4 +548,10 @@ DefaultSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+Scheduler::CancelStatistics
+DefaultSimulatorImpl::GetCancelStatistics() const
+{
+    return m_events->GetCancelStatistics();
+}
+
 } // namespace ns3
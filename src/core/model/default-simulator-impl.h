@@ -9,10 +9,12 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-trace-file.h"
+#include "mpsc-queue.h"
+#include "scheduler.h"
 #include "simulator-impl.h"
 
 #include <list>
-#include <mutex>
 #include <thread>
 
 /**
@@ -24,9 +26,6 @@
 namespace ns3
 {
 
-// Forward
-class Scheduler;
-
 /**
  * @ingroup simulator
  *
@@ -53,6 +52,7 @@ class DefaultSimulatorImpl : public SimulatorImpl
     EventId Stop(const Time& delay) override;
     EventId Schedule(const Time& delay, EventImpl* event) override;
     void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    void ScheduleWithContextBatch(const Time& delay, EventBatch events) override;
     EventId ScheduleNow(EventImpl* event) override;
     EventId ScheduleDestroy(EventImpl* event) override;
     void Remove(const EventId& id) override;
@@ -67,11 +67,45 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
 
+    /**
+     * Get the statistics of the scheduler on the cancelled events.
+     *
+     * @returns The statistics, only zeros if the scheduler does not
+     *          track the cancelled events.
+     */
+    Scheduler::CancelStatistics GetCancelStatistics() const;
+
   private:
     void DoDispose() override;
 
+    /**
+     * Open the file recording the operations on the event queue.
+     *
+     * @param [in] filename The file name; empty to stop recording.
+     */
+    void SetTraceFile(const std::string& filename);
+    /**
+     * Record an operation on the event queue.
+     *
+     * @param [in] operation The operation.
+     * @param [in] key The key of the event.
+     */
+    void Trace(EventTraceFile::Operation operation, const Scheduler::EventKey& key);
+
     /** Process the next event. */
     void ProcessOneEvent();
+    /** The event running a batch of events. */
+    class BatchEvent;
+    /**
+     * Run the events of a batch, from the current event.
+     *
+     * If the simulation is stopped by one of them, the remaining ones
+     * are scheduled again as a new batch, with their original ordering.
+     *
+     * @param [in,out] events The events of the batch, which are released
+     *                 once run.
+     */
+    void InvokeBatch(EventBatch& events);
     /** Move events from a different context into the main event queue. */
     void ProcessEventsWithContext();
 
@@ -86,17 +120,11 @@ class DefaultSimulatorImpl : public SimulatorImpl
         EventImpl* event;
     };
 
-    /** Container type for the events from a different context. */
-    typedef std::list<EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
-    EventsWithContext m_eventsWithContext;
     /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
+     * The events scheduled from other threads, waiting to be moved to
+     * the primary event queue.
      */
-    bool m_eventsWithContextEmpty;
-    /** Mutex to control access to the list of events with context. */
-    std::mutex m_eventsWithContextMutex;
+    MpscQueue<EventWithContext> m_eventsWithContext;
 
     /** Container type for the events to run at Simulator::Destroy() */
     typedef std::list<EventId> DestroyEvents;
@@ -106,6 +134,8 @@ class DefaultSimulatorImpl : public SimulatorImpl
     bool m_stop;
     /** The event priority queue. */
     Ptr<Scheduler> m_events;
+    /** The record of the operations on the event queue, if open. */
+    EventTraceFile m_trace;
 
     /** Next event unique id. */
     uint32_t m_uid;
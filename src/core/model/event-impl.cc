@@ -10,6 +10,8 @@
 
 #include "log.h"
 
+#include <array>
+
 /**
  * @file
  * @ingroup events
@@ -21,6 +23,65 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+
+/** Size granularity of the event pool, in bytes. */
+constexpr std::size_t POOL_GRANULARITY = 16;
+/** Events larger than this size are not pooled. */
+constexpr std::size_t POOL_MAX_SIZE = 256;
+/** Maximum number of free blocks kept by a thread for each size class. */
+constexpr std::size_t POOL_MAX_FREE = 4096;
+
+/**
+ * @ingroup events
+ * The free lists of the event memory of a thread.
+ *
+ * Each block is allocated on its own, so that a block released by
+ * another thread than the one which allocated it can be reused or
+ * freed by that thread.
+ */
+struct EventPool
+{
+    /** A free block, linked in the free list of its size class. */
+    struct Block
+    {
+        Block* next; //!< The next free block.
+    };
+
+    /** Release the free blocks of the thread. */
+    ~EventPool();
+
+    /** The free lists, indexed by size class. */
+    std::array<Block*, POOL_MAX_SIZE / POOL_GRANULARITY> free{};
+    /** The length of each free list. */
+    std::array<std::size_t, POOL_MAX_SIZE / POOL_GRANULARITY> length{};
+};
+
+/**
+ * Set when the pool of the thread has been destroyed, so that the
+ * events released later, e.g., by static destructors, are freed.
+ */
+thread_local bool g_poolDestroyed = false;
+/** The event pool of the thread. */
+thread_local EventPool g_pool;
+
+EventPool::~EventPool()
+{
+    for (auto block : free)
+    {
+        while (block != nullptr)
+        {
+            Block* next = block->next;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+    g_poolDestroyed = true;
+}
+
+} // unnamed namespace
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
@@ -56,4 +117,56 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+// Do not add function logging to the allocation functions, which run
+// before the construction and after the destruction of the events
+void*
+EventImpl::operator new(std::size_t size)
+{
+    if (size > POOL_MAX_SIZE || g_poolDestroyed)
+    {
+        return ::operator new(size);
+    }
+    std::size_t sizeClass = (size - 1) / POOL_GRANULARITY;
+    EventPool::Block* block = g_pool.free[sizeClass];
+    if (block == nullptr)
+    {
+        return ::operator new((sizeClass + 1) * POOL_GRANULARITY);
+    }
+    g_pool.free[sizeClass] = block->next;
+    g_pool.length[sizeClass]--;
+    return block;
+}
+
+void*
+EventImpl::operator new(std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    if (size > POOL_MAX_SIZE || g_poolDestroyed)
+    {
+        ::operator delete(p);
+        return;
+    }
+    std::size_t sizeClass = (size - 1) / POOL_GRANULARITY;
+    if (g_pool.length[sizeClass] >= POOL_MAX_FREE)
+    {
+        ::operator delete(p);
+        return;
+    }
+    auto block = static_cast<EventPool::Block*>(p);
+    block->next = g_pool.free[sizeClass];
+    g_pool.free[sizeClass] = block;
+    g_pool.length[sizeClass]++;
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size, std::align_val_t alignment)
+{
+    ::operator delete(p, alignment);
+}
+
 } // namespace ns3
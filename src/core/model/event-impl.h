@@ -10,7 +10,11 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
+#include <new>
 #include <stdint.h>
+#include <utility>
+#include <vector>
 
 /**
  * @file
@@ -30,6 +34,11 @@ namespace ns3
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * Events are created and destroyed at a very high rate, so their
+ * memory comes from a pool: the memory of a destroyed event is kept
+ * in a per-thread free list, one for each size class, and reused by
+ * the next event of the same size class.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -56,6 +65,37 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * Allocate the memory of an event from the pool.
+     *
+     * @param [in] size The size of the event object.
+     * @returns The memory of the event.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Allocate the memory of an over-aligned event, which is not pooled.
+     *
+     * @param [in] size The size of the event object.
+     * @param [in] alignment The alignment of the event object.
+     * @returns The memory of the event.
+     */
+    static void* operator new(std::size_t size, std::align_val_t alignment);
+    /**
+     * Return the memory of an event to the pool.
+     *
+     * @param [in] p The memory of the event.
+     * @param [in] size The size of the event object.
+     */
+    static void operator delete(void* p, std::size_t size);
+    /**
+     * Release the memory of an over-aligned event.
+     *
+     * @param [in] p The memory of the event.
+     * @param [in] size The size of the event object.
+     * @param [in] alignment The alignment of the event object.
+     */
+    static void operator delete(void* p, std::size_t size, std::align_val_t alignment);
+
   protected:
     /**
      * Implementation for Invoke().
@@ -69,6 +109,13 @@ class EventImpl : public SimpleRefCount<EventImpl>
     bool m_cancel; /**< Has this event been cancelled. */
 };
 
+/**
+ * @ingroup events
+ * Events to run at the same time, each with its execution context,
+ * in order: see Simulator::ScheduleWithContextBatch().
+ */
+typedef std::vector<std::pair<uint32_t, EventImpl*>> EventBatch;
+
 } // namespace ns3
 
 #endif /* EVENT_IMPL_H */
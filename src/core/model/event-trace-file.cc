@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "event-trace-file.h"
+
+#include "abort.h"
+#include "assert.h"
+#include "log.h"
+
+#include <cstring>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::EventTraceFile implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventTraceFile");
+
+namespace
+{
+
+/** The magic string at the start of the file. */
+const char EVENT_TRACE_MAGIC[8] = {'n', 's', '3', 'e', 'v', 't', 'r', 'c'};
+/** The version of the file format. */
+const uint32_t EVENT_TRACE_VERSION = 1;
+
+} // unnamed namespace
+
+EventTraceFile::EventTraceFile()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+EventTraceFile::~EventTraceFile()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+EventTraceFile::Open(const std::string& filename, std::ios::openmode mode)
+{
+    NS_LOG_FUNCTION(this << filename << mode);
+    NS_ASSERT_MSG(!m_file.is_open(), "Event trace file already open");
+    NS_ASSERT_MSG(mode == std::ios::in || mode == std::ios::out,
+                  "Event trace files are opened either for reading or for writing");
+
+    m_file.open(filename, mode | std::ios::binary);
+    if (!m_file)
+    {
+        NS_FATAL_ERROR("Cannot open event trace file " << filename);
+    }
+
+    if (mode == std::ios::out)
+    {
+        m_file.write(EVENT_TRACE_MAGIC, sizeof(EVENT_TRACE_MAGIC));
+        m_file.write(reinterpret_cast<const char*>(&EVENT_TRACE_VERSION),
+                     sizeof(EVENT_TRACE_VERSION));
+        return;
+    }
+
+    char magic[sizeof(EVENT_TRACE_MAGIC)];
+    uint32_t version = 0;
+    m_file.read(magic, sizeof(magic));
+    m_file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!m_file || std::memcmp(magic, EVENT_TRACE_MAGIC, sizeof(magic)) != 0)
+    {
+        NS_FATAL_ERROR(filename << " is not an event trace file");
+    }
+    if (version != EVENT_TRACE_VERSION)
+    {
+        NS_FATAL_ERROR("Unsupported version " << version << " of event trace file " << filename);
+    }
+}
+
+void
+EventTraceFile::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+}
+
+bool
+EventTraceFile::IsOpen() const
+{
+    return m_file.is_open();
+}
+
+void
+EventTraceFile::Write(const Record& record)
+{
+    char buffer[RECORD_SIZE];
+    char* p = buffer;
+    *p++ = record.operation;
+    std::memcpy(p, &record.context, sizeof(record.context));
+    p += sizeof(record.context);
+    std::memcpy(p, &record.uid, sizeof(record.uid));
+    p += sizeof(record.uid);
+    std::memcpy(p, &record.now, sizeof(record.now));
+    p += sizeof(record.now);
+    std::memcpy(p, &record.delay, sizeof(record.delay));
+    m_file.write(buffer, RECORD_SIZE);
+}
+
+bool
+EventTraceFile::Read(Record& record)
+{
+    char buffer[RECORD_SIZE];
+    if (!m_file.read(buffer, RECORD_SIZE))
+    {
+        return false;
+    }
+    const char* p = buffer;
+    auto operation = static_cast<uint8_t>(*p++);
+    NS_ABORT_MSG_IF(operation > CANCEL,
+                    "Invalid operation " << +operation << " in event trace file");
+    record.operation = static_cast<Operation>(operation);
+    std::memcpy(&record.context, p, sizeof(record.context));
+    p += sizeof(record.context);
+    std::memcpy(&record.uid, p, sizeof(record.uid));
+    p += sizeof(record.uid);
+    std::memcpy(&record.now, p, sizeof(record.now));
+    p += sizeof(record.now);
+    std::memcpy(&record.delay, p, sizeof(record.delay));
+    return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_TRACE_FILE_H
+#define EVENT_TRACE_FILE_H
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::EventTraceFile declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief A binary file of the operations on the event queue of a simulation.
+ *
+ * The DefaultSimulatorImpl writes such a file when its \c TraceFile
+ * attribute is set.  Each record describes one operation on the
+ * scheduler, so that the file can be replayed on any Scheduler
+ * implementation, as the \c replay-event-trace utility does.
+ *
+ * The file starts with an 8 byte magic string and a 32 bit version,
+ * followed by fixed size records of 25 bytes, in host byte order.
+ */
+class EventTraceFile
+{
+  public:
+    /** The operation on the event queue. */
+    enum Operation : uint8_t
+    {
+        INSERT = 0,  //!< An event was inserted.
+        EXECUTE = 1, //!< The next event was removed to be executed.
+        REMOVE = 2,  //!< An event was removed with Simulator::Remove(), or purged by the scheduler.
+        CANCEL = 3   //!< An event was cancelled, and left in the queue.
+    };
+
+    /** A record of the file. */
+    struct Record
+    {
+        Operation operation; //!< The operation.
+        uint32_t context;    //!< The event context.
+        uint32_t uid;        //!< The event unique id.
+        uint64_t now;        //!< The simulation time of the operation, in time steps.
+        uint64_t delay;      //!< The event timestamp relative to \c now, in time steps.
+    };
+
+    EventTraceFile();
+    ~EventTraceFile();
+
+    /**
+     * Create a new file, or open an existing file and check its header.
+     * Failures are fatal.
+     *
+     * @param [in] filename The file name.
+     * @param [in] mode Either \c std::ios::out or \c std::ios::in.
+     */
+    void Open(const std::string& filename, std::ios::openmode mode);
+
+    /** Close the file. */
+    void Close();
+
+    /**
+     * @returns \c true if the file is open.
+     */
+    bool IsOpen() const;
+
+    /**
+     * Append a record to a file opened for writing.
+     *
+     * @param [in] record The record.
+     */
+    void Write(const Record& record);
+
+    /**
+     * Read the next record of a file opened for reading.
+     *
+     * @param [out] record The record.
+     * @returns \c false at the end of the file.
+     */
+    bool Read(Record& record);
+
+  private:
+    /** The size of a record in the file. */
+    static constexpr std::size_t RECORD_SIZE = 25;
+
+    std::fstream m_file; //!< The file.
+};
+
+} // namespace ns3
+
+#endif /* EVENT_TRACE_FILE_H */
@@ -11,8 +11,10 @@
 #include "heap-scheduler.h"
 
 #include "assert.h"
+#include "double.h"
 #include "event-impl.h"
 #include "log.h"
+#include "uinteger.h"
 
 /**
  * @file
@@ -33,11 +35,27 @@ HeapScheduler::GetTypeId()
     static TypeId tid = TypeId("ns3::HeapScheduler")
                             .SetParent<Scheduler>()
                             .SetGroupName("Core")
-                            .AddConstructor<HeapScheduler>();
+                            .AddConstructor<HeapScheduler>()
+                            .AddAttribute("CompactionRatio",
+                                          "Purge the cancelled events once they make up "
+                                          "more than this share of the event list",
+                                          DoubleValue(0.5),
+                                          MakeDoubleAccessor(&HeapScheduler::m_compactionRatio),
+                                          MakeDoubleChecker<double>(0, 1))
+                            .AddAttribute("CompactionMinimum",
+                                          "The minimum number of cancelled events to purge",
+                                          UintegerValue(64),
+                                          MakeUintegerAccessor(&HeapScheduler::m_compactionMinimum),
+                                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
 HeapScheduler::HeapScheduler()
+    : m_cancelled(0),
+      m_compactions(0),
+      m_purged(0),
+      m_compactionRatio(0.5),
+      m_compactionMinimum(64)
 {
     NS_LOG_FUNCTION(this);
     // we purposely waste an item at the start of
@@ -210,6 +228,10 @@ HeapScheduler::RemoveNext()
     Exch(Root(), Last());
     m_heap.pop_back();
     TopDown(Root());
+    if (m_cancelled > 0 && next.impl->IsCancelled())
+    {
+        m_cancelled--;
+    }
     return next;
 }
 
@@ -232,4 +254,61 @@ HeapScheduler::Remove(const Event& ev)
     NS_ASSERT(false);
 }
 
+std::vector<Scheduler::Event>
+HeapScheduler::NotifyCancel(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_uid);
+    m_cancelled++;
+    if (m_cancelled >= m_compactionMinimum &&
+        m_cancelled > m_compactionRatio * (m_heap.size() - 1))
+    {
+        return Compact();
+    }
+    return {};
+}
+
+Scheduler::CancelStatistics
+HeapScheduler::GetCancelStatistics() const
+{
+    NS_LOG_FUNCTION(this);
+    return {m_heap.size() - 1, m_cancelled, m_compactions, m_purged};
+}
+
+std::vector<Scheduler::Event>
+HeapScheduler::Compact()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<Event> purged;
+    purged.reserve(m_cancelled);
+    std::size_t end = Root();
+    for (std::size_t i = Root(); i < m_heap.size(); i++)
+    {
+        if (m_heap[i].impl->IsCancelled())
+        {
+            purged.push_back(m_heap[i]);
+        }
+        else
+        {
+            m_heap[end++] = m_heap[i];
+        }
+    }
+    m_heap.resize(end);
+    if (m_heap.size() < m_heap.capacity() / 4)
+    {
+        m_heap.shrink_to_fit();
+    }
+    // Rebuild the heap from the parent of the last item up to the root
+    for (std::size_t i = Parent(Last()); i >= Root(); i--)
+    {
+        TopDown(i);
+    }
+
+    NS_LOG_INFO("purged " << purged.size() << " cancelled events, " << m_heap.size() - 1
+                          << " left");
+    m_cancelled = 0;
+    m_compactions++;
+    m_purged += purged.size();
+    return purged;
+}
+
 } // namespace ns3
@@ -42,6 +42,11 @@ namespace ns3
  *  - It uses a slightly non-standard while loop for top-down heapify
  *    to move one if statement out of the loop.
  *
+ * Cancelled events are counted when notified by NotifyCancel().  Once
+ * there are at least \c CompactionMinimum of them and they make up more
+ * than \c CompactionRatio of the heap, they are all purged and the heap
+ * is rebuilt in linear time.
+ *
  * @par Time Complexity
  *
  * Operation    | Amortized %Time | Reason
@@ -51,6 +56,7 @@ namespace ns3
  * PeekNext()   | Constant        | Heap kept sorted
  * Remove()     | Logarithmic     | Search, heapify
  * RemoveNext() | Logarithmic     | Heapify
+ * NotifyCancel() | Constant      | Compaction amortized over the cancellations
  *
  * @par Memory Complexity
  *
@@ -79,6 +85,8 @@ class HeapScheduler : public Scheduler
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
     void Remove(const Scheduler::Event& ev) override;
+    std::vector<Scheduler::Event> NotifyCancel(const Scheduler::Event& ev) override;
+    CancelStatistics GetCancelStatistics() const override;
 
   private:
     /** Event list type:  vector of Events, managed as a heap. */
@@ -168,9 +176,25 @@ class HeapScheduler : public Scheduler
      * @param [in] start Starting entry.
      */
     void TopDown(std::size_t start);
+    /**
+     * Remove all the cancelled events and rebuild the heap.
+     *
+     * @returns The cancelled events.
+     */
+    std::vector<Scheduler::Event> Compact();
 
     /** The event list. */
     BinaryHeap m_heap;
+    /** The number of cancelled events in the heap. */
+    uint64_t m_cancelled;
+    /** The number of compactions. */
+    uint64_t m_compactions;
+    /** The number of cancelled events purged by the compactions. */
+    uint64_t m_purged;
+    /** Share of cancelled events of the heap triggering a compaction. */
+    double m_compactionRatio;
+    /** Minimum number of cancelled events triggering a compaction. */
+    uint32_t m_compactionMinimum;
 };
 
 } // namespace ns3
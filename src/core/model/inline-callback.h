@@ -0,0 +1,230 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef INLINE_CALLBACK_H
+#define INLINE_CALLBACK_H
+
+#include "event-impl.h"
+
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file
+ * @ingroup callback
+ * ns3::InlineCallback declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup callback
+ * @brief A Callback stored inline, without allocation nor reference count.
+ *
+ * An InlineCallback holds a trivially copyable callable object, such as
+ * a function pointer or a class method bound to a raw pointer to its
+ * object, in a fixed size buffer.  It is invoked through a single
+ * function pointer, whereas a Callback goes through a reference counted
+ * implementation and one or more \c std::function objects.  An
+ * InlineCallback is itself trivially copyable, so that containers can
+ * move it with \c memcpy.
+ *
+ * The price is that nothing is owned: the object of a class method must
+ * outlive the InlineCallback, and arguments cannot be bound besides the
+ * captures of a small lambda.  Two InlineCallbacks are equal when they
+ * call the same function on the same bytes.
+ *
+ * InlineCallbacks are built by MakeInlineCallback(), and can be connected
+ * to a TracedCallback or scheduled with MakeEvent().
+ *
+ * @tparam R \explicit The return type of the callback.
+ * @tparam Args \explicit The types of the arguments of the callback.
+ */
+template <typename R, typename... Args>
+class InlineCallback
+{
+  public:
+    /** The size of the inline storage: a method pointer and an object pointer. */
+    static constexpr std::size_t STORAGE_SIZE = 3 * sizeof(void*);
+
+    /** Create a null callback. */
+    InlineCallback()
+        : m_invoke(nullptr),
+          m_storage{}
+    {
+    }
+
+    /**
+     * Create a callback from a callable object.
+     *
+     * @tparam F \deduced The type of the callable object.
+     * @param [in] f The callable object, which is copied inline.
+     */
+    template <typename F,
+              std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineCallback> &&
+                                   std::is_trivially_copyable_v<F> &&
+                                   std::is_invocable_r_v<R, const F&, Args...>,
+                               int> = 0>
+    InlineCallback(const F& f)
+        : m_invoke(&Invoke<F>),
+          m_storage{}
+    {
+        static_assert(sizeof(F) <= STORAGE_SIZE, "The callable object is too large");
+        static_assert(alignof(F) <= alignof(void*), "The callable object is over-aligned");
+        std::memcpy(m_storage, &f, sizeof(F));
+    }
+
+    /**
+     * Invoke the callback.
+     *
+     * @param [in] args The arguments of the callback.
+     * @returns The value returned by the callback.
+     */
+    R operator()(Args... args) const
+    {
+        return m_invoke(m_storage, std::forward<Args>(args)...);
+    }
+
+    /** @returns \c true if the callback is null. */
+    bool IsNull() const
+    {
+        return m_invoke == nullptr;
+    }
+
+    /** Set the callback to null. */
+    void Nullify()
+    {
+        *this = InlineCallback();
+    }
+
+    /**
+     * Equality test.
+     *
+     * @param [in] other The other callback.
+     * @returns \c true if both callbacks call the same function on the
+     *          same callable object.
+     */
+    bool IsEqual(const InlineCallback& other) const
+    {
+        return m_invoke == other.m_invoke &&
+               std::memcmp(m_storage, other.m_storage, STORAGE_SIZE) == 0;
+    }
+
+  private:
+    /**
+     * Call the callable object stored inline.
+     *
+     * @tparam F \explicit The type of the callable object.
+     * @param [in] storage The inline storage.
+     * @param [in] args The arguments of the callback.
+     * @returns The value returned by the callable object.
+     */
+    template <typename F>
+    static R Invoke(const unsigned char* storage, Args... args)
+    {
+        return (*reinterpret_cast<const F*>(storage))(std::forward<Args>(args)...);
+    }
+
+    /** The function calling the callable object. */
+    R (*m_invoke)(const unsigned char*, Args...);
+    /** The callable object. */
+    alignas(void*) unsigned char m_storage[STORAGE_SIZE];
+};
+
+/**
+ * @ingroup callback
+ * @{
+ */
+/**
+ * Build an InlineCallback for a class method.
+ *
+ * @tparam T \deduced The class of the method.
+ * @tparam OBJ \deduced The class of the object, derived from \pname{T}.
+ * @tparam R \deduced The return type of the method.
+ * @tparam Args \deduced The types of the arguments of the method.
+ * @param [in] memPtr The class method.
+ * @param [in] objPtr The object, which must outlive the callback.
+ * @returns The InlineCallback.
+ */
+template <typename T, typename OBJ, typename R, typename... Args>
+InlineCallback<R, Args...>
+MakeInlineCallback(R (T::*memPtr)(Args...), OBJ* objPtr)
+{
+    return InlineCallback<R, Args...>(
+        [memPtr, objPtr](Args... args) -> R { return (objPtr->*memPtr)(args...); });
+}
+
+template <typename T, typename OBJ, typename R, typename... Args>
+InlineCallback<R, Args...>
+MakeInlineCallback(R (T::*memPtr)(Args...) const, const OBJ* objPtr)
+{
+    return InlineCallback<R, Args...>(
+        [memPtr, objPtr](Args... args) -> R { return (objPtr->*memPtr)(args...); });
+}
+
+/**
+ * Build an InlineCallback for a function.
+ *
+ * @tparam R \deduced The return type of the function.
+ * @tparam Args \deduced The types of the arguments of the function.
+ * @param [in] fnPtr The function.
+ * @returns The InlineCallback.
+ */
+template <typename R, typename... Args>
+InlineCallback<R, Args...>
+MakeInlineCallback(R (*fnPtr)(Args...))
+{
+    return InlineCallback<R, Args...>(fnPtr);
+}
+
+/**@}*/
+
+/**
+ * @ingroup events
+ * Make an EventImpl from an InlineCallback and its arguments.
+ *
+ * @tparam Us \deduced The types of the arguments of the callback.
+ * @tparam Ts \deduced The types of the arguments given.
+ * @param [in] cb The callback.
+ * @param [in] args The arguments of the callback, stored in the event.
+ * @returns The event.
+ */
+template <typename... Us, typename... Ts>
+EventImpl*
+MakeEvent(const InlineCallback<void, Us...>& cb, Ts... args)
+{
+    class EventInlineCallbackImpl : public EventImpl
+    {
+      public:
+        EventInlineCallbackImpl(const InlineCallback<void, Us...>& cb, Ts... args)
+            : m_callback(cb),
+              m_arguments(args...)
+        {
+        }
+
+      protected:
+        ~EventInlineCallbackImpl() override
+        {
+        }
+
+      private:
+        void Notify() override
+        {
+            std::apply([this](auto&... args) { m_callback(args...); }, m_arguments);
+        }
+
+        InlineCallback<void, Us...> m_callback;
+        std::tuple<std::remove_reference_t<Ts>...> m_arguments;
+    }* ev = new EventInlineCallbackImpl(cb, args...);
+
+    return ev;
+}
+
+} // namespace ns3
+
+#endif /* INLINE_CALLBACK_H */
@@ -0,0 +1,301 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "uinteger.h"
+
+#include <algorithm>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+namespace
+{
+
+/**
+ * @ingroup scheduler
+ * Order the events of the Bottom by decreasing key, so that the
+ * next event is at the back of the vector.
+ *
+ * @param [in] a The first event.
+ * @param [in] b The second event.
+ * @returns \c true if \pname{a} is later than \pname{b}.
+ */
+bool
+IsLater(const Scheduler::Event& a, const Scheduler::Event& b)
+{
+    return b < a;
+}
+
+} // unnamed namespace
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LadderScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<LadderScheduler>()
+            .AddAttribute("Threshold",
+                          "Buckets with more events than this are spread over a new rung "
+                          "rather than sorted into the Bottom",
+                          UintegerValue(50),
+                          MakeUintegerAccessor(&LadderScheduler::m_threshold),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxRungs",
+                          "The maximum number of rungs of the ladder",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&LadderScheduler::m_maxRungs),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topMin(0),
+      m_topMax(0),
+      m_topStart(0),
+      m_size(0),
+      m_threshold(50),
+      m_maxRungs(8)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+LadderScheduler::CurrentStart(const Rung& rung)
+{
+    return rung.start + rung.current * rung.width;
+}
+
+void
+LadderScheduler::SpawnRung(uint64_t start, uint64_t end, Bucket& events)
+{
+    NS_LOG_FUNCTION(this << start << end << events.size());
+    NS_ASSERT(start < end && !events.empty());
+    Rung rung;
+    rung.start = start;
+    // One bucket per event, on average
+    rung.width = std::max<uint64_t>((end - start + events.size() - 1) / events.size(), 1);
+    rung.current = 0;
+    rung.buckets.resize((end - start + rung.width - 1) / rung.width);
+    for (const auto& ev : events)
+    {
+        NS_ASSERT(ev.key.m_ts >= start && ev.key.m_ts < end);
+        rung.buckets[(ev.key.m_ts - start) / rung.width].push_back(ev);
+    }
+    events.clear();
+    m_rungs.push_back(std::move(rung));
+}
+
+void
+LadderScheduler::MoveToBottom(Bucket& events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    NS_ASSERT(m_bottom.empty());
+    m_bottom.assign(events.begin(), events.end());
+    events.clear();
+    std::sort(m_bottom.begin(), m_bottom.end(), IsLater);
+}
+
+void
+LadderScheduler::InsertBottom(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    auto it = std::upper_bound(m_bottom.begin(), m_bottom.end(), ev, IsLater);
+    m_bottom.insert(it, ev);
+
+    if (m_bottom.size() > m_threshold && m_rungs.size() < m_maxRungs &&
+        m_bottom.front().key.m_ts != m_bottom.back().key.m_ts)
+    {
+        // The Bottom grew too large to keep sorted: spread it over a
+        // new rung covering up to the lowest one.
+        uint64_t start = m_bottom.back().key.m_ts;
+        uint64_t end = m_rungs.empty() ? m_topStart : CurrentStart(m_rungs.back());
+        Bucket events;
+        events.swap(m_bottom);
+        SpawnRung(start, end, events);
+    }
+}
+
+void
+LadderScheduler::Refill()
+{
+    NS_LOG_FUNCTION(this);
+    while (m_bottom.empty() && m_size > 0)
+    {
+        if (m_rungs.empty())
+        {
+            // All the events are in the Top
+            NS_ASSERT(!m_top.empty());
+            uint64_t start = m_topMin;
+            uint64_t end = m_topMax + 1;
+            m_topStart = end;
+            Bucket events;
+            events.swap(m_top);
+            if (events.size() <= m_threshold || start + 1 == end)
+            {
+                MoveToBottom(events);
+            }
+            else
+            {
+                SpawnRung(start, end, events);
+            }
+            continue;
+        }
+
+        Rung& rung = m_rungs.back();
+        while (rung.current < rung.buckets.size() && rung.buckets[rung.current].empty())
+        {
+            rung.current++;
+        }
+        if (rung.current == rung.buckets.size())
+        {
+            m_rungs.pop_back();
+            continue;
+        }
+        uint64_t start = CurrentStart(rung);
+        uint64_t width = rung.width;
+        Bucket events;
+        events.swap(rung.buckets[rung.current]);
+        rung.current++;
+        if (events.size() > m_threshold && width > 1 && m_rungs.size() < m_maxRungs)
+        {
+            SpawnRung(start, start + width, events);
+        }
+        else
+        {
+            MoveToBottom(events);
+        }
+    }
+}
+
+void
+LadderScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    uint64_t ts = ev.key.m_ts;
+    m_size++;
+    if (ts >= m_topStart)
+    {
+        if (m_top.empty())
+        {
+            m_topMin = ts;
+            m_topMax = ts;
+        }
+        else
+        {
+            m_topMin = std::min(m_topMin, ts);
+            m_topMax = std::max(m_topMax, ts);
+        }
+        m_top.push_back(ev);
+    }
+    else
+    {
+        // The rungs are ordered from the coarsest to the finest: the
+        // first one whose unread buckets cover the timestamp holds it.
+        auto rung = std::find_if(m_rungs.begin(), m_rungs.end(), [ts](const Rung& r) {
+            return ts >= CurrentStart(r);
+        });
+        if (rung != m_rungs.end())
+        {
+            rung->buckets[(ts - rung->start) / rung->width].push_back(ev);
+        }
+        else
+        {
+            InsertBottom(ev);
+        }
+    }
+    Refill();
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom.back();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Event ev = m_bottom.back();
+    m_bottom.pop_back();
+    m_size--;
+    Refill();
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+    uint64_t ts = ev.key.m_ts;
+    auto sameUid = [&ev](const Event& other) { return other.key.m_uid == ev.key.m_uid; };
+
+    Bucket* bucket = nullptr;
+    if (ts >= m_topStart)
+    {
+        bucket = &m_top;
+    }
+    else
+    {
+        auto rung = std::find_if(m_rungs.begin(), m_rungs.end(), [ts](const Rung& r) {
+            return ts >= CurrentStart(r);
+        });
+        if (rung != m_rungs.end())
+        {
+            bucket = &rung->buckets[(ts - rung->start) / rung->width];
+        }
+    }
+
+    if (bucket != nullptr)
+    {
+        // Buckets are not sorted: swap with the last event
+        auto it = std::find_if(bucket->begin(), bucket->end(), sameUid);
+        NS_ASSERT_MSG(it != bucket->end(), "Event not found");
+        *it = bucket->back();
+        bucket->pop_back();
+    }
+    else
+    {
+        auto it = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, IsLater);
+        NS_ASSERT_MSG(it != m_bottom.end() && sameUid(*it), "Event not found");
+        m_bottom.erase(it);
+    }
+    m_size--;
+    Refill();
+}
+
+} // namespace ns3
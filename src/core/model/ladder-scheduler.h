@@ -0,0 +1,163 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue published in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang], in ACM TOMACS 15(3), 2005.
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * The events are stored in three tiers:
+ *  - Top: an unsorted `std::vector` of the events later than all the
+ *    events of the other tiers; new events are appended to it.
+ *  - Ladder: a stack of rungs, each rung being an array of buckets
+ *    covering a uniform time span.  When the Bottom is empty, the
+ *    Top is spread over the first rung; the first non-empty bucket of
+ *    the lowest rung is then either moved to the Bottom or, if it holds
+ *    more than \c Threshold events, spread over a new, finer rung.
+ *  - Bottom: the earliest events, sorted in a `std::vector`.
+ *
+ * Unlike the CalendarScheduler, the ladder never needs to be resized: the
+ * rungs adapt lazily to the distribution of the event timestamps, which
+ * makes this scheduler robust to skewed distributions, such as many
+ * events at the same timestamp mixed with long timers.  Events with
+ * identical timestamps cannot be split across rungs and go straight to
+ * the Bottom.
+ *
+ * @par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to Top or to a bucket; ordered insert in Bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Bottom kept sorted
+ * Remove()     | ~Constant       | Search within bucket
+ * RemoveNext() | ~Constant       | Lazy spawning of rungs, sort of a bucket
+ *
+ * @par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 9 x `sizeof (*)`<br/>(72 bytes)  | Top, ladder and Bottom `std::vector`
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** A bucket of unsorted events. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        uint64_t start;              //!< Timestamp of the start of the first bucket.
+        uint64_t width;              //!< Time span of each bucket.
+        std::size_t current;         //!< Index of the first bucket not yet dequeued.
+        std::vector<Bucket> buckets; //!< The buckets.
+    };
+
+    /**
+     * Get the timestamp of the start of the first bucket of a rung
+     * which has not been dequeued.
+     *
+     * @param [in] rung The rung.
+     * @returns The earliest timestamp which can be inserted in the rung.
+     */
+    static uint64_t CurrentStart(const Rung& rung);
+
+    /**
+     * Spread events over a new lowest rung.
+     *
+     * @param [in] start The earliest timestamp covered by the rung.
+     * @param [in] end The timestamp following the latest one covered by the rung.
+     * @param [in] events The events to spread, with timestamps in [start, end).
+     */
+    void SpawnRung(uint64_t start, uint64_t end, Bucket& events);
+
+    /**
+     * Sort events in the Bottom, which must be empty.
+     *
+     * @param [in] events The events to move.
+     */
+    void MoveToBottom(Bucket& events);
+
+    /**
+     * Insert an event in the sorted Bottom.
+     *
+     * @param [in] ev The event.
+     */
+    void InsertBottom(const Scheduler::Event& ev);
+
+    /**
+     * Move the next events to the Bottom, if it is empty.
+     *
+     * This keeps the invariant that the Bottom holds the next event
+     * whenever the scheduler is not empty.
+     */
+    void Refill();
+
+    /** The Top: unsorted events, later than all the other events. */
+    Bucket m_top;
+    /** The smallest timestamp in the Top. */
+    uint64_t m_topMin;
+    /** The largest timestamp in the Top. */
+    uint64_t m_topMax;
+    /** The events with a timestamp from this one on go to the Top. */
+    uint64_t m_topStart;
+    /** The rungs of the ladder, the finest one last. */
+    std::vector<Rung> m_rungs;
+    /** The Bottom: the earliest events, sorted by decreasing key. */
+    Bucket m_bottom;
+    /** The number of events. */
+    std::size_t m_size;
+    /** Buckets with more events are spread over a new rung. */
+    uint32_t m_threshold;
+    /** The maximum number of rungs. */
+    uint32_t m_maxRungs;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
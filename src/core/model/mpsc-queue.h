@@ -0,0 +1,289 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include "assert.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::MpscQueue declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup simulator
+ * @brief A multiple producer, single consumer queue.
+ *
+ * Any thread may Push() values, which are removed by a single consumer
+ * thread with Drain().  The values go through a bounded lock-free ring,
+ * so that the producers neither take a lock nor allocate memory in the
+ * common case.  When the ring is full, the values are appended to an
+ * overflow vector protected by a mutex instead, until the consumer
+ * empties it: the values pushed by a given thread are thus always
+ * drained in the order they were pushed.
+ *
+ * The ring is the bounded queue of Dmitry Vyukov: each cell holds a
+ * sequence number telling whether it is free for the producer claiming
+ * its position, or published for the consumer.
+ *
+ * @tparam T \deduced The type of the values, which must be copyable.
+ */
+template <typename T>
+class MpscQueue
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] capacity The number of values the ring can hold,
+     *             which must be a power of two.
+     */
+    MpscQueue(std::size_t capacity = 1024);
+
+    /** Copying the queue is not allowed. */
+    MpscQueue(const MpscQueue&) = delete;
+    /** Copying the queue is not allowed. @returns this */
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * Append a value, from any thread.
+     *
+     * @param [in] value The value.
+     */
+    void Push(const T& value);
+
+    /**
+     * Remove all the values pushed so far, from the consumer thread.
+     *
+     * @tparam F \deduced The type of the function called on the values.
+     * @param [in] f The function called on each value, in order.
+     * @returns The number of values removed.
+     */
+    template <typename F>
+    std::size_t Drain(F f);
+
+    /**
+     * Check whether values are waiting, from the consumer thread.
+     *
+     * @returns \c true if there is no value to drain.
+     */
+    bool IsEmpty() const;
+
+    /**
+     * Get the number of values which did not fit in the ring.
+     *
+     * @returns The number of values pushed to the overflow vector.
+     */
+    uint64_t GetOverflowCount() const;
+
+  private:
+    /** A cell of the ring. */
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence; //!< The sequence number of the cell.
+        T value;                           //!< The value.
+    };
+
+    /**
+     * Append a value to the ring, if it is not full.
+     *
+     * @param [in] value The value.
+     * @returns \c false if the ring is full.
+     */
+    bool TryPush(const T& value);
+    /**
+     * Remove the next value of the ring, if it has been published.
+     *
+     * @param [out] value The value.
+     * @returns \c false if the ring is empty, or the next value is not
+     *          published yet.
+     */
+    bool TryPop(T& value);
+
+    std::unique_ptr<Cell[]> m_cells; //!< The cells of the ring.
+    std::size_t m_mask;              //!< The capacity of the ring, minus one.
+
+    /** The next position claimed by the producers. */
+    alignas(64) std::atomic<std::size_t> m_enqueuePos;
+    /** The next position read by the consumer. */
+    alignas(64) std::size_t m_dequeuePos;
+
+    /** Flag set while values are waiting in the overflow vector. */
+    alignas(64) std::atomic<bool> m_overflowing;
+    /** The number of values pushed to the overflow vector. */
+    std::atomic<uint64_t> m_overflowCount;
+    /** The values which did not fit in the ring. */
+    std::vector<T> m_overflow;
+    /** Mutex protecting the overflow vector. */
+    std::mutex m_overflowMutex;
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+template <typename T>
+MpscQueue<T>::MpscQueue(std::size_t capacity)
+    : m_cells(new Cell[capacity]),
+      m_mask(capacity - 1),
+      m_enqueuePos(0),
+      m_dequeuePos(0),
+      m_overflowing(false),
+      m_overflowCount(0)
+{
+    NS_ASSERT_MSG(capacity >= 2 && (capacity & m_mask) == 0,
+                  "The capacity must be a power of two");
+    for (std::size_t i = 0; i < capacity; i++)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool
+MpscQueue<T>::TryPush(const T& value)
+{
+    Cell* cell;
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        cell = &m_cells[pos & m_mask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0)
+        {
+            // The cell is free: claim its position
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The consumer did not read the cell yet: the ring is full
+            return false;
+        }
+        else
+        {
+            // Another producer claimed the position
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    cell->value = value;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool
+MpscQueue<T>::TryPop(T& value)
+{
+    Cell* cell = &m_cells[m_dequeuePos & m_mask];
+    std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    if (sequence != m_dequeuePos + 1)
+    {
+        return false;
+    }
+    value = cell->value;
+    cell->sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+    m_dequeuePos++;
+    return true;
+}
+
+template <typename T>
+void
+MpscQueue<T>::Push(const T& value)
+{
+    // Once a value overflowed, the next ones follow it until the
+    // consumer drains them, so that they are not reordered.
+    if (!m_overflowing.load(std::memory_order_acquire) && TryPush(value))
+    {
+        return;
+    }
+    std::unique_lock lock{m_overflowMutex};
+    m_overflow.push_back(value);
+    m_overflowing.store(true, std::memory_order_release);
+    m_overflowCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+template <typename F>
+std::size_t
+MpscQueue<T>::Drain(F f)
+{
+    std::size_t count = 0;
+    T value;
+    while (TryPop(value))
+    {
+        f(value);
+        count++;
+    }
+    if (!m_overflowing.load(std::memory_order_acquire))
+    {
+        return count;
+    }
+
+    std::vector<T> overflow;
+    {
+        std::unique_lock lock{m_overflowMutex};
+        // The values in the ring were pushed before the ones which
+        // overflowed: wait for the producers still writing them.
+        while (m_enqueuePos.load(std::memory_order_acquire) != m_dequeuePos)
+        {
+            if (TryPop(value))
+            {
+                f(value);
+                count++;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        overflow.swap(m_overflow);
+        m_overflowing.store(false, std::memory_order_release);
+    }
+    for (const auto& v : overflow)
+    {
+        f(v);
+    }
+    return count + overflow.size();
+}
+
+template <typename T>
+bool
+MpscQueue<T>::IsEmpty() const
+{
+    return m_enqueuePos.load(std::memory_order_acquire) == m_dequeuePos &&
+           !m_overflowing.load(std::memory_order_acquire);
+}
+
+template <typename T>
+uint64_t
+MpscQueue<T>::GetOverflowCount() const
+{
+    return m_overflowCount.load(std::memory_order_relaxed);
+}
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
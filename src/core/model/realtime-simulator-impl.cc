@@ -19,6 +19,7 @@
 #include "synchronizer.h"
 #include "wall-clock-synchronizer.h"
 
+#include <algorithm>
 #include <cmath>
 #include <mutex>
 #include <thread>
@@ -92,6 +93,10 @@ void
 RealtimeSimulatorImpl::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    {
+        std::unique_lock lock{m_mutex};
+        ProcessEventsWithContext();
+    }
     while (!m_events->IsEmpty())
     {
         Scheduler::Event next = m_events->RemoveNext();
@@ -139,6 +144,7 @@ RealtimeSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
 
         if (m_events)
         {
+            ProcessEventsWithContext();
             while (!m_events->IsEmpty())
             {
                 Scheduler::Event next = m_events->RemoveNext();
@@ -193,6 +199,15 @@ RealtimeSimulatorImpl::ProcessOneEvent()
 
         {
             std::unique_lock lock{m_mutex};
+            //
+            // This next line resets the synchronizer so that any future event
+            // will cause it to interrupt.  It comes before we look for the events
+            // scheduled from other threads, which signal the synchronizer after
+            // pushing them: either we find them below, or the wait is interrupted.
+            //
+            m_synchronizer->SetCondition(false);
+            ProcessEventsWithContext();
+
             //
             // Since we are in realtime mode, the time to delay has got to be the
             // difference between the current realtime and the timestamp of the next
@@ -239,10 +254,9 @@ RealtimeSimulatorImpl::ProcessOneEvent()
             // We've figured out how long we need to delay in order to pace the
             // simulation time with the real time.  We're going to sleep, but need
             // to work with the synchronizer to make sure we're awakened if something
-            // external happens (like a packet is received).  This next line resets
-            // the synchronizer so that any future event will cause it to interrupt.
+            // external happens (like a packet is received), which is why its
+            // condition was reset above.
             //
-            m_synchronizer->SetCondition(false);
         }
 
         //
@@ -310,8 +324,10 @@ RealtimeSimulatorImpl::ProcessOneEvent()
         // We do know we're waiting for an event, so there had better be an event on the
         // event queue.  Let's pull it off.  When we release the critical section, the
         // event we're working on won't be on the list and so subsequent operations won't
-        // mess with us.
+        // mess with us.  Events scheduled from other threads in the meantime may
+        // be due before it.
         //
+        ProcessEventsWithContext();
         NS_ASSERT_MSG(m_events->IsEmpty() == false,
                       "RealtimeSimulatorImpl::ProcessOneEvent(): event queue is empty");
         next = m_events->RemoveNext();
@@ -432,6 +448,7 @@ RealtimeSimulatorImpl::Run()
         {
             std::unique_lock lock{m_mutex};
 
+            ProcessEventsWithContext();
             if (!m_events->IsEmpty())
             {
                 process = true;
@@ -531,24 +548,32 @@ RealtimeSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay,
 {
     NS_LOG_FUNCTION(this << context << delay << impl);
 
+    if (m_main != std::this_thread::get_id())
     {
-        std::unique_lock lock{m_mutex};
-        uint64_t ts;
-
-        if (m_main == std::this_thread::get_id())
-        {
-            ts = m_currentTs + delay.GetTimeStep();
-        }
-        else
+        //
+        // If the simulator is running, we're pacing and have a meaningful
+        // realtime clock.  If we're not, then m_currentTs is where we stopped,
+        // which is only read in ProcessEventsWithContext().  Other threads do not
+        // take the critical section: the main thread moves the event to the
+        // event list when it is interrupted.
+        //
+        EventWithContext ev;
+        ev.context = context;
+        ev.running = m_running;
+        ev.timestamp = delay.GetTimeStep();
+        if (ev.running)
         {
-            //
-            // If the simulator is running, we're pacing and have a meaningful
-            // realtime clock.  If we're not, then m_currentTs is where we stopped.
-            //
-            ts = m_running ? m_synchronizer->GetCurrentRealtime() : m_currentTs;
-            ts += delay.GetTimeStep();
+            ev.timestamp += m_synchronizer->GetCurrentRealtime();
         }
+        ev.event = impl;
+        m_eventsWithContext.Push(ev);
+        m_synchronizer->Signal();
+        return;
+    }
 
+    {
+        std::unique_lock lock{m_mutex};
+        uint64_t ts = m_currentTs + delay.GetTimeStep();
         NS_ASSERT_MSG(ts >= m_currentTs,
                       "RealtimeSimulatorImpl::ScheduleRealtime(): schedule for time < m_currentTs");
         Scheduler::Event ev;
@@ -563,6 +588,24 @@ RealtimeSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay,
     }
 }
 
+void
+RealtimeSimulatorImpl::ProcessEventsWithContext()
+{
+    m_eventsWithContext.Drain([this](const EventWithContext& event) {
+        uint64_t ts = event.running ? event.timestamp : m_currentTs + event.timestamp;
+        // The main thread may have moved past the real time at which the
+        // event was scheduled: do not schedule it in the past.
+        Scheduler::Event ev;
+        ev.impl = event.event;
+        ev.key.m_ts = std::max(ts, m_currentTs);
+        ev.key.m_context = event.context;
+        ev.key.m_uid = m_uid;
+        m_uid++;
+        m_unscheduledEvents++;
+        m_events->Insert(ev);
+    });
+}
+
 EventId
 RealtimeSimulatorImpl::ScheduleNow(EventImpl* impl)
 {
@@ -730,6 +773,25 @@ RealtimeSimulatorImpl::Cancel(const EventId& id)
     if (!IsExpired(id))
     {
         id.PeekEventImpl()->Cancel();
+        if (id.GetUid() == EventId::UID::DESTROY)
+        {
+            return;
+        }
+
+        std::unique_lock lock{m_mutex};
+
+        Scheduler::Event event;
+        event.impl = id.PeekEventImpl();
+        event.key.m_ts = id.GetTs();
+        event.key.m_context = id.GetContext();
+        event.key.m_uid = id.GetUid();
+
+        // The scheduler may purge the cancelled events, which are then released here
+        for (const auto& purged : m_events->NotifyCancel(event))
+        {
+            purged.impl->Unref();
+            m_unscheduledEvents--;
+        }
     }
 }
 
@@ -791,6 +853,13 @@ RealtimeSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+Scheduler::CancelStatistics
+RealtimeSimulatorImpl::GetCancelStatistics() const
+{
+    std::unique_lock lock{m_mutex};
+    return m_events->GetCancelStatistics();
+}
+
 void
 RealtimeSimulatorImpl::SetSynchronizationMode(SynchronizationMode mode)
 {
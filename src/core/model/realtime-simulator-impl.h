@@ -10,11 +10,13 @@
 #include "assert.h"
 #include "event-impl.h"
 #include "log.h"
+#include "mpsc-queue.h"
 #include "ptr.h"
 #include "scheduler.h"
 #include "simulator-impl.h"
 #include "synchronizer.h"
 
+#include <atomic>
 #include <list>
 #include <mutex>
 #include <thread>
@@ -97,6 +99,14 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
 
+    /**
+     * Get the statistics of the scheduler on the cancelled events.
+     *
+     * @returns The statistics, only zeros if the scheduler does not
+     *          track the cancelled events.
+     */
+    Scheduler::CancelStatistics GetCancelStatistics() const;
+
     /** @copydoc ScheduleWithContext(uint32_t,const Time&,EventImpl*) */
     void ScheduleRealtimeWithContext(uint32_t context, const Time& delay, EventImpl* event);
     /**
@@ -170,9 +180,33 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     uint64_t NextTs() const;
     /** Process the next event. */
     void ProcessOneEvent();
+    /**
+     * Move the events scheduled from other threads into the event list.
+     * Should be called with the critical section locked.
+     */
+    void ProcessEventsWithContext();
     /** Destructor implementation. */
     void DoDispose() override;
 
+    /** An event scheduled from another thread. */
+    struct EventWithContext
+    {
+        /** The event context. */
+        uint32_t context;
+        /**
+         * The event timestamp if the simulator was running, else the
+         * delay from the current event.
+         */
+        uint64_t timestamp;
+        /** Flag \c true if the timestamp is absolute. */
+        bool running;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /** The events scheduled from other threads, outside of #m_mutex. */
+    MpscQueue<EventWithContext> m_eventsWithContext;
+
     /** Container type for events to be run at destroy time. */
     typedef std::list<EventId> DestroyEvents;
     /** Container for events to be run at destroy time. */
@@ -180,7 +214,7 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     /** Has the stopping condition been reached? */
     bool m_stop;
     /** Is the simulator currently running. */
-    bool m_running;
+    std::atomic<bool> m_running;
 
     /**
      * @name Mutex-protected variables.
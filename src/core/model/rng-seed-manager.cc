@@ -27,9 +27,14 @@ NS_LOG_COMPONENT_DEFINE("RngSeedManager");
 /**
  * @relates RngSeedManager
  * The next random number generator stream number to use
- * for automatic assignment.
+ * for automatic assignment.  Each thread of a multithreaded simulation
+ * draws the stream numbers from the block of the partition it runs.
  */
+#ifdef NS3_MTP
+static thread_local uint64_t g_nextStreamIndex = 0;
+#else
 static uint64_t g_nextStreamIndex = 0;
+#endif
 /**
  * @relates RngSeedManager
  * @anchor GlobalValueRngSeed
@@ -96,9 +101,20 @@ uint64_t
 RngSeedManager::GetNextStreamIndex()
 {
     NS_LOG_FUNCTION_NOARGS();
-    uint64_t next = g_nextStreamIndex;
-    g_nextStreamIndex++;
-    return next;
+    return g_nextStreamIndex++;
+}
+
+uint64_t
+RngSeedManager::PeekNextStreamIndex()
+{
+    return g_nextStreamIndex;
+}
+
+void
+RngSeedManager::SetNextStreamIndex(uint64_t index)
+{
+    NS_LOG_FUNCTION(index);
+    g_nextStreamIndex = index;
 }
 
 void
@@ -94,6 +94,24 @@ class RngSeedManager
      */
     static uint64_t GetNextStreamIndex();
 
+    /**
+     * Get the next automatically assigned stream index, without assigning it.
+     * @returns The next stream index.
+     */
+    static uint64_t PeekNextStreamIndex();
+
+    /**
+     * Set the next automatically assigned stream index.
+     *
+     * With NS3_MTP, the stream index counter is kept per thread: the
+     * multithreaded simulator gives each partition its own block of
+     * stream indices, so that the streams assigned by a partition do not
+     * depend on the interleaving of the threads.
+     *
+     * @param [in] index The next stream index.
+     */
+    static void SetNextStreamIndex(uint64_t index);
+
     /**
      * Resets the global stream index counter.
      */
@@ -36,4 +36,18 @@ Scheduler::GetTypeId()
     return tid;
 }
 
+std::vector<Scheduler::Event>
+Scheduler::NotifyCancel(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_uid);
+    return {};
+}
+
+Scheduler::CancelStatistics
+Scheduler::GetCancelStatistics() const
+{
+    NS_LOG_FUNCTION(this);
+    return {0, 0, 0, 0};
+}
+
 } // namespace ns3
@@ -12,6 +12,7 @@
 #include "object.h"
 
 #include <stdint.h>
+#include <vector>
 
 /**
  * @file
@@ -100,6 +101,14 @@ class EventImpl;
  *      <td class="markdownTableBodyLeft"> 0 </td>
  * </tr>
  * <tr class="markdownTableBody">
+ *      <td class="markdownTableBodyLeft"> LadderScheduler </td>
+ *      <td class="markdownTableBodyLeft"> Ladder of `std::vector` buckets </td>
+ *      <td class="markdownTableBodyLeft"> Constant </td>
+ *      <td class="markdownTableBodyLeft"> Constant </td>
+ *      <td class="markdownTableBodyLeft"> 72 bytes </td>
+ *      <td class="markdownTableBodyLeft"> 0 </td>
+ * </tr>
+ * <tr class="markdownTableBody">
  *      <td class="markdownTableBodyLeft"> ListScheduler </td>
  *      <td class="markdownTableBodyLeft"> `std::list` </td>
  *      <td class="markdownTableBodyLeft"> Linear </td>
@@ -141,6 +150,13 @@ class EventImpl;
  * calling EventId::Ref and SimpleRefCount::Unref at the right time.
  * Typically, EventId::Ref is called before Insert and SimpleRefCount::Unref is called
  * after a call to one of the Remove methods.
+ *
+ * Cancelled events are normally left in the event list until they
+ * are removed by RemoveNext().  Schedulers may instead purge them once
+ * they make up a large share of the event list, when notified of the
+ * cancellations by NotifyCancel(): the purged events are then handed
+ * back to the caller, which releases them like removed events.
+ * The HeapScheduler and the CalendarScheduler do so.
  */
 class Scheduler : public Object
 {
@@ -175,6 +191,15 @@ class Scheduler : public Object
         EventKey key;    /**< Key for sorting and ordering Events. */
     };
 
+    /** Statistics on the cancelled events of the event list. */
+    struct CancelStatistics
+    {
+        uint64_t events;      /**< Events in the event list, cancelled or not. */
+        uint64_t cancelled;   /**< Cancelled events in the event list. */
+        uint64_t compactions; /**< Number of purges of the cancelled events. */
+        uint64_t purged;      /**< Cancelled events removed by the purges. */
+    };
+
     /** Destructor. */
     ~Scheduler() override = 0;
 
@@ -215,6 +240,25 @@ class Scheduler : public Object
      * @param [in] ev The event to remove
      */
     virtual void Remove(const Event& ev) = 0;
+    /**
+     * Notify that an event of the event list has been cancelled.
+     *
+     * The default implementation leaves the event in the event list.
+     *
+     * @param [in] ev The cancelled event.
+     * @returns The cancelled events purged from the event list, if any.
+     *      The caller releases them as if they had been removed by Remove().
+     */
+    virtual std::vector<Event> NotifyCancel(const Event& ev);
+    /**
+     * Get the statistics on the cancelled events.
+     *
+     * The default implementation, for schedulers which do not track
+     * the cancelled events, returns only zeros.
+     *
+     * @returns The statistics.
+     */
+    virtual CancelStatistics GetCancelStatistics() const;
 };
 
 /**
@@ -16,6 +16,10 @@
 #include <limits>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 /**
  * @file
  * @ingroup ptr
@@ -114,8 +118,7 @@ class SimpleRefCount : public PARENT
      */
     inline void Unref() const
     {
-        m_count--;
-        if (m_count == 0)
+        if (--m_count == 0)
         {
             DELETER::Delete(static_cast<T*>(const_cast<SimpleRefCount*>(this)));
         }
@@ -138,9 +141,14 @@ class SimpleRefCount : public PARENT
      *
      * @internal
      * Note we make this mutable so that the const methods can still
-     * change it.
+     * change it.  Multithreaded builds (NS3_MTP) use an atomic counter
+     * so that objects can be shared between simulation threads.
      */
+#ifdef NS3_MTP
+    mutable std::atomic<uint32_t> m_count;
+#else
     mutable uint32_t m_count;
+#endif
 };
 
 } // namespace ns3
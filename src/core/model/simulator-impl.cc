@@ -29,4 +29,13 @@ SimulatorImpl::GetTypeId()
     return tid;
 }
 
+void
+SimulatorImpl::ScheduleWithContextBatch(const Time& delay, EventBatch events)
+{
+    for (const auto& [context, event] : events)
+    {
+        ScheduleWithContext(context, delay, event);
+    }
+}
+
 } // namespace ns3
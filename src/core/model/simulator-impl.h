@@ -55,6 +55,13 @@ class SimulatorImpl : public Object
     virtual EventId Schedule(const Time& delay, EventImpl* event) = 0;
     /** @copydoc Simulator::ScheduleWithContext(uint32_t,const Time&,EventImpl*) */
     virtual void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) = 0;
+    /**
+     * @copydoc Simulator::ScheduleWithContextBatch
+     *
+     * The default implementation schedules each event with
+     * ScheduleWithContext(), in order.
+     */
+    virtual void ScheduleWithContextBatch(const Time& delay, EventBatch events);
     /** @copydoc Simulator::ScheduleNow(const Ptr<EventImpl>&) */
     virtual EventId ScheduleNow(EventImpl* event) = 0;
     /** @copydoc Simulator::ScheduleDestroy(const Ptr<EventImpl>&) */
@@ -18,6 +18,7 @@
 #include "scheduler.h"
 #include "simulator-impl.h"
 #include "string.h"
+#include "timer-wheel.h"
 
 #include "ns3/core-config.h"
 
@@ -144,6 +145,9 @@ Simulator::Destroy()
      */
     LogSetTimePrinter(nullptr);
     LogSetNodePrinter(nullptr);
+    // The timers left in the wheel are unlinked, so that they can be cancelled
+    // by the destroy events
+    TimerWheel::DeleteWheel();
     (*pimpl)->Destroy();
     (*pimpl)->Unref();
     *pimpl = nullptr;
@@ -230,6 +234,18 @@ Simulator::ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* i
     return GetImpl()->ScheduleWithContext(context, delay, impl);
 }
 
+void
+Simulator::ScheduleWithContextBatch(const Time& delay, EventBatch events)
+{
+#ifdef ENABLE_DES_METRICS
+    for (const auto& [context, event] : events)
+    {
+        DesMetrics::Get()->TraceWithContext(context, Now(), delay);
+    }
+#endif
+    GetImpl()->ScheduleWithContextBatch(delay, std::move(events));
+}
+
 EventId
 Simulator::ScheduleDestroy(const Ptr<EventImpl>& ev)
 {
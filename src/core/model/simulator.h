@@ -470,6 +470,23 @@ class Simulator
      */
     static void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event);
 
+    /**
+     * Schedule events to run at the same time, each in its own context.
+     * This method is thread-safe: it can be called from any thread.
+     *
+     * The events run in the order of the batch, as if they had been
+     * scheduled one by one with ScheduleWithContext(); but the simulator
+     * may insert them as a single entry of its event list, to spare an
+     * insertion and a removal per event.  This fits the channels
+     * delivering a transmission to many receivers.  The events of a
+     * batch cannot be cancelled.
+     *
+     * @param [in] delay Delay until the events expire.
+     * @param [in] events The events, with their context, created by
+     *             MakeEvent().  The simulator takes their ownership.
+     */
+    static void ScheduleWithContextBatch(const Time& delay, EventBatch events);
+
     /**
      * Schedule an event to run at the end of the simulation, after
      * the Stop() time or condition has been reached.
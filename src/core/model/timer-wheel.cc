@@ -0,0 +1,378 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "timer-wheel.h"
+
+#include "assert.h"
+#include "boolean.h"
+#include "global-value.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <bit>
+#include <limits>
+
+/**
+ * @file
+ * @ingroup timer
+ * ns3::TimerWheel implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TimerWheel");
+
+NS_OBJECT_ENSURE_REGISTERED(TimerWheel);
+
+/**
+ * @relates TimerWheel
+ * @anchor GlobalValueTimerWheelEnabled
+ * Whether Timer and Watchdog expire through the TimerWheel.  The value
+ * is read when the first timer of a simulation is scheduled.
+ *
+ * This is accessible as "--TimerWheelEnabled" from CommandLine.
+ */
+static GlobalValue g_timerWheelEnabled("TimerWheelEnabled",
+                                       "Whether Timer and Watchdog expire through the TimerWheel",
+                                       BooleanValue(false),
+                                       MakeBooleanChecker());
+
+/**
+ * @relates TimerWheel
+ * The wheel of the simulation.
+ */
+static TimerWheel* g_timerWheel = nullptr;
+/**
+ * @relates TimerWheel
+ * Whether the "TimerWheelEnabled" global value was read in this simulation.
+ */
+static bool g_timerWheelChecked = false;
+
+TimerWheel::Entry::Entry()
+    : m_prev(nullptr),
+      m_next(nullptr),
+      m_tick(0),
+      m_expiration(),
+      m_context(0),
+      m_generation(0),
+      m_expiring(false),
+      m_expire()
+{
+}
+
+TimerWheel::Entry::~Entry()
+{
+    Unlink();
+}
+
+void
+TimerWheel::Entry::Unlink()
+{
+    if (m_prev != nullptr)
+    {
+        m_prev->m_next = m_next;
+        if (m_next != nullptr)
+        {
+            m_next->m_prev = m_prev;
+        }
+        m_prev = nullptr;
+        m_next = nullptr;
+    }
+}
+
+void
+TimerWheel::Entry::Cancel()
+{
+    Unlink();
+    m_expiring = false;
+}
+
+bool
+TimerWheel::Entry::IsPending() const
+{
+    return m_prev != nullptr || m_expiring;
+}
+
+Time
+TimerWheel::Entry::GetExpiration() const
+{
+    return m_expiration;
+}
+
+TypeId
+TimerWheel::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TimerWheel")
+                            .SetParent<Object>()
+                            .SetGroupName("Core")
+                            .AddConstructor<TimerWheel>()
+                            .AddAttribute("Resolution",
+                                          "The duration of a tick of the wheel",
+                                          TimeValue(MilliSeconds(1)),
+                                          MakeTimeAccessor(&TimerWheel::m_resolution),
+                                          MakeTimeChecker(TimeStep(1)));
+    return tid;
+}
+
+TimerWheel::TimerWheel()
+    : m_resolution(MilliSeconds(1)),
+      m_now(0),
+      m_next(std::numeric_limits<uint64_t>::max()),
+      m_tickEvent(),
+      m_ticks(0),
+      m_slots(),
+      m_occupied()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TimerWheel::~TimerWheel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TimerWheel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& head : m_slots)
+    {
+        while (head.m_next != nullptr)
+        {
+            head.m_next->Unlink();
+        }
+    }
+    m_occupied.fill(0);
+    m_tickEvent.Cancel();
+    m_next = std::numeric_limits<uint64_t>::max();
+    Object::DoDispose();
+}
+
+TimerWheel*
+TimerWheel::Get()
+{
+    if (!g_timerWheelChecked)
+    {
+        g_timerWheelChecked = true;
+        BooleanValue enabled;
+        g_timerWheelEnabled.GetValue(enabled);
+        if (enabled.Get())
+        {
+            Ptr<TimerWheel> wheel = CreateObject<TimerWheel>();
+            g_timerWheel = PeekPointer(wheel);
+            g_timerWheel->Ref();
+        }
+    }
+    return g_timerWheel;
+}
+
+void
+TimerWheel::DeleteWheel()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    if (g_timerWheel != nullptr)
+    {
+        g_timerWheel->Dispose();
+        g_timerWheel->Unref();
+        g_timerWheel = nullptr;
+    }
+    g_timerWheelChecked = false;
+}
+
+uint64_t
+TimerWheel::GetTickCount() const
+{
+    return m_ticks;
+}
+
+uint64_t
+TimerWheel::GetTick(const Time& time) const
+{
+    return time.GetTimeStep() / m_resolution.GetTimeStep();
+}
+
+void
+TimerWheel::Schedule(Ptr<Entry> entry, const Time& delay, const InlineCallback<void>& expire)
+{
+    NS_LOG_FUNCTION(this << entry << delay);
+    NS_ASSERT_MSG(!delay.IsStrictlyNegative(), "Negative timer delay " << delay);
+    entry->Cancel();
+    entry->m_expiration = Simulator::Now() + delay;
+    entry->m_tick = GetTick(entry->m_expiration);
+    entry->m_context = Simulator::GetContext();
+    entry->m_expire = expire;
+
+    uint64_t now = GetTick(Simulator::Now());
+    if (now > m_now)
+    {
+        Advance(now);
+    }
+    if (entry->m_tick <= m_now)
+    {
+        Expire(PeekPointer(entry));
+        return;
+    }
+    uint64_t tick = File(PeekPointer(entry));
+    if (tick < m_next)
+    {
+        m_tickEvent.Cancel();
+        m_next = tick;
+        m_tickEvent =
+            Simulator::Schedule(TimeStep(tick * m_resolution.GetTimeStep()) - Simulator::Now(),
+                                &TimerWheel::Tick,
+                                this);
+    }
+}
+
+uint64_t
+TimerWheel::File(Entry* entry)
+{
+    // The level is given by the highest bit differing from the current
+    // tick: the higher bits of all the entries of a level are the ones of
+    // the current tick, and their slot follows the one of the current tick.
+    uint64_t diff = entry->m_tick ^ m_now;
+    NS_ASSERT(diff != 0);
+    uint32_t level = (63 - std::countl_zero(diff)) / BITS;
+    uint32_t slot = (entry->m_tick >> (level * BITS)) & (SLOTS - 1);
+
+    Entry& head = m_slots[level * SLOTS + slot];
+    entry->m_next = head.m_next;
+    if (entry->m_next != nullptr)
+    {
+        entry->m_next->m_prev = entry;
+    }
+    entry->m_prev = &head;
+    head.m_next = entry;
+    m_occupied[level] |= uint64_t(1) << slot;
+
+    uint32_t shift = (level + 1) * BITS;
+    uint64_t upper = shift < 64 ? (m_now >> shift) << shift : 0;
+    return upper | (uint64_t(slot) << (level * BITS));
+}
+
+bool
+TimerWheel::FindNext(uint64_t& tick, uint32_t& level, uint32_t& slot)
+{
+    // The entries of a level all expire before the ones of the upper
+    // levels, and the slots of a level are cleared lazily.
+    for (level = 0; level < LEVELS; level++)
+    {
+        uint64_t bits = m_occupied[level];
+        while (bits != 0)
+        {
+            slot = std::countr_zero(bits);
+            if (m_slots[level * SLOTS + slot].m_next != nullptr)
+            {
+                uint32_t shift = (level + 1) * BITS;
+                uint64_t upper = shift < 64 ? (m_now >> shift) << shift : 0;
+                tick = upper | (uint64_t(slot) << (level * BITS));
+                return true;
+            }
+            bits &= bits - 1;
+            m_occupied[level] &= ~(uint64_t(1) << slot);
+        }
+    }
+    return false;
+}
+
+void
+TimerWheel::Advance(uint64_t tick)
+{
+    NS_LOG_FUNCTION(this << tick);
+    if (m_next > tick)
+    {
+        // No slot to process: the entries remain in the slots they follow
+        m_now = tick;
+        return;
+    }
+    uint64_t next;
+    uint32_t level;
+    uint32_t slot;
+    while (FindNext(next, level, slot) && next <= tick)
+    {
+        m_now = next;
+        Entry& head = m_slots[level * SLOTS + slot];
+        Entry* entry = head.m_next;
+        head.m_next = nullptr;
+        m_occupied[level] &= ~(uint64_t(1) << slot);
+        while (entry != nullptr)
+        {
+            Entry* following = entry->m_next;
+            entry->m_prev = nullptr;
+            entry->m_next = nullptr;
+            if (entry->m_tick <= m_now)
+            {
+                Expire(entry);
+            }
+            else
+            {
+                // Cascade to a lower level
+                File(entry);
+            }
+            entry = following;
+        }
+    }
+    m_now = tick;
+    ScheduleTick();
+}
+
+void
+TimerWheel::ScheduleTick()
+{
+    uint64_t tick;
+    uint32_t level;
+    uint32_t slot;
+    if (!FindNext(tick, level, slot))
+    {
+        m_tickEvent.Cancel();
+        m_next = std::numeric_limits<uint64_t>::max();
+        return;
+    }
+    if (tick == m_next && m_tickEvent.IsPending())
+    {
+        return;
+    }
+    m_tickEvent.Cancel();
+    m_next = tick;
+    m_tickEvent =
+        Simulator::Schedule(TimeStep(tick * m_resolution.GetTimeStep()) - Simulator::Now(),
+                            &TimerWheel::Tick,
+                            this);
+}
+
+void
+TimerWheel::Tick()
+{
+    NS_LOG_FUNCTION(this);
+    m_ticks++;
+    Advance(GetTick(Simulator::Now()));
+}
+
+void
+TimerWheel::Expire(Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    entry->m_expiring = true;
+    entry->m_generation++;
+    Simulator::ScheduleWithContext(entry->m_context,
+                                   entry->m_expiration - Simulator::Now(),
+                                   &TimerWheel::Fire,
+                                   Ptr<Entry>(entry),
+                                   entry->m_generation);
+}
+
+void
+TimerWheel::Fire(Ptr<Entry> entry, uint32_t generation)
+{
+    // The entry may have been cancelled, or rescheduled, since the event
+    // was scheduled.
+    if (entry->m_expiring && entry->m_generation == generation)
+    {
+        entry->m_expiring = false;
+        entry->m_expire();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,207 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "event-id.h"
+#include "inline-callback.h"
+#include "nstime.h"
+#include "object.h"
+#include "simple-ref-count.h"
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @file
+ * @ingroup timer
+ * ns3::TimerWheel declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup timer
+ * @brief A hierarchical timing wheel holding the Timer and Watchdog
+ * expirations.
+ *
+ * Protocols keep many timers which are rescheduled long before they
+ * expire.  With a wheel, the scheduler holds a single event, for the
+ * next occupied slot of the wheel, instead of one event per timer:
+ * scheduling and cancelling a timer only link and unlink it from a slot.
+ *
+ * The time is divided in ticks of the \c Resolution attribute.  The
+ * wheel has 11 levels of 64 slots: a timer expiring in \f$n\f$ ticks is
+ * filed in the level of the highest bit of \f$n\f$ (in base 64), and
+ * cascades to the lower levels as the time advances.  When the tick of
+ * a timer is reached, an event is scheduled at its exact expiration
+ * time, in the context it was scheduled from: the expirations are not
+ * rounded to the resolution.
+ *
+ * Timer and Watchdog use the wheel when the "TimerWheelEnabled" global
+ * value is set.  The wheel is created by the first timer scheduled in a
+ * simulation, and the global value is read at that time.  The wheel is
+ * deleted by Simulator::Destroy().  The wheel is not thread-safe: it
+ * cannot be used with a multithreaded simulator implementation.
+ */
+class TimerWheel : public Object
+{
+  public:
+    /**
+     * @brief A timer of the wheel.
+     *
+     * Entries are reference counted, so that an entry remains valid
+     * until its expiration event runs, even if its owner is destroyed
+     * once the entry is cancelled.
+     */
+    class Entry : public SimpleRefCount<Entry>
+    {
+      public:
+        /** Constructor. */
+        Entry();
+        /** Destructor. */
+        ~Entry();
+
+        /**
+         * Cancel the expiration, whether the entry is still in the
+         * wheel or its expiration event is scheduled.
+         */
+        void Cancel();
+        /** @returns \c true if the entry has not expired nor been cancelled. */
+        bool IsPending() const;
+        /** @returns The expiration time of the entry. */
+        Time GetExpiration() const;
+
+      private:
+        friend class TimerWheel;
+
+        /** Remove the entry from its slot. */
+        void Unlink();
+
+        Entry* m_prev;                 //!< The previous entry in the slot, or the slot head.
+        Entry* m_next;                 //!< The next entry in the slot.
+        uint64_t m_tick;               //!< The tick of the expiration.
+        Time m_expiration;             //!< The expiration time.
+        uint32_t m_context;            //!< The context of the expiration event.
+        uint32_t m_generation;         //!< The number of expiration events scheduled.
+        bool m_expiring;               //!< Whether the expiration event is scheduled.
+        InlineCallback<void> m_expire; //!< The function called on expiration.
+    };
+
+    /**
+     * Register this type.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    TimerWheel();
+    /** Destructor. */
+    ~TimerWheel() override;
+
+    /**
+     * Get the wheel of the simulation.
+     *
+     * The "TimerWheelEnabled" global value is read on the first call of a
+     * simulation, which must be made from the main thread: the
+     * multithreaded simulator makes it before starting its threads.
+     *
+     * @returns The wheel, or \c nullptr if the "TimerWheelEnabled" global
+     *          value was not set when the first timer was scheduled.
+     */
+    static TimerWheel* Get();
+
+    /**
+     * Delete the wheel of the simulation, if any, so that the next
+     * simulation reads the "TimerWheelEnabled" global value again.
+     *
+     * This is called by Simulator::Destroy().
+     */
+    static void DeleteWheel();
+
+    /**
+     * Schedule an entry, cancelling its previous expiration if needed.
+     *
+     * @param [in] entry The entry.
+     * @param [in] delay The delay before the expiration.
+     * @param [in] expire The function called on expiration.
+     */
+    void Schedule(Ptr<Entry> entry, const Time& delay, const InlineCallback<void>& expire);
+
+    /** @returns The number of wheel ticks processed. */
+    uint64_t GetTickCount() const;
+
+  private:
+    void DoDispose() override;
+
+    /** Number of bits of the tick per level. */
+    static constexpr uint32_t BITS = 6;
+    /** Number of slots per level. */
+    static constexpr uint32_t SLOTS = 1 << BITS;
+    /** Number of levels, enough for any 64 bit tick. */
+    static constexpr uint32_t LEVELS = (64 + BITS - 1) / BITS;
+
+    /**
+     * Convert a time to a tick, rounding down.
+     *
+     * @param [in] time The time.
+     * @returns The tick.
+     */
+    uint64_t GetTick(const Time& time) const;
+    /**
+     * Add an entry to the slot of its tick.
+     *
+     * @param [in] entry The entry, expiring after the current tick.
+     * @returns The tick at which the slot is processed.
+     */
+    uint64_t File(Entry* entry);
+    /**
+     * Schedule the expiration event of an entry.
+     *
+     * @param [in] entry The entry, expiring in the current tick.
+     */
+    void Expire(Entry* entry);
+    /**
+     * Find the next occupied slot.
+     *
+     * @param [out] tick The tick at which the slot is processed.
+     * @param [out] level The level of the slot.
+     * @param [out] slot The slot.
+     * @returns \c false if the wheel is empty.
+     */
+    bool FindNext(uint64_t& tick, uint32_t& level, uint32_t& slot);
+    /**
+     * Process the slots up to a tick.
+     *
+     * @param [in] tick The tick.
+     */
+    void Advance(uint64_t tick);
+    /** Schedule the tick event at the next occupied slot. */
+    void ScheduleTick();
+    /** The tick event. */
+    void Tick();
+    /**
+     * The expiration event of an entry.
+     *
+     * @param [in] entry The entry.
+     * @param [in] generation The generation of the entry when the event was scheduled.
+     */
+    static void Fire(Ptr<Entry> entry, uint32_t generation);
+
+    Time m_resolution;   //!< The duration of a tick.
+    uint64_t m_now;      //!< The last tick processed.
+    uint64_t m_next;     //!< The tick of the tick event.
+    EventId m_tickEvent; //!< The tick event.
+    uint64_t m_ticks;    //!< The number of tick events.
+    /** The heads of the slots. */
+    std::array<Entry, LEVELS * SLOTS> m_slots;
+    /** The slots which may be occupied, one bit per slot. */
+    std::array<uint64_t, LEVELS> m_occupied;
+};
+
+} // namespace ns3
+
+#endif /* TIMER_WHEEL_H */
@@ -26,6 +26,7 @@ Timer::Timer()
     : m_flags(CHECK_ON_DESTROY),
       m_delay(),
       m_event(),
+      m_wheelEntry(),
       m_impl(nullptr)
 {
     NS_LOG_FUNCTION(this);
@@ -35,6 +36,7 @@ Timer::Timer(DestroyPolicy destroyPolicy)
     : m_flags(destroyPolicy),
       m_delay(),
       m_event(),
+      m_wheelEntry(),
       m_impl(nullptr)
 {
     NS_LOG_FUNCTION(this << destroyPolicy);
@@ -45,7 +47,7 @@ Timer::~Timer()
     NS_LOG_FUNCTION(this);
     if (m_flags & CHECK_ON_DESTROY)
     {
-        if (m_event.IsPending())
+        if (m_event.IsPending() || IsWheelPending())
         {
             NS_FATAL_ERROR("Event is still running while destroying.");
         }
@@ -58,6 +60,11 @@ Timer::~Timer()
     {
         m_event.Remove();
     }
+    if (m_wheelEntry)
+    {
+        // The expiration event may outlive the timer
+        m_wheelEntry->Cancel();
+    }
     delete m_impl;
 }
 
@@ -82,6 +89,10 @@ Timer::GetDelayLeft() const
     switch (GetState())
     {
     case Timer::RUNNING:
+        if (IsWheelPending())
+        {
+            return m_wheelEntry->GetExpiration() - Simulator::Now();
+        }
         return Simulator::GetDelayLeft(m_event);
     case Timer::EXPIRED:
         return TimeStep(0);
@@ -98,6 +109,10 @@ Timer::Cancel()
 {
     NS_LOG_FUNCTION(this);
     m_event.Cancel();
+    if (m_wheelEntry)
+    {
+        m_wheelEntry->Cancel();
+    }
 }
 
 void
@@ -105,20 +120,24 @@ Timer::Remove()
 {
     NS_LOG_FUNCTION(this);
     m_event.Remove();
+    if (m_wheelEntry)
+    {
+        m_wheelEntry->Cancel();
+    }
 }
 
 bool
 Timer::IsExpired() const
 {
     NS_LOG_FUNCTION(this);
-    return !IsSuspended() && m_event.IsExpired();
+    return !IsSuspended() && m_event.IsExpired() && !IsWheelPending();
 }
 
 bool
 Timer::IsRunning() const
 {
     NS_LOG_FUNCTION(this);
-    return !IsSuspended() && m_event.IsPending();
+    return !IsSuspended() && (m_event.IsPending() || IsWheelPending());
 }
 
 bool
@@ -159,11 +178,11 @@ Timer::Schedule(Time delay)
 {
     NS_LOG_FUNCTION(this << delay);
     NS_ASSERT(m_impl != nullptr);
-    if (m_event.IsPending())
+    if (m_event.IsPending() || IsWheelPending())
     {
         NS_FATAL_ERROR("Event is still running while re-scheduling.");
     }
-    m_event = m_impl->Schedule(delay);
+    DoSchedule(delay);
 }
 
 void
@@ -171,14 +190,14 @@ Timer::Suspend()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(IsRunning());
-    m_delayLeft = Simulator::GetDelayLeft(m_event);
+    m_delayLeft = GetDelayLeft();
     if (m_flags & CANCEL_ON_DESTROY)
     {
-        m_event.Cancel();
+        Cancel();
     }
     else if (m_flags & REMOVE_ON_DESTROY)
     {
-        m_event.Remove();
+        Remove();
     }
     m_flags |= TIMER_SUSPENDED;
 }
@@ -188,8 +207,37 @@ Timer::Resume()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(m_flags & TIMER_SUSPENDED);
-    m_event = m_impl->Schedule(m_delayLeft);
+    DoSchedule(m_delayLeft);
     m_flags &= ~TIMER_SUSPENDED;
 }
 
+void
+Timer::DoSchedule(Time delay)
+{
+    TimerWheel* wheel = TimerWheel::Get();
+    if (wheel == nullptr)
+    {
+        m_event = m_impl->Schedule(delay);
+        return;
+    }
+    if (!m_wheelEntry)
+    {
+        m_wheelEntry = Create<TimerWheel::Entry>();
+    }
+    wheel->Schedule(m_wheelEntry, delay, MakeInlineCallback(&Timer::Expire, this));
+}
+
+void
+Timer::Expire()
+{
+    NS_LOG_FUNCTION(this);
+    m_impl->Invoke();
+}
+
+bool
+Timer::IsWheelPending() const
+{
+    return m_wheelEntry && m_wheelEntry->IsPending();
+}
+
 } // namespace ns3
@@ -11,6 +11,7 @@
 #include "event-id.h"
 #include "fatal-error.h"
 #include "nstime.h"
+#include "timer-wheel.h"
 
 /**
  * @file
@@ -61,6 +62,10 @@ class TimerImpl;
  * management policies. These policies are specified at construction time
  * and cannot be changed after.
  *
+ * When the "TimerWheelEnabled" global value is set, the timer is kept
+ * in the TimerWheel until its last tick, so that scheduling and
+ * cancelling it do not touch the event list.
+ *
  * @see Watchdog for a simpler interface for a watchdog timer.
  */
 class Timer
@@ -229,6 +234,17 @@ class Timer
     /** Internal bit marking the suspended timer state */
     static constexpr auto TIMER_SUSPENDED{1 << 7};
 
+    /**
+     * Schedule the expiration, in the TimerWheel if it is enabled.
+     *
+     * @param [in] delay The delay.
+     */
+    void DoSchedule(Time delay);
+    /** Invoke the function, on expiration through the TimerWheel. */
+    void Expire();
+    /** @returns \c true if the expiration is pending in the TimerWheel. */
+    bool IsWheelPending() const;
+
     /**
      * Bitfield for Timer State, DestroyPolicy and InternalSuspended.
      *
@@ -243,6 +259,8 @@ class Timer
     Time m_delay;
     /** The future event scheduled to expire the timer. */
     EventId m_event;
+    /** The entry expiring the timer through the TimerWheel. */
+    Ptr<TimerWheel::Entry> m_wheelEntry;
     /**
      * The timer implementation, which contains the bound callback
      * function and arguments.
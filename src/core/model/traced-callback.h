@@ -9,9 +9,14 @@
 #ifndef TRACED_CALLBACK_H
 #define TRACED_CALLBACK_H
 
+#include "assert.h"
 #include "callback.h"
+#include "inline-callback.h"
+#include "ptr.h"
+#include "simple-ref-count.h"
 
 #include <list>
+#include <vector>
 
 /**
  * @file
@@ -36,6 +41,13 @@ namespace ns3
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * InlineCallbacks can be connected too, for the sinks invoked on a hot
+ * path: they are held in a vector and invoked, in the order they were
+ * connected, before the chain of Callbacks.  The vector is only allocated
+ * once an InlineCallback is connected, and is copied on write, so that
+ * the InlineCallbacks connected when the TracedCallback is invoked are
+ * all invoked, even if a sink disconnects itself or another one.
+ *
  * @tparam Ts \explicit Types of the functor arguments.
  */
 template <typename... Ts>
@@ -73,6 +85,18 @@ class TracedCallback
      * @param [in] path Context path which was used to connect the Callback.
      */
     void Disconnect(const CallbackBase& callback, std::string path);
+    /**
+     * Append an InlineCallback to the chain (without a context).
+     *
+     * @param [in] callback InlineCallback to add to chain.
+     */
+    void ConnectWithoutContext(const InlineCallback<void, Ts...>& callback);
+    /**
+     * Remove an InlineCallback from the chain.
+     *
+     * @param [in] callback InlineCallback to remove from the chain.
+     */
+    void DisconnectWithoutContext(const InlineCallback<void, Ts...>& callback);
     /**
      * @brief Functor which invokes the chain of Callbacks.
      * @tparam Ts \deduced Types of the functor arguments.
@@ -103,8 +127,20 @@ class TracedCallback
      * @tparam Ts \deduced Types of the functor arguments.
      */
     typedef std::list<Callback<void, Ts...>> CallbackList;
+    /** The InlineCallbacks, shared by the copies of the TracedCallback. */
+    struct InlineList : public SimpleRefCount<InlineList>
+    {
+        /** The InlineCallbacks, in the order they were connected. */
+        std::vector<InlineCallback<void, Ts...>> callbacks;
+    };
+
     /** The chain of Callbacks. */
     CallbackList m_callbackList;
+    /**
+     * The InlineCallbacks, invoked before the chain of Callbacks, or null
+     * if there is none.  The list is never modified once shared.
+     */
+    Ptr<InlineList> m_inlineList;
 };
 
 } // namespace ns3
@@ -118,7 +154,8 @@ namespace ns3
 
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
-    : m_callbackList()
+    : m_callbackList(),
+      m_inlineList(nullptr)
 {
 }
 
@@ -177,10 +214,52 @@ TracedCallback<Ts...>::Disconnect(const CallbackBase& callback, std::string path
     DisconnectWithoutContext(realCb);
 }
 
+template <typename... Ts>
+void
+TracedCallback<Ts...>::ConnectWithoutContext(const InlineCallback<void, Ts...>& callback)
+{
+    NS_ASSERT_MSG(!callback.IsNull(), "Connecting a null InlineCallback");
+    Ptr<InlineList> list = Create<InlineList>();
+    if (m_inlineList)
+    {
+        list->callbacks = m_inlineList->callbacks;
+    }
+    list->callbacks.push_back(callback);
+    m_inlineList = list;
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::DisconnectWithoutContext(const InlineCallback<void, Ts...>& callback)
+{
+    if (!m_inlineList)
+    {
+        return;
+    }
+    Ptr<InlineList> list = Create<InlineList>();
+    for (const auto& cb : m_inlineList->callbacks)
+    {
+        if (!cb.IsEqual(callback))
+        {
+            list->callbacks.push_back(cb);
+        }
+    }
+    m_inlineList = list->callbacks.empty() ? nullptr : list;
+}
+
 template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
+    if (m_inlineList)
+    {
+        // Hold the list: a sink may disconnect an InlineCallback
+        Ptr<InlineList> list = m_inlineList;
+        for (const auto& cb : list->callbacks)
+        {
+            cb(args...);
+        }
+    }
     for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
     {
         (*i)(args...);
@@ -191,7 +270,7 @@ template <typename... Ts>
 bool
 TracedCallback<Ts...>::IsEmpty() const
 {
-    return m_callbackList.empty();
+    return m_callbackList.empty() && !m_inlineList;
 }
 
 } // namespace ns3
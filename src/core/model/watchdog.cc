@@ -23,6 +23,7 @@ NS_LOG_COMPONENT_DEFINE("Watchdog");
 Watchdog::Watchdog()
     : m_impl(nullptr),
       m_event(),
+      m_wheelEntry(),
       m_end()
 {
     NS_LOG_FUNCTION_NOARGS();
@@ -32,6 +33,10 @@ Watchdog::~Watchdog()
 {
     NS_LOG_FUNCTION(this);
     m_event.Cancel();
+    if (m_wheelEntry)
+    {
+        m_wheelEntry->Cancel();
+    }
     delete m_impl;
 }
 
@@ -40,12 +45,39 @@ Watchdog::Ping(Time delay)
 {
     NS_LOG_FUNCTION(this << delay);
     Time end = Simulator::Now() + delay;
+    if (m_wheelEntry && m_wheelEntry->IsPending())
+    {
+        // Moving the entry in the wheel is cheap: do not wait for the
+        // previous expiration to reschedule it.
+        if (end > m_end)
+        {
+            m_end = end;
+            Arm();
+        }
+        return;
+    }
     m_end = std::max(m_end, end);
     if (m_event.IsPending())
     {
         return;
     }
-    m_event = Simulator::Schedule(m_end - Now(), &Watchdog::Expire, this);
+    Arm();
+}
+
+void
+Watchdog::Arm()
+{
+    TimerWheel* wheel = TimerWheel::Get();
+    if (wheel == nullptr)
+    {
+        m_event = Simulator::Schedule(m_end - Now(), &Watchdog::Expire, this);
+        return;
+    }
+    if (!m_wheelEntry)
+    {
+        m_wheelEntry = Create<TimerWheel::Entry>();
+    }
+    wheel->Schedule(m_wheelEntry, m_end - Now(), MakeInlineCallback(&Watchdog::Expire, this));
 }
 
 void
@@ -58,7 +90,7 @@ Watchdog::Expire()
     }
     else
     {
-        m_event = Simulator::Schedule(m_end - Now(), &Watchdog::Expire, this);
+        Arm();
     }
 }
 
@@ -10,6 +10,7 @@
 
 #include "event-id.h"
 #include "nstime.h"
+#include "timer-wheel.h"
 
 /**
  * @file
@@ -105,6 +106,8 @@ class Watchdog
   private:
     /** Internal callback invoked when the timer expires. */
     void Expire();
+    /** Schedule the expiration at m_end, in the TimerWheel if it is enabled. */
+    void Arm();
     /**
      * The timer implementation, which contains the bound callback
      * function and arguments.
@@ -112,6 +115,8 @@ class Watchdog
     internal::TimerImpl* m_impl;
     /** The future event scheduled to expire the timer. */
     EventId m_event;
+    /** The entry expiring the timer through the TimerWheel. */
+    Ptr<TimerWheel::Entry> m_wheelEntry;
     /** The absolute time when the timer will expire. */
     Time m_end;
 };
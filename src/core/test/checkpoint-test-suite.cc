@@ -0,0 +1,166 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/checkpoint.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup simulator
+ * Checkpoint test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup core-tests
+ * Fork a simulation from an event, and check that each branch continues
+ * from the state of the parent, with the same random numbers.
+ */
+class CheckpointForkTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    CheckpointForkTestCase();
+
+  private:
+    void DoRun() override;
+    /** Add a random value to the sum, every 100 ms. */
+    void Sample();
+    /** Fork the simulation into the branches. */
+    void Fork();
+    /**
+     * Get the file written by a branch.
+     *
+     * @param [in] branch The branch.
+     * @returns The filename.
+     */
+    std::string GetFilename(uint32_t branch);
+
+    Ptr<UniformRandomVariable> m_random; //!< The random values.
+    double m_sum;                        //!< The sum of the random values.
+    double m_factor;                     //!< The factor of the values, set by the branch.
+    double m_forkSum;                    //!< The sum when forking.
+};
+
+CheckpointForkTestCase::CheckpointForkTestCase()
+    : TestCase("Check the branches forked from a simulation")
+{
+}
+
+std::string
+CheckpointForkTestCase::GetFilename(uint32_t branch)
+{
+    return CreateTempDirFilename("branch-" + std::to_string(branch));
+}
+
+void
+CheckpointForkTestCase::Sample()
+{
+    m_sum += m_factor * m_random->GetValue();
+    Simulator::Schedule(MilliSeconds(100), &CheckpointForkTestCase::Sample, this);
+}
+
+void
+CheckpointForkTestCase::Fork()
+{
+    m_forkSum = m_sum;
+    uint32_t branch = Checkpoint::Fork(3, 2);
+    if (branch != Checkpoint::PARENT)
+    {
+        m_factor = branch + 1;
+    }
+}
+
+void
+CheckpointForkTestCase::DoRun()
+{
+    m_random = CreateObject<UniformRandomVariable>();
+    m_sum = 0;
+    m_factor = 1;
+    NS_TEST_EXPECT_MSG_EQ(Checkpoint::GetBranch(), Checkpoint::PARENT, "Not the parent");
+
+    Simulator::Schedule(MilliSeconds(100), &CheckpointForkTestCase::Sample, this);
+    Simulator::Schedule(MilliSeconds(1050), &CheckpointForkTestCase::Fork, this);
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+
+    uint32_t branch = Checkpoint::GetBranch();
+    if (branch != Checkpoint::PARENT)
+    {
+        // Report to the parent, without running the rest of the test runner
+        {
+            std::ofstream file(GetFilename(branch));
+            file.precision(17);
+            file << m_forkSum << " " << m_sum << " " << Simulator::Now().GetMilliSeconds()
+                 << std::endl;
+        }
+        std::_Exit(branch == 2 ? 5 : 0);
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MilliSeconds(1050), "Parent not stopped by the fork");
+    Simulator::Destroy();
+    std::vector<int> expected{0, 0, 5};
+    NS_TEST_ASSERT_MSG_EQ((Checkpoint::GetExitCodes() == expected), true, "Wrong exit codes");
+
+    double increment = 0;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        std::ifstream file(GetFilename(i));
+        double forkSum = 0;
+        double sum = 0;
+        int64_t now = 0;
+        file >> forkSum >> sum >> now;
+        NS_TEST_ASSERT_MSG_EQ(file.fail(), false, "No report from branch " << i);
+        NS_TEST_EXPECT_MSG_EQ(forkSum, m_forkSum, "Branch " << i << " forked from another state");
+        NS_TEST_EXPECT_MSG_EQ(now, 2000, "Branch " << i << " did not run until the end");
+        // The branches draw the same random values after the fork
+        if (i == 0)
+        {
+            increment = sum - forkSum;
+            NS_TEST_EXPECT_MSG_GT(increment, 0, "No value drawn after the fork");
+        }
+        NS_TEST_EXPECT_MSG_EQ_TOL((sum - forkSum) / (i + 1),
+                                  increment,
+                                  1e-9,
+                                  "Branch " << i << " drew other random values");
+    }
+}
+
+/**
+ * @ingroup core-tests
+ * Checkpoint test suite.
+ */
+class CheckpointTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    CheckpointTestSuite()
+        : TestSuite("checkpoint")
+    {
+        AddTestCase(new CheckpointForkTestCase());
+    }
+};
+
+/**
+ * @ingroup core-tests
+ * CheckpointTestSuite instance variable.
+ */
+static CheckpointTestSuite g_checkpointTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,240 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/default-simulator-impl.h"
+#include "ns3/double.h"
+#include "ns3/event-trace-file.h"
+#include "ns3/map-scheduler.h"
+#include "ns3/object-factory.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup scheduler
+ * EventTraceFile test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup core-tests
+ * Check the event trace recorded by the DefaultSimulatorImpl.
+ */
+class EventTraceFileTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventTraceFileTestCase();
+
+  private:
+    void DoRun() override;
+    /** An event scheduling another one. */
+    void Reschedule();
+    /**
+     * Check a record.
+     *
+     * @param [in] record The record.
+     * @param [in] operation The expected operation.
+     * @param [in] id The expected event.
+     * @param [in] now The expected time of the operation, in ns.
+     */
+    void Check(const EventTraceFile::Record& record,
+               EventTraceFile::Operation operation,
+               const EventId& id,
+               uint64_t now);
+
+    EventId m_rescheduled; //!< The event scheduled by Reschedule().
+};
+
+EventTraceFileTestCase::EventTraceFileTestCase()
+    : TestCase("Check the operations recorded by DefaultSimulatorImpl::TraceFile")
+{
+}
+
+void
+EventTraceFileTestCase::Reschedule()
+{
+    m_rescheduled = Simulator::Schedule(NanoSeconds(500), [] {});
+}
+
+void
+EventTraceFileTestCase::Check(const EventTraceFile::Record& record,
+                              EventTraceFile::Operation operation,
+                              const EventId& id,
+                              uint64_t now)
+{
+    NS_TEST_EXPECT_MSG_EQ(+record.operation, +operation, "Wrong operation");
+    NS_TEST_EXPECT_MSG_EQ(record.uid, id.GetUid(), "Wrong event");
+    NS_TEST_EXPECT_MSG_EQ(record.context, id.GetContext(), "Wrong context");
+    NS_TEST_EXPECT_MSG_EQ(record.now, now, "Wrong time of the operation");
+    NS_TEST_EXPECT_MSG_EQ(record.now + record.delay, id.GetTs(), "Wrong event timestamp");
+}
+
+void
+EventTraceFileTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("event-trace.bin");
+
+    Ptr<DefaultSimulatorImpl> impl = CreateObject<DefaultSimulatorImpl>();
+    impl->SetAttribute("TraceFile", StringValue(filename));
+    Simulator::SetImplementation(impl);
+    impl = nullptr;
+
+    EventId removed = Simulator::Schedule(NanoSeconds(1000), [] {});
+    EventId cancelled = Simulator::Schedule(NanoSeconds(2000), [] {});
+    Simulator::ScheduleWithContext(7,
+                                   NanoSeconds(3000),
+                                   &EventTraceFileTestCase::Reschedule,
+                                   this);
+    // ScheduleWithContext() does not return the event
+    EventId withContext(nullptr, 3000, 7, cancelled.GetUid() + 1);
+    Simulator::Cancel(cancelled);
+    Simulator::Remove(removed);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    EventTraceFile file;
+    file.Open(filename, std::ios::in);
+    std::vector<EventTraceFile::Record> records;
+    EventTraceFile::Record record;
+    while (file.Read(record))
+    {
+        records.push_back(record);
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(records.size(), 9, "Wrong number of records");
+    Check(records[0], EventTraceFile::INSERT, removed, 0);
+    Check(records[1], EventTraceFile::INSERT, cancelled, 0);
+    Check(records[2], EventTraceFile::INSERT, withContext, 0);
+    Check(records[3], EventTraceFile::CANCEL, cancelled, 0);
+    Check(records[4], EventTraceFile::REMOVE, removed, 0);
+    // Cancelled events are still removed from the queue
+    Check(records[5], EventTraceFile::EXECUTE, cancelled, 0);
+    Check(records[6], EventTraceFile::EXECUTE, withContext, 2000);
+    Check(records[7], EventTraceFile::INSERT, m_rescheduled, 3000);
+    Check(records[8], EventTraceFile::EXECUTE, m_rescheduled, 3000);
+}
+
+/**
+ * @ingroup core-tests
+ * Check that a trace recorded while the HeapScheduler purges the
+ * cancelled events can be replayed on another scheduler.
+ */
+class EventTraceFileCompactionTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventTraceFileCompactionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EventTraceFileCompactionTestCase::EventTraceFileCompactionTestCase()
+    : TestCase("Check the replay of a trace recorded with the cancelled events purged")
+{
+}
+
+void
+EventTraceFileCompactionTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("event-trace-compaction.bin");
+
+    Ptr<DefaultSimulatorImpl> impl = CreateObject<DefaultSimulatorImpl>();
+    impl->SetAttribute("TraceFile", StringValue(filename));
+    Simulator::SetImplementation(impl);
+    impl = nullptr;
+    ObjectFactory heap("ns3::HeapScheduler");
+    heap.Set("CompactionMinimum", UintegerValue(4));
+    heap.Set("CompactionRatio", DoubleValue(0.5));
+    Simulator::SetScheduler(heap);
+
+    std::vector<EventId> events;
+    for (uint32_t i = 1; i <= 8; i++)
+    {
+        events.push_back(Simulator::Schedule(NanoSeconds(100 * i), [] {}));
+    }
+    // The fifth cancellation purges the five cancelled events
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        Simulator::Cancel(events[2 * i % 7]);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    EventTraceFile file;
+    file.Open(filename, std::ios::in);
+    std::vector<EventTraceFile::Record> records;
+    EventTraceFile::Record record;
+    while (file.Read(record))
+    {
+        records.push_back(record);
+    }
+
+    uint32_t removed = 0;
+    uint32_t executed = 0;
+    Ptr<Scheduler> scheduler = CreateObject<MapScheduler>();
+    for (const auto& rec : records)
+    {
+        Scheduler::Event ev{nullptr, {rec.now + rec.delay, rec.uid, rec.context}};
+        switch (rec.operation)
+        {
+        case EventTraceFile::INSERT:
+            scheduler->Insert(ev);
+            break;
+        case EventTraceFile::EXECUTE:
+            NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), false, "Execution of an unknown event");
+            NS_TEST_EXPECT_MSG_EQ(scheduler->RemoveNext().key.m_uid,
+                                  rec.uid,
+                                  "Event executed out of the recorded order");
+            executed++;
+            break;
+        case EventTraceFile::REMOVE:
+            scheduler->Remove(ev);
+            removed++;
+            break;
+        case EventTraceFile::CANCEL:
+            break;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(removed, 5, "The purged events were not recorded");
+    NS_TEST_EXPECT_MSG_EQ(executed, 3, "Wrong number of executed events");
+    NS_TEST_EXPECT_MSG_EQ(scheduler->IsEmpty(), true, "Events left after the replay");
+}
+
+/**
+ * @ingroup core-tests
+ * EventTraceFile test suite.
+ */
+class EventTraceFileTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    EventTraceFileTestSuite()
+        : TestSuite("event-trace-file")
+    {
+        AddTestCase(new EventTraceFileTestCase());
+        AddTestCase(new EventTraceFileCompactionTestCase());
+    }
+};
+
+/**
+ * @ingroup core-tests
+ * EventTraceFileTestSuite instance variable.
+ */
+static EventTraceFileTestSuite g_eventTraceFileTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/inline-callback.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/traced-callback.h"
+
+#include <type_traits>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup callback
+ * InlineCallback test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+static_assert(std::is_trivially_copyable_v<InlineCallback<void, int, double>>,
+              "InlineCallback must be trivially copyable");
+
+/** The sum of the values received by InlineCallbackTestCase::Function(). */
+static int g_functionSum = 0;
+
+/**
+ * @ingroup core-tests
+ * Check the InlineCallback invocation, comparison and use in a
+ * TracedCallback and in an event.
+ */
+class InlineCallbackTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    InlineCallbackTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Add to the sum of the class method calls.
+     *
+     * @param [in] value The value added.
+     */
+    void Method(int value);
+    /**
+     * Get a value.
+     *
+     * @param [in] value The value.
+     * @returns The value, doubled.
+     */
+    int Double(int value) const;
+    /**
+     * Add to the sum of the function calls.
+     *
+     * @param [in] value The value added.
+     */
+    static void Function(int value);
+
+    int m_methodSum; //!< The sum of the values received by Method().
+};
+
+InlineCallbackTestCase::InlineCallbackTestCase()
+    : TestCase("Check the InlineCallback operations")
+{
+}
+
+void
+InlineCallbackTestCase::Method(int value)
+{
+    m_methodSum += value;
+}
+
+int
+InlineCallbackTestCase::Double(int value) const
+{
+    return 2 * value;
+}
+
+void
+InlineCallbackTestCase::Function(int value)
+{
+    g_functionSum += value;
+}
+
+void
+InlineCallbackTestCase::DoRun()
+{
+    m_methodSum = 0;
+    g_functionSum = 0;
+
+    InlineCallback<void, int> null;
+    NS_TEST_EXPECT_MSG_EQ(null.IsNull(), true, "Default InlineCallback not null");
+
+    auto method = MakeInlineCallback(&InlineCallbackTestCase::Method, this);
+    auto function = MakeInlineCallback(&InlineCallbackTestCase::Function);
+    auto constMethod = MakeInlineCallback(&InlineCallbackTestCase::Double, this);
+    NS_TEST_EXPECT_MSG_EQ(method.IsNull(), false, "InlineCallback null");
+    NS_TEST_EXPECT_MSG_EQ(constMethod(21), 42, "Wrong value returned");
+
+    method(1);
+    function(2);
+    NS_TEST_EXPECT_MSG_EQ(m_methodSum, 1, "Method not invoked");
+    NS_TEST_EXPECT_MSG_EQ(g_functionSum, 2, "Function not invoked");
+
+    NS_TEST_EXPECT_MSG_EQ(method.IsEqual(MakeInlineCallback(&InlineCallbackTestCase::Method, this)),
+                          true,
+                          "Same method on the same object not equal");
+    NS_TEST_EXPECT_MSG_EQ(method.IsEqual(function), false, "Different callbacks equal");
+    auto copy = method;
+    copy.Nullify();
+    NS_TEST_EXPECT_MSG_EQ(copy.IsNull(), true, "InlineCallback not nullified");
+    NS_TEST_EXPECT_MSG_EQ(method.IsNull(), false, "Copy not independent");
+
+    // TracedCallback: the InlineCallbacks are invoked with the Callbacks
+    TracedCallback<int> trace;
+    NS_TEST_EXPECT_MSG_EQ(trace.IsEmpty(), true, "New TracedCallback not empty");
+    trace.ConnectWithoutContext(method);
+    trace.ConnectWithoutContext(function);
+    trace.ConnectWithoutContext(MakeCallback(&InlineCallbackTestCase::Method, this));
+    NS_TEST_EXPECT_MSG_EQ(trace.IsEmpty(), false, "TracedCallback empty");
+    trace(10);
+    NS_TEST_EXPECT_MSG_EQ(m_methodSum, 21, "Sinks of the method not invoked");
+    NS_TEST_EXPECT_MSG_EQ(g_functionSum, 12, "Sink of the function not invoked");
+
+    trace.DisconnectWithoutContext(MakeInlineCallback(&InlineCallbackTestCase::Method, this));
+    trace(100);
+    NS_TEST_EXPECT_MSG_EQ(m_methodSum, 121, "InlineCallback not disconnected");
+    NS_TEST_EXPECT_MSG_EQ(g_functionSum, 112, "Wrong InlineCallback disconnected");
+    trace.DisconnectWithoutContext(function);
+    trace.DisconnectWithoutContext(MakeCallback(&InlineCallbackTestCase::Method, this));
+    NS_TEST_EXPECT_MSG_EQ(trace.IsEmpty(), true, "TracedCallback not empty");
+
+    // Events
+    Simulator::Schedule(Seconds(1), method, 1000);
+    Simulator::Schedule(Seconds(2), function, 1000);
+    Simulator::Run();
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(m_methodSum, 1121, "Event of the method not run");
+    NS_TEST_EXPECT_MSG_EQ(g_functionSum, 1112, "Event of the function not run");
+}
+
+/**
+ * @ingroup core-tests
+ * InlineCallback test suite.
+ */
+class InlineCallbackTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    InlineCallbackTestSuite()
+        : TestSuite("inline-callback")
+    {
+        AddTestCase(new InlineCallbackTestCase());
+    }
+};
+
+/**
+ * @ingroup core-tests
+ * InlineCallbackTestSuite instance variable.
+ */
+static InlineCallbackTestSuite g_inlineCallbackTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,159 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/mpsc-queue.h"
+#include "ns3/test.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup simulator
+ * MpscQueue test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup core-tests
+ * Check the order of the values pushed by a single thread, beyond the
+ * capacity of the ring.
+ */
+class MpscQueueOverflowTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    MpscQueueOverflowTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MpscQueueOverflowTestCase::MpscQueueOverflowTestCase()
+    : TestCase("Check the values overflowing the ring")
+{
+}
+
+void
+MpscQueueOverflowTestCase::DoRun()
+{
+    MpscQueue<int> queue(8);
+    NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), true, "New queue not empty");
+
+    for (int i = 0; i < 100; i++)
+    {
+        queue.Push(i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), false, "Values lost");
+    NS_TEST_EXPECT_MSG_EQ(queue.GetOverflowCount(), 92, "Wrong number of overflowing values");
+
+    int next = 0;
+    std::size_t count = queue.Drain([this, &next](int value) {
+        NS_TEST_EXPECT_MSG_EQ(value, next, "Value out of order");
+        next++;
+    });
+    NS_TEST_EXPECT_MSG_EQ(count, 100, "Wrong number of values drained");
+    NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), true, "Values left after Drain()");
+
+    // The ring is used again once the overflow vector is drained
+    queue.Push(100);
+    NS_TEST_EXPECT_MSG_EQ(queue.GetOverflowCount(), 92, "Value not pushed to the ring");
+    queue.Drain([this](int value) { NS_TEST_EXPECT_MSG_EQ(value, 100, "Wrong value"); });
+}
+
+/**
+ * @ingroup core-tests
+ * Check that the values pushed by several threads are all drained, in
+ * the order each thread pushed them.
+ */
+class MpscQueueThreadsTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    MpscQueueThreadsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MpscQueueThreadsTestCase::MpscQueueThreadsTestCase()
+    : TestCase("Check the values pushed by several threads")
+{
+}
+
+void
+MpscQueueThreadsTestCase::DoRun()
+{
+    const uint32_t nThreads = 4;
+    const uint32_t nValues = 20000;
+
+    // A small ring, for the producers to overflow it
+    MpscQueue<std::pair<uint32_t, uint32_t>> queue(16);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < nThreads; t++)
+    {
+        threads.emplace_back([&queue, t, nValues]() {
+            for (uint32_t i = 0; i < nValues; i++)
+            {
+                queue.Push({t, i});
+            }
+        });
+    }
+
+    std::vector<uint32_t> next(nThreads, 0);
+    uint32_t received = 0;
+    bool ordered = true;
+    while (received < nThreads * nValues)
+    {
+        received += queue.Drain([&next, &ordered](const std::pair<uint32_t, uint32_t>& value) {
+            ordered = ordered && (value.second == next[value.first]);
+            next[value.first]++;
+        });
+        std::this_thread::yield();
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(ordered, true, "Values of a thread out of order");
+    NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), true, "Values left");
+    for (uint32_t t = 0; t < nThreads; t++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(next[t], nValues, "Values of thread " << t << " lost");
+    }
+}
+
+/**
+ * @ingroup core-tests
+ * MpscQueue test suite.
+ */
+class MpscQueueTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    MpscQueueTestSuite()
+        : TestSuite("mpsc-queue")
+    {
+        AddTestCase(new MpscQueueOverflowTestCase());
+        AddTestCase(new MpscQueueThreadsTestCase());
+    }
+};
+
+/**
+ * @ingroup core-tests
+ * MpscQueueTestSuite instance variable.
+ */
+static MpscQueueTestSuite g_mpscQueueTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,204 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ladder-scheduler.h"
+#include "ns3/map-scheduler.h"
+#include "ns3/object.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup scheduler
+ * Scheduler test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup core-tests
+ * Check the order in which a LadderScheduler dequeues the events of a
+ * random sequence of insertions and removals against a MapScheduler.
+ *
+ * The timestamps mix equal timestamps, which are ordered by uid, close
+ * and distant ones, so that rungs are spawned; a small MaxRungs makes
+ * the ladder overflow into the Bottom.  The events removed are picked
+ * among all the pending events, wherever they are stored.
+ */
+class LadderSchedulerTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] threshold The Threshold attribute of the scheduler.
+     * @param [in] maxRungs The MaxRungs attribute of the scheduler.
+     * @param [in] seed The seed of the sequence of operations.
+     */
+    LadderSchedulerTestCase(uint32_t threshold, uint32_t maxRungs, uint32_t seed);
+
+  private:
+    void DoRun() override;
+
+    uint32_t m_threshold; //!< The Threshold attribute of the scheduler.
+    uint32_t m_maxRungs;  //!< The MaxRungs attribute of the scheduler.
+    uint32_t m_seed;      //!< The seed of the sequence of operations.
+};
+
+LadderSchedulerTestCase::LadderSchedulerTestCase(uint32_t threshold,
+                                                 uint32_t maxRungs,
+                                                 uint32_t seed)
+    : TestCase("Check the LadderScheduler against the MapScheduler, Threshold=" +
+               std::to_string(threshold) + ", MaxRungs=" + std::to_string(maxRungs) +
+               ", seed=" + std::to_string(seed)),
+      m_threshold(threshold),
+      m_maxRungs(maxRungs),
+      m_seed(seed)
+{
+}
+
+void
+LadderSchedulerTestCase::DoRun()
+{
+    Ptr<LadderScheduler> ladder = CreateObject<LadderScheduler>();
+    ladder->SetAttribute("Threshold", UintegerValue(m_threshold));
+    ladder->SetAttribute("MaxRungs", UintegerValue(m_maxRungs));
+    Ptr<MapScheduler> reference = CreateObject<MapScheduler>();
+
+    std::mt19937 rng(m_seed);
+    std::vector<Scheduler::Event> pending;
+    uint64_t now = 0;
+    uint32_t uid = 0;
+
+    auto insert = [&]() {
+        uint64_t delay = 0;
+        switch (rng() % 4)
+        {
+        case 0:
+            // equal timestamps are ordered by uid
+            break;
+        case 1:
+            delay = rng() % 16;
+            break;
+        case 2:
+            delay = rng() % 10000;
+            break;
+        default:
+            delay = rng() % 10000000;
+            break;
+        }
+        Scheduler::Event ev;
+        ev.impl = nullptr;
+        ev.key.m_ts = now + delay;
+        ev.key.m_uid = uid++;
+        ev.key.m_context = 0;
+        ladder->Insert(ev);
+        reference->Insert(ev);
+        pending.push_back(ev);
+    };
+
+    auto remove = [&]() {
+        std::size_t index = rng() % pending.size();
+        Scheduler::Event ev = pending[index];
+        pending[index] = pending.back();
+        pending.pop_back();
+        ladder->Remove(ev);
+        reference->Remove(ev);
+    };
+
+    bool ok = true;
+    auto removeNext = [&]() {
+        Scheduler::Event expected = reference->RemoveNext();
+        Scheduler::Event ev = ladder->RemoveNext();
+        if (ev.key.m_uid != expected.key.m_uid || ev.key.m_ts != expected.key.m_ts)
+        {
+            ok = false;
+        }
+        NS_TEST_EXPECT_MSG_EQ(ev.key.m_uid,
+                              expected.key.m_uid,
+                              "Wrong event dequeued at " << ev.key.m_ts);
+        now = expected.key.m_ts;
+        for (auto& other : pending)
+        {
+            if (other.key.m_uid == expected.key.m_uid)
+            {
+                other = pending.back();
+                pending.pop_back();
+                break;
+            }
+        }
+    };
+
+    for (uint32_t round = 0; round < 20 && ok; round++)
+    {
+        // fill the Top, then mix the operations as the ladder drains
+        uint32_t burst = rng() % 500;
+        for (uint32_t k = 0; k < burst; k++)
+        {
+            insert();
+        }
+        for (uint32_t k = 0; k < 2000 && ok; k++)
+        {
+            uint32_t operation = rng() % 10;
+            if (pending.empty() || operation < 4)
+            {
+                insert();
+            }
+            else if (operation < 6)
+            {
+                remove();
+            }
+            else
+            {
+                removeNext();
+            }
+            NS_TEST_EXPECT_MSG_EQ(ladder->IsEmpty(), pending.empty(), "Wrong emptiness");
+        }
+    }
+    while (!pending.empty() && ok)
+    {
+        NS_TEST_EXPECT_MSG_EQ(ladder->PeekNext().key.m_uid,
+                              reference->PeekNext().key.m_uid,
+                              "Wrong event peeked");
+        removeNext();
+    }
+    NS_TEST_EXPECT_MSG_EQ(ladder->IsEmpty(), true, "Events left in the scheduler");
+}
+
+/**
+ * @ingroup core-tests
+ * Scheduler test suite.
+ */
+class SchedulerTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    SchedulerTestSuite()
+        : TestSuite("scheduler")
+    {
+        AddTestCase(new LadderSchedulerTestCase(50, 8, 1));
+        AddTestCase(new LadderSchedulerTestCase(4, 8, 2));
+        AddTestCase(new LadderSchedulerTestCase(1, 2, 3));
+        AddTestCase(new LadderSchedulerTestCase(1, 1, 4));
+    }
+};
+
+/**
+ * @ingroup core-tests
+ * SchedulerTestSuite instance variable.
+ */
+static SchedulerTestSuite g_schedulerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
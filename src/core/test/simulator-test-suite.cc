@@ -6,12 +6,18 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/calendar-scheduler.h"
+#include "ns3/default-simulator-impl.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <array>
+#include <vector>
 
 using namespace ns3;
 
@@ -200,6 +206,297 @@ SimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_destroy, true, "Event should have run");
 }
 
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that the cancelled events purged by the scheduler are
+ * released, and that the other events still run in order.
+ */
+class SimulatorCancelTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param schedulerFactory Scheduler factory.
+     */
+    SimulatorCancelTestCase(ObjectFactory schedulerFactory);
+    void DoRun() override;
+    /**
+     * Test Event.
+     * @param value Event parameter.
+     */
+    void Timeout(int value);
+
+    int m_last;                       //!< The parameter of the last event run.
+    int m_count;                      //!< The number of events run.
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SimulatorCancelTestCase::SimulatorCancelTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check that cancelled events are purged by " +
+               schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SimulatorCancelTestCase::Timeout(int value)
+{
+    NS_TEST_EXPECT_MSG_GT(value, m_last, "Event run out of order");
+    NS_TEST_EXPECT_MSG_EQ(value % 4, 0, "Cancelled event run");
+    m_last = value;
+    m_count++;
+}
+
+void
+SimulatorCancelTestCase::DoRun()
+{
+    m_last = -1;
+    m_count = 0;
+
+    Ptr<DefaultSimulatorImpl> impl = CreateObject<DefaultSimulatorImpl>();
+    Simulator::SetImplementation(impl);
+    Simulator::SetScheduler(m_schedulerFactory);
+
+    const int n = 1000;
+    std::vector<EventId> ids;
+    for (int i = 0; i < n; i++)
+    {
+        ids.push_back(
+            Simulator::Schedule(MicroSeconds(i + 1), &SimulatorCancelTestCase::Timeout, this, i));
+    }
+    // Keep one event out of four, like restarted timers
+    for (int i = 0; i < n; i++)
+    {
+        if (i % 4 != 0)
+        {
+            ids[i].Cancel();
+        }
+    }
+
+    auto stats = impl->GetCancelStatistics();
+    NS_TEST_EXPECT_MSG_GT(stats.compactions, 0, "The cancelled events were not purged");
+    NS_TEST_EXPECT_MSG_EQ(stats.purged + stats.cancelled, 3 * n / 4, "Cancelled events lost");
+    NS_TEST_EXPECT_MSG_EQ(stats.events - stats.cancelled, n / 4, "Live events lost");
+    for (int i = 0; i < n; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(ids[i].IsExpired(), (i % 4 != 0), "Wrong event state");
+    }
+
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_count, n / 4, "Live events not run");
+    stats = impl->GetCancelStatistics();
+    NS_TEST_EXPECT_MSG_EQ(stats.events, 0, "Events left in the scheduler");
+    NS_TEST_EXPECT_MSG_EQ(stats.cancelled, 0, "Cancelled events left in the scheduler");
+
+    impl = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that the events of a batch run in order, in their
+ * context, like events scheduled one by one.
+ */
+class SimulatorBatchTestCase : public TestCase
+{
+  public:
+    SimulatorBatchTestCase();
+    void DoRun() override;
+    /**
+     * Test Event.
+     * @param value Event parameter.
+     */
+    void Record(uint32_t value);
+    /** Test Event stopping the simulation. */
+    void StopNow();
+
+    std::vector<std::pair<uint32_t, uint32_t>> m_runs; //!< The value and context of each event.
+};
+
+SimulatorBatchTestCase::SimulatorBatchTestCase()
+    : TestCase("Check that the events of a batch run in order")
+{
+}
+
+void
+SimulatorBatchTestCase::Record(uint32_t value)
+{
+    m_runs.emplace_back(value, Simulator::GetContext());
+}
+
+void
+SimulatorBatchTestCase::StopNow()
+{
+    Record(100);
+    Simulator::Stop();
+}
+
+void
+SimulatorBatchTestCase::DoRun()
+{
+    Simulator::ScheduleWithContext(7, MicroSeconds(10), &SimulatorBatchTestCase::Record, this, 1);
+    EventBatch batch;
+    for (uint32_t i = 2; i <= 4; i++)
+    {
+        batch.emplace_back(10 + i, MakeEvent(&SimulatorBatchTestCase::Record, this, i));
+    }
+    batch.emplace_back(20, MakeEvent(&SimulatorBatchTestCase::StopNow, this));
+    batch.emplace_back(21, MakeEvent(&SimulatorBatchTestCase::Record, this, 5));
+    Simulator::ScheduleWithContextBatch(MicroSeconds(10), std::move(batch));
+    Simulator::ScheduleWithContext(8, MicroSeconds(10), &SimulatorBatchTestCase::Record, this, 6);
+
+    uint64_t count = Simulator::GetEventCount();
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(m_runs.size(), 5, "The batch did not stop with the simulation");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount() - count, 5, "Wrong event count");
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(m_runs.size(), 7, "Events lost");
+
+    std::vector<std::pair<uint32_t, uint32_t>> expected{{1, 7},
+                                                        {2, 12},
+                                                        {3, 13},
+                                                        {4, 14},
+                                                        {100, 20},
+                                                        {5, 21},
+                                                        {6, 8}};
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_runs[i].first, expected[i].first, "Wrong event order");
+        NS_TEST_EXPECT_MSG_EQ(m_runs[i].second, expected[i].second, "Wrong event context");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check the events recycled by the EventImpl pool, and the
+ * arguments bound by MakeEvent() to a class method.
+ */
+class SimulatorEventPoolTestCase : public TestCase
+{
+  public:
+    SimulatorEventPoolTestCase();
+    void DoRun() override;
+
+    /** An argument whose copies are reference counted. */
+    class Payload : public SimpleRefCount<Payload>
+    {
+    };
+
+    /**
+     * Test Event.
+     * @param value Event parameter.
+     */
+    void Record(uint32_t value);
+    /**
+     * Test Event holding a reference counted argument.
+     * @param payload The argument.
+     * @param value Event parameter.
+     */
+    void Hold(Ptr<Payload> payload, uint32_t value);
+    /**
+     * Test Event too large to be pooled.
+     * @param values Event parameter.
+     */
+    void Large(std::array<uint32_t, 100> values);
+
+    std::vector<uint32_t> m_values; //!< The values received by the events.
+};
+
+SimulatorEventPoolTestCase::SimulatorEventPoolTestCase()
+    : TestCase("Check the recycling of the events and their bound arguments")
+{
+}
+
+void
+SimulatorEventPoolTestCase::Record(uint32_t value)
+{
+    m_values.push_back(value);
+}
+
+void
+SimulatorEventPoolTestCase::Hold(Ptr<Payload> payload, uint32_t value)
+{
+    // The event and the argument of this call hold the payload
+    m_values.push_back(payload->GetReferenceCount() >= 3 ? value : 0);
+}
+
+void
+SimulatorEventPoolTestCase::Large(std::array<uint32_t, 100> values)
+{
+    m_values.push_back(values.front() + values.back());
+}
+
+void
+SimulatorEventPoolTestCase::DoRun()
+{
+    // The memory of a released event is reused by the next event of its size
+    EventImpl* first = MakeEvent(&SimulatorEventPoolTestCase::Record, this, 1);
+    void* memory = first;
+    first->Ref();
+    first->Cancel();
+    first->Unref();
+    NS_TEST_EXPECT_MSG_EQ(first->IsCancelled(), true, "Event released while referenced");
+    first->Unref();
+    EventImpl* second = MakeEvent(&SimulatorEventPoolTestCase::Record, this, 2);
+    NS_TEST_EXPECT_MSG_EQ(static_cast<void*>(second), memory, "Event memory not recycled");
+    NS_TEST_EXPECT_MSG_EQ(second->GetReferenceCount(), 1, "Reference count not reset");
+    NS_TEST_EXPECT_MSG_EQ(second->IsCancelled(), false, "Recycled event still cancelled");
+    second->Invoke();
+    second->Unref();
+    NS_TEST_ASSERT_MSG_EQ(m_values.size(), 1, "Wrong number of events invoked");
+    NS_TEST_EXPECT_MSG_EQ(m_values[0], 2, "Argument of the released event invoked");
+
+    // The bound arguments are copied in the event, and released with it
+    Ptr<Payload> payload = Create<Payload>();
+    uint32_t value = 3;
+    EventImpl* hold = MakeEvent(&SimulatorEventPoolTestCase::Hold, this, payload, value);
+    value = 4;
+    NS_TEST_EXPECT_MSG_EQ(payload->GetReferenceCount(), 2, "Argument not held by the event");
+    hold->Invoke();
+    hold->Invoke();
+    NS_TEST_EXPECT_MSG_EQ(payload->GetReferenceCount(), 2, "Argument released by the invocation");
+    hold->Unref();
+    NS_TEST_EXPECT_MSG_EQ(payload->GetReferenceCount(), 1, "Argument not released");
+    EventImpl* reused = MakeEvent(&SimulatorEventPoolTestCase::Hold, this, payload, value);
+    NS_TEST_EXPECT_MSG_EQ(payload->GetReferenceCount(), 2, "Argument not held by the event");
+    reused->Invoke();
+    reused->Unref();
+    NS_TEST_EXPECT_MSG_EQ(payload->GetReferenceCount(), 1, "Argument not released");
+
+    // The events too large for the pool are allocated on their own
+    std::array<uint32_t, 100> values{};
+    values.front() = 5;
+    values.back() = 6;
+    EventImpl* large = MakeEvent(&SimulatorEventPoolTestCase::Large, this, values);
+    large->Invoke();
+    large->Unref();
+
+    std::vector<uint32_t> expected{2, 3, 3, 4, 11};
+    NS_TEST_EXPECT_MSG_EQ((m_values == expected), true, "Wrong arguments of the events");
+
+    // The pooled events are scheduled and released by the simulator as usual
+    m_values.clear();
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        EventId id =
+            Simulator::Schedule(MicroSeconds(i), &SimulatorEventPoolTestCase::Record, this, i);
+        if (i % 3 == 0)
+        {
+            Simulator::Cancel(id);
+        }
+    }
+    Simulator::Schedule(MicroSeconds(200), &SimulatorEventPoolTestCase::Hold, this, payload, 7);
+    Simulator::Run();
+    Simulator::Destroy();
+    NS_TEST_ASSERT_MSG_EQ(m_values.size(), 67, "Wrong number of events run");
+    NS_TEST_EXPECT_MSG_EQ(m_values.back(), 7, "Wrong argument of the last event");
+    NS_TEST_EXPECT_MSG_EQ(payload->GetReferenceCount(), 1, "Argument not released");
+}
+
 /**
  * @ingroup simulator-tests
  *
@@ -726,6 +1023,18 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        // Spawn a rung for every bucket with more than one event
+        factory.Set("Threshold", UintegerValue(1));
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+
+        factory = ObjectFactory(HeapScheduler::GetTypeId().GetName());
+        AddTestCase(new SimulatorCancelTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(CalendarScheduler::GetTypeId());
+        AddTestCase(new SimulatorCancelTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorBatchTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorEventPoolTestCase(), TestCase::Duration::QUICK);
     }
 };
 
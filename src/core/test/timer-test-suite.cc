@@ -5,10 +5,16 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/boolean.h"
+#include "ns3/global-value.h"
 #include "ns3/nstime.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 #include "ns3/timer.h"
+#include "ns3/watchdog.h"
+
+#include <memory>
+#include <vector>
 
 /**
  * @file
@@ -205,6 +211,154 @@ TimerTemplateTestCase::DoTeardown()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup timer-tests
+ *
+ * @brief Check the timers expiring through the TimerWheel.
+ */
+class TimerWheelTestCase : public TestCase
+{
+  public:
+    TimerWheelTestCase();
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+  private:
+    /**
+     * Record the expiration of a timer.
+     * @param i The index of the timer.
+     */
+    void Expired(uint32_t i);
+    /** Record the expiration of the watchdog. */
+    void WatchdogExpired();
+    /** Reschedule one timer in three. */
+    void Reschedule();
+    /**
+     * Get a pseudo-random delay, from a few microseconds to hours.
+     * @returns The delay.
+     */
+    Time NextDelay();
+
+    std::vector<std::unique_ptr<Timer>> m_timers; //!< The timers.
+    std::vector<Time> m_expected;                 //!< The expected expiration times.
+    std::vector<uint32_t> m_contexts;             //!< The expected contexts.
+    std::vector<uint32_t> m_fired;                //!< The number of expirations.
+    uint64_t m_random;                            //!< The pseudo-random state.
+    Time m_watchdogExpired;                       //!< The watchdog expiration time.
+};
+
+TimerWheelTestCase::TimerWheelTestCase()
+    : TestCase("Check the timers expiring through the TimerWheel")
+{
+}
+
+void
+TimerWheelTestCase::DoSetup()
+{
+    GlobalValue::Bind("TimerWheelEnabled", BooleanValue(true));
+}
+
+void
+TimerWheelTestCase::DoTeardown()
+{
+    GlobalValue::Bind("TimerWheelEnabled", BooleanValue(false));
+}
+
+Time
+TimerWheelTestCase::NextDelay()
+{
+    m_random = m_random * 6364136223846793005ULL + 1442695040888963407ULL;
+    uint32_t bits = (m_random >> 59) + 1;
+    return MicroSeconds((m_random >> 20) & ((uint64_t(1) << bits) - 1));
+}
+
+void
+TimerWheelTestCase::Expired(uint32_t i)
+{
+    m_fired[i]++;
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), m_expected[i], "Timer " << i << " expired late");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetContext(), m_contexts[i], "Wrong context");
+}
+
+void
+TimerWheelTestCase::WatchdogExpired()
+{
+    m_watchdogExpired = Simulator::Now();
+}
+
+void
+TimerWheelTestCase::Reschedule()
+{
+    for (uint32_t i = 0; i < m_timers.size(); i += 3)
+    {
+        if (m_timers[i]->IsRunning())
+        {
+            m_timers[i]->Cancel();
+            Time delay = NextDelay();
+            m_timers[i]->Schedule(delay);
+            m_expected[i] = Simulator::Now() + delay;
+            m_contexts[i] = Simulator::GetContext();
+        }
+    }
+}
+
+void
+TimerWheelTestCase::DoRun()
+{
+    const uint32_t n = 1000;
+    m_random = 1;
+    m_fired.assign(n, 0);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        m_timers.push_back(std::make_unique<Timer>(Timer::CANCEL_ON_DESTROY));
+        m_timers[i]->SetFunction(&TimerWheelTestCase::Expired, this);
+        m_timers[i]->SetArguments(i);
+        Time delay = NextDelay();
+        m_timers[i]->Schedule(delay);
+        m_expected.push_back(delay);
+        m_contexts.push_back(Simulator::NO_CONTEXT);
+    }
+    NS_TEST_ASSERT_MSG_NE(TimerWheel::Get(), nullptr, "TimerWheel not enabled");
+    NS_TEST_EXPECT_MSG_EQ(m_timers[1]->GetDelayLeft(), m_expected[1], "Wrong delay left");
+
+    Simulator::ScheduleWithContext(7, MilliSeconds(10), &TimerWheelTestCase::Reschedule, this);
+
+    // Suspend a timer for 100 ms
+    Timer& suspended = *m_timers[2];
+    Simulator::Schedule(MilliSeconds(20), [&suspended]() {
+        if (suspended.IsRunning())
+        {
+            suspended.Suspend();
+        }
+    });
+    Simulator::Schedule(MilliSeconds(120), [this, &suspended]() {
+        if (suspended.IsSuspended())
+        {
+            m_expected[2] = Simulator::Now() + suspended.GetDelayLeft();
+            suspended.Resume();
+        }
+    });
+
+    // A Watchdog pinged before its expiration
+    Watchdog watchdog;
+    watchdog.SetFunction(&TimerWheelTestCase::WatchdogExpired, this);
+    watchdog.Ping(MilliSeconds(100));
+    Simulator::Schedule(MilliSeconds(50), &Watchdog::Ping, &watchdog, MilliSeconds(200));
+    Simulator::Schedule(MilliSeconds(60), &Watchdog::Ping, &watchdog, MicroSeconds(10));
+
+    Simulator::Run();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_fired[i], 1, "Timer " << i << " did not expire once");
+        NS_TEST_EXPECT_MSG_EQ(m_timers[i]->IsExpired(), true, "Timer " << i << " not expired");
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_watchdogExpired, MilliSeconds(250), "Wrong watchdog expiration");
+    NS_TEST_EXPECT_MSG_LT(TimerWheel::Get()->GetTickCount(), n, "Too many wheel ticks");
+    Simulator::Destroy();
+    m_timers.clear();
+}
+
 /**
  * @ingroup timer-tests
  *
@@ -218,6 +372,7 @@ class TimerTestSuite : public TestSuite
     {
         AddTestCase(new TimerStateTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new TimerTemplateTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new TimerWheelTestCase(), TestCase::Duration::QUICK);
     }
 };
 
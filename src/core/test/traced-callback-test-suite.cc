@@ -122,6 +122,98 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * @ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check the InlineCallback sinks which disconnect
+ * themselves, or another sink, when invoked.
+ */
+class SelfDisconnectTracedCallbackTestCase : public TestCase
+{
+  public:
+    SelfDisconnectTracedCallbackTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * InlineCallback sink which disconnects itself and the next one.
+     * @param a The parameter.
+     */
+    void InlineOne(int a);
+    /**
+     * InlineCallback sink.
+     * @param a The parameter.
+     */
+    void InlineTwo(int a);
+    /**
+     * Callback sink.
+     * @param a The parameter.
+     */
+    void CbOne(int a);
+
+    TracedCallback<int> m_trace; //!< The TracedCallback under test.
+    int m_inlineOne;             //!< Sum of the values received by InlineOne.
+    int m_inlineTwo;             //!< Sum of the values received by InlineTwo.
+    int m_one;                   //!< Sum of the values received by CbOne.
+};
+
+SelfDisconnectTracedCallbackTestCase::SelfDisconnectTracedCallbackTestCase()
+    : TestCase("Check the InlineCallback sinks which disconnect when invoked")
+{
+}
+
+void
+SelfDisconnectTracedCallbackTestCase::InlineOne(int a)
+{
+    m_inlineOne += a;
+    m_trace.DisconnectWithoutContext(
+        MakeInlineCallback(&SelfDisconnectTracedCallbackTestCase::InlineOne, this));
+    m_trace.DisconnectWithoutContext(
+        MakeInlineCallback(&SelfDisconnectTracedCallbackTestCase::InlineTwo, this));
+}
+
+void
+SelfDisconnectTracedCallbackTestCase::InlineTwo(int a)
+{
+    m_inlineTwo += a;
+}
+
+void
+SelfDisconnectTracedCallbackTestCase::CbOne(int a)
+{
+    m_one += a;
+}
+
+void
+SelfDisconnectTracedCallbackTestCase::DoRun()
+{
+    m_inlineOne = 0;
+    m_inlineTwo = 0;
+    m_one = 0;
+    m_trace.ConnectWithoutContext(
+        MakeInlineCallback(&SelfDisconnectTracedCallbackTestCase::InlineOne, this));
+    m_trace.ConnectWithoutContext(
+        MakeInlineCallback(&SelfDisconnectTracedCallbackTestCase::InlineTwo, this));
+    m_trace.ConnectWithoutContext(MakeCallback(&SelfDisconnectTracedCallbackTestCase::CbOne, this));
+
+    // The sinks connected when the trace is invoked are all invoked once
+    m_trace(1);
+    NS_TEST_EXPECT_MSG_EQ(m_inlineOne, 1, "InlineCallback disconnecting itself not invoked");
+    NS_TEST_EXPECT_MSG_EQ(m_inlineTwo, 1, "InlineCallback disconnected by another not invoked");
+    NS_TEST_EXPECT_MSG_EQ(m_one, 1, "Callback after the InlineCallbacks not invoked");
+
+    // Only the sink which was not disconnected is left
+    m_trace(10);
+    NS_TEST_EXPECT_MSG_EQ(m_inlineOne, 1, "InlineCallback not disconnected");
+    NS_TEST_EXPECT_MSG_EQ(m_inlineTwo, 1, "InlineCallback not disconnected");
+    NS_TEST_EXPECT_MSG_EQ(m_one, 11, "Callback not invoked");
+
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&SelfDisconnectTracedCallbackTestCase::CbOne, this));
+    NS_TEST_EXPECT_MSG_EQ(m_trace.IsEmpty(), true, "TracedCallback not empty");
+}
+
 /**
  * @ingroup tracedcallback-tests
  *
@@ -137,6 +229,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new SelfDisconnectTracedCallbackTestCase, TestCase::Duration::QUICK);
 }
 
 static TracedCallbackTestSuite
@@ -17,6 +17,7 @@
 #include "ns3/ethernet-trailer.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
+#include "ns3/packet-burst.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
@@ -1007,6 +1008,52 @@ CsmaNetDevice::SendFrom(Ptr<Packet> packet,
     return true;
 }
 
+uint32_t
+CsmaNetDevice::SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(burst << dest << protocolNumber);
+
+    NS_ASSERT(IsLinkUp());
+
+    if (!IsSendEnabled())
+    {
+        for (auto it = burst->Begin(); it != burst->End(); ++it)
+        {
+            m_macTxDropTrace(*it);
+        }
+        return 0;
+    }
+
+    Mac48Address destination = Mac48Address::ConvertFrom(dest);
+    std::vector<Ptr<Packet>> packets;
+    packets.reserve(burst->GetNPackets());
+    for (auto it = burst->Begin(); it != burst->End(); ++it)
+    {
+        AddHeader(*it, m_address, destination, protocolNumber);
+        m_macTxTrace(*it);
+        packets.push_back(*it);
+    }
+
+    //
+    // Place the whole burst on the send queue, then start a transmission if
+    // the device is idle, as SendFrom does for a single packet.
+    //
+    uint32_t nEnqueued = m_queue->EnqueueBatch(packets);
+    for (const auto& packet : packets)
+    {
+        m_macTxDropTrace(packet);
+    }
+
+    if (m_txMachineState == READY && !m_queue->IsEmpty())
+    {
+        m_currentPkt = m_queue->Dequeue();
+        m_promiscSnifferTrace(m_currentPkt);
+        m_snifferTrace(m_currentPkt);
+        TransmitStart();
+    }
+    return nEnqueued;
+}
+
 Ptr<Node>
 CsmaNetDevice::GetNode() const
 {
@@ -267,6 +267,17 @@ class CsmaNetDevice : public NetDevice
      */
     bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) override;
 
+    /**
+     * Start sending a burst of packets down the channel.
+     * @param burst packets to send, in order
+     * @param dest layer 2 destination address
+     * @param protocolNumber protocol number
+     * @return the number of packets enqueued
+     */
+    uint32_t SendBurst(Ptr<PacketBurst> burst,
+                       const Address& dest,
+                       uint16_t protocolNumber) override;
+
     /**
      * Start sending a packet down the channel, with MAC spoofing
      * @param packet packet to send
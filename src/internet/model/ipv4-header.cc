@@ -418,6 +418,45 @@ Ipv4Header::Serialize(Buffer::Iterator start) const
     }
 }
 
+bool
+Ipv4Header::SerializeContiguous(uint8_t* start, uint32_t size) const
+{
+    NS_LOG_FUNCTION(this << &start << size);
+    uint8_t* i = start;
+
+    uint8_t verIhl = (4 << 4) | (5);
+    i = WriteU8(i, verIhl);
+    i = WriteU8(i, m_tos);
+    i = WriteHtonU16(i, m_payloadSize + 5 * 4);
+    i = WriteHtonU16(i, m_identification);
+    uint32_t fragmentOffset = m_fragmentOffset / 8;
+    uint8_t flagsFrag = (fragmentOffset >> 8) & 0x1f;
+    if (m_flags & DONT_FRAGMENT)
+    {
+        flagsFrag |= (1 << 6);
+    }
+    if (m_flags & MORE_FRAGMENTS)
+    {
+        flagsFrag |= (1 << 5);
+    }
+    i = WriteU8(i, flagsFrag);
+    uint8_t frag = fragmentOffset & 0xff;
+    i = WriteU8(i, frag);
+    i = WriteU8(i, m_ttl);
+    i = WriteU8(i, m_protocol);
+    i = WriteHtonU16(i, 0);
+    i = WriteHtonU32(i, m_source.Get());
+    WriteHtonU32(i, m_destination.Get());
+
+    if (m_calcChecksum)
+    {
+        uint16_t checksum = CalculateIpChecksum(start, 20);
+        NS_LOG_LOGIC("checksum=" << checksum);
+        WriteHtolsbU16(start + 10, checksum);
+    }
+    return true;
+}
+
 uint32_t
 Ipv4Header::Deserialize(Buffer::Iterator start)
 {
@@ -472,4 +511,32 @@ Ipv4Header::Deserialize(Buffer::Iterator start)
     return GetSerializedSize();
 }
 
+Header*
+Ipv4Header::CopyHeader() const
+{
+    return new Ipv4Header(*this);
+}
+
+bool
+Ipv4Header::AssignHeader(const Header& header)
+{
+    if (m_calcChecksum)
+    {
+        return false;
+    }
+    const auto& ipv4 = static_cast<const Ipv4Header&>(header);
+    m_payloadSize = ipv4.m_payloadSize;
+    m_identification = ipv4.m_identification;
+    m_tos = ipv4.m_tos;
+    m_ttl = ipv4.m_ttl;
+    m_protocol = ipv4.m_protocol;
+    m_flags = ipv4.m_flags;
+    m_fragmentOffset = ipv4.m_fragmentOffset;
+    m_source = ipv4.m_source;
+    m_destination = ipv4.m_destination;
+    m_checksum = ipv4.m_checksum;
+    m_headerSize = ipv4.m_headerSize;
+    return true;
+}
+
 } // namespace ns3
@@ -192,6 +192,20 @@ Ipv6Header::Deserialize(Buffer::Iterator start)
     return GetSerializedSize();
 }
 
+Header*
+Ipv6Header::CopyHeader() const
+{
+    return new Ipv6Header(*this);
+}
+
+bool
+Ipv6Header::AssignHeader(const Header& header)
+{
+    // all the fields are read by Deserialize
+    *this = static_cast<const Ipv6Header&>(header);
+    return true;
+}
+
 void
 Ipv6Header::SetDscp(DscpType dscp)
 {
@@ -258,6 +258,8 @@ class Ipv6Header : public Header
      * @return size of the packet
      */
     uint32_t Deserialize(Buffer::Iterator start) override;
+    Header* CopyHeader() const override;
+    bool AssignHeader(const Header& header) override;
 
   private:
     /**
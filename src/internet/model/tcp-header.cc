@@ -315,6 +315,27 @@ TcpHeader::Serialize(Buffer::Iterator start) const
     }
 }
 
+bool
+TcpHeader::SerializeContiguous(uint8_t* start, uint32_t size) const
+{
+    if (m_calcChecksum || !m_options.empty())
+    {
+        // the checksum covers the payload, which may not be contiguous,
+        // and the options are serialized through an iterator
+        return false;
+    }
+    uint8_t* i = start;
+    i = WriteHtonU16(i, m_sourcePort);
+    i = WriteHtonU16(i, m_destinationPort);
+    i = WriteHtonU32(i, m_sequenceNumber.GetValue());
+    i = WriteHtonU32(i, m_ackNumber.GetValue());
+    i = WriteHtonU16(i, GetLength() << 12 | m_flags); // reserved bits are all zero
+    i = WriteHtonU16(i, m_windowSize);
+    i = WriteHtonU16(i, 0);
+    WriteHtonU16(i, m_urgentPointer);
+    return true;
+}
+
 uint32_t
 TcpHeader::Deserialize(Buffer::Iterator start)
 {
@@ -400,6 +421,33 @@ TcpHeader::Deserialize(Buffer::Iterator start)
     return GetSerializedSize();
 }
 
+Header*
+TcpHeader::CopyHeader() const
+{
+    return new TcpHeader(*this);
+}
+
+bool
+TcpHeader::AssignHeader(const Header& header)
+{
+    if (m_calcChecksum)
+    {
+        return false;
+    }
+    const auto& tcp = static_cast<const TcpHeader&>(header);
+    m_sourcePort = tcp.m_sourcePort;
+    m_destinationPort = tcp.m_destinationPort;
+    m_sequenceNumber = tcp.m_sequenceNumber;
+    m_ackNumber = tcp.m_ackNumber;
+    m_length = tcp.m_length;
+    m_flags = tcp.m_flags;
+    m_windowSize = tcp.m_windowSize;
+    m_urgentPointer = tcp.m_urgentPointer;
+    m_options = tcp.m_options;
+    m_optionsLen = tcp.m_optionsLen;
+    return true;
+}
+
 uint8_t
 TcpHeader::CalculateHeaderLength() const
 {
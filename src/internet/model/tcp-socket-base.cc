@@ -44,6 +44,7 @@
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/object.h"
+#include "ns3/packet-accounting.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
 #include "ns3/simulation-singleton.h"
@@ -3215,6 +3216,7 @@ uint32_t
 TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withAck)
 {
     NS_LOG_FUNCTION(this << seq << maxSize << withAck);
+    PacketAccounting::Scope scope(GetInstanceTypeId());
 
     bool isStartOfTransmission = BytesInFlight() == 0U;
     TcpTxItem* outItem = m_txBuffer->CopyFromSequence(maxSize, seq);
@@ -20,6 +20,7 @@
 #include "ns3/timer.h"
 #include "ns3/traced-value.h"
 
+#include <deque>
 #include <shared_mutex>
 #include <stdint.h>
 
@@ -193,6 +193,23 @@ UdpHeader::Serialize(Buffer::Iterator start) const
     }
 }
 
+bool
+UdpHeader::SerializeContiguous(uint8_t* start, uint32_t size) const
+{
+    if (m_checksum == 0 && m_calcChecksum)
+    {
+        // the checksum covers the payload, which may not be contiguous
+        return false;
+    }
+    uint8_t* i = start;
+
+    i = WriteHtonU16(i, m_sourcePort);
+    i = WriteHtonU16(i, m_destinationPort);
+    i = WriteHtonU16(i, m_forcedPayloadSize == 0 ? size : m_forcedPayloadSize);
+    WriteHtolsbU16(i, m_checksum);
+    return true;
+}
+
 uint32_t
 UdpHeader::Deserialize(Buffer::Iterator start)
 {
@@ -231,6 +248,27 @@ UdpHeader::Deserialize(Buffer::Iterator start)
     return GetSerializedSize();
 }
 
+Header*
+UdpHeader::CopyHeader() const
+{
+    return new UdpHeader(*this);
+}
+
+bool
+UdpHeader::AssignHeader(const Header& header)
+{
+    if (m_calcChecksum)
+    {
+        return false;
+    }
+    const auto& udp = static_cast<const UdpHeader&>(header);
+    m_sourcePort = udp.m_sourcePort;
+    m_destinationPort = udp.m_destinationPort;
+    m_payloadSize = udp.m_payloadSize;
+    m_checksum = udp.m_checksum;
+    return true;
+}
+
 uint16_t
 UdpHeader::GetChecksum() const
 {
@@ -98,7 +98,10 @@ class UdpHeader : public Header
     void Print(std::ostream& os) const override;
     uint32_t GetSerializedSize() const override;
     void Serialize(Buffer::Iterator start) const override;
+    bool SerializeContiguous(uint8_t* start, uint32_t size) const override;
     uint32_t Deserialize(Buffer::Iterator start) override;
+    Header* CopyHeader() const override;
+    bool AssignHeader(const Header& header) override;
 
     /**
      * @brief Is the UDP checksum correct ?
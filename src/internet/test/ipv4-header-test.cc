@@ -33,6 +33,7 @@
 #include <sys/socket.h>
 #endif
 
+#include <cstring>
 #include <limits>
 #include <sstream>
 #include <string>
@@ -279,6 +280,65 @@ Ipv4HeaderTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 Header contiguous serialization Test
+ */
+class Ipv4HeaderContiguousTest : public TestCase
+{
+  public:
+    Ipv4HeaderContiguousTest();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4HeaderContiguousTest::Ipv4HeaderContiguousTest()
+    : TestCase("IPv4 Header contiguous serialization")
+{
+}
+
+void
+Ipv4HeaderContiguousTest::DoRun()
+{
+    Ipv4Header header;
+    header.SetSource(Ipv4Address("10.0.0.1"));
+    header.SetDestination(Ipv4Address("10.0.0.2"));
+    header.SetProtocol(17);
+    header.SetPayloadSize(100);
+    header.SetIdentification(4242);
+    header.SetTtl(12);
+    header.SetDscp(Ipv4Header::DSCP_EF);
+    header.SetFragmentOffset(1480);
+    header.SetMoreFragments();
+
+    for (bool checksum : {false, true})
+    {
+        if (checksum)
+        {
+            header.EnableChecksum();
+        }
+        Buffer buffer;
+        buffer.AddAtStart(header.GetSerializedSize());
+        header.Serialize(buffer.Begin());
+
+        Ptr<Packet> packet = Create<Packet>(100);
+        packet->AddHeader(header);
+        uint8_t contiguous[20];
+        packet->CopyData(contiguous, 20);
+
+        NS_TEST_EXPECT_MSG_EQ((std::memcmp(buffer.PeekData(), contiguous, 20) == 0),
+                              true,
+                              "Contiguous serialization differs, checksum " << checksum);
+
+        Ipv4Header copy;
+        packet->RemoveHeader(copy);
+        NS_TEST_EXPECT_MSG_EQ(copy.IsChecksumOk(), true, "Checksum not valid");
+        NS_TEST_EXPECT_MSG_EQ(copy.GetIdentification(), 4242, "Identification not valid");
+    }
+}
+
 /**
  * @ingroup internet-test
  *
@@ -291,6 +351,7 @@ class Ipv4HeaderTestSuite : public TestSuite
         : TestSuite("ipv4-header", Type::UNIT)
     {
         AddTestCase(new Ipv4HeaderTest, TestCase::Duration::QUICK);
+        AddTestCase(new Ipv4HeaderContiguousTest, TestCase::Duration::QUICK);
     }
 };
 
@@ -8,11 +8,13 @@
 #define __STDC_LIMIT_MACROS
 #include "ns3/buffer.h"
 #include "ns3/core-module.h"
+#include "ns3/packet.h"
 #include "ns3/tcp-header.h"
 #include "ns3/tcp-option-rfc793.h"
 #include "ns3/test.h"
 
 #include <stdint.h>
+#include <vector>
 
 using namespace ns3;
 
@@ -440,6 +442,178 @@ TcpHeaderFlagsToString::DoRun()
     NS_TEST_ASSERT_MSG_EQ(str, target, "str " << str << " does not equal target " << target);
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief TCP header contiguous serialization test.
+ *
+ * Check that SerializeContiguous writes the bytes written by Serialize,
+ * and declines when the header has options or a checksum.
+ */
+class TcpHeaderContiguousTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param name Test description.
+     */
+    TcpHeaderContiguousTestCase(std::string name);
+
+  private:
+    void DoRun() override;
+};
+
+TcpHeaderContiguousTestCase::TcpHeaderContiguousTestCase(std::string name)
+    : TestCase(name)
+{
+}
+
+void
+TcpHeaderContiguousTestCase::DoRun()
+{
+    const uint32_t payloadSize = 100;
+    TcpHeader header;
+    header.SetSourcePort(0x1234);
+    header.SetDestinationPort(0xfedc);
+    header.SetSequenceNumber(SequenceNumber32(0x01234567));
+    header.SetAckNumber(SequenceNumber32(0x89abcdef));
+    header.SetWindowSize(0xa5c3);
+    header.SetUrgentPointer(0x5a3c);
+
+    for (uint8_t flags : {0x00, 0x02, 0x12, 0x10, 0x19, 0xff})
+    {
+        header.SetFlags(flags);
+        uint32_t size = header.GetSerializedSize();
+        Buffer buffer;
+        buffer.AddAtStart(size + payloadSize);
+        header.Serialize(buffer.Begin());
+        std::vector<uint8_t> serialized(size);
+        buffer.CopyData(serialized.data(), size);
+
+        std::vector<uint8_t> contiguous(size);
+        NS_TEST_ASSERT_MSG_EQ(header.SerializeContiguous(contiguous.data(), size + payloadSize),
+                              true,
+                              "Header without options nor checksum not serialized");
+        NS_TEST_EXPECT_MSG_EQ((contiguous == serialized),
+                              true,
+                              "Contiguous serialization differs, flags "
+                                  << TcpHeader::FlagsToString(flags));
+    }
+
+    std::vector<uint8_t> contiguous(60);
+    TcpHeader withOption = header;
+    withOption.AppendOption(CreateObject<TcpOptionNOP>());
+    NS_TEST_EXPECT_MSG_EQ(withOption.SerializeContiguous(contiguous.data(), 60),
+                          false,
+                          "Header with options serialized");
+    TcpHeader withChecksum = header;
+    withChecksum.EnableChecksums();
+    NS_TEST_EXPECT_MSG_EQ(withChecksum.SerializeContiguous(contiguous.data(), 60),
+                          false,
+                          "Header with checksum serialized");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief TCP header over a scatter-gather buffer test.
+ *
+ * Check that a TCP header with checksums, with and without options,
+ * added to a packet whose buffer chains the bytes of another packet has
+ * the bytes of the same header added to a flat packet, and that its
+ * checksum covers the whole packet.
+ */
+class TcpHeaderScatterGatherTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param name Test description.
+     */
+    TcpHeaderScatterGatherTestCase(std::string name);
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+    /**
+     * Build a packet of two payloads and a TCP header with checksums.
+     * @param scatterGather whether the buffer of the packet chains the second payload
+     * @param option whether the header has an option
+     * @return the bytes of the packet
+     */
+    std::vector<uint8_t> Build(bool scatterGather, bool option);
+};
+
+TcpHeaderScatterGatherTestCase::TcpHeaderScatterGatherTestCase(std::string name)
+    : TestCase(name)
+{
+}
+
+std::vector<uint8_t>
+TcpHeaderScatterGatherTestCase::Build(bool scatterGather, bool option)
+{
+    if (scatterGather)
+    {
+        Buffer::EnableScatterGather();
+    }
+    else
+    {
+        Buffer::DisableScatterGather();
+    }
+    std::vector<uint8_t> payload(1000);
+    for (uint32_t k = 0; k < payload.size(); k++)
+    {
+        payload[k] = static_cast<uint8_t>(k * 7);
+    }
+    Ptr<Packet> p = Create<Packet>(payload.data(), payload.size());
+    payload.assign(payload.size(), 0x5a);
+    p->AddAtEnd(Create<Packet>(payload.data(), payload.size()));
+    TcpHeader header;
+    header.SetSourcePort(0x1234);
+    header.SetDestinationPort(0xfedc);
+    header.SetSequenceNumber(SequenceNumber32(0x01234567));
+    header.SetAckNumber(SequenceNumber32(0x89abcdef));
+    header.SetFlags(TcpHeader::ACK);
+    if (option)
+    {
+        header.AppendOption(CreateObject<TcpOptionNOP>());
+    }
+    header.EnableChecksums();
+    header.InitializeChecksum(Ipv4Address("10.0.0.1"), Ipv4Address("10.0.0.2"), 6);
+    p->AddHeader(header);
+    Buffer::DisableScatterGather();
+
+    std::vector<uint8_t> bytes(p->GetSize());
+    p->CopyData(bytes.data(), bytes.size());
+    return bytes;
+}
+
+void
+TcpHeaderScatterGatherTestCase::DoRun()
+{
+    for (bool option : {false, true})
+    {
+        std::vector<uint8_t> flat = Build(false, option);
+        std::vector<uint8_t> chained = Build(true, option);
+        NS_TEST_EXPECT_MSG_EQ((chained == flat),
+                              true,
+                              "Bytes differ from the flat packet, option " << option);
+
+        Ptr<Packet> p = Create<Packet>(chained.data(), chained.size());
+        TcpHeader header;
+        header.EnableChecksums();
+        header.InitializeChecksum(Ipv4Address("10.0.0.1"), Ipv4Address("10.0.0.2"), 6);
+        p->RemoveHeader(header);
+        NS_TEST_EXPECT_MSG_EQ(header.IsChecksumOk(), true, "Wrong TCP checksum, option " << option);
+    }
+}
+
+void
+TcpHeaderScatterGatherTestCase::DoTeardown()
+{
+    Buffer::DisableScatterGather();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -456,6 +630,10 @@ class TcpHeaderTestSuite : public TestSuite
                     TestCase::Duration::QUICK);
         AddTestCase(new TcpHeaderFlagsToString("Test flags to string function"),
                     TestCase::Duration::QUICK);
+        AddTestCase(new TcpHeaderContiguousTestCase("Test contiguous serialization"),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new TcpHeaderScatterGatherTestCase("Test scatter-gather serialization"),
+                    TestCase::Duration::QUICK);
     }
 };
 
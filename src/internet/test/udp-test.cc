@@ -12,6 +12,7 @@
 
 #include "ns3/arp-l3-protocol.h"
 #include "ns3/boolean.h"
+#include "ns3/buffer.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/inet-socket-address.h"
@@ -36,11 +37,13 @@
 #include "ns3/tcp-l4-protocol.h"
 #include "ns3/test.h"
 #include "ns3/traffic-control-helper.h"
+#include "ns3/udp-header.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/udp-socket-factory.h"
 
 #include <limits>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -749,6 +752,223 @@ Udp6SocketImplTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief UDP header cache Test
+ *
+ * Check that the headers peeked from the cache of a packet keep their
+ * checksum configuration, and verify the checksum when it is enabled.
+ */
+class UdpHeaderCacheTest : public TestCase
+{
+  public:
+    UdpHeaderCacheTest();
+    void DoRun() override;
+};
+
+UdpHeaderCacheTest::UdpHeaderCacheTest()
+    : TestCase("UDP header cache")
+{
+}
+
+void
+UdpHeaderCacheTest::DoRun()
+{
+    Packet::EnableHeaderCache();
+    Ipv4Address source("10.0.0.1");
+    Ipv4Address destination("10.0.0.2");
+    UdpHeader header;
+    header.SetSourcePort(1234);
+    header.SetDestinationPort(5678);
+    header.EnableChecksums();
+    header.InitializeChecksum(source, destination, UdpL4Protocol::PROT_NUMBER);
+    Ptr<Packet> p = Create<Packet>(100);
+    p->AddHeader(header);
+
+    UdpHeader peeked;
+    p->PeekHeader(peeked);
+    NS_TEST_EXPECT_MSG_EQ(peeked.GetDestinationPort(), 5678, "Wrong header peeked");
+
+    UdpHeader verified;
+    verified.EnableChecksums();
+    verified.InitializeChecksum(source, destination, UdpL4Protocol::PROT_NUMBER);
+    p->PeekHeader(verified);
+    NS_TEST_EXPECT_MSG_EQ(verified.IsChecksumOk(), true, "Good checksum not verified");
+
+    // the checksum depends on the addresses of the header peeking it
+    UdpHeader wrong;
+    wrong.EnableChecksums();
+    wrong.InitializeChecksum(source, Ipv4Address("10.0.0.3"), UdpL4Protocol::PROT_NUMBER);
+    p->PeekHeader(wrong);
+    NS_TEST_EXPECT_MSG_EQ(wrong.IsChecksumOk(), false, "Bad checksum not detected");
+    NS_TEST_EXPECT_MSG_EQ(wrong.GetDestinationPort(), 5678, "Wrong header peeked");
+
+    // a header which does not verify the checksum keeps its configuration
+    p = Create<Packet>(100);
+    p->AddHeader(header);
+    p->PeekHeader(wrong);
+    NS_TEST_EXPECT_MSG_EQ(wrong.IsChecksumOk(), false, "Bad checksum not detected");
+    UdpHeader unchecked;
+    p->PeekHeader(unchecked);
+    NS_TEST_EXPECT_MSG_EQ(unchecked.IsChecksumOk(), true, "Checksum result copied");
+    NS_TEST_EXPECT_MSG_EQ(unchecked.GetSourcePort(), 1234, "Wrong header peeked");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief UDP header contiguous serialization Test
+ *
+ * Check that SerializeContiguous writes the bytes written by Serialize,
+ * and declines when the checksum must be computed over the payload.
+ */
+class UdpHeaderContiguousTest : public TestCase
+{
+  public:
+    UdpHeaderContiguousTest();
+    void DoRun() override;
+};
+
+UdpHeaderContiguousTest::UdpHeaderContiguousTest()
+    : TestCase("UDP header contiguous serialization")
+{
+}
+
+void
+UdpHeaderContiguousTest::DoRun()
+{
+    const uint32_t size = 8;
+    const uint32_t payloadSize = 100;
+    for (uint32_t forced = 0; forced < 4; forced++)
+    {
+        UdpHeader header;
+        header.SetSourcePort(0x1234);
+        header.SetDestinationPort(0xfedc);
+        if (forced & 1)
+        {
+            header.ForcePayloadSize(0x0abc);
+        }
+        if (forced & 2)
+        {
+            header.EnableChecksums();
+            header.ForceChecksum(0x5a3c);
+        }
+        Buffer buffer;
+        buffer.AddAtStart(size + payloadSize);
+        header.Serialize(buffer.Begin());
+        std::vector<uint8_t> serialized(size);
+        buffer.CopyData(serialized.data(), size);
+
+        std::vector<uint8_t> contiguous(size);
+        NS_TEST_ASSERT_MSG_EQ(header.SerializeContiguous(contiguous.data(), size + payloadSize),
+                              true,
+                              "Header without computed checksum not serialized");
+        NS_TEST_EXPECT_MSG_EQ((contiguous == serialized),
+                              true,
+                              "Contiguous serialization differs, case " << forced);
+    }
+
+    UdpHeader header;
+    header.EnableChecksums();
+    header.InitializeChecksum(Ipv4Address("10.0.0.1"),
+                              Ipv4Address("10.0.0.2"),
+                              UdpL4Protocol::PROT_NUMBER);
+    std::vector<uint8_t> contiguous(size);
+    NS_TEST_EXPECT_MSG_EQ(header.SerializeContiguous(contiguous.data(), size + payloadSize),
+                          false,
+                          "Header with computed checksum serialized");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief UDP header over a scatter-gather buffer Test
+ *
+ * Check that a UDP header with checksums added to a packet whose buffer
+ * chains the bytes of another packet has the bytes of the same header
+ * added to a flat packet, and that its checksum covers the whole packet.
+ */
+class UdpHeaderScatterGatherTest : public TestCase
+{
+  public:
+    UdpHeaderScatterGatherTest();
+    void DoRun() override;
+    void DoTeardown() override;
+
+  private:
+    /**
+     * Build a packet of two payloads and a UDP header with checksums.
+     * @param scatterGather whether the buffer of the packet chains the second payload
+     * @return the bytes of the packet
+     */
+    std::vector<uint8_t> Build(bool scatterGather);
+};
+
+UdpHeaderScatterGatherTest::UdpHeaderScatterGatherTest()
+    : TestCase("UDP header over a scatter-gather buffer")
+{
+}
+
+std::vector<uint8_t>
+UdpHeaderScatterGatherTest::Build(bool scatterGather)
+{
+    if (scatterGather)
+    {
+        Buffer::EnableScatterGather();
+    }
+    else
+    {
+        Buffer::DisableScatterGather();
+    }
+    std::vector<uint8_t> payload(1000);
+    for (uint32_t k = 0; k < payload.size(); k++)
+    {
+        payload[k] = static_cast<uint8_t>(k * 7);
+    }
+    Ptr<Packet> p = Create<Packet>(payload.data(), payload.size());
+    payload.assign(payload.size(), 0x5a);
+    p->AddAtEnd(Create<Packet>(payload.data(), payload.size()));
+    UdpHeader header;
+    header.SetSourcePort(1234);
+    header.SetDestinationPort(4321);
+    header.EnableChecksums();
+    header.InitializeChecksum(Ipv4Address("10.0.0.1"),
+                              Ipv4Address("10.0.0.2"),
+                              UdpL4Protocol::PROT_NUMBER);
+    p->AddHeader(header);
+    Buffer::DisableScatterGather();
+
+    std::vector<uint8_t> bytes(p->GetSize());
+    p->CopyData(bytes.data(), bytes.size());
+    return bytes;
+}
+
+void
+UdpHeaderScatterGatherTest::DoRun()
+{
+    std::vector<uint8_t> flat = Build(false);
+    std::vector<uint8_t> chained = Build(true);
+    NS_TEST_ASSERT_MSG_EQ(chained.size(), 2008, "Wrong packet size");
+    NS_TEST_EXPECT_MSG_EQ((chained[4] << 8) + chained[5], 2008, "Wrong UDP length");
+    NS_TEST_EXPECT_MSG_EQ((chained == flat), true, "Bytes differ from the flat packet");
+
+    Ptr<Packet> p = Create<Packet>(chained.data(), chained.size());
+    UdpHeader header;
+    header.EnableChecksums();
+    header.InitializeChecksum(Ipv4Address("10.0.0.1"),
+                              Ipv4Address("10.0.0.2"),
+                              UdpL4Protocol::PROT_NUMBER);
+    p->RemoveHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(header.IsChecksumOk(), true, "Wrong UDP checksum");
+}
+
+void
+UdpHeaderScatterGatherTest::DoTeardown()
+{
+    Buffer::DisableScatterGather();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -764,6 +984,9 @@ class UdpTestSuite : public TestSuite
         AddTestCase(new UdpSocketLoopbackTest, TestCase::Duration::QUICK);
         AddTestCase(new Udp6SocketImplTest, TestCase::Duration::QUICK);
         AddTestCase(new Udp6SocketLoopbackTest, TestCase::Duration::QUICK);
+        AddTestCase(new UdpHeaderCacheTest, TestCase::Duration::QUICK);
+        AddTestCase(new UdpHeaderContiguousTest, TestCase::Duration::QUICK);
+        AddTestCase(new UdpHeaderScatterGatherTest, TestCase::Duration::QUICK);
     }
 };
 
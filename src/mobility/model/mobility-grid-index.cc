@@ -0,0 +1,288 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "mobility-grid-index.h"
+
+#include "constant-acceleration-mobility-model.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/callback.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MobilityGridIndex");
+
+std::size_t
+MobilityGridIndex::CellHash::operator()(const Cell& cell) const
+{
+    return std::hash<int64_t>{}(cell.first) ^ (std::hash<int64_t>{}(cell.second) << 1);
+}
+
+MobilityGridIndex::MobilityGridIndex(double cellSize)
+    : m_cellSize(cellSize),
+      m_maxSpeed(0)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    NS_ABORT_MSG_IF(cellSize <= 0, "The size of the cells must be positive");
+}
+
+MobilityGridIndex::~MobilityGridIndex()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+}
+
+void
+MobilityGridIndex::SetCellSize(double cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    NS_ABORT_MSG_IF(cellSize <= 0, "The size of the cells must be positive");
+    m_cellSize = cellSize;
+    m_grid.clear();
+    m_moving.clear();
+    m_outOfGrid.clear();
+    for (auto& [mobility, entry] : m_entries)
+    {
+        Insert(entry);
+    }
+}
+
+double
+MobilityGridIndex::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+void
+MobilityGridIndex::Add(uint64_t id, Ptr<MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << id << mobility);
+    if (!mobility)
+    {
+        m_unlocated.push_back(id);
+        return;
+    }
+    auto [it, inserted] = m_entries.try_emplace(PeekPointer(mobility));
+    auto& entry = it->second;
+    if (inserted)
+    {
+        entry.mobility = mobility;
+        entry.accelerating = DynamicCast<ConstantAccelerationMobilityModel>(mobility) != nullptr;
+        mobility->TraceConnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MobilityGridIndex::CourseChanged, this));
+    }
+    else
+    {
+        Erase(entry);
+    }
+    entry.ids.push_back(id);
+    Insert(entry);
+}
+
+void
+MobilityGridIndex::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& [mobility, entry] : m_entries)
+    {
+        entry.mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MobilityGridIndex::CourseChanged, this));
+    }
+    m_entries.clear();
+    m_grid.clear();
+    m_moving.clear();
+    m_outOfGrid.clear();
+    m_unlocated.clear();
+}
+
+std::size_t
+MobilityGridIndex::GetN() const
+{
+    std::size_t n = m_unlocated.size();
+    for (const auto& [mobility, entry] : m_entries)
+    {
+        n += entry.ids.size();
+    }
+    return n;
+}
+
+MobilityGridIndex::Cell
+MobilityGridIndex::GetCell(const Vector& position) const
+{
+    return {static_cast<int64_t>(std::floor(position.x / m_cellSize)),
+            static_cast<int64_t>(std::floor(position.y / m_cellSize))};
+}
+
+void
+MobilityGridIndex::Insert(Entry& entry)
+{
+    const auto mobility = PeekPointer(entry.mobility);
+    if (entry.accelerating)
+    {
+        m_outOfGrid.insert(mobility);
+        return;
+    }
+    entry.velocity = entry.mobility->GetVelocity();
+    entry.cell = GetCell(entry.mobility->GetPosition());
+    m_grid[entry.cell].push_back(mobility);
+    const auto speed = entry.velocity.GetLength();
+    if (speed > 0)
+    {
+        if (m_moving.empty())
+        {
+            m_maxSpeed = 0;
+            m_binTime = Simulator::Now();
+        }
+        m_moving.insert(mobility);
+        m_maxSpeed = std::max(m_maxSpeed, speed);
+    }
+}
+
+void
+MobilityGridIndex::Erase(const Entry& entry)
+{
+    const auto mobility = PeekPointer(entry.mobility);
+    if (entry.accelerating)
+    {
+        m_outOfGrid.erase(mobility);
+        return;
+    }
+    auto cellIt = m_grid.find(entry.cell);
+    NS_ASSERT(cellIt != m_grid.end());
+    std::erase(cellIt->second, mobility);
+    if (cellIt->second.empty())
+    {
+        m_grid.erase(cellIt);
+    }
+    m_moving.erase(mobility);
+}
+
+void
+MobilityGridIndex::Rebin()
+{
+    NS_LOG_FUNCTION(this);
+    const std::vector<const MobilityModel*> moving(m_moving.cbegin(), m_moving.cend());
+    for (const auto mobility : moving)
+    {
+        Erase(m_entries.at(mobility));
+    }
+    NS_ASSERT(m_moving.empty());
+    for (const auto mobility : moving)
+    {
+        auto& entry = m_entries.at(mobility);
+        if (mobility->GetVelocity() != entry.velocity)
+        {
+            NS_LOG_DEBUG("The velocity of " << mobility << " changed without a course change");
+            entry.accelerating = true;
+        }
+        Insert(entry);
+    }
+}
+
+double
+MobilityGridIndex::GetMaxDrift() const
+{
+    if (m_moving.empty())
+    {
+        return 0;
+    }
+    return m_maxSpeed * (Simulator::Now() - m_binTime).GetSeconds();
+}
+
+void
+MobilityGridIndex::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_entries.find(PeekPointer(mobility));
+    NS_ASSERT(it != m_entries.end());
+    auto& entry = it->second;
+    if (!entry.accelerating)
+    {
+        const auto velocity = mobility->GetVelocity();
+        if (velocity == Vector(0, 0, 0) && entry.velocity == velocity &&
+            GetCell(mobility->GetPosition()) == entry.cell)
+        {
+            // still in the same cell
+            return;
+        }
+    }
+    Erase(entry);
+    Insert(entry);
+}
+
+std::vector<uint64_t>
+MobilityGridIndex::GetItemsInRange(const Vector& position, double range)
+{
+    NS_LOG_FUNCTION(this << position << range);
+    if (GetMaxDrift() > m_cellSize / 2)
+    {
+        Rebin();
+    }
+    // the moving mobility models may have left their cell by this distance
+    const auto margin = GetMaxDrift();
+
+    std::vector<uint64_t> items(m_unlocated);
+    auto addIfInRange = [&](const MobilityModel* mobility) {
+        if (CalculateDistance(mobility->GetPosition(), position) <= range)
+        {
+            const auto& ids = m_entries.at(mobility).ids;
+            items.insert(items.end(), ids.cbegin(), ids.cend());
+        }
+    };
+
+    for (const auto mobility : m_outOfGrid)
+    {
+        addIfInRange(mobility);
+    }
+
+    const auto extent = range + margin;
+    const auto nCells = (std::floor((position.x + extent) / m_cellSize) -
+                         std::floor((position.x - extent) / m_cellSize) + 1) *
+                        (std::floor((position.y + extent) / m_cellSize) -
+                         std::floor((position.y - extent) / m_cellSize) + 1);
+    if (nCells >= static_cast<double>(m_grid.size()))
+    {
+        // the range overlaps more cells than there are occupied cells
+        for (const auto& [cell, mobilities] : m_grid)
+        {
+            for (const auto mobility : mobilities)
+            {
+                addIfInRange(mobility);
+            }
+        }
+    }
+    else
+    {
+        const auto [xMin, yMin] = GetCell(Vector(position.x - extent, position.y - extent, 0));
+        const auto [xMax, yMax] = GetCell(Vector(position.x + extent, position.y + extent, 0));
+        for (auto x = xMin; x <= xMax; ++x)
+        {
+            for (auto y = yMin; y <= yMax; ++y)
+            {
+                if (auto cellIt = m_grid.find({x, y}); cellIt != m_grid.end())
+                {
+                    for (const auto mobility : cellIt->second)
+                    {
+                        addIfInRange(mobility);
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(items.begin(), items.end());
+    return items;
+}
+
+} // namespace ns3
@@ -0,0 +1,183 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MOBILITY_GRID_INDEX_H
+#define MOBILITY_GRID_INDEX_H
+
+#include "mobility-model.h"
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup mobility
+ *
+ * @brief Spatial index of the items located by a MobilityModel, which
+ * returns the items within a given range of a position without looking
+ * at all the items.
+ *
+ * The items are identified by an ID chosen by the user of the index
+ * (e.g., the position of a receiver in the list of a channel) and are
+ * bucketed in the square cells of a grid over the x and y coordinates,
+ * according to the position of their mobility model. The index follows
+ * the `CourseChange` notifications of the mobility models to move the
+ * items between cells.
+ *
+ * A mobility model may move without notifying a course change, as long as
+ * it keeps the velocity of its last course change (e.g.,
+ * ConstantVelocityMobilityModel). The moving mobility models are bucketed
+ * by their position when they were last put in a cell, and the queries also
+ * look at the cells within the distance that the fastest of them may have
+ * covered since. Once this distance would exceed half a cell, the moving
+ * mobility models are bucketed again by their current position, so that
+ * the queries look at a bounded number of cells.
+ *
+ * The mobility models whose velocity changes without a course change
+ * (ConstantAccelerationMobilityModel, or any model whose velocity is found
+ * to differ from the one of its last course change when it is bucketed
+ * again), as well as the items without a mobility model, are kept out of
+ * the grid and are checked at each query.
+ */
+class MobilityGridIndex
+{
+  public:
+    /**
+     * Create an index whose cells have the given size.
+     *
+     * @param cellSize the length of the side of the cells, in meters
+     */
+    MobilityGridIndex(double cellSize = 1000);
+    ~MobilityGridIndex();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    MobilityGridIndex(const MobilityGridIndex&) = delete;
+    MobilityGridIndex& operator=(const MobilityGridIndex&) = delete;
+
+    /**
+     * Set the size of the cells, which should be close to the range of the
+     * queries: the queries look at the items of the cells overlapping the
+     * square that encloses the range. The items are bucketed again.
+     *
+     * @param cellSize the length of the side of the cells, in meters
+     */
+    void SetCellSize(double cellSize);
+    /**
+     * @return the length of the side of the cells, in meters
+     */
+    double GetCellSize() const;
+
+    /**
+     * Add an item to the index.
+     *
+     * @param id the ID of the item, which must not be in the index
+     * @param mobility the mobility model locating the item, if any
+     */
+    void Add(uint64_t id, Ptr<MobilityModel> mobility);
+    /**
+     * Remove all the items from the index.
+     */
+    void Clear();
+    /**
+     * @return the number of items in the index
+     */
+    std::size_t GetN() const;
+
+    /**
+     * Get the IDs of the items whose distance from the given position is not
+     * larger than the given range, and of the items without a mobility model.
+     * The moving mobility models are bucketed again first, if needed.
+     *
+     * @param position the position
+     * @param range the range, in meters
+     * @return the IDs of the items, sorted in increasing order
+     */
+    std::vector<uint64_t> GetItemsInRange(const Vector& position, double range);
+
+  private:
+    /// The coordinates of a cell of the grid
+    using Cell = std::pair<int64_t, int64_t>;
+
+    /// Hash function of the coordinates of a cell
+    struct CellHash
+    {
+        /**
+         * @param cell the coordinates of the cell
+         * @return the hash of the coordinates
+         */
+        std::size_t operator()(const Cell& cell) const;
+    };
+
+    /// The items located by a mobility model
+    struct Entry
+    {
+        Ptr<MobilityModel> mobility; //!< the mobility model
+        std::vector<uint64_t> ids;   //!< the IDs of the items
+        Cell cell;                   //!< the cell holding the mobility model, if in the grid
+        Vector velocity;             //!< the velocity when the mobility model was put in a cell
+        bool accelerating;           //!< whether the velocity changes without a course change
+    };
+
+    /**
+     * @param position a position
+     * @return the coordinates of the cell holding the position
+     */
+    Cell GetCell(const Vector& position) const;
+
+    /**
+     * Put a mobility model in the cell of its current position, or in the
+     * list of the mobility models out of the grid if it is accelerating.
+     *
+     * @param entry the items of the mobility model
+     */
+    void Insert(Entry& entry);
+    /**
+     * Remove a mobility model from its cell or from the list of the mobility
+     * models out of the grid.
+     *
+     * @param entry the items of the mobility model
+     */
+    void Erase(const Entry& entry);
+    /**
+     * Put the moving mobility models in the cells of their current position,
+     * and move those whose velocity changed without a course change out of
+     * the grid.
+     */
+    void Rebin();
+    /**
+     * @return the distance that the moving mobility models in the grid may
+     * have covered since they were put in their cell, in meters
+     */
+    double GetMaxDrift() const;
+
+    /**
+     * Callback for the `CourseChange` trace of the mobility models.
+     *
+     * @param mobility the mobility model whose course changed
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    double m_cellSize;                                  //!< the size of the cells
+    std::map<const MobilityModel*, Entry> m_entries;    //!< the items per mobility model
+    std::unordered_map<Cell, std::vector<const MobilityModel*>, CellHash>
+        m_grid;                                 //!< the mobility models per cell
+    std::set<const MobilityModel*> m_moving;    //!< the moving mobility models in the grid
+    double m_maxSpeed;                          //!< the largest speed of m_moving
+    Time m_binTime;                             //!< a time before m_moving were put in their cell
+    std::set<const MobilityModel*> m_outOfGrid; //!< the mobility models out of the grid
+    std::vector<uint64_t> m_unlocated;          //!< the items without a mobility model
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_GRID_INDEX_H */
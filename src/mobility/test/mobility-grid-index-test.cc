@@ -0,0 +1,182 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/constant-acceleration-mobility-model.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/mobility-grid-index.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <random>
+
+using namespace ns3;
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Test the items returned by the MobilityGridIndex
+ *
+ * Check that the items in range of a position are those found by looking at
+ * every item, for several ranges and cell sizes, after some of the items
+ * moved, with items sharing a mobility model, moving with a constant velocity
+ * or acceleration across cells without course change, or without a mobility
+ * model.
+ */
+class MobilityGridIndexTestCase : public TestCase
+{
+  public:
+    MobilityGridIndexTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the items in range of a position.
+     *
+     * @param position the position
+     * @param range the range
+     */
+    void CheckItemsInRange(const Vector& position, double range);
+
+    MobilityGridIndex m_index;                      //!< the index under test
+    std::vector<Ptr<MobilityModel>> m_mobilities;   //!< the mobility model of each item
+};
+
+MobilityGridIndexTestCase::MobilityGridIndexTestCase()
+    : TestCase("Check the items in range returned by the MobilityGridIndex"),
+      m_index(100)
+{
+}
+
+void
+MobilityGridIndexTestCase::CheckItemsInRange(const Vector& position, double range)
+{
+    std::vector<uint64_t> expected;
+    for (uint64_t id = 0; id < m_mobilities.size(); ++id)
+    {
+        if (!m_mobilities[id] ||
+            CalculateDistance(m_mobilities[id]->GetPosition(), position) <= range)
+        {
+            expected.push_back(id);
+        }
+    }
+    const auto items = m_index.GetItemsInRange(position, range);
+    NS_TEST_ASSERT_MSG_EQ(items.size(),
+                          expected.size(),
+                          "Unexpected number of items within " << range << "m of " << position);
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(items[i], expected[i], "Unexpected item at position " << i);
+    }
+}
+
+void
+MobilityGridIndexTestCase::DoRun()
+{
+    std::mt19937 rng(RngSeedManager::GetSeed());
+    std::uniform_real_distribution<double> coordinate(-1000, 1000);
+
+    for (uint32_t i = 0; i < 200; ++i)
+    {
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(coordinate(rng), coordinate(rng), 0));
+        m_mobilities.push_back(mobility);
+        if (i % 10 == 0)
+        {
+            // another item located by the same mobility model
+            m_mobilities.push_back(mobility);
+        }
+    }
+    auto moving = CreateObject<ConstantVelocityMobilityModel>();
+    moving->SetPosition(Vector(0, 0, 0));
+    moving->SetVelocity(Vector(10, 5, 0));
+    m_mobilities.push_back(moving);
+    m_mobilities.push_back(nullptr);
+    std::uniform_real_distribution<double> speed(-40, 40);
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        auto mobility = CreateObject<ConstantVelocityMobilityModel>();
+        mobility->SetPosition(Vector(coordinate(rng), coordinate(rng), 0));
+        mobility->SetVelocity(Vector(speed(rng), speed(rng), 0));
+        m_mobilities.push_back(mobility);
+    }
+    auto accelerating = CreateObject<ConstantAccelerationMobilityModel>();
+    accelerating->SetPosition(Vector(-500, -500, 0));
+    accelerating->SetVelocityAndAcceleration(Vector(0, 0, 0), Vector(2, 1, 0));
+    m_mobilities.push_back(accelerating);
+
+    for (uint64_t id = 0; id < m_mobilities.size(); ++id)
+    {
+        m_index.Add(id, m_mobilities[id]);
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_index.GetN(), m_mobilities.size(), "Unexpected number of items");
+
+    const std::vector<double> ranges{0, 50, 150, 400, 5000};
+    auto checkAll = [&]() {
+        for (const auto range : ranges)
+        {
+            for (uint32_t i = 0; i < 10; ++i)
+            {
+                CheckItemsInRange(Vector(coordinate(rng), coordinate(rng), 0), range);
+            }
+            CheckItemsInRange(m_mobilities[3]->GetPosition(), range);
+        }
+    };
+    checkAll();
+
+    // move some of the items through their course change notifications
+    for (std::size_t i = 0; i < m_mobilities.size(); i += 7)
+    {
+        if (auto mobility = DynamicCast<ConstantPositionMobilityModel>(m_mobilities[i]))
+        {
+            mobility->SetPosition(Vector(coordinate(rng), coordinate(rng), 0));
+        }
+    }
+    checkAll();
+
+    // the moving items are found at their current position, as they leave
+    // the cell they were put in
+    for (uint32_t step = 1; step <= 100; ++step)
+    {
+        Simulator::Stop(MilliSeconds(300));
+        Simulator::Run();
+        CheckItemsInRange(moving->GetPosition(), 1);
+        CheckItemsInRange(accelerating->GetPosition(), 1);
+        checkAll();
+    }
+    CheckItemsInRange(Vector(300, 150, 0), 1);
+    CheckItemsInRange(Vector(0, 0, 0), 100);
+
+    m_index.SetCellSize(37);
+    checkAll();
+
+    m_index.Clear();
+    NS_TEST_EXPECT_MSG_EQ(m_index.GetN(), 0, "The index should be empty");
+    NS_TEST_EXPECT_MSG_EQ(m_index.GetItemsInRange(Vector(0, 0, 0), 5000).size(),
+                          0,
+                          "No item expected");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief MobilityGridIndex test suite
+ */
+class MobilityGridIndexTestSuite : public TestSuite
+{
+  public:
+    MobilityGridIndexTestSuite();
+};
+
+MobilityGridIndexTestSuite::MobilityGridIndexTestSuite()
+    : TestSuite("mobility-grid-index", Type::UNIT)
+{
+    AddTestCase(new MobilityGridIndexTestCase, TestCase::Duration::QUICK);
+}
+
+static MobilityGridIndexTestSuite g_mobilityGridIndexTestSuite; ///< the test suite
@@ -0,0 +1,211 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup mtp
+ *
+ * Compare the DefaultSimulatorImpl and the MultithreadedSimulatorImpl
+ * on the same scenario.
+ *
+ * The topology is a chain of routers connected by point-to-point links;
+ * each router serves a CSMA LAN of hosts.  Every host of LAN i sends a
+ * constant bit rate UDP flow to a host of LAN (i + lans / 2) % lans:
+ *
+ *     h h h       h h h              h h h
+ *     | | |       | | |              | | |
+ *    ======= r0  ======= r1  ...    ======= rN
+ *             |           |                  |
+ *             +-----------+-- ... -----------+
+ *
+ * Each LAN with its router can be executed by a different thread, the
+ * lookahead being the delay of the point-to-point links.  The scenario is first
+ * run with the sequential simulator and then with the multithreaded one,
+ * and the wall clock times and the received packets are compared.
+ */
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <iomanip>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("MtpBenchmark");
+
+/** The result of a run. */
+struct RunResult
+{
+    int64_t wallClock;   //!< Wall clock time of Simulator::Run(), in ms
+    uint64_t events;     //!< Executed events
+    uint64_t received;   //!< Packets received by all the hosts
+    uint32_t partitions; //!< Partitions, 1 for the sequential simulator
+};
+
+/**
+ * Build the scenario and run it with a simulator implementation.
+ *
+ * @param impl The simulator implementation.
+ * @param lans The number of LANs.
+ * @param hosts The number of hosts per LAN.
+ * @param interval The interval between two packets of a flow.
+ * @param stop The simulation stop time.
+ * @return The result of the run.
+ */
+static RunResult
+RunScenario(Ptr<SimulatorImpl> impl, uint32_t lans, uint32_t hosts, Time interval, Time stop)
+{
+    Simulator::SetImplementation(impl);
+    // Give both runs the same random variable streams
+    RngSeedManager::ResetNextStreamIndex();
+
+    NodeContainer routers;
+    routers.Create(lans);
+    std::vector<NodeContainer> lanHosts(lans);
+    for (auto& lan : lanHosts)
+    {
+        lan.Create(hosts);
+    }
+
+    InternetStackHelper stack;
+    stack.Install(routers);
+    for (const auto& lan : lanHosts)
+    {
+        stack.Install(lan);
+    }
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+    CsmaHelper csma;
+    csma.SetChannelAttribute("DataRate", StringValue("1Gbps"));
+    csma.SetChannelAttribute("Delay", StringValue("1us"));
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.252");
+    for (uint32_t i = 0; i + 1 < lans; ++i)
+    {
+        NetDeviceContainer devices = p2p.Install(NodeContainer(routers.Get(i), routers.Get(i + 1)));
+        address.Assign(devices);
+        address.NewNetwork();
+    }
+    std::vector<Ipv4InterfaceContainer> interfaces(lans);
+    address.SetBase("10.1.0.0", "255.255.255.0");
+    for (uint32_t i = 0; i < lans; ++i)
+    {
+        NetDeviceContainer devices = csma.Install(NodeContainer(NodeContainer(routers.Get(i)),
+                                                                lanHosts[i]));
+        interfaces[i] = address.Assign(devices);
+        address.NewNetwork();
+    }
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    uint16_t port = 9;
+    ApplicationContainer servers;
+    for (const auto& lan : lanHosts)
+    {
+        servers.Add(UdpServerHelper(port).Install(lan));
+    }
+    servers.Start(Seconds(0));
+    for (uint32_t i = 0; i < lans; ++i)
+    {
+        for (uint32_t j = 0; j < hosts; ++j)
+        {
+            // Interface 0 of each LAN is the router
+            Ipv4Address destination = interfaces[(i + lans / 2) % lans].GetAddress(j + 1);
+            UdpClientHelper client(destination, port);
+            client.SetAttribute("MaxPackets", UintegerValue(0));
+            client.SetAttribute("Interval", TimeValue(interval));
+            client.SetAttribute("PacketSize", UintegerValue(512));
+            ApplicationContainer app = client.Install(lanHosts[i].Get(j));
+            app.Start(Seconds(1) + MicroSeconds(i * hosts + j));
+            app.Stop(stop);
+        }
+    }
+
+    Simulator::Stop(stop + Seconds(1));
+    SystemWallClockMs clock;
+    clock.Start();
+    Simulator::Run();
+
+    RunResult result;
+    result.wallClock = clock.End();
+    result.events = Simulator::GetEventCount();
+    result.received = 0;
+    for (uint32_t i = 0; i < servers.GetN(); ++i)
+    {
+        result.received += DynamicCast<UdpServer>(servers.Get(i))->GetReceived();
+    }
+    Ptr<MultithreadedSimulatorImpl> mtp = DynamicCast<MultithreadedSimulatorImpl>(impl);
+    result.partitions = mtp ? mtp->GetPartitionCount() : 1;
+    Simulator::Destroy();
+    return result;
+}
+
+/**
+ * Print the result of a run.
+ *
+ * @param name The simulator implementation name.
+ * @param result The result of the run.
+ */
+static void
+Print(const std::string& name, const RunResult& result)
+{
+    std::cout << std::left << std::setw(14) << name << std::right << std::setw(6)
+              << result.partitions << " partitions" << std::setw(10) << result.wallClock
+              << " ms" << std::setw(12) << result.events << " events" << std::setw(10)
+              << result.received << " packets" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t lans = 8;
+    uint32_t hosts = 8;
+    uint32_t threads = 0;
+    Time interval = MilliSeconds(1);
+    Time stop = Seconds(10);
+    bool sequential = true;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("lans", "Number of LANs on the chain of routers", lans);
+    cmd.AddValue("hosts", "Number of hosts per LAN", hosts);
+    cmd.AddValue("threads", "Maximum number of threads, 0 for one per core", threads);
+    cmd.AddValue("interval", "Interval between the packets of each flow", interval);
+    cmd.AddValue("stop", "Simulation stop time", stop);
+    cmd.AddValue("sequential", "Also run the sequential simulator", sequential);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(lans < 2, "At least two LANs are needed");
+
+    RunResult reference;
+    if (sequential)
+    {
+        reference = RunScenario(CreateObject<DefaultSimulatorImpl>(), lans, hosts, interval, stop);
+        Print("sequential", reference);
+    }
+
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(threads));
+    RunResult result = RunScenario(impl, lans, hosts, interval, stop);
+    Print("multithreaded", result);
+
+    if (sequential)
+    {
+        std::cout << "speed-up: " << std::fixed << std::setprecision(2)
+                  << double(reference.wallClock) / std::max<int64_t>(result.wallClock, 1)
+                  << std::endl;
+        if (reference.received != result.received)
+        {
+            std::cout << "received packets differ from the sequential simulator" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,922 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/channel-list.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/timer-wheel.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <barrier>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+/**
+ * @file
+ * @ingroup mtp
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+namespace
+{
+
+/** Partition index of the threads which do not run a partition. */
+constexpr uint32_t NO_PARTITION = std::numeric_limits<uint32_t>::max();
+
+/**
+ * The index of the partition executed by the calling thread,
+ * or NO_PARTITION outside of MultithreadedSimulatorImpl::Run().
+ */
+thread_local uint32_t g_partitionIndex = NO_PARTITION;
+
+} // unnamed namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Mtp")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("MaxThreads",
+                          "The maximum number of threads (and partitions) used by Run(); "
+                          "0 uses one thread per hardware core.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+    // Until the first call to Run() all the events live in the global partition
+    m_partitions.resize(1);
+    Partition& global = m_partitions.back();
+    global.uid = EventId::UID::VALID;
+    global.currentUid = EventId::UID::INVALID;
+    global.currentTs = 0;
+    global.currentContext = Simulator::NO_CONTEXT;
+    global.eventCount = 0;
+    global.packetUid = 0;
+    global.streamIndex = 0;
+    global.unscheduledEvents = 0;
+    m_partitionCount = 0;
+    m_channelCount = 0;
+    m_maxThreads = 0;
+    m_lookAhead = GetMaximumSimulationTime().GetTimeStep();
+    m_windowEnd = 0;
+    m_running = false;
+    m_finished = false;
+    m_stop = false;
+    m_stopTs = GetMaximumSimulationTime().GetTimeStep();
+    m_eventsWithContextEmpty = true;
+    m_mainThreadId = std::this_thread::get_id();
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    ProcessEventsWithContext();
+
+    for (auto& partition : m_partitions)
+    {
+        for (auto& events : partition.eventsWithContext)
+        {
+            for (auto& event : events)
+            {
+                event.event->Unref();
+            }
+            events.clear();
+        }
+        while (!partition.events->IsEmpty())
+        {
+            Scheduler::Event next = partition.events->RemoveNext();
+            next.impl->Unref();
+        }
+        partition.events = nullptr;
+    }
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    NS_ASSERT_MSG(!m_running, "Cannot change the scheduler while the simulation is running");
+    m_schedulerFactory = schedulerFactory;
+
+    for (auto& partition : m_partitions)
+    {
+        Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+        if (partition.events)
+        {
+            while (!partition.events->IsEmpty())
+            {
+                Scheduler::Event next = partition.events->RemoveNext();
+                scheduler->Insert(next);
+            }
+        }
+        partition.events = scheduler;
+    }
+}
+
+// The shared-memory parallel simulation runs in a single process
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionCount() const
+{
+    return m_partitionCount;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookAhead() const
+{
+    return TimeStep(m_lookAhead);
+}
+
+MultithreadedSimulatorImpl::Partition&
+MultithreadedSimulatorImpl::GetCurrentPartition()
+{
+    return g_partitionIndex == NO_PARTITION ? m_partitions.back()
+                                            : m_partitions[g_partitionIndex];
+}
+
+const MultithreadedSimulatorImpl::Partition&
+MultithreadedSimulatorImpl::GetCurrentPartition() const
+{
+    return g_partitionIndex == NO_PARTITION ? m_partitions.back()
+                                            : m_partitions[g_partitionIndex];
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionIndex(uint32_t context) const
+{
+    if (context < m_partitionOfContext.size())
+    {
+        return m_partitionOfContext[context];
+    }
+    return m_partitionCount;
+}
+
+MultithreadedSimulatorImpl::Partition&
+MultithreadedSimulatorImpl::GetPartition(uint32_t context)
+{
+    return m_partitions[GetPartitionIndex(context)];
+}
+
+const MultithreadedSimulatorImpl::Partition&
+MultithreadedSimulatorImpl::GetPartition(uint32_t context) const
+{
+    return m_partitions[GetPartitionIndex(context)];
+}
+
+void
+MultithreadedSimulatorImpl::CalculatePartitions()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_partitions.size() == 1);
+
+    // Merge the nodes which share a channel that cannot be cut
+    uint32_t nNodes = NodeList::GetNNodes();
+    std::vector<uint32_t> parent(nNodes);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](uint32_t n) {
+        while (parent[n] != n)
+        {
+            parent[n] = parent[parent[n]];
+            n = parent[n];
+        }
+        return n;
+    };
+
+    // Channels which may join two partitions: (node, node, delay)
+    std::vector<std::tuple<uint32_t, uint32_t, uint64_t>> cuts;
+    for (auto i = ChannelList::Begin(); i != ChannelList::End(); ++i)
+    {
+        Ptr<Channel> channel = *i;
+        std::vector<uint32_t> nodes;
+        bool pointToPoint = true;
+        for (std::size_t j = 0; j < channel->GetNDevices(); ++j)
+        {
+            Ptr<NetDevice> device = channel->GetDevice(j);
+            if (device && device->GetNode())
+            {
+                nodes.push_back(device->GetNode()->GetId());
+                pointToPoint &= device->IsPointToPoint();
+            }
+        }
+        TimeValue delay;
+        if (nodes.size() == 2 && pointToPoint && channel->GetAttributeFailSafe("Delay", delay) &&
+            delay.Get().IsStrictlyPositive())
+        {
+            cuts.emplace_back(nodes[0], nodes[1], delay.Get().GetTimeStep());
+            continue;
+        }
+        for (std::size_t j = 1; j < nodes.size(); ++j)
+        {
+            parent[find(nodes[j])] = find(nodes[0]);
+        }
+    }
+
+    // Assign the groups, largest first, to the least loaded partition
+    std::vector<uint32_t> groupSize(nNodes, 0);
+    std::vector<uint32_t> groups;
+    for (uint32_t n = 0; n < nNodes; ++n)
+    {
+        if (groupSize[find(n)]++ == 0)
+        {
+            groups.push_back(find(n));
+        }
+    }
+    std::stable_sort(groups.begin(), groups.end(), [&groupSize](uint32_t a, uint32_t b) {
+        return groupSize[a] > groupSize[b];
+    });
+
+    uint32_t maxThreads = m_maxThreads;
+    if (maxThreads == 0)
+    {
+        maxThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    m_partitionCount =
+        std::max<uint32_t>(std::min<uint32_t>(maxThreads, static_cast<uint32_t>(groups.size())),
+                           1);
+
+    std::vector<uint32_t> load(m_partitionCount, 0);
+    std::vector<uint32_t> partitionOfGroup(nNodes, 0);
+    for (auto group : groups)
+    {
+        auto least = std::min_element(load.begin(), load.end());
+        partitionOfGroup[group] = static_cast<uint32_t>(least - load.begin());
+        *least += groupSize[group];
+    }
+    m_partitionOfContext.resize(nNodes);
+    for (uint32_t n = 0; n < nNodes; ++n)
+    {
+        m_partitionOfContext[n] = partitionOfGroup[find(n)];
+    }
+    m_channelCount = ChannelList::GetNChannels();
+
+    m_lookAhead = GetMaximumSimulationTime().GetTimeStep();
+    for (const auto& [a, b, delay] : cuts)
+    {
+        if (m_partitionOfContext[a] != m_partitionOfContext[b])
+        {
+            m_lookAhead = std::min(m_lookAhead, delay);
+        }
+    }
+    NS_LOG_INFO(nNodes << " nodes in " << groups.size() << " groups, " << m_partitionCount
+                       << " partitions, lookahead " << TimeStep(m_lookAhead));
+
+    // Partition i creates the packets with uids in [(i + 1) << 32, (i + 2) << 32), the main
+    // thread and the global events the packets with uids below 1 << 32. The automatic stream
+    // indices are split in the same way. The event uids are interleaved instead: from the next
+    // uid of the global partition, partition i takes every (m_partitionCount + 1)-th uid
+    // starting at offset i, and the global partition the ones at offset m_partitionCount, so
+    // that the partitions do not assign the same uid and the new uids are above the old ones.
+    for (auto i = static_cast<uint32_t>(m_packetUids.size()); i < m_partitionCount; ++i)
+    {
+        m_packetUids.push_back(static_cast<uint64_t>(i + 1) << 32);
+        m_streamIndices.push_back(static_cast<uint64_t>(i + 1) << 32);
+    }
+
+    // Create the worker partitions in front of the global one
+    Partition global = std::move(m_partitions.back());
+    m_partitions.clear();
+    m_partitions.resize(m_partitionCount + 1);
+    for (uint32_t i = 0; i < m_partitionCount; ++i)
+    {
+        Partition& partition = m_partitions[i];
+        partition.events = m_schedulerFactory.Create<Scheduler>();
+        partition.eventsWithContext.resize(m_partitionCount);
+        partition.uid = global.uid + i;
+        partition.currentUid = global.currentUid;
+        partition.currentTs = global.currentTs;
+        partition.currentContext = Simulator::NO_CONTEXT;
+        partition.eventCount = 0;
+        partition.packetUid = m_packetUids[i];
+        partition.streamIndex = m_streamIndices[i];
+        partition.unscheduledEvents = 0;
+    }
+    global.uid += m_partitionCount;
+    global.eventsWithContext.resize(m_partitionCount);
+
+    // Hand the node events over to their partition
+    std::vector<Scheduler::Event> globalEvents;
+    while (!global.events->IsEmpty())
+    {
+        Scheduler::Event next = global.events->RemoveNext();
+        uint32_t index = GetPartitionIndex(next.key.m_context);
+        if (index == m_partitionCount)
+        {
+            globalEvents.push_back(next);
+            continue;
+        }
+        m_partitions[index].events->Insert(next);
+        m_partitions[index].unscheduledEvents++;
+        global.unscheduledEvents--;
+    }
+    for (const auto& next : globalEvents)
+    {
+        global.events->Insert(next);
+    }
+    m_partitions.back() = std::move(global);
+}
+
+void
+MultithreadedSimulatorImpl::MergePartitions()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_partitions.size() == 1)
+    {
+        return;
+    }
+
+    Partition global = std::move(m_partitions.back());
+    m_partitions.pop_back();
+    for (uint32_t i = 0; i < m_partitions.size(); ++i)
+    {
+        Partition& partition = m_partitions[i];
+        while (!partition.events->IsEmpty())
+        {
+            global.events->Insert(partition.events->RemoveNext());
+        }
+        global.stopEvents.insert(global.stopEvents.end(),
+                                 partition.stopEvents.begin(),
+                                 partition.stopEvents.end());
+        m_packetUids[i] = partition.packetUid;
+        m_streamIndices[i] = partition.streamIndex;
+        // The next uid of every partition is above all the uids it assigned
+        global.uid = std::max(global.uid, partition.uid);
+        if (partition.currentTs > global.currentTs)
+        {
+            global.currentTs = partition.currentTs;
+            global.currentUid = partition.currentUid;
+        }
+        else if (partition.currentTs == global.currentTs)
+        {
+            global.currentUid = std::max(global.currentUid, partition.currentUid);
+        }
+        global.eventCount += partition.eventCount;
+        global.unscheduledEvents += partition.unscheduledEvents;
+    }
+    global.eventsWithContext.clear();
+
+    m_partitions.clear();
+    m_partitions.push_back(std::move(global));
+    m_partitionOfContext.clear();
+    m_partitionCount = 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::Insert(Partition& partition,
+                                   uint64_t ts,
+                                   uint32_t context,
+                                   EventImpl* event)
+{
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = partition.uid;
+    partition.uid += static_cast<uint32_t>(m_partitions.size());
+    partition.unscheduledEvents++;
+    partition.events->Insert(ev);
+    return ev.key.m_uid;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::NextTs(const Partition& partition) const
+{
+    if (partition.events->IsEmpty())
+    {
+        return GetMaximumSimulationTime().GetTimeStep();
+    }
+    return partition.events->PeekNext().key.m_ts;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent(Partition& partition)
+{
+    Scheduler::Event next = partition.events->RemoveNext();
+
+    PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+
+    NS_ASSERT(next.key.m_ts >= partition.currentTs);
+    partition.unscheduledEvents--;
+    partition.eventCount++;
+
+    NS_LOG_LOGIC("handle " << next.key.m_ts);
+    partition.currentTs = next.key.m_ts;
+    partition.currentContext = next.key.m_context;
+    partition.currentUid = next.key.m_uid;
+    next.impl->Invoke();
+    next.impl->Unref();
+}
+
+template <typename BARRIER>
+void
+MultithreadedSimulatorImpl::RunPartition(uint32_t index, BARRIER& synchronize)
+{
+    g_partitionIndex = index;
+    Partition& partition = m_partitions[index];
+    Packet::SetNextUid(partition.packetUid);
+    RngSeedManager::SetNextStreamIndex(partition.streamIndex);
+    while (true)
+    {
+        synchronize.arrive_and_wait();
+        if (m_finished)
+        {
+            break;
+        }
+        while (!partition.events->IsEmpty() &&
+               partition.events->PeekNext().key.m_ts < m_windowEnd &&
+               partition.events->PeekNext().key.m_ts < m_stopTs)
+        {
+            ProcessOneEvent(partition);
+        }
+    }
+    partition.packetUid = Packet::GetNextUid();
+    partition.streamIndex = RngSeedManager::PeekNextStreamIndex();
+    g_partitionIndex = NO_PARTITION;
+}
+
+void
+MultithreadedSimulatorImpl::Synchronize()
+{
+    // Run as the global partition on whichever thread completed the barrier
+    uint32_t worker = g_partitionIndex;
+    g_partitionIndex = m_partitionCount;
+    Partition& global = m_partitions.back();
+    const uint64_t maxTs = GetMaximumSimulationTime().GetTimeStep();
+    const uint64_t workerPacketUid = Packet::GetNextUid();
+    const uint64_t workerStreamIndex = RngSeedManager::PeekNextStreamIndex();
+    Packet::SetNextUid(global.packetUid);
+    RngSeedManager::SetNextStreamIndex(global.streamIndex);
+
+    while (true)
+    {
+        for (auto& partition : m_partitions)
+        {
+            for (auto& events : partition.eventsWithContext)
+            {
+                for (const auto& event : events)
+                {
+                    Insert(partition, event.timestamp, event.context, event.event);
+                }
+                events.clear();
+            }
+        }
+        ProcessEventsWithContext();
+
+        if (m_stop)
+        {
+            m_finished = true;
+            break;
+        }
+
+        uint64_t lbts = maxTs;
+        for (uint32_t i = 0; i < m_partitionCount; ++i)
+        {
+            lbts = std::min(lbts, NextTs(m_partitions[i]));
+        }
+        if (!global.events->IsEmpty() && NextTs(global) <= lbts)
+        {
+            // Global events see every partition stopped at their timestamp
+            ProcessOneEvent(global);
+            continue;
+        }
+        EventId stopEvent;
+        const uint64_t stopTs = NextStopTs(stopEvent);
+        if (stopTs <= lbts)
+        {
+            // The partitions have executed all the events before the stop event, which
+            // is executed here, before the other events at the same time: these events,
+            // whatever their uid, are still pending
+            const uint32_t index = GetPartitionIndex(stopEvent.GetContext());
+            Remove(stopEvent);
+            Partition& partition = m_partitions[index];
+            partition.eventCount++;
+            partition.currentTs = stopEvent.GetTs();
+            partition.currentUid = EventId::UID::INVALID;
+            m_stop = true;
+            m_finished = true;
+            break;
+        }
+        if (lbts == maxTs)
+        {
+            m_finished = true;
+            break;
+        }
+
+        m_windowEnd = lbts > maxTs - m_lookAhead ? maxTs : lbts + m_lookAhead;
+        m_windowEnd = std::min({m_windowEnd, NextTs(global), stopTs});
+        break;
+    }
+    global.packetUid = Packet::GetNextUid();
+    global.streamIndex = RngSeedManager::PeekNextStreamIndex();
+    Packet::SetNextUid(workerPacketUid);
+    RngSeedManager::SetNextStreamIndex(workerStreamIndex);
+    g_partitionIndex = worker;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::NextStopTs(EventId& id)
+{
+    uint64_t stopTs = GetMaximumSimulationTime().GetTimeStep();
+    for (auto& partition : m_partitions)
+    {
+        std::erase_if(partition.stopEvents,
+                      [this](const EventId& stopEvent) { return IsExpired(stopEvent); });
+        for (const auto& stopEvent : partition.stopEvents)
+        {
+            if (stopEvent.GetTs() < stopTs)
+            {
+                stopTs = stopEvent.GetTs();
+                id = stopEvent;
+            }
+        }
+    }
+    return stopTs;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    return std::all_of(m_partitions.begin(), m_partitions.end(), [](const Partition& partition) {
+        return partition.events->IsEmpty();
+    });
+}
+
+void
+MultithreadedSimulatorImpl::ProcessEventsWithContext()
+{
+    if (m_eventsWithContextEmpty)
+    {
+        return;
+    }
+
+    // swap queues
+    EventsWithContext eventsWithContext;
+    {
+        std::unique_lock lock{m_eventsWithContextMutex};
+        m_eventsWithContext.swap(eventsWithContext);
+        m_eventsWithContextEmpty = true;
+    }
+    while (!eventsWithContext.empty())
+    {
+        EventWithContext event = eventsWithContext.front();
+        eventsWithContext.pop_front();
+        // The partitions have executed all the events before the end of the last window
+        Partition& partition = GetPartition(event.context);
+        uint64_t now = partition.currentTs;
+        if (m_running &&
+            m_windowEnd != static_cast<uint64_t>(GetMaximumSimulationTime().GetTimeStep()))
+        {
+            now = std::max(now, m_windowEnd);
+        }
+        Insert(partition, now + event.timestamp, event.context, event.event);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    ProcessEventsWithContext();
+    m_stop = false;
+    m_stopTs = GetMaximumSimulationTime().GetTimeStep();
+    m_finished = false;
+
+    if (m_partitions.size() == 1 || m_partitionOfContext.size() != NodeList::GetNNodes() ||
+        m_channelCount != ChannelList::GetNChannels())
+    {
+        MergePartitions();
+        CalculatePartitions();
+    }
+
+    // The TimerWheel is shared by all the timers of the simulation: read the
+    // global value here, rather than from the first partition scheduling a timer
+    NS_ABORT_MSG_IF(m_partitionCount > 1 && TimerWheel::Get() != nullptr,
+                    "The TimerWheel cannot be used by several partitions");
+
+    Partition& global = m_partitions.back();
+    global.packetUid = Packet::GetNextUid();
+    global.streamIndex = RngSeedManager::PeekNextStreamIndex();
+    m_windowEnd = global.currentTs;
+    m_running = true;
+
+    auto completion = [this]() noexcept { Synchronize(); };
+    std::barrier synchronize(m_partitionCount, completion);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < m_partitionCount; ++i)
+    {
+        threads.emplace_back([this, &synchronize, i]() { RunPartition(i, synchronize); });
+    }
+    RunPartition(0, synchronize);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    m_running = false;
+    Packet::SetNextUid(global.packetUid);
+    RngSeedManager::SetNextStreamIndex(global.streamIndex);
+
+    // Outside of Run() the main thread sees the time of the most advanced partition
+    for (uint32_t i = 0; i < m_partitionCount; ++i)
+    {
+        if (m_partitions[i].currentTs > global.currentTs)
+        {
+            global.currentTs = m_partitions[i].currentTs;
+            global.currentUid = EventId::UID::INVALID;
+        }
+    }
+
+    // If the simulator stopped naturally by lack of events, make a
+    // consistency test to check that we didn't lose any events along the way.
+    NS_ASSERT(!IsFinished() || m_stop ||
+              std::all_of(m_partitions.begin(),
+                          m_partitions.end(),
+                          [](const Partition& partition) {
+                              return partition.unscheduledEvents == 0;
+                          }));
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+    if (g_partitionIndex != NO_PARTITION)
+    {
+        // The partitions still executing the current window stop before this time
+        const uint64_t ts = GetCurrentPartition().currentTs;
+        uint64_t stopTs = m_stopTs;
+        while (ts < stopTs && !m_stopTs.compare_exchange_weak(stopTs, ts))
+        {
+        }
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    EventId id = Simulator::Schedule(delay, &Simulator::Stop);
+    // The windows end at the time of the stop event
+    GetCurrentPartition().stopEvents.push_back(id);
+    return id;
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(g_partitionIndex != NO_PARTITION ||
+                      m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::Schedule Thread-unsafe invocation!");
+
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+    Partition& partition = GetCurrentPartition();
+    Time tAbsolute = delay + TimeStep(partition.currentTs);
+    auto ts = (uint64_t)tAbsolute.GetTimeStep();
+    uint32_t uid = Insert(partition, ts, partition.currentContext, event);
+    return EventId(event, ts, partition.currentContext, uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+
+    uint32_t source = g_partitionIndex;
+    if (source == NO_PARTITION && m_mainThreadId != std::this_thread::get_id())
+    {
+        EventWithContext ev;
+        ev.context = context;
+        // Current time added in ProcessEventsWithContext()
+        ev.timestamp = delay.GetTimeStep();
+        ev.event = event;
+        {
+            std::unique_lock lock{m_eventsWithContextMutex};
+            m_eventsWithContext.push_back(ev);
+            m_eventsWithContextEmpty = false;
+        }
+        return;
+    }
+
+    Time tAbsolute = delay + TimeStep(GetCurrentPartition().currentTs);
+    auto ts = (uint64_t)tAbsolute.GetTimeStep();
+    uint32_t target = GetPartitionIndex(context);
+    if (source == NO_PARTITION || source == m_partitionCount || source == target)
+    {
+        // No other thread is executing the target partition
+        Insert(m_partitions[target], ts, context, event);
+        return;
+    }
+    if (ts < m_windowEnd)
+    {
+        NS_FATAL_ERROR("Event for context " << context << " at " << TimeStep(ts)
+                                            << " crosses partitions within the lookahead "
+                                            << TimeStep(m_lookAhead));
+    }
+    m_partitions[target].eventsWithContext[source].push_back({context, ts, event});
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id() && g_partitionIndex == NO_PARTITION,
+                  "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+    Partition& global = m_partitions.back();
+    EventId id(Ptr<EventImpl>(event, false), global.currentTs, 0xffffffff, 2);
+    m_destroyEvents.push_back(id);
+    global.uid += static_cast<uint32_t>(m_partitions.size());
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(GetCurrentPartition().currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs() - GetCurrentPartition().currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    uint32_t index = GetPartitionIndex(id.GetContext());
+    NS_ASSERT_MSG(!m_running || g_partitionIndex == index || g_partitionIndex == m_partitionCount,
+                  "Simulator::Remove of an event owned by another partition");
+    Partition& partition = m_partitions[index];
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    partition.events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+
+    partition.unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    const Partition& partition = GetPartition(id.GetContext());
+    return id.PeekEventImpl() == nullptr || id.GetTs() < partition.currentTs ||
+           (id.GetTs() == partition.currentTs && id.GetUid() <= partition.currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return GetCurrentPartition().currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t eventCount = 0;
+    for (const auto& partition : m_partitions)
+    {
+        eventCount += partition.eventCount;
+    }
+    return eventCount;
+}
+
+} // namespace ns3
@@ -0,0 +1,345 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup mtp
+ * Declaration of class ns3::MultithreadedSimulatorImpl.
+ */
+
+#ifndef NS3_MULTITHREADED_SIMULATOR_IMPL_H
+#define NS3_MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/event-impl.h"
+#include "ns3/object-factory.h"
+#include "ns3/ptr.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup simulator
+ * @ingroup mtp
+ *
+ * @brief Shared-memory parallel simulator implementation using lookahead.
+ *
+ * When Run() is invoked the nodes of the NodeList are split into
+ * partitions, each of which is executed by its own thread.  Nodes are
+ * only separated across point-to-point channels with a strictly
+ * positive "Delay" attribute; nodes attached to any other channel
+ * (CSMA, wifi, ...) always end up in the same partition.  The smallest
+ * delay of the channels joining two partitions is the lookahead.
+ *
+ * Simulation time then advances in conservative windows, like
+ * the granted time window algorithm of the DistributedSimulatorImpl:
+ * every partition executes the events with a timestamp strictly
+ * smaller than the smallest next event timestamp plus the lookahead,
+ * in parallel with the other partitions.  Events sent to another
+ * partition are buffered in per-source hand-off lists which are
+ * moved into the destination event queue while all the threads are
+ * stopped between two windows.
+ *
+ * Events whose context is not a node (e.g., Simulator::NO_CONTEXT
+ * events scheduled from the main program) are global events: they are
+ * executed by a single thread while all the partitions are stopped.
+ *
+ * A stop time known before the window which reaches it starts is
+ * exact: the window ends at the stop time, so every partition executes
+ * the events before it and none of the events at or after it.  This is
+ * the case of Simulator::Stop(delay) called from the main program, by
+ * a global event, or by a partition with a delay of at least one
+ * lookahead.  Otherwise, i.e. Simulator::Stop() called by an event of a
+ * partition, the stop time is only exact for that partition: the other
+ * partitions stop before their events at the stop time, unless they
+ * have already executed them, which they may do up to the end of the
+ * current window, i.e. less than one lookahead after the stop time.
+ *
+ * Each partition numbers the packets it creates in its own range of
+ * packet uids (see Packet::SetNextUid()), and assigns the random
+ * variable streams of the objects it creates from its own block of
+ * stream indices (see RngSeedManager::SetNextStreamIndex()), so that the
+ * uids and the streams are unique and do not depend on the interleaving
+ * of the threads.
+ *
+ * This implementation is only available when ns-3 is configured with
+ * NS3_MTP, which makes the reference counts of ns-3 objects and of
+ * packet internals thread-safe.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Default constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited from SimulatorImpl
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Get the number of partitions used by the last call to Run().
+     *
+     * @return The number of partitions, each of which is run by its own thread.
+     */
+    uint32_t GetPartitionCount() const;
+
+    /**
+     * Get the lookahead used by the last call to Run().
+     *
+     * @return The smallest delay of the channels joining two partitions,
+     *         or the maximum simulation time if no channel does.
+     */
+    Time GetLookAhead() const;
+
+  private:
+    // Inherited from Object
+    void DoDispose() override;
+
+    /** Wrap an event with its execution context. */
+    struct EventWithContext
+    {
+        /** The event context. */
+        uint32_t context;
+        /** Event timestamp. */
+        uint64_t timestamp;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /** Container type for the events from a different partition or thread. */
+    typedef std::list<EventWithContext> EventsWithContext;
+
+    /**
+     * The state of the events executed by a single thread.
+     *
+     * Aligned on a cache line so that threads updating their own
+     * partition do not invalidate the partitions of the other threads.
+     */
+    struct alignas(64) Partition
+    {
+        /** The event priority queue. */
+        Ptr<Scheduler> events;
+        /**
+         * Events sent by the other partitions during the current window,
+         * indexed by the source partition.  Only the source thread appends
+         * to its list, and the lists are drained between two windows.
+         */
+        std::vector<EventsWithContext> eventsWithContext;
+        /**
+         * Next event unique id; the partitions assign the uids in turn,
+         * so that the events of two partitions never share a uid.
+         */
+        uint32_t uid;
+        /** Unique id of the current event. */
+        uint32_t currentUid;
+        /** Timestamp of the current event. */
+        uint64_t currentTs;
+        /** Execution context of the current event. */
+        uint32_t currentContext;
+        /** The event count. */
+        uint64_t eventCount;
+        /** The uid of the next packet created by the thread running the partition. */
+        uint64_t packetUid;
+        /** The next stream index assigned by the thread running the partition. */
+        uint64_t streamIndex;
+        /** The events scheduled by Stop(const Time&) which may not have run yet. */
+        std::vector<EventId> stopEvents;
+        /**
+         * Number of events that have been inserted but not yet scheduled,
+         * not counting the Destroy events; this is used for validation.
+         */
+        int unscheduledEvents;
+    };
+
+    /**
+     * Split the nodes into partitions and compute the lookahead.
+     *
+     * Nodes connected by a channel which cannot be split are merged
+     * with a union-find; the resulting groups are then assigned to at
+     * most m_maxThreads partitions, balancing the number of nodes.
+     */
+    void CalculatePartitions();
+    /**
+     * Move all the pending events into the global partition, so that
+     * they can be repartitioned by the next call to Run().
+     */
+    void MergePartitions();
+
+    /**
+     * Get the partition executing the events of the calling thread.
+     *
+     * @return The partition of a worker thread, or the global partition
+     *         when called from the main thread outside a window.
+     */
+    Partition& GetCurrentPartition();
+    /** @copydoc GetCurrentPartition() */
+    const Partition& GetCurrentPartition() const;
+    /**
+     * Get the partition owning the events with a given context.
+     *
+     * @param [in] context The event context.
+     * @return The partition owning the context.
+     */
+    Partition& GetPartition(uint32_t context);
+    /** @copydoc GetPartition(uint32_t) */
+    const Partition& GetPartition(uint32_t context) const;
+    /**
+     * Get the index of the partition owning the events with a given context.
+     *
+     * @param [in] context The event context.
+     * @return The partition index; m_partitionCount for the global partition.
+     */
+    uint32_t GetPartitionIndex(uint32_t context) const;
+
+    /**
+     * Insert an event in the queue of a partition.
+     *
+     * @param [in] partition The partition, owned by the calling thread.
+     * @param [in] ts The absolute event timestamp.
+     * @param [in] context The event context.
+     * @param [in] event The event to insert.
+     * @return The event unique id.
+     */
+    uint32_t Insert(Partition& partition, uint64_t ts, uint32_t context, EventImpl* event);
+
+    /**
+     * Get the timestamp of the next event of a partition.
+     *
+     * @param [in] partition The partition.
+     * @return The next event timestamp, or the maximum simulation time
+     *         if the partition has no events.
+     */
+    uint64_t NextTs(const Partition& partition) const;
+
+    /**
+     * Process the next event of a partition.
+     *
+     * @param [in] partition The partition, owned by the calling thread.
+     */
+    void ProcessOneEvent(Partition& partition);
+
+    /**
+     * Run the events of a worker partition until the end of each window.
+     *
+     * @param [in] index The partition index.
+     * @param [in] synchronize The function waiting for all the threads
+     *             at the end of a window.
+     */
+    template <typename BARRIER>
+    void RunPartition(uint32_t index, BARRIER& synchronize);
+
+    /**
+     * Executed by a single thread while all the partitions are stopped:
+     * move the events exchanged during the last window into their
+     * destination queues, run the global events which are due, and
+     * compute the end of the next window.
+     */
+    void Synchronize();
+
+    /** Move events from a different thread into their partition. */
+    void ProcessEventsWithContext();
+
+    /**
+     * Get the earliest pending event scheduled by Stop(const Time&),
+     * forgetting the events which have expired.
+     *
+     * @param [out] id The earliest pending stop event, if any.
+     * @return The timestamp of the stop event, or the maximum simulation
+     *         time if there is none.
+     */
+    uint64_t NextStopTs(EventId& id);
+
+    /** The factory used to create the event queue of each partition. */
+    ObjectFactory m_schedulerFactory;
+    /** The partitions; the last one holds the global events. */
+    std::vector<Partition> m_partitions;
+    /** The number of worker partitions. */
+    uint32_t m_partitionCount;
+    /** The partition index of each node, indexed by node id. */
+    std::vector<uint32_t> m_partitionOfContext;
+    /** The number of channels when the partitions were calculated. */
+    std::size_t m_channelCount;
+    /** The maximum number of threads; 0 to use one thread per core. */
+    uint32_t m_maxThreads;
+
+    /** The smallest delay of the channels joining two partitions. */
+    uint64_t m_lookAhead;
+    /** The end of the current window, exclusive. */
+    uint64_t m_windowEnd;
+    /** Set when the partitions execute their events in parallel. */
+    bool m_running;
+    /** Set when the worker threads must exit. */
+    bool m_finished;
+
+    /** The container of events from a thread which is not a simulation thread. */
+    EventsWithContext m_eventsWithContext;
+    /**
+     * Flag \c true if all events with context have been moved to the
+     * event queues.
+     */
+    std::atomic<bool> m_eventsWithContextEmpty;
+    /** Mutex to control access to the list of events with context. */
+    std::mutex m_eventsWithContextMutex;
+
+    /** Container type for the events to run at Simulator::Destroy(). */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy(). */
+    DestroyEvents m_destroyEvents;
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+    /**
+     * The time of the event which called Stop() in a partition; the
+     * partitions do not execute the events at or after this time.
+     */
+    std::atomic<uint64_t> m_stopTs;
+    /**
+     * The uid of the next packet created by each partition, kept from
+     * one partitioning to the next.
+     */
+    std::vector<uint64_t> m_packetUids;
+    /**
+     * The next stream index assigned by each partition, kept from one
+     * partitioning to the next.
+     */
+    std::vector<uint64_t> m_streamIndices;
+
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+};
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADED_SIMULATOR_IMPL_H */
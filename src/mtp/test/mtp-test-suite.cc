@@ -0,0 +1,595 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/default-simulator-impl.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <numeric>
+#include <set>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup mtp-tests
+ * Multithreaded simulator implementation test suite.
+ */
+
+/**
+ * @ingroup mtp
+ * @defgroup mtp-tests MTP module tests
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup mtp-tests
+ *
+ * Build a topology of SimpleNetDevices.
+ *
+ * @param [in] nodes The nodes.
+ * @param [in] a The first node.
+ * @param [in] b The second node.
+ * @param [in] delay The channel delay.
+ * @return The two devices.
+ */
+static NetDeviceContainer
+Connect(const NodeContainer& nodes, uint32_t a, uint32_t b, Time delay)
+{
+    SimpleNetDeviceHelper helper;
+    helper.SetChannelAttribute("Delay", TimeValue(delay));
+    helper.SetNetDevicePointToPointMode(true);
+    return helper.Install(NodeContainer(nodes.Get(a), nodes.Get(b)));
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * Check the split of the nodes into partitions and the lookahead.
+ */
+class MtpPartitionTestCase : public TestCase
+{
+  public:
+    MtpPartitionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MtpPartitionTestCase::MtpPartitionTestCase()
+    : TestCase("Check the partitions and the lookahead")
+{
+}
+
+void
+MtpPartitionTestCase::DoRun()
+{
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(2));
+    Simulator::SetImplementation(impl);
+
+    // A ring of four nodes, node 3 sharing a broadcast channel with nodes 4 and 5
+    NodeContainer nodes;
+    nodes.Create(6);
+    Connect(nodes, 0, 1, MilliSeconds(1));
+    Connect(nodes, 1, 2, MilliSeconds(2));
+    Connect(nodes, 2, 3, MilliSeconds(2));
+    Connect(nodes, 3, 0, MilliSeconds(3));
+    SimpleNetDeviceHelper helper;
+    helper.SetChannelAttribute("Delay", TimeValue(MicroSeconds(1)));
+    helper.Install(NodeContainer(nodes.Get(3), nodes.Get(4), nodes.Get(5)));
+
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+
+    // {3, 4, 5} is the largest group and gets a partition of its own
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), 2, "Unexpected number of partitions");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetLookAhead(),
+                          MilliSeconds(2),
+                          "The lookahead is the delay of the fastest channel between partitions");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), Seconds(1), "The simulation did not stop on time");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * Exchange packets on a ring of nodes and compare the receptions with
+ * the ones of the DefaultSimulatorImpl.
+ */
+class MtpTrafficTestCase : public TestCase
+{
+  public:
+    MtpTrafficTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the scenario with a simulator implementation.
+     *
+     * @param [in] impl The simulator implementation.
+     */
+    void RunScenario(Ptr<SimulatorImpl> impl);
+
+    /**
+     * Send a broadcast packet on every device of a node, and schedule the next one.
+     *
+     * @param [in] node The node.
+     */
+    void Send(Ptr<Node> node);
+
+    /**
+     * Receive a packet.
+     *
+     * @param [in] device The receiving device.
+     * @param [in] packet The packet.
+     * @param [in] protocol The protocol number.
+     * @param [in] from The sender address.
+     * @return Always true.
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    static constexpr uint32_t NODES = 16; //!< The number of nodes in the ring
+
+    std::vector<uint64_t> m_received;          //!< Received packets, by node
+    std::vector<int64_t> m_rxTime;             //!< Sum of the reception times, by node
+    std::vector<uint32_t> m_badContext;        //!< Receptions with a wrong context, by node
+    std::vector<std::vector<uint64_t>> m_uids; //!< Uids of the received packets, by node
+    std::vector<std::vector<double>> m_draws;  //!< Draws of new random variables, by node
+};
+
+MtpTrafficTestCase::MtpTrafficTestCase()
+    : TestCase("Compare the receptions with the sequential simulator")
+{
+}
+
+void
+MtpTrafficTestCase::Send(Ptr<Node> node)
+{
+    for (uint32_t i = 0; i < node->GetNDevices(); ++i)
+    {
+        Ptr<NetDevice> device = node->GetDevice(i);
+        device->Send(Create<Packet>(100 + node->GetId()), device->GetBroadcast(), 0x800);
+    }
+    if (Simulator::Now() < MilliSeconds(100))
+    {
+        Simulator::Schedule(MicroSeconds(100 + 10 * node->GetId()),
+                            &MtpTrafficTestCase::Send,
+                            this,
+                            node);
+    }
+}
+
+bool
+MtpTrafficTestCase::Receive(Ptr<NetDevice> device,
+                            Ptr<const Packet> packet,
+                            uint16_t protocol,
+                            const Address& from)
+{
+    // Only the thread of the partition of the node updates its counters
+    uint32_t id = device->GetNode()->GetId();
+    m_received[id]++;
+    m_rxTime[id] += Simulator::Now().GetMicroSeconds();
+    m_uids[id].push_back(packet->GetUid());
+    // a random variable created by a partition gets a stream of its block
+    m_draws[id].push_back(CreateObject<UniformRandomVariable>()->GetValue());
+    if (Simulator::GetContext() != id)
+    {
+        m_badContext[id]++;
+    }
+    return true;
+}
+
+void
+MtpTrafficTestCase::RunScenario(Ptr<SimulatorImpl> impl)
+{
+    Simulator::SetImplementation(impl);
+    m_received.assign(NODES, 0);
+    m_rxTime.assign(NODES, 0);
+    m_badContext.assign(NODES, 0);
+    m_uids.assign(NODES, {});
+    m_draws.assign(NODES, {});
+
+    NodeContainer nodes;
+    nodes.Create(NODES);
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        NetDeviceContainer devices = Connect(nodes, i, (i + 1) % NODES, MicroSeconds(500 + i));
+        for (uint32_t j = 0; j < devices.GetN(); ++j)
+        {
+            devices.Get(j)->SetReceiveCallback(MakeCallback(&MtpTrafficTestCase::Receive, this));
+        }
+    }
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(i),
+                                       &MtpTrafficTestCase::Send,
+                                       this,
+                                       nodes.Get(i));
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+void
+MtpTrafficTestCase::DoRun()
+{
+    RunScenario(CreateObject<DefaultSimulatorImpl>());
+    std::vector<uint64_t> received = m_received;
+    std::vector<int64_t> rxTime = m_rxTime;
+
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(4));
+    RunScenario(impl);
+
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), 4, "Unexpected number of partitions");
+    std::set<uint64_t> uids;
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        NS_TEST_EXPECT_MSG_GT(received[i], 0, "Node " << i << " did not receive any packet");
+        NS_TEST_EXPECT_MSG_EQ(m_received[i], received[i], "Wrong receptions at node " << i);
+        NS_TEST_EXPECT_MSG_EQ(m_rxTime[i], rxTime[i], "Wrong reception times at node " << i);
+        NS_TEST_EXPECT_MSG_EQ(m_badContext[i], 0, "Wrong context at node " << i);
+        uids.insert(m_uids[i].begin(), m_uids[i].end());
+    }
+    // Every packet is received once
+    NS_TEST_EXPECT_MSG_EQ(uids.size(),
+                          std::accumulate(received.begin(), received.end(), uint64_t{0}),
+                          "The packets created by different partitions have the same uid");
+
+    // The uids and the random streams do not depend on the interleaving of the threads
+    std::vector<std::vector<uint64_t>> firstUids = m_uids;
+    std::vector<std::vector<double>> firstDraws = m_draws;
+    impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(4));
+    RunScenario(impl);
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ((m_uids[i] == firstUids[i]),
+                              true,
+                              "Different packet uids received at node " << i);
+        NS_TEST_EXPECT_MSG_EQ((m_draws[i] == firstDraws[i]),
+                              true,
+                              "Different random streams assigned at node " << i);
+    }
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * Check that global events run while the partitions are stopped.
+ */
+class MtpGlobalEventTestCase : public TestCase
+{
+  public:
+    MtpGlobalEventTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Node event, counting its executions.
+     *
+     * @param [in] node The node index.
+     */
+    void NodeEvent(uint32_t node);
+
+    /** Global event, checking the time of every partition. */
+    void GlobalEvent();
+
+    static constexpr uint32_t NODES = 4; //!< The number of nodes
+
+    std::vector<uint32_t> m_nodeEvents; //!< Executed node events, by node
+    uint32_t m_globalEvents;            //!< Executed global events
+    bool m_ordered;                     //!< Whether the events ran in timestamp order
+};
+
+MtpGlobalEventTestCase::MtpGlobalEventTestCase()
+    : TestCase("Check the global events")
+{
+}
+
+void
+MtpGlobalEventTestCase::NodeEvent(uint32_t node)
+{
+    // Node events run at 0.5 ms + n ms, the global events every 10 ms from 0
+    if (m_nodeEvents[node] / 10 + 1 != m_globalEvents)
+    {
+        m_ordered = false;
+    }
+    m_nodeEvents[node]++;
+    Simulator::Schedule(MilliSeconds(1), &MtpGlobalEventTestCase::NodeEvent, this, node);
+}
+
+void
+MtpGlobalEventTestCase::GlobalEvent()
+{
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetContext(),
+                          Simulator::NO_CONTEXT,
+                          "Global events run without a context");
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        if (m_nodeEvents[i] != 10 * m_globalEvents)
+        {
+            m_ordered = false;
+        }
+    }
+    m_globalEvents++;
+    Simulator::Schedule(MilliSeconds(10), &MtpGlobalEventTestCase::GlobalEvent, this);
+}
+
+void
+MtpGlobalEventTestCase::DoRun()
+{
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(NODES));
+    Simulator::SetImplementation(impl);
+    m_nodeEvents.assign(NODES, 0);
+    m_globalEvents = 0;
+    m_ordered = true;
+
+    NodeContainer nodes;
+    nodes.Create(NODES);
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        Connect(nodes, i, (i + 1) % NODES, MilliSeconds(5));
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(500),
+                                       &MtpGlobalEventTestCase::NodeEvent,
+                                       this,
+                                       i);
+    }
+    Simulator::Schedule(Seconds(0), &MtpGlobalEventTestCase::GlobalEvent, this);
+    Simulator::Stop(MilliSeconds(100));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), NODES, "Unexpected number of partitions");
+    NS_TEST_EXPECT_MSG_EQ(m_ordered, true, "Global events did not stop the partitions");
+    NS_TEST_EXPECT_MSG_EQ(m_globalEvents, 10, "Wrong number of global events");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MilliSeconds(100), "Wrong stop time");
+
+    // A second run continues from the stop time with the same partitions
+    uint64_t eventCount = impl->GetEventCount();
+    Simulator::Stop(MilliSeconds(50));
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_globalEvents, 15, "Wrong number of global events");
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_nodeEvents[i], 150, "Wrong number of events at node " << i);
+    }
+    // The node events, the global events and the stop event
+    NS_TEST_EXPECT_MSG_EQ(impl->GetEventCount() - eventCount,
+                          4 * 50 + 5 + 1,
+                          "Wrong event count of the second run");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * Check the events executed by the partitions when an event of a
+ * partition stops the simulation.
+ */
+class MtpStopTestCase : public TestCase
+{
+  public:
+    MtpStopTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Node event, counting its executions; the events of node 0 stop the
+     * simulation at the requested times.
+     *
+     * @param [in] node The node index.
+     */
+    void NodeEvent(uint32_t node);
+
+    static constexpr uint32_t NODES = 4; //!< The number of nodes
+
+    std::vector<uint32_t> m_nodeEvents; //!< Executed node events, by node
+    Time m_stopWithDelay;               //!< Time of the call to Stop(delay) by node 0
+    Time m_stopNow;                     //!< Time of the call to Stop() by node 0
+};
+
+MtpStopTestCase::MtpStopTestCase()
+    : TestCase("Check the stop of the simulation by a partition")
+{
+}
+
+void
+MtpStopTestCase::NodeEvent(uint32_t node)
+{
+    m_nodeEvents[node]++;
+    Simulator::Schedule(MilliSeconds(1), &MtpStopTestCase::NodeEvent, this, node);
+    if (node == 0 && Simulator::Now() == m_stopWithDelay)
+    {
+        Simulator::Stop(MilliSeconds(20));
+    }
+    if (node == 0 && Simulator::Now() == m_stopNow)
+    {
+        Simulator::Stop();
+    }
+}
+
+void
+MtpStopTestCase::DoRun()
+{
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(NODES));
+    Simulator::SetImplementation(impl);
+    m_nodeEvents.assign(NODES, 0);
+    m_stopWithDelay = MicroSeconds(10500);
+    m_stopNow = MicroSeconds(40500);
+
+    // The node events run at 0.5 ms + n ms, the lookahead is 5 ms
+    NodeContainer nodes;
+    nodes.Create(NODES);
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        Connect(nodes, i, (i + 1) % NODES, MilliSeconds(5));
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(500),
+                                       &MtpStopTestCase::NodeEvent,
+                                       this,
+                                       i);
+    }
+
+    // The stop time is known before the window which reaches it starts
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), NODES, "Unexpected number of partitions");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MicroSeconds(30500), "Wrong stop time");
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        // The events from 0.5 ms to 29.5 ms
+        NS_TEST_EXPECT_MSG_EQ(m_nodeEvents[i], 30, "Wrong number of events at node " << i);
+    }
+
+    // The other partitions stop before 40.5 ms, unless they have already
+    // executed the events of the current window, which ends before 45.5 ms
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_nodeEvents[0], 41, "Wrong number of events at node 0");
+    for (uint32_t i = 1; i < NODES; ++i)
+    {
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(m_nodeEvents[i],
+                                    40,
+                                    "Node " << i << " stopped before the stop time");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(m_nodeEvents[i],
+                                    45,
+                                    "Node " << i << " stopped after the end of the window");
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * Check the events left in several partitions at the same time by a
+ * stop, when the partitions are merged by the next run.
+ */
+class MtpMergeTestCase : public TestCase
+{
+  public:
+    MtpMergeTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Node event, counting its executions and keeping the id of the next one.
+     *
+     * @param [in] node The node index.
+     */
+    void NodeEvent(uint32_t node);
+
+    static constexpr uint32_t NODES = 4; //!< The number of nodes
+
+    std::vector<uint32_t> m_nodeEvents; //!< Executed node events, by node
+    std::vector<EventId> m_nextEvents;  //!< Next node event, by node
+};
+
+MtpMergeTestCase::MtpMergeTestCase()
+    : TestCase("Check the merge of the partitions with events at the stop time")
+{
+}
+
+void
+MtpMergeTestCase::NodeEvent(uint32_t node)
+{
+    m_nodeEvents[node]++;
+    m_nextEvents[node] =
+        Simulator::Schedule(MilliSeconds(1), &MtpMergeTestCase::NodeEvent, this, node);
+}
+
+void
+MtpMergeTestCase::DoRun()
+{
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(NODES));
+    Simulator::SetImplementation(impl);
+    m_nodeEvents.assign(NODES, 0);
+    m_nextEvents.assign(NODES, EventId());
+
+    // The node events run every millisecond, the first run stops at the
+    // time of the next event of every partition
+    NodeContainer nodes;
+    nodes.Create(NODES);
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        Connect(nodes, i, (i + 1) % NODES, MilliSeconds(5));
+        Simulator::ScheduleWithContext(i, MilliSeconds(1), &MtpMergeTestCase::NodeEvent, this, i);
+    }
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), NODES, "Unexpected number of partitions");
+
+    std::set<uint32_t> uids;
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_nodeEvents[i], 9, "Wrong number of events at node " << i);
+        NS_TEST_EXPECT_MSG_EQ(TimeStep(m_nextEvents[i].GetTs()),
+                              MilliSeconds(10),
+                              "Wrong time of the next event of node " << i);
+        NS_TEST_EXPECT_MSG_EQ(m_nextEvents[i].IsPending(),
+                              true,
+                              "The next event of node " << i << " is not pending");
+        uids.insert(m_nextEvents[i].GetUid());
+    }
+    NS_TEST_EXPECT_MSG_EQ(uids.size(), NODES, "The partitions assigned the same event uids");
+
+    // A new node merges the partitions into one queue before splitting them again
+    std::vector<EventId> pendingEvents = m_nextEvents;
+    CreateObject<Node>();
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+    for (uint32_t i = 0; i < NODES; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_nodeEvents[i], 19, "Wrong number of events at node " << i);
+        NS_TEST_EXPECT_MSG_EQ(pendingEvents[i].IsExpired(),
+                              true,
+                              "The event of node " << i << " at the first stop did not run");
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * Multithreaded simulator implementation test suite.
+ */
+class MtpTestSuite : public TestSuite
+{
+  public:
+    MtpTestSuite();
+};
+
+MtpTestSuite::MtpTestSuite()
+    : TestSuite("mtp", Type::UNIT)
+{
+    AddTestCase(new MtpPartitionTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new MtpTrafficTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new MtpGlobalEventTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new MtpStopTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new MtpMergeTestCase, TestCase::Duration::QUICK);
+}
+
+static MtpTestSuite g_mtpTestSuite; //!< Static variable for test initialization
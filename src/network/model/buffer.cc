@@ -7,9 +7,14 @@
  */
 #include "buffer.h"
 
+#include "packet-accounting.h"
+
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
+#include <limits>
+#include <utility>
+
 #define LOG_INTERNAL_STATE(y)                                                                      \
     NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
                    << ", zero start=" << m_zeroAreaStart << ", zero end=" << m_zeroAreaEnd         \
@@ -43,154 +48,133 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
-uint32_t Buffer::g_recommendedStart = 0;
-#ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy
- * constructor orderings.
+thread_local uint32_t Buffer::g_recommendedStart = 0;
+thread_local Buffer::AllocationStatistics Buffer::g_allocationStatistics = {0, 0, 0, 0};
+bool Buffer::g_enableScatterGather = false;
+
+/**
+ * @relates Buffer
+ * The maximum number of data storages cached in each size class.
  */
-#define MAGIC_DESTROYED (~(long)0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
-
-Buffer::LocalStaticDestructor::~LocalStaticDestructor()
-{
-    NS_LOG_FUNCTION(this);
-    if (IS_INITIALIZED(g_freeList))
-    {
-        for (auto i = g_freeList->begin(); i != g_freeList->end(); i++)
-        {
-            Buffer::Deallocate(*i);
-        }
-        delete g_freeList;
-        g_freeList = DESTROYED;
-    }
-}
+static std::atomic<uint32_t> g_poolHighWaterMark = 1000;
+/**
+ * @relates Buffer
+ * The pool of the data storages of the thread.
+ */
+static constinit thread_local SizeClassPool g_pool(&g_poolHighWaterMark);
 
 void
 Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
-    g_maxSize = std::max(g_maxSize, data->m_size);
-    /* feed into free list */
-    if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
-    {
-        Buffer::Deallocate(data);
-    }
-    else
+    if (data->m_accounting != 0)
     {
-        NS_ASSERT(IS_INITIALIZED(g_freeList));
-        g_freeList->push_back(data);
+        PacketAccounting::RemoveBytes(data->m_accounting, data->m_size - 1 + sizeof(Buffer::Data));
     }
+    g_pool.Release(data, data->m_size - 1 + sizeof(Buffer::Data));
 }
 
+constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
+
 Buffer::Data*
-Buffer::Create(uint32_t dataSize)
+Buffer::Create(uint32_t reqSize)
 {
-    NS_LOG_FUNCTION(dataSize);
-    /* try to find a buffer correctly sized. */
-    if (IS_UNINITIALIZED(g_freeList))
+    NS_LOG_FUNCTION(reqSize);
+    if (reqSize == 0)
     {
-        g_freeList = new Buffer::FreeList();
+        reqSize = 1;
     }
-    else if (IS_INITIALIZED(g_freeList))
+    NS_ASSERT(reqSize >= 1);
+    reqSize += ALLOC_OVER_PROVISION;
+    uint32_t size = reqSize - 1 + sizeof(Buffer::Data);
+    bool allocated;
+    auto data = static_cast<Buffer::Data*>(g_pool.Acquire(size, allocated));
+    // The block of the size class may be larger than requested
+    data->m_size = size + 1 - sizeof(Buffer::Data);
+    data->m_count = 1;
+    data->m_accounting = PacketAccounting::IsEnabled() ? PacketAccounting::AddBytes(size) : 0;
+    g_allocationStatistics.allocations++;
+    g_allocationStatistics.allocatedBytes += size;
+    if (allocated)
     {
-        while (!g_freeList->empty())
-        {
-            Buffer::Data* data = g_freeList->back();
-            g_freeList->pop_back();
-            if (data->m_size >= dataSize)
-            {
-                data->m_count = 1;
-                return data;
-            }
-            Buffer::Deallocate(data);
-        }
+        g_allocationStatistics.heapAllocations++;
     }
-    Buffer::Data* data = Buffer::Allocate(dataSize);
-    NS_ASSERT(data->m_count == 1);
     return data;
 }
-#else  /* BUFFER_FREE_LIST */
+
+Buffer::AllocationStatistics
+Buffer::GetAllocationStatistics()
+{
+    return g_allocationStatistics;
+}
+
 void
-Buffer::Recycle(Buffer::Data* data)
+Buffer::ResetAllocationStatistics()
 {
-    NS_LOG_FUNCTION(data);
-    NS_ASSERT(data->m_count == 0);
-    Deallocate(data);
+    g_allocationStatistics = {0, 0, 0, 0};
 }
 
-Buffer::Data*
-Buffer::Create(uint32_t size)
+SizeClassPool::Statistics
+Buffer::GetPoolStatistics()
 {
-    NS_LOG_FUNCTION(size);
-    return Allocate(size);
+    return g_pool.GetStatistics();
 }
-#endif /* BUFFER_FREE_LIST */
 
-constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
+void
+Buffer::ResetPoolStatistics()
+{
+    g_pool.ResetStatistics();
+}
 
-Buffer::Data*
-Buffer::Allocate(uint32_t reqSize)
+void
+Buffer::SetPoolHighWaterMark(uint32_t blocks)
 {
-    NS_LOG_FUNCTION(reqSize);
-    if (reqSize == 0)
-    {
-        reqSize = 1;
-    }
-    NS_ASSERT(reqSize >= 1);
-    reqSize += ALLOC_OVER_PROVISION;
-    uint32_t size = reqSize - 1 + sizeof(Buffer::Data);
-    auto b = new uint8_t[size];
-    auto data = reinterpret_cast<Buffer::Data*>(b);
-    data->m_size = reqSize;
-    data->m_count = 1;
-    return data;
+    NS_LOG_FUNCTION(blocks);
+    g_poolHighWaterMark = blocks;
 }
 
 void
-Buffer::Deallocate(Buffer::Data* data)
+Buffer::ClearPool()
 {
-    NS_LOG_FUNCTION(data);
-    NS_ASSERT(data->m_count == 0);
-    auto buf = reinterpret_cast<uint8_t*>(data);
-    delete[] buf;
+    NS_LOG_FUNCTION_NOARGS();
+    g_pool.Clear();
+}
+
+void
+Buffer::EnableScatterGather()
+{
+    NS_LOG_FUNCTION_NOARGS();
+#ifdef NS3_MTP
+    NS_LOG_WARN("The scatter-gather mode is not used by the multithreaded simulator");
+#else
+    g_enableScatterGather = true;
+#endif
+}
+
+void
+Buffer::DisableScatterGather()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    g_enableScatterGather = false;
 }
 
 Buffer::Buffer()
+    : m_chain(nullptr)
 {
     NS_LOG_FUNCTION(this);
     Initialize(0);
 }
 
 Buffer::Buffer(uint32_t dataSize)
+    : m_chain(nullptr)
 {
     NS_LOG_FUNCTION(this << dataSize);
     Initialize(dataSize);
 }
 
 Buffer::Buffer(uint32_t dataSize, bool initialize)
+    : m_chain(nullptr)
 {
     NS_LOG_FUNCTION(this << dataSize << initialize);
     if (initialize)
@@ -252,11 +236,17 @@ Buffer&
 Buffer::operator=(const Buffer& o)
 {
     NS_ASSERT(CheckInternalState());
+    // o may be a buffer of the chain of this buffer: release the chain last
+    Chain* chain = m_chain;
+    m_chain = o.m_chain;
+    if (m_chain != nullptr)
+    {
+        m_chain->m_count++;
+    }
     if (m_data != o.m_data)
     {
         // not assignment to self.
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Recycle(m_data);
         }
@@ -269,6 +259,10 @@ Buffer::operator=(const Buffer& o)
     m_zeroAreaEnd = o.m_zeroAreaEnd;
     m_start = o.m_start;
     m_end = o.m_end;
+    if (chain != nullptr && --chain->m_count == 0)
+    {
+        delete chain;
+    }
     NS_ASSERT(CheckInternalState());
     return *this;
 }
@@ -278,11 +272,175 @@ Buffer::~Buffer()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         Recycle(m_data);
     }
+    ReleaseChain();
+}
+
+Buffer
+Buffer::CopyHead() const
+{
+    NS_LOG_FUNCTION(this);
+    Buffer head = *this;
+    head.ReleaseChain();
+    return head;
+}
+
+void
+Buffer::ReleaseChain()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_chain != nullptr)
+    {
+        if (--m_chain->m_count == 0)
+        {
+            delete m_chain;
+        }
+        m_chain = nullptr;
+    }
+}
+
+Buffer::Chain*
+Buffer::GetOwnedChain()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_chain == nullptr)
+    {
+        m_chain = new Chain{1, 0, {}, std::nullopt, std::nullopt};
+    }
+    else if (m_chain->m_count > 1)
+    {
+        auto chain = new Chain{1, m_chain->m_size, m_chain->m_segments, std::nullopt, std::nullopt};
+        m_chain->m_count--;
+        m_chain = chain;
+    }
+    else
+    {
+        m_chain->m_head.reset();
+        m_chain->m_flat.reset();
+    }
+    return m_chain;
+}
+
+void
+Buffer::ChainAtEnd(const Buffer& o)
+{
+    NS_LOG_FUNCTION(this << &o);
+    // o may be this buffer, or share its chain
+    Buffer src = o;
+    Chain* chain = GetOwnedChain();
+    auto append = [chain](const Buffer& segment) {
+        uint32_t size = segment.GetSize();
+        if (size == 0)
+        {
+            return;
+        }
+        if (size < SCATTER_GATHER_MIN && !chain->m_segments.empty())
+        {
+            // copying a few bytes is cheaper than chaining them
+            chain->m_segments.back().AddAtEnd(segment);
+        }
+        else
+        {
+            chain->m_segments.push_back(segment);
+        }
+        chain->m_size += size;
+    };
+    append(src.CopyHead());
+    if (src.m_chain != nullptr)
+    {
+        for (const auto& segment : src.m_chain->m_segments)
+        {
+            append(segment);
+        }
+    }
+    if (chain->m_segments.empty())
+    {
+        ReleaseChain();
+    }
+}
+
+void
+Buffer::Flatten() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_chain != nullptr);
+    Chain* chain = m_chain;
+    Buffer head = CopyHead();
+    const std::optional<Buffer>& last = chain->m_head;
+    if (!last.has_value() || last->m_data != head.m_data || last->m_start != head.m_start ||
+        last->m_end != head.m_end || last->m_zeroAreaStart != head.m_zeroAreaStart ||
+        last->m_zeroAreaEnd != head.m_zeroAreaEnd)
+    {
+        // The bytes of the cached head cannot change, since the cache
+        // shares their data storage.
+        std::vector<const Buffer*> pieces = {&head};
+        for (const auto& segment : chain->m_segments)
+        {
+            pieces.push_back(&segment);
+        }
+        // keep the largest zero area virtual, and write the bytes around it
+        uint32_t offset = 0;
+        uint32_t zeroStart = 0;
+        uint32_t zeroSize = 0;
+        uint32_t zeroes = 0;
+        for (auto piece : pieces)
+        {
+            uint32_t pieceZeroSize = piece->m_zeroAreaEnd - piece->m_zeroAreaStart;
+            if (pieceZeroSize > zeroSize)
+            {
+                zeroStart = offset + piece->m_zeroAreaStart - piece->m_start;
+                zeroSize = pieceZeroSize;
+            }
+            zeroes += pieceZeroSize;
+            offset += piece->GetSize();
+        }
+        uint32_t zeroEnd = zeroStart + zeroSize;
+        Buffer flat(0, false);
+        flat.m_data = Buffer::Create(g_recommendedStart + offset - zeroSize);
+        flat.m_start = g_recommendedStart;
+        flat.m_maxZeroAreaStart = flat.m_start + zeroStart;
+        flat.m_zeroAreaStart = flat.m_start + zeroStart;
+        flat.m_zeroAreaEnd = flat.m_zeroAreaStart + zeroSize;
+        flat.m_end = flat.m_start + offset;
+        flat.m_data->m_dirtyStart = flat.m_start;
+        flat.m_data->m_dirtyEnd = flat.m_end;
+        g_allocationStatistics.zeroBytes += zeroes - zeroSize;
+        offset = 0;
+        for (auto piece : pieces)
+        {
+            uint32_t size = piece->GetSize();
+            uint32_t end = std::min(offset + size, zeroStart);
+            if (offset < end)
+            {
+                piece->CreateFragment(0, end - offset)
+                    .CopyData(flat.m_data->m_data + flat.m_start + offset, end - offset);
+            }
+            uint32_t start = std::max(offset, zeroEnd);
+            if (start < offset + size)
+            {
+                piece->CreateFragment(start - offset, offset + size - start)
+                    .CopyData(flat.m_data->m_data + flat.m_zeroAreaStart + start - zeroEnd,
+                              offset + size - start);
+            }
+            offset += size;
+        }
+        chain->m_head = head;
+        chain->m_flat = flat;
+    }
+    // take the representation of a copy of the flattened buffer, and let
+    // the copy release the former representation of this buffer
+    Buffer flat = *chain->m_flat;
+    std::swap(m_data, flat.m_data);
+    std::swap(m_chain, flat.m_chain);
+    std::swap(m_maxZeroAreaStart, flat.m_maxZeroAreaStart);
+    std::swap(m_zeroAreaStart, flat.m_zeroAreaStart);
+    std::swap(m_zeroAreaEnd, flat.m_zeroAreaEnd);
+    std::swap(m_start, flat.m_start);
+    std::swap(m_end, flat.m_end);
+    NS_ASSERT(CheckInternalState());
 }
 
 uint32_t
@@ -304,7 +462,12 @@ Buffer::AddAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    // another thread may extend the dirty area of shared data concurrently
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+#endif
     if (m_start >= start && !isDirty)
     {
         /* enough space in the buffer and not dirty.
@@ -322,8 +485,7 @@ Buffer::AddAtStart(uint32_t start)
         uint32_t newSize = GetInternalSize() + start;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -345,12 +507,35 @@ Buffer::AddAtStart(uint32_t start)
     NS_ASSERT(CheckInternalState());
 }
 
+uint8_t*
+Buffer::AddAtStartContiguous(uint32_t start)
+{
+    NS_LOG_FUNCTION(this << start);
+    AddAtStart(start);
+    NS_ASSERT(m_zeroAreaStart - m_start >= start);
+    return m_data->m_data + m_start;
+}
+
 void
 Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
+    if (m_chain != nullptr)
+    {
+        // the bytes are added to the last buffer of the chain
+        Chain* chain = GetOwnedChain();
+        chain->m_segments.back().AddAtEnd(end);
+        chain->m_size += end;
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+#ifdef NS3_MTP
+    // another thread may extend the dirty area of shared data concurrently
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+#endif
     if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
     {
         /* enough space in buffer and not dirty
@@ -368,8 +553,7 @@ Buffer::AddAtEnd(uint32_t end)
         uint32_t newSize = GetInternalSize() + end;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -396,39 +580,144 @@ Buffer::AddAtEnd(const Buffer& o)
 {
     NS_LOG_FUNCTION(this << &o);
 
-    if (m_data->m_count == 1 && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
-        m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart &&
-        o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
+    if (m_chain != nullptr || o.m_chain != nullptr)
     {
-        /**
-         * This is an optimization which kicks in when
-         * we attempt to aggregate two buffers which contain
-         * adjacent zero areas.
+        ChainAtEnd(o);
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
+    if ((m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
+        o.m_start == o.m_zeroAreaStart && o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
+    {
+        uint32_t endData = o.m_end - o.m_zeroAreaEnd;
+        bool owned = m_data->m_count == 1 && m_end == m_data->m_dirtyEnd;
+#ifdef NS3_MTP
+        bool shared = false;
+#else
+        // The zero area takes no room in the data: when there is no byte
+        // to write, the data can remain shared with other buffers.
+        bool shared = endData == 0;
+#endif
+        if (owned || shared)
+        {
+            /**
+             * This is an optimization which kicks in when
+             * we attempt to aggregate two buffers which contain
+             * adjacent zero areas.
+             */
+            if (m_zeroAreaStart == m_zeroAreaEnd)
+            {
+                m_zeroAreaStart = m_end;
+            }
+            uint32_t zeroSize = o.m_zeroAreaEnd - o.m_zeroAreaStart;
+            m_zeroAreaEnd = m_end + zeroSize;
+            m_end = m_zeroAreaEnd;
+            if (!owned)
+            {
+                // The other buffers must not write after their end anymore,
+                // nor this one after its new end
+                m_data->m_dirtyEnd = std::numeric_limits<uint32_t>::max();
+                m_maxZeroAreaStart = std::max(m_maxZeroAreaStart, m_zeroAreaStart);
+                NS_ASSERT(CheckInternalState());
+                return;
+            }
+            m_data->m_dirtyEnd = m_zeroAreaEnd;
+            AddAtEnd(endData);
+            Buffer::Iterator dst = End();
+            dst.Prev(endData);
+            Buffer::Iterator src = o.End();
+            src.Prev(endData);
+            dst.Write(src, o.End());
+            NS_ASSERT(CheckInternalState());
+            return;
+        }
+    }
+
+    if (g_enableScatterGather && o.GetSize() >= SCATTER_GATHER_MIN)
+    {
+        if (GetSize() == 0)
+        {
+            *this = o;
+        }
+        else
+        {
+            ChainAtEnd(o);
+        }
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
+    // A buffer has a single zero area: keep the largest one virtual, and
+    // write the bytes of the other one.  The buffers may share their data,
+    // or be the same buffer.
+    Buffer src = o;
+    uint32_t size = GetSize();
+    if (src.m_zeroAreaEnd - src.m_zeroAreaStart > m_zeroAreaEnd - m_zeroAreaStart)
+    {
+        Buffer dst = src;
+        dst.AddAtStart(size);
+        g_allocationStatistics.zeroBytes += m_zeroAreaEnd - m_zeroAreaStart;
+        CopyData(dst.m_data->m_data + dst.m_start, size);
+        *this = dst;
+    }
+    else
+    {
+        uint32_t srcSize = src.GetSize();
+        AddAtEnd(srcSize);
+        g_allocationStatistics.zeroBytes += src.m_zeroAreaEnd - src.m_zeroAreaStart;
+        src.CopyData(m_data->m_data + GetInternalEnd() - srcSize, srcSize);
+    }
+    NS_ASSERT(CheckInternalState());
+}
+
+void
+Buffer::AddZeroesAtEnd(uint32_t end)
+{
+    NS_LOG_FUNCTION(this << end);
+    NS_ASSERT(CheckInternalState());
+    if (m_chain != nullptr)
+    {
+        Chain* chain = GetOwnedChain();
+        chain->m_segments.back().AddZeroesAtEnd(end);
+        chain->m_size += end;
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+    bool owned = m_data->m_count == 1 && m_end == m_data->m_dirtyEnd;
+#ifdef NS3_MTP
+    bool shared = false;
+#else
+    // The zero area takes no room in the data, which can remain shared
+    bool shared = true;
+#endif
+    if ((owned || shared) && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd))
+    {
+        /* extend the zero area
+         * Add:    |...|
+         * Before: |**----|
+         * After:  |**-------|
          */
         if (m_zeroAreaStart == m_zeroAreaEnd)
         {
             m_zeroAreaStart = m_end;
         }
-        uint32_t zeroSize = o.m_zeroAreaEnd - o.m_zeroAreaStart;
-        m_zeroAreaEnd = m_end + zeroSize;
+        m_zeroAreaEnd = m_end + end;
         m_end = m_zeroAreaEnd;
-        m_data->m_dirtyEnd = m_zeroAreaEnd;
-        uint32_t endData = o.m_end - o.m_zeroAreaEnd;
-        AddAtEnd(endData);
-        Buffer::Iterator dst = End();
-        dst.Prev(endData);
-        Buffer::Iterator src = o.End();
-        src.Prev(endData);
-        dst.Write(src, o.End());
-        NS_ASSERT(CheckInternalState());
-        return;
+        // When the data is shared, the other buffers must not write after
+        // their end anymore, nor this one after its new end
+        m_data->m_dirtyEnd = owned ? m_end : std::numeric_limits<uint32_t>::max();
+        m_maxZeroAreaStart = std::max(m_maxZeroAreaStart, m_zeroAreaStart);
     }
-
-    *this = CreateFullCopy();
-    AddAtEnd(o.GetSize());
-    Buffer::Iterator destStart = End();
-    destStart.Prev(o.GetSize());
-    destStart.Write(o.Begin(), o.End());
+    else
+    {
+        AddAtEnd(end);
+        Buffer::Iterator i = End();
+        i.Prev(end);
+        i.WriteU8(0, end);
+        g_allocationStatistics.zeroBytes += end;
+    }
+    LOG_INTERNAL_STATE("add zeroes end=" << end << ", ");
     NS_ASSERT(CheckInternalState());
 }
 
@@ -437,6 +726,41 @@ Buffer::RemoveAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
+    if (m_chain != nullptr && start >= m_end - m_start)
+    {
+        /* remove the bytes preceding the chain and the first buffers
+         * of the chain: the first buffer left precedes the others.
+         */
+        start -= m_end - m_start;
+        const std::vector<Buffer>& segments = m_chain->m_segments;
+        std::size_t first = 0;
+        while (first < segments.size() && start >= segments[first].GetSize())
+        {
+            start -= segments[first].GetSize();
+            first++;
+        }
+        if (first == segments.size())
+        {
+            ReleaseChain();
+            start = m_end - m_start;
+        }
+        else
+        {
+            Buffer head = segments[first];
+            std::vector<Buffer> rest(segments.begin() + first + 1, segments.end());
+            ReleaseChain();
+            *this = head;
+            if (!rest.empty())
+            {
+                uint32_t size = 0;
+                for (const auto& segment : rest)
+                {
+                    size += segment.GetSize();
+                }
+                m_chain = new Chain{1, size, std::move(rest), std::nullopt, std::nullopt};
+            }
+        }
+    }
     uint32_t newStart = m_start + start;
     if (newStart <= m_zeroAreaStart)
     {
@@ -483,6 +807,31 @@ Buffer::RemoveAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
+    if (m_chain != nullptr)
+    {
+        if (end == 0)
+        {
+            return;
+        }
+        if (end < m_chain->m_size)
+        {
+            /* remove the last buffers of the chain, and the end of the
+             * last buffer left
+             */
+            Chain* chain = GetOwnedChain();
+            chain->m_size -= end;
+            while (end >= chain->m_segments.back().GetSize())
+            {
+                end -= chain->m_segments.back().GetSize();
+                chain->m_segments.pop_back();
+            }
+            chain->m_segments.back().RemoveAtEnd(end);
+            NS_ASSERT(CheckInternalState());
+            return;
+        }
+        end -= m_chain->m_size;
+        ReleaseChain();
+    }
     uint32_t newEnd = m_end - std::min(end, m_end - m_start);
     if (newEnd > m_zeroAreaEnd)
     {
@@ -519,6 +868,32 @@ Buffer::CreateFragment(uint32_t start, uint32_t length) const
 {
     NS_LOG_FUNCTION(this << start << length);
     NS_ASSERT(CheckInternalState());
+    if (m_chain != nullptr)
+    {
+        // a fragment of a single buffer of the chain needs no chain
+        uint32_t headSize = m_end - m_start;
+        if (start + length <= headSize)
+        {
+            return CopyHead().CreateFragment(start, length);
+        }
+        if (start >= headSize)
+        {
+            uint32_t offset = start - headSize;
+            for (const auto& segment : m_chain->m_segments)
+            {
+                uint32_t size = segment.GetSize();
+                if (offset + length <= size)
+                {
+                    return segment.CreateFragment(offset, length);
+                }
+                if (offset < size)
+                {
+                    break;
+                }
+                offset -= size;
+            }
+        }
+    }
     Buffer tmp = *this;
     tmp.RemoveAtStart(start);
     tmp.RemoveAtEnd(GetSize() - (start + length));
@@ -533,6 +908,7 @@ Buffer::CreateFullCopy() const
     NS_ASSERT(CheckInternalState());
     if (m_zeroAreaEnd - m_zeroAreaStart != 0)
     {
+        g_allocationStatistics.zeroBytes += m_zeroAreaEnd - m_zeroAreaStart;
         Buffer tmp;
         tmp.AddAtStart(m_zeroAreaEnd - m_zeroAreaStart);
         tmp.Begin().WriteU8(0, m_zeroAreaEnd - m_zeroAreaStart);
@@ -555,6 +931,10 @@ uint32_t
 Buffer::GetSerializedSize() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_chain != nullptr)
+    {
+        Flatten();
+    }
     uint32_t dataStart = (m_zeroAreaStart - m_start + 3) & (~0x3);
     uint32_t dataEnd = (m_end - m_zeroAreaEnd + 3) & (~0x3);
 
@@ -571,6 +951,10 @@ uint32_t
 Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
 {
     NS_LOG_FUNCTION(this << &buffer << maxSize);
+    if (m_chain != nullptr)
+    {
+        Flatten();
+    }
     auto p = reinterpret_cast<uint32_t*>(buffer);
     uint32_t size = 0;
 
@@ -693,6 +1077,10 @@ Buffer::PeekData() const
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
+    if (m_chain != nullptr)
+    {
+        Flatten();
+    }
     TransformIntoRealBuffer();
     NS_ASSERT(CheckInternalState());
     return m_data->m_data + m_start;
@@ -702,6 +1090,19 @@ void
 Buffer::CopyData(std::ostream* os, uint32_t size) const
 {
     NS_LOG_FUNCTION(this << &os << size);
+    if (m_chain != nullptr)
+    {
+        uint32_t headSize = std::min(size, m_end - m_start);
+        CopyHead().CopyData(os, headSize);
+        size -= headSize;
+        for (const auto& segment : m_chain->m_segments)
+        {
+            uint32_t segmentSize = std::min(size, segment.GetSize());
+            segment.CopyData(os, segmentSize);
+            size -= segmentSize;
+        }
+        return;
+    }
     if (size > 0)
     {
         uint32_t tmpsize = std::min(m_zeroAreaStart - m_start, size);
@@ -731,6 +1132,15 @@ uint32_t
 Buffer::CopyData(uint8_t* buffer, uint32_t size) const
 {
     NS_LOG_FUNCTION(this << &buffer << size);
+    if (m_chain != nullptr)
+    {
+        uint32_t copied = CopyHead().CopyData(buffer, size);
+        for (const auto& segment : m_chain->m_segments)
+        {
+            copied += segment.CopyData(buffer + copied, size - copied);
+        }
+        return copied;
+    }
     uint32_t originalSize = size;
     if (size > 0)
     {
@@ -821,27 +1231,33 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
     NS_ASSERT(m_data != start.m_data);
     uint32_t size = end.m_current - start.m_current;
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    // the bytes written are all before or all after the zero area of this buffer
+    uint8_t* to = &m_data[m_current];
+    if (m_current > m_zeroStart)
+    {
+        to -= m_zeroEnd - m_zeroStart;
+    }
+    m_current += size;
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        memset(to, 0, toCopy);
+        g_allocationStatistics.zeroBytes += toCopy;
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
     memcpy(to, from, toCopy);
-    m_current += toCopy;
 }
 
 void
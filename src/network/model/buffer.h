@@ -8,14 +8,16 @@
 #ifndef BUFFER_H
 #define BUFFER_H
 
+#include "size-class-pool.h"
+
 #include "ns3/assert.h"
 
+#include <atomic>
+#include <optional>
 #include <ostream>
 #include <stdint.h>
 #include <vector>
 
-#define BUFFER_FREE_LIST 1
-
 namespace ns3
 {
 
@@ -78,6 +80,13 @@ namespace ns3
  * @endverbatim
  *
  * A simple state invariant is that m_start <= m_zeroStart <= m_zeroEnd <= m_end
+ *
+ * When the scatter-gather mode is enabled (see EnableScatterGather), a
+ * buffer appended with AddAtEnd is not copied but referenced by a chain
+ * of buffers which follow the bytes described above.  The chain is shared
+ * by the copies of the buffer, trimmed by reference when bytes are
+ * removed, and flattened into a single data storage only when an Iterator
+ * or the data of the buffer is requested.
  */
 class Buffer
 {
@@ -500,6 +509,16 @@ class Buffer
      * pointing to this Buffer.
      */
     void AddAtStart(uint32_t start);
+    /**
+     * @param start size to reserve
+     * @return a pointer to the bytes added
+     *
+     * Add bytes at the start of the Buffer, as AddAtStart(). The
+     * bytes added are always stored contiguously, and can be written
+     * through the pointer returned until the next call to a method
+     * of this Buffer.
+     */
+    uint8_t* AddAtStartContiguous(uint32_t start);
     /**
      * @param end size to reserve
      *
@@ -510,6 +529,16 @@ class Buffer
      * pointing to this Buffer.
      */
     void AddAtEnd(uint32_t end);
+    /**
+     * @param end number of zero bytes to add
+     *
+     * Add zero bytes at the end of the Buffer.  When the
+     * Buffer ends with its zero area, the zero area is
+     * extended without writing any byte.
+     * Any call to this method invalidates any Iterator
+     * pointing to this Buffer.
+     */
+    void AddZeroesAtEnd(uint32_t end);
 
     /**
      * @param o the buffer to append to the end of this buffer.
@@ -548,11 +577,15 @@ class Buffer
     /**
      * @return an Iterator which points to the
      * start of this Buffer.
+     *
+     * A chained Buffer is flattened first.
      */
     inline Buffer::Iterator Begin() const;
     /**
      * @return an Iterator which points to the
      * end of this Buffer.
+     *
+     * A chained Buffer is flattened first.
      */
     inline Buffer::Iterator End() const;
 
@@ -633,6 +666,83 @@ class Buffer
     Buffer(uint32_t dataSize, bool initialize);
     ~Buffer();
 
+    /**
+     * Statistics on the memory used by the buffers.
+     */
+    struct AllocationStatistics
+    {
+        uint64_t allocations;     //!< Number of data storages created, from the pool or not
+        uint64_t heapAllocations; //!< Number of data storages allocated on the heap
+        uint64_t allocatedBytes;  //!< Number of bytes of the storages created
+        uint64_t zeroBytes;       //!< Number of bytes of zero areas written in a storage
+    };
+
+    /**
+     * @brief Get the statistics on the memory used by the buffers
+     *
+     * The statistics are kept by each thread.
+     *
+     * @returns the statistics since the last reset
+     */
+    static AllocationStatistics GetAllocationStatistics();
+    /**
+     * @brief Reset the statistics on the memory used by the buffers
+     */
+    static void ResetAllocationStatistics();
+
+    /**
+     * @brief Get the statistics on the pool of the data storages
+     *
+     * The data storages are recycled through a pool owned by each thread,
+     * whose statistics are returned for the calling thread.
+     *
+     * @returns the statistics since the last reset
+     */
+    static SizeClassPool::Statistics GetPoolStatistics();
+    /**
+     * @brief Reset the statistics on the pool of the data storages
+     */
+    static void ResetPoolStatistics();
+    /**
+     * @brief Set the maximum number of data storages cached
+     *
+     * The value applies to the pools of all the threads, for each size
+     * class, and each pool caches at most SizeClassPool::BUDGET_PER_BLOCK
+     * bytes per block of this value.  The default is 1000.
+     *
+     * @param blocks the maximum number of data storages of a size class
+     */
+    static void SetPoolHighWaterMark(uint32_t blocks);
+    /**
+     * @brief Free the data storages cached by the pool of the calling thread
+     */
+    static void ClearPool();
+    /**
+     * @brief Enable the scatter-gather mode of the buffers.
+     *
+     * In this mode, AddAtEnd appends a buffer of at least
+     * SCATTER_GATHER_MIN bytes by reference to a chain of buffers instead
+     * of copying its bytes, RemoveAtStart, RemoveAtEnd and CreateFragment
+     * slice the chain by reference, and CopyData reads the chain in place.
+     * The chain is flattened into a single data storage the first time an
+     * Iterator (Begin or End), PeekData or the serialized buffer is
+     * requested; the copies of a buffer sharing the same chain and the
+     * same leading bytes share the flattened storage.
+     *
+     * The mode is not used by the multithreaded simulator, since the
+     * chains are shared without synchronization.
+     */
+    static void EnableScatterGather();
+    /**
+     * @brief Disable the scatter-gather mode of the buffers.
+     *
+     * The buffers chained already keep their chain.
+     */
+    static void DisableScatterGather();
+
+    /// The size of the smallest buffer chained in the scatter-gather mode
+    static constexpr uint32_t SCATTER_GATHER_MIN = 256;
+
   private:
     /**
      * This data structure is variable-sized through its last member whose size
@@ -654,7 +764,11 @@ class Buffer
          * The reference count of an instance of this data structure.
          * Each buffer which references an instance holds a count.
          */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /**
          * the size of the m_data field below.
          */
@@ -669,6 +783,11 @@ class Buffer
          * end of the area in which user bytes were written.
          */
         uint32_t m_dirtyEnd;
+        /**
+         * The slot of the creator of this instance, if it is accounted by
+         * PacketAccounting, or zero.
+         */
+        uint32_t m_accounting;
         /**
          * The real data buffer holds _at least_ one byte.
          * Its real size is stored in the m_size field.
@@ -676,6 +795,42 @@ class Buffer
         uint8_t m_data[1];
     };
 
+    /**
+     * The buffers chained after the bytes of a buffer in the scatter-gather
+     * mode.  A chain is shared by the copies of a buffer, and copied
+     * before being modified if it is shared.
+     */
+    struct Chain;
+
+    /**
+     * @brief Get a copy of the buffer without its chain
+     * @returns the bytes of the buffer which precede its chain
+     */
+    Buffer CopyHead() const;
+    /**
+     * @brief Release the chain of the buffer, and remove its bytes
+     */
+    void ReleaseChain();
+    /**
+     * @brief Get the chain of the buffer, creating it or copying it if it is
+     * shared, for modification
+     * @returns the chain, which only this buffer references
+     */
+    Chain* GetOwnedChain();
+    /**
+     * @brief Append a buffer to the chain of this buffer
+     * @param o the buffer to append
+     */
+    void ChainAtEnd(const Buffer& o);
+    /**
+     * @brief Copy the bytes of the chain after the bytes of the buffer
+     *
+     * This changes the representation of the buffer, but not its bytes,
+     * which is why the const accessors which need contiguous bytes may
+     * call it: the members of the representation are mutable.
+     */
+    void Flatten() const;
+
     /**
      * @brief Create a full copy of the buffer, including
      * all the internal structures.
@@ -724,23 +879,16 @@ class Buffer
     static void Recycle(Buffer::Data* data);
     /**
      * @brief Create a buffer data storage
-     * @param size the storage size to create
-     * @returns a pointer to the created buffer storage
-     */
-    static Buffer::Data* Create(uint32_t size);
-    /**
-     * @brief Allocate a buffer data storage
      * @param reqSize the storage size to create
-     * @returns a pointer to the allocated buffer storage
-     */
-    static Buffer::Data* Allocate(uint32_t reqSize);
-    /**
-     * @brief Deallocate the buffer memory
-     * @param data the buffer data storage
+     * @returns a pointer to the created buffer storage
      */
-    static void Deallocate(Buffer::Data* data);
+    static Buffer::Data* Create(uint32_t reqSize);
 
-    Data* m_data; //!< the buffer data storage
+    // The data members below are mutable since Flatten() replaces a chained
+    // buffer by an equivalent flat buffer from the const accessors.
+
+    mutable Data* m_data;   //!< the buffer data storage
+    mutable Chain* m_chain; //!< the buffers chained after the data, if any
 
     /**
      * keep track of the maximum value of m_zeroAreaStart across
@@ -752,49 +900,58 @@ class Buffer
      * the Buffer constructor to choose an initial value for
      * m_zeroAreaStart.
      */
-    uint32_t m_maxZeroAreaStart;
+    mutable uint32_t m_maxZeroAreaStart;
     /**
      * location in a newly-allocated buffer where you should start
      * writing data. i.e., m_start should be initialized to this
      * value.
      */
-    static uint32_t g_recommendedStart;
+    static thread_local uint32_t g_recommendedStart;
+
+    /** The statistics on the memory used by the buffers. */
+    static thread_local AllocationStatistics g_allocationStatistics;
+
+    /**
+     * Whether the buffers appended are chained instead of copied.
+     *
+     * Unlike the allocation heuristics above, this is not per-thread
+     * state: like Packet::EnablePrinting, it is a switch set from the
+     * main program before the simulation runs and only read afterwards,
+     * and all the threads must agree on it since a chained buffer can
+     * be handed from one thread to another. The multithreaded simulator
+     * never sets it (see EnableScatterGather).
+     */
+    static bool g_enableScatterGather;
 
     /**
      * offset to the start of the virtual zero area from the start
      * of m_data->m_data
      */
-    uint32_t m_zeroAreaStart;
+    mutable uint32_t m_zeroAreaStart;
     /**
      * offset to the end of the virtual zero area from the start
      * of m_data->m_data
      */
-    uint32_t m_zeroAreaEnd;
+    mutable uint32_t m_zeroAreaEnd;
     /**
      * offset to the start of the data referenced by this Buffer
      * instance from the start of m_data->m_data
      */
-    uint32_t m_start;
+    mutable uint32_t m_start;
     /**
      * offset to the end of the data referenced by this Buffer
      * instance from the start of m_data->m_data
      */
-    uint32_t m_end;
-
-#ifdef BUFFER_FREE_LIST
-    /// Container for buffer data
-    typedef std::vector<Buffer::Data*> FreeList;
-
-    /// Local static destructor structure
-    struct LocalStaticDestructor
-    {
-        ~LocalStaticDestructor();
-    };
+    mutable uint32_t m_end;
+};
 
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
-#endif
+struct Buffer::Chain
+{
+    uint32_t m_count;               //!< the number of buffers which reference the chain
+    uint32_t m_size;                //!< the number of bytes of the buffers chained
+    std::vector<Buffer> m_segments; //!< the buffers chained, which have no chain
+    std::optional<Buffer> m_head;   //!< the bytes preceding the chain when last flattened
+    std::optional<Buffer> m_flat;   //!< the buffer last flattened, with its chain
 };
 
 } // namespace ns3
@@ -1043,6 +1200,7 @@ Buffer::Iterator::Read(Buffer::Iterator start, uint32_t size)
 
 Buffer::Buffer(const Buffer& o)
     : m_data(o.m_data),
+      m_chain(o.m_chain),
       m_maxZeroAreaStart(o.m_zeroAreaStart),
       m_zeroAreaStart(o.m_zeroAreaStart),
       m_zeroAreaEnd(o.m_zeroAreaEnd),
@@ -1050,19 +1208,27 @@ Buffer::Buffer(const Buffer& o)
       m_end(o.m_end)
 {
     m_data->m_count++;
+    if (m_chain != nullptr)
+    {
+        m_chain->m_count++;
+    }
     NS_ASSERT(CheckInternalState());
 }
 
 uint32_t
 Buffer::GetSize() const
 {
-    return m_end - m_start;
+    return m_end - m_start + (m_chain == nullptr ? 0 : m_chain->m_size);
 }
 
 Buffer::Iterator
 Buffer::Begin() const
 {
     NS_ASSERT(CheckInternalState());
+    if (m_chain != nullptr)
+    {
+        Flatten();
+    }
     return Buffer::Iterator(this);
 }
 
@@ -1070,6 +1236,10 @@ Buffer::Iterator
 Buffer::End() const
 {
     NS_ASSERT(CheckInternalState());
+    if (m_chain != nullptr)
+    {
+        Flatten();
+    }
     return Buffer::Iterator(this, false);
 }
 
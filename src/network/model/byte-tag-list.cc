@@ -9,19 +9,54 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
 #include <cstring>
 #include <limits>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#else
+// The free list is shared by the whole process, so it is not used when
+// simulation events run concurrently in several threads.
 #define USE_FREE_LIST 1
+#endif
 #define FREE_LIST_SIZE 1000
 #define OFFSET_MAX (std::numeric_limits<int32_t>::max())
+// The size of the tags above which a range is looked up in an index
+#define INDEX_THRESHOLD 512
+// The maximum number of tags scanned in the index to look up a range
+#define INDEX_SCAN_MAX 64
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("ByteTagList");
 
+/**
+ * @ingroup packet
+ *
+ * @brief Index of the byte tags stored in a ByteTagListData.
+ *
+ * The tags are sorted by start offset, and the running maximum of their
+ * end offsets bounds the tags which can overlap a range.  The offsets
+ * are the ones stored in the data, before adjustment.
+ */
+struct ByteTagListIndex
+{
+    /// A tag of the index
+    struct Entry
+    {
+        int32_t start;   //!< offset of the first byte of the tag
+        int32_t end;     //!< offset following the last byte of the tag
+        uint32_t offset; //!< offset of the tag in the data
+    };
+
+    uint32_t used;                //!< number of bytes of the data indexed
+    std::vector<Entry> entries;   //!< the tags, sorted by start offset
+    std::vector<int32_t> maxEnds; //!< maximum end of the tags up to each entry
+};
+
 /**
  * @ingroup packet
  *
@@ -32,9 +67,14 @@ NS_LOG_COMPONENT_DEFINE("ByteTagList");
 struct ByteTagListData
 {
     uint32_t size;   //!< size of the data
-    uint32_t count;  //!< use counter (for smart deallocation)
-    uint32_t dirty;  //!< number of bytes actually in use
-    uint8_t data[4]; //!< data
+#ifdef NS3_MTP
+    std::atomic<uint32_t> count; //!< use counter (for smart deallocation)
+#else
+    uint32_t count; //!< use counter (for smart deallocation)
+#endif
+    uint32_t dirty;          //!< number of bytes actually in use
+    ByteTagListIndex* index; //!< index of the tags, if built
+    uint8_t data[4];         //!< data
 };
 
 #ifdef USE_FREE_LIST
@@ -98,6 +138,15 @@ ByteTagList::Iterator::PrepareForNext()
     NS_LOG_FUNCTION(this);
     while (m_current < m_end)
     {
+        if (m_start != nullptr)
+        {
+            if (m_nextCandidate == m_candidateCount)
+            {
+                m_current = m_end;
+                break;
+            }
+            m_current = m_start + m_candidates[m_nextCandidate++];
+        }
         TagBuffer buf = TagBuffer(m_current, m_end);
         m_nextTid = buf.ReadU32();
         m_nextSize = buf.ReadU32();
@@ -123,12 +172,39 @@ ByteTagList::Iterator::Iterator(uint8_t* start,
       m_end(end),
       m_offsetStart(offsetStart),
       m_offsetEnd(offsetEnd),
-      m_adjustment(adjustment)
+      m_adjustment(adjustment),
+      m_start(nullptr),
+      m_candidates{},
+      m_candidateCount(0),
+      m_nextCandidate(0)
 {
     NS_LOG_FUNCTION(this << &start << &end << offsetStart << offsetEnd << adjustment);
     PrepareForNext();
 }
 
+ByteTagList::Iterator::Iterator(uint8_t* start,
+                                uint8_t* end,
+                                int32_t offsetStart,
+                                int32_t offsetEnd,
+                                int32_t adjustment,
+                                const uint32_t* candidates,
+                                uint32_t count)
+    : m_current(start),
+      m_end(end),
+      m_offsetStart(offsetStart),
+      m_offsetEnd(offsetEnd),
+      m_adjustment(adjustment),
+      m_start(start),
+      m_candidates{},
+      m_candidateCount(count),
+      m_nextCandidate(0)
+{
+    NS_LOG_FUNCTION(this << &start << &end << offsetStart << offsetEnd << adjustment << count);
+    NS_ASSERT(count <= MAX_CANDIDATES);
+    std::copy(candidates, candidates + count, m_candidates);
+    PrepareForNext();
+}
+
 uint32_t
 ByteTagList::Iterator::GetOffsetStart() const
 {
@@ -141,6 +217,7 @@ ByteTagList::ByteTagList()
       m_maxEnd(INT32_MIN),
       m_adjustment(0),
       m_used(0),
+      m_last(0),
       m_data(nullptr)
 {
     NS_LOG_FUNCTION(this);
@@ -151,6 +228,7 @@ ByteTagList::ByteTagList(const ByteTagList& o)
       m_maxEnd(o.m_maxEnd),
       m_adjustment(o.m_adjustment),
       m_used(o.m_used),
+      m_last(o.m_last),
       m_data(o.m_data)
 {
     NS_LOG_FUNCTION(this << &o);
@@ -174,6 +252,7 @@ ByteTagList::operator=(const ByteTagList& o)
     m_adjustment = o.m_adjustment;
     m_data = o.m_data;
     m_used = o.m_used;
+    m_last = o.m_last;
     if (m_data != nullptr)
     {
         m_data->count++;
@@ -200,7 +279,12 @@ ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
         m_data = Allocate(spaceNeeded);
         m_used = 0;
     }
+#ifdef NS3_MTP
+    // another thread may append to shared data concurrently
+    else if (m_data->size < spaceNeeded || m_data->count != 1)
+#else
     else if (m_data->size < spaceNeeded || (m_data->count != 1 && m_data->dirty != m_used))
+#endif
     {
         ByteTagListData* newData = Allocate(spaceNeeded);
         std::memcpy(&newData->data, &m_data->data, m_used);
@@ -220,6 +304,7 @@ ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
     {
         m_maxEnd = end - m_adjustment;
     }
+    m_last = m_used;
     m_used = spaceNeeded;
     m_data->dirty = m_used;
     return tag;
@@ -229,13 +314,53 @@ void
 ByteTagList::Add(const ByteTagList& o)
 {
     NS_LOG_FUNCTION(this << &o);
+    // the last tag may be extended by the first tag of o
+    uint32_t last = m_used != 0 ? m_last : m_used;
     ByteTagList::Iterator i = o.BeginAll();
     while (i.HasNext())
     {
         ByteTagList::Iterator::Item item = i.Next();
+        uint32_t next = m_used;
         TagBuffer buf = Add(item.tid, item.size, item.start, item.end);
         buf.CopyFrom(item.buf);
+        if (last == next || !Coalesce(last, next))
+        {
+            last = next;
+        }
+    }
+}
+
+bool
+ByteTagList::Coalesce(uint32_t last, uint32_t next)
+{
+    NS_LOG_FUNCTION(this << last << next);
+    if (m_data->count != 1)
+    {
+        // the last tag is seen by the other lists sharing the data
+        return false;
+    }
+    TagBuffer lastBuf = TagBuffer(&m_data->data[last], &m_data->data[next]);
+    TagBuffer nextBuf = TagBuffer(&m_data->data[next], &m_data->data[m_used]);
+    uint32_t lastTid = lastBuf.ReadU32();
+    uint32_t lastSize = lastBuf.ReadU32();
+    lastBuf.ReadU32();
+    int32_t lastEnd = lastBuf.ReadU32();
+    uint32_t nextTid = nextBuf.ReadU32();
+    uint32_t nextSize = nextBuf.ReadU32();
+    int32_t nextStart = nextBuf.ReadU32();
+    int32_t nextEnd = nextBuf.ReadU32();
+    if (lastTid != nextTid || lastSize != nextSize || lastEnd != nextStart ||
+        std::memcmp(&m_data->data[last + 16], &m_data->data[next + 16], lastSize) != 0)
+    {
+        return false;
     }
+    TagBuffer(&m_data->data[last + 12], &m_data->data[last + 16]).WriteU32(nextEnd);
+    m_used = next;
+    m_last = last;
+    m_data->dirty = m_used;
+    delete m_data->index;
+    m_data->index = nullptr;
+    return true;
 }
 
 void
@@ -248,6 +373,7 @@ ByteTagList::RemoveAll()
     m_adjustment = 0;
     m_data = nullptr;
     m_used = 0;
+    m_last = 0;
 }
 
 ByteTagList::Iterator
@@ -267,10 +393,100 @@ ByteTagList::Begin(int32_t offsetStart, int32_t offsetEnd) const
     {
         return Iterator(nullptr, nullptr, offsetStart, offsetEnd, 0);
     }
-    else
+#ifndef NS3_MTP
+    // the index is shared by the lists sharing the data, so it is not
+    // built when simulation events run concurrently in several threads.
+    // offsets of the range before adjustment
+    int64_t start = static_cast<int64_t>(offsetStart) - m_adjustment;
+    int64_t end = static_cast<int64_t>(offsetEnd) - m_adjustment;
+    if (m_used >= INDEX_THRESHOLD && (start > m_minStart || end < m_maxEnd))
+    {
+        const ByteTagListIndex& index = GetIndex();
+        auto first = std::partition_point(index.maxEnds.begin(),
+                                          index.maxEnds.end(),
+                                          [start](int32_t maxEnd) { return maxEnd <= start; }) -
+                     index.maxEnds.begin();
+        auto last = std::partition_point(index.entries.begin() + first,
+                                         index.entries.end(),
+                                         [end](const ByteTagListIndex::Entry& entry) {
+                                             return entry.start < end;
+                                         }) -
+                    index.entries.begin();
+        if (last - first <= INDEX_SCAN_MAX)
+        {
+            uint32_t candidates[Iterator::MAX_CANDIDATES];
+            uint32_t count = 0;
+            for (auto k = first; k < last; k++)
+            {
+                if (index.entries[k].end > start)
+                {
+                    if (count == Iterator::MAX_CANDIDATES)
+                    {
+                        count++;
+                        break;
+                    }
+                    candidates[count++] = index.entries[k].offset;
+                }
+            }
+            if (count <= Iterator::MAX_CANDIDATES)
+            {
+                // iterate the tags in the order in which they were added
+                std::sort(candidates, candidates + count);
+                return Iterator(m_data->data,
+                                &m_data->data[m_used],
+                                offsetStart,
+                                offsetEnd,
+                                m_adjustment,
+                                candidates,
+                                count);
+            }
+        }
+    }
+#endif
+    return Iterator(m_data->data, &m_data->data[m_used], offsetStart, offsetEnd, m_adjustment);
+}
+
+const ByteTagListIndex&
+ByteTagList::GetIndex() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_data != nullptr);
+    ByteTagListIndex* index = m_data->index;
+    if (index != nullptr && index->used == m_used)
+    {
+        return *index;
+    }
+    if (index == nullptr)
+    {
+        index = new ByteTagListIndex;
+        m_data->index = index;
+    }
+    // the lists sharing the data may use different prefixes of it
+    index->used = m_used;
+    index->entries.clear();
+    for (uint32_t current = 0; current < m_used;)
+    {
+        TagBuffer buf = TagBuffer(&m_data->data[current], &m_data->data[m_used]);
+        buf.ReadU32();
+        uint32_t size = buf.ReadU32();
+        int32_t start = buf.ReadU32();
+        int32_t end = buf.ReadU32();
+        index->entries.push_back({start, end, current});
+        current += 4 + 4 + 4 + 4 + size;
+    }
+    std::stable_sort(index->entries.begin(),
+                     index->entries.end(),
+                     [](const ByteTagListIndex::Entry& a, const ByteTagListIndex::Entry& b) {
+                         return a.start < b.start;
+                     });
+    index->maxEnds.resize(index->entries.size());
+    int32_t maxEnd = INT32_MIN;
+    for (std::size_t k = 0; k < index->entries.size(); k++)
     {
-        return Iterator(m_data->data, &m_data->data[m_used], offsetStart, offsetEnd, m_adjustment);
+        maxEnd = std::max(maxEnd, index->entries[k].end);
+        index->maxEnds[k] = maxEnd;
     }
+    return *index;
 }
 
 void
@@ -353,6 +569,7 @@ ByteTagList::Allocate(uint32_t size)
         {
             data->count = 1;
             data->dirty = 0;
+            data->index = nullptr;
             return data;
         }
         auto buffer = (uint8_t*)data;
@@ -363,6 +580,7 @@ ByteTagList::Allocate(uint32_t size)
     data->count = 1;
     data->size = size;
     data->dirty = 0;
+    data->index = nullptr;
     return data;
 }
 
@@ -375,9 +593,10 @@ ByteTagList::Deallocate(ByteTagListData* data)
         return;
     }
     g_maxSize = std::max(g_maxSize, data->size);
-    data->count--;
-    if (data->count == 0)
+    if (--data->count == 0)
     {
+        delete data->index;
+        data->index = nullptr;
         if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
         {
             auto buffer = (uint8_t*)data;
@@ -401,6 +620,7 @@ ByteTagList::Allocate(uint32_t size)
     data->count = 1;
     data->size = size;
     data->dirty = 0;
+    data->index = nullptr;
     return data;
 }
 
@@ -412,9 +632,9 @@ ByteTagList::Deallocate(ByteTagListData* data)
     {
         return;
     }
-    data->count--;
-    if (data->count == 0)
+    if (--data->count == 0)
     {
+        delete data->index;
         uint8_t* buffer = (uint8_t*)data;
         delete[] buffer;
     }
@@ -19,6 +19,7 @@ namespace ns3
 {
 
 struct ByteTagListData;
+struct ByteTagListIndex;
 
 /**
  * @ingroup packet
@@ -50,6 +51,14 @@ struct ByteTagListData;
  *     the boundaries before returning item. However, when packet is extending,
  *     it calls ByteTagList::AddAtStart or ByteTagList::AddAtEnd to cut byte
  *     tags that will otherwise cover new bytes.
+ *   - When a list holds many tags, and only a part of them is iterated,
+ *     an index of the tags sorted by start offset is built and shared by
+ *     the copies of the list, to find the tags which overlap the range
+ *     iterated without walking the whole buffer.  The tags are iterated
+ *     in the order in which they were added, with or without an index.
+ *   - When a list is aggregated at the end of another, a tag identical to
+ *     the last tag of the list, and which starts where it ends, extends it
+ *     instead of being added.
  */
 class ByteTagList
 {
@@ -127,10 +136,32 @@ class ByteTagList
                  int32_t offsetEnd,
                  int32_t adjustment);
 
+        /**
+         * @brief Constructor of an iterator on a subset of the tags
+         * @param start Starting tag
+         * @param end End tag
+         * @param offsetStart offset to the start of the tag from the virtual byte buffer
+         * @param offsetEnd offset to the end of the tag from the virtual byte buffer
+         * @param adjustment adjustment to byte tag offsets
+         * @param candidates offsets of the tags to iterate from start, in increasing order
+         * @param count number of candidates, at most MAX_CANDIDATES
+         */
+        Iterator(uint8_t* start,
+                 uint8_t* end,
+                 int32_t offsetStart,
+                 int32_t offsetEnd,
+                 int32_t adjustment,
+                 const uint32_t* candidates,
+                 uint32_t count);
+
         /**
          * @brief Prepare the iterator for the next tag
          */
         void PrepareForNext();
+
+        /// The maximum number of tags iterated through an index
+        static constexpr uint32_t MAX_CANDIDATES = 8;
+
         uint8_t* m_current;    //!< Current tag
         uint8_t* m_end;        //!< End tag
         int32_t m_offsetStart; //!< Offset to the start of the tag from the virtual byte buffer
@@ -140,6 +171,10 @@ class ByteTagList
         uint32_t m_nextSize;   //!< Size of the next tag
         int32_t m_nextStart;   //!< Start of the next tag
         int32_t m_nextEnd;     //!< End of the next tag
+        uint8_t* m_start;      //!< First tag, when iterating candidates
+        uint32_t m_candidates[MAX_CANDIDATES]; //!< Offsets of the tags to iterate
+        uint32_t m_candidateCount;             //!< Number of tags to iterate, if m_start is set
+        uint32_t m_nextCandidate;              //!< Index of the next tag to iterate
     };
 
     ByteTagList();
@@ -259,6 +294,21 @@ class ByteTagList
      */
     ByteTagList::Iterator BeginAll() const;
 
+    /**
+     * @brief Get the index of the tags, building it if needed
+     * @returns the index of the m_used bytes of the data
+     */
+    const ByteTagListIndex& GetIndex() const;
+
+    /**
+     * @brief Extend the last tag of the list with the tag which follows it,
+     * if they are identical and contiguous
+     * @param last offset of the last tag
+     * @param next offset of the tag added after the last tag
+     * @returns true if the tag added was removed
+     */
+    bool Coalesce(uint32_t last, uint32_t next);
+
     /**
      * @brief Allocate the memory for the ByteTagListData
      * @param size the memory to allocate
@@ -276,6 +326,7 @@ class ByteTagList
     int32_t m_maxEnd;        //!< maximal end offset
     int32_t m_adjustment;    //!< adjustment to byte tag offsets
     uint32_t m_used;         //!< the number of used bytes in the buffer
+    uint32_t m_last;         //!< the offset of the last tag in the buffer, if any
     ByteTagListData* m_data; //!< the ByteTagListData structure
 };
 
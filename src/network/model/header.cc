@@ -8,6 +8,7 @@
 
 #include "header.h"
 
+#include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
 namespace ns3
@@ -29,6 +30,45 @@ Header::GetTypeId()
     return tid;
 }
 
+bool
+Header::SerializeContiguous(uint8_t* start, uint32_t size) const
+{
+    return false;
+}
+
+Header*
+Header::CopyHeader() const
+{
+    return nullptr;
+}
+
+bool
+Header::AssignHeader(const Header& header)
+{
+    NS_FATAL_ERROR("Header " << GetInstanceTypeId().GetName() << " cannot be assigned");
+    return false;
+}
+
+uint16_t
+Header::CalculateIpChecksum(const uint8_t* start, uint16_t size)
+{
+    /* see RFC 1071 to understand this code. */
+    uint32_t sum = 0;
+    for (uint16_t j = 0; j + 1 < size; j += 2)
+    {
+        sum += start[j] | (start[j + 1] << 8);
+    }
+    if (size & 1)
+    {
+        sum += start[size - 1];
+    }
+    while (sum >> 16)
+    {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return ~sum;
+}
+
 std::ostream&
 operator<<(std::ostream& os, const Header& header)
 {
@@ -60,6 +60,21 @@ class Header : public Chunk
      * header in a real network.
      */
     virtual void Serialize(Buffer::Iterator start) const = 0;
+    /**
+     * @param start a pointer to the GetSerializedSize() contiguous bytes
+     *        where the header should be written.
+     * @param size the number of bytes from start to the end of the packet,
+     *        header included.
+     * @returns true if the header was written, false if it must be written
+     *          by Serialize(Buffer::Iterator).
+     *
+     * This method is used by Packet::AddHeader to store a header without
+     * the bounds checks of Buffer::Iterator, when the bytes of the header
+     * are stored contiguously.  The data written must match bit-for-bit
+     * the data written by Serialize(Buffer::Iterator).  The default
+     * implementation returns false.
+     */
+    virtual bool SerializeContiguous(uint8_t* start, uint32_t size) const;
     /**
      * @param start an iterator which points to where the header should
      *        read from.
@@ -91,6 +106,105 @@ class Header : public Chunk
      * i.e.: (field1 val1 field2 val2 field3 val3) field4 val4 field5 val5
      */
     void Print(std::ostream& os) const override = 0;
+    /**
+     * @returns a copy of this header, owned by the caller, or nullptr
+     *          if the header cannot be copied.
+     *
+     * This method is used by Packet to cache the headers deserialized
+     * by Packet::PeekHeader: only the headers which can be copied are
+     * cached.  The default implementation returns nullptr.
+     */
+    virtual Header* CopyHeader() const;
+    /**
+     * @param header a header of the same type as this header, as
+     *        returned by CopyHeader.
+     * @returns false if this header must be deserialized instead.
+     *
+     * Set the fields of this header read by Deserialize to those of
+     * another one, keeping the fields which configure Deserialize.  A
+     * header which would verify a checksum on the bytes deserialized
+     * returns false and is left unchanged.  This method must be
+     * implemented by the headers which implement CopyHeader.
+     */
+    virtual bool AssignHeader(const Header& header);
+
+  protected:
+    /**
+     * Write a byte to a contiguous region.
+     * @param start where to write
+     * @param data the byte
+     * @returns a pointer past the byte written
+     */
+    static uint8_t* WriteU8(uint8_t* start, uint8_t data)
+    {
+        *start = data;
+        return start + 1;
+    }
+
+    /**
+     * Write two bytes in network order to a contiguous region.
+     * @param start where to write
+     * @param data the bytes
+     * @returns a pointer past the bytes written
+     */
+    static uint8_t* WriteHtonU16(uint8_t* start, uint16_t data)
+    {
+        start[0] = (data >> 8) & 0xff;
+        start[1] = data & 0xff;
+        return start + 2;
+    }
+
+    /**
+     * Write four bytes in network order to a contiguous region.
+     * @param start where to write
+     * @param data the bytes
+     * @returns a pointer past the bytes written
+     */
+    static uint8_t* WriteHtonU32(uint8_t* start, uint32_t data)
+    {
+        start[0] = (data >> 24) & 0xff;
+        start[1] = (data >> 16) & 0xff;
+        start[2] = (data >> 8) & 0xff;
+        start[3] = data & 0xff;
+        return start + 4;
+    }
+
+    /**
+     * Write two bytes in little-endian order to a contiguous region.
+     * @param start where to write
+     * @param data the bytes
+     * @returns a pointer past the bytes written
+     */
+    static uint8_t* WriteHtolsbU16(uint8_t* start, uint16_t data)
+    {
+        start[0] = data & 0xff;
+        start[1] = (data >> 8) & 0xff;
+        return start + 2;
+    }
+
+    /**
+     * Write four bytes in little-endian order to a contiguous region.
+     * @param start where to write
+     * @param data the bytes
+     * @returns a pointer past the bytes written
+     */
+    static uint8_t* WriteHtolsbU32(uint8_t* start, uint32_t data)
+    {
+        start[0] = data & 0xff;
+        start[1] = (data >> 8) & 0xff;
+        start[2] = (data >> 16) & 0xff;
+        start[3] = (data >> 24) & 0xff;
+        return start + 4;
+    }
+
+    /**
+     * Compute the Internet checksum (RFC 1071) of a contiguous region, as
+     * Buffer::Iterator::CalculateIpChecksum does.
+     * @param start the first byte
+     * @param size the number of bytes
+     * @returns the checksum, in host order
+     */
+    static uint16_t CalculateIpChecksum(const uint8_t* start, uint16_t size);
 };
 
 /**
@@ -9,6 +9,7 @@
 #include "net-device.h"
 
 #include "ns3/log.h"
+#include "ns3/packet-burst.h"
 
 namespace ns3
 {
@@ -29,4 +30,19 @@ NetDevice::~NetDevice()
     NS_LOG_FUNCTION(this);
 }
 
+uint32_t
+NetDevice::SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << burst << dest << protocolNumber);
+    uint32_t sent = 0;
+    for (auto it = burst->Begin(); it != burst->End(); ++it)
+    {
+        if (Send(*it, dest, protocolNumber))
+        {
+            sent++;
+        }
+    }
+    return sent;
+}
+
 } // namespace ns3
@@ -25,6 +25,7 @@ namespace ns3
 
 class Node;
 class Channel;
+class PacketBurst;
 
 /**
  * @ingroup network
@@ -236,6 +237,25 @@ class NetDevice : public Object
      * @return whether the Send operation succeeded
      */
     virtual bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) = 0;
+    /**
+     * @param burst packets sent from above down to Network Device, in order
+     * @param dest mac address of the destination of all the packets (already resolved)
+     * @param protocolNumber identifies the type of payload contained in
+     *        the packets. Used to call the right L3Protocol when the packets
+     *        are received.
+     *
+     *  Called from higher layer to send several packets into Network Device
+     *  to the specified destination Address.  The packets are not copied.
+     *  The default implementation calls Send for each packet; devices may
+     *  override it to check their state and start the transmission once for
+     *  the whole burst.  The caller may reuse the burst once this method
+     *  returns, so devices must not keep a reference to it.
+     *
+     * @return the number of packets whose Send operation succeeded
+     */
+    virtual uint32_t SendBurst(Ptr<PacketBurst> burst,
+                               const Address& dest,
+                               uint16_t protocolNumber);
     /**
      * @param packet packet sent from above down to Network Device
      * @param source source mac address (so called "MAC spoofing")
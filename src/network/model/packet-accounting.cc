@@ -0,0 +1,218 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "packet-accounting.h"
+
+#include "ns3/log.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+
+/**
+ * @file
+ * @ingroup packet
+ * ns3::PacketAccounting implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PacketAccounting");
+
+NS_OBJECT_ENSURE_REGISTERED(PacketAccounting);
+
+bool PacketAccounting::m_enabled = false;
+uint32_t PacketAccounting::m_current = 1;
+// Not destroyed, since packets may be released by the destructors of static objects
+std::vector<PacketAccounting::Usage>& PacketAccounting::m_usage =
+    *new std::vector<PacketAccounting::Usage>;
+
+TypeId
+PacketAccounting::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::PacketAccounting")
+            .SetParent<Object>()
+            .SetGroupName("Network")
+            .AddConstructor<PacketAccounting>()
+            .AddAttribute("Interval",
+                          "The interval between two samples of the usage",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&PacketAccounting::m_interval),
+                          MakeTimeChecker(Time(1)))
+            .AddTraceSource("Usage",
+                            "The usage of a creator, reported for each creator at each sample",
+                            MakeTraceSourceAccessor(&PacketAccounting::m_usageTrace),
+                            "ns3::PacketAccounting::UsageTracedCallback");
+    return tid;
+}
+
+PacketAccounting::PacketAccounting()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PacketAccounting::~PacketAccounting()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+PacketAccounting::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_sample.Cancel();
+    m_stream = nullptr;
+    Object::DoDispose();
+}
+
+void
+PacketAccounting::Enable()
+{
+    NS_LOG_FUNCTION_NOARGS();
+#ifdef NS3_MTP
+    NS_LOG_WARN("The packets are not accounted by the multithreaded simulator");
+#else
+    m_enabled = true;
+#endif
+}
+
+PacketAccounting::Usage&
+PacketAccounting::GetSlot(uint32_t slot)
+{
+    if (slot >= m_usage.size())
+    {
+        m_usage.resize(slot + 1, Usage{0, 0, 0, 0});
+    }
+    return m_usage[slot];
+}
+
+uint32_t
+PacketAccounting::AddPacket()
+{
+    return AddPacket(m_current);
+}
+
+uint32_t
+PacketAccounting::AddPacket(uint32_t slot)
+{
+    if (slot == 0)
+    {
+        // a copy of a packet created before the accounting was enabled
+        slot = m_current;
+    }
+    Usage& usage = GetSlot(slot);
+    usage.packets++;
+    usage.peakPackets = std::max(usage.peakPackets, usage.packets);
+    return slot;
+}
+
+void
+PacketAccounting::RemovePacket(uint32_t slot)
+{
+    if (slot != 0)
+    {
+        NS_ASSERT(slot < m_usage.size() && m_usage[slot].packets > 0);
+        m_usage[slot].packets--;
+    }
+}
+
+uint32_t
+PacketAccounting::AddBytes(uint32_t bytes)
+{
+    Usage& usage = GetSlot(m_current);
+    usage.bytes += bytes;
+    usage.peakBytes = std::max(usage.peakBytes, usage.bytes);
+    return m_current;
+}
+
+void
+PacketAccounting::RemoveBytes(uint32_t slot, uint32_t bytes)
+{
+    if (slot != 0)
+    {
+        NS_ASSERT(slot < m_usage.size() && m_usage[slot].bytes >= bytes);
+        m_usage[slot].bytes -= bytes;
+    }
+}
+
+std::map<TypeId, PacketAccounting::Usage>
+PacketAccounting::GetUsage()
+{
+    std::map<TypeId, Usage> usage;
+    for (uint32_t slot = 1; slot < m_usage.size(); slot++)
+    {
+        if (m_usage[slot].peakPackets > 0 || m_usage[slot].peakBytes > 0)
+        {
+            usage[slot == 1 ? TypeId() : TypeId::GetRegistered(slot - 2)] = m_usage[slot];
+        }
+    }
+    return usage;
+}
+
+void
+PacketAccounting::ResetPeaks()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    for (auto& usage : m_usage)
+    {
+        usage.peakPackets = usage.packets;
+        usage.peakBytes = usage.bytes;
+    }
+}
+
+void
+PacketAccounting::Print(std::ostream& os)
+{
+    for (const auto& [creator, usage] : GetUsage())
+    {
+        os << (creator == TypeId() ? std::string("(none)") : creator.GetName())
+           << " packets=" << usage.packets << " bytes=" << usage.bytes
+           << " peakPackets=" << usage.peakPackets << " peakBytes=" << usage.peakBytes
+           << std::endl;
+    }
+}
+
+void
+PacketAccounting::SetStream(Ptr<OutputStreamWrapper> stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_stream = stream;
+}
+
+void
+PacketAccounting::Start()
+{
+    NS_LOG_FUNCTION(this);
+    m_sample.Cancel();
+    m_sample = Simulator::ScheduleNow(&PacketAccounting::Sample, this);
+}
+
+void
+PacketAccounting::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_sample.Cancel();
+}
+
+void
+PacketAccounting::Sample()
+{
+    NS_LOG_FUNCTION(this);
+    auto usage = GetUsage();
+    for (const auto& [creator, creatorUsage] : usage)
+    {
+        m_usageTrace(creator, creatorUsage);
+    }
+    if (m_stream)
+    {
+        std::ostream& os = *m_stream->GetStream();
+        os << "time=" << Simulator::Now().As(Time::S) << std::endl;
+        Print(os);
+    }
+    m_sample = Simulator::Schedule(m_interval, &PacketAccounting::Sample, this);
+}
+
+} // namespace ns3
@@ -0,0 +1,230 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PACKET_ACCOUNTING_H
+#define PACKET_ACCOUNTING_H
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+#include "ns3/type-id.h"
+
+#include <map>
+#include <ostream>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup packet
+ * ns3::PacketAccounting declaration.
+ */
+
+namespace ns3
+{
+
+class OutputStreamWrapper;
+
+/**
+ * @ingroup packet
+ * @brief Account the packets alive, and the memory they hold, per creator.
+ *
+ * When enabled, each Packet, and each data storage of a Buffer or of a
+ * PacketMetadata, is attributed to the creator in scope when it is
+ * allocated: the TypeId given to the innermost live PacketAccounting::Scope,
+ * or no creator if there is none.  The copies of a packet are attributed
+ * to the creator of the packet.  The number of packets and of bytes of
+ * data storage alive, and their peaks, are kept for each creator.
+ *
+ * The applications which generate traffic, and the TCP sockets for the
+ * segments they send, declare a scope.  Other models can declare one
+ * around the code which creates the packets they hold:
+ *
+ * @code
+ *   PacketAccounting::Scope scope(GetInstanceTypeId());
+ *   Ptr<Packet> packet = Create<Packet>(size);
+ * @endcode
+ *
+ * An instance of this class samples the usage periodically, reports it
+ * through the Usage trace source and, if a stream is set, prints it.
+ *
+ * The accounting is not thread safe, and is not used by the
+ * multithreaded simulator.
+ */
+class PacketAccounting : public Object
+{
+  public:
+    /**
+     * The packets and bytes attributed to a creator.
+     */
+    struct Usage
+    {
+        uint64_t packets;     //!< Number of packets alive
+        uint64_t bytes;       //!< Number of bytes of data storage alive
+        uint64_t peakPackets; //!< Largest number of packets alive
+        uint64_t peakBytes;   //!< Largest number of bytes of data storage alive
+    };
+
+    /**
+     * Attribute the packets and data storages allocated during the lifetime
+     * of this object to a creator.
+     */
+    class Scope
+    {
+      public:
+        /**
+         * Enter the scope of a creator.
+         * @param creator the TypeId of the creator
+         */
+        Scope(TypeId creator);
+        /// Restore the creator in scope before this one.
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        uint32_t m_previous; //!< The slot of the creator in scope before this one
+    };
+
+    /**
+     * TracedCallback signature for the usage of a creator.
+     * @param [in] creator The TypeId of the creator, or TypeId() if none.
+     * @param [in] usage The packets and bytes attributed to the creator.
+     */
+    typedef void (*UsageTracedCallback)(TypeId creator, const Usage& usage);
+
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    PacketAccounting();
+    ~PacketAccounting() override;
+
+    /**
+     * @brief Enable the accounting of the packets created from now on.
+     */
+    static void Enable();
+
+    /**
+     * @brief Check whether the accounting is enabled.
+     * @returns true if the packets are accounted
+     */
+    static bool IsEnabled();
+
+    /**
+     * @brief Get the usage of each creator which has been attributed packets.
+     * @returns the usage, indexed by the TypeId of the creator, or TypeId()
+     *          for the packets without creator
+     */
+    static std::map<TypeId, Usage> GetUsage();
+
+    /**
+     * @brief Set the peaks of each creator to its current usage.
+     */
+    static void ResetPeaks();
+
+    /**
+     * @brief Print the usage of each creator, one per line.
+     * @param os the output stream
+     */
+    static void Print(std::ostream& os);
+
+    /**
+     * @brief Set the stream on which the usage is printed at each sample.
+     * @param stream the output stream, or nullptr to print nothing
+     */
+    void SetStream(Ptr<OutputStreamWrapper> stream);
+
+    /**
+     * @brief Sample the usage every Interval, starting now.
+     */
+    void Start();
+
+    /**
+     * @brief Stop sampling the usage.
+     */
+    void Stop();
+
+    /**
+     * @brief Account a packet created by the creator in scope.
+     * @returns the slot of the creator, to be given to RemovePacket
+     */
+    static uint32_t AddPacket();
+    /**
+     * @brief Account a copy of a packet.
+     * @param slot the slot of the creator of the packet copied
+     * @returns the slot of the creator of the copy
+     */
+    static uint32_t AddPacket(uint32_t slot);
+    /**
+     * @brief Account the destruction of a packet.
+     * @param slot the slot returned by AddPacket, or 0 if not accounted
+     */
+    static void RemovePacket(uint32_t slot);
+    /**
+     * @brief Account a data storage allocated by the creator in scope.
+     * @param bytes the size of the data storage
+     * @returns the slot of the creator, to be given to RemoveBytes
+     */
+    static uint32_t AddBytes(uint32_t bytes);
+    /**
+     * @brief Account the release of a data storage.
+     * @param slot the slot returned by AddBytes, or 0 if not accounted
+     * @param bytes the size of the data storage
+     */
+    static void RemoveBytes(uint32_t slot, uint32_t bytes);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * @brief Get the usage of a slot, creating it if needed.
+     * @param slot the slot
+     * @returns the usage
+     */
+    static Usage& GetSlot(uint32_t slot);
+
+    /// Report and print the usage, and schedule the next sample.
+    void Sample();
+
+    static bool m_enabled;              //!< Whether the packets are accounted
+    static uint32_t m_current;          //!< The slot of the creator in scope
+    static std::vector<Usage>& m_usage; //!< The usage of each slot
+    Time m_interval;                    //!< The interval between two samples
+    EventId m_sample;                   //!< The next sample
+    Ptr<OutputStreamWrapper> m_stream;  //!< The stream on which the usage is printed
+    TracedCallback<TypeId, const Usage&> m_usageTrace; //!< The usage of each creator
+};
+
+/**
+ * The slot of a creator is its TypeId uid, plus one so that the slot 0
+ * marks the storages which are not accounted, and the slot 1 is the one
+ * of the packets without creator.
+ */
+
+inline PacketAccounting::Scope::Scope(TypeId creator)
+    : m_previous(m_current)
+{
+    m_current = creator.GetUid() + 1U;
+}
+
+inline PacketAccounting::Scope::~Scope()
+{
+    m_current = m_previous;
+}
+
+inline bool
+PacketAccounting::IsEnabled()
+{
+    return m_enabled;
+}
+
+} // namespace ns3
+
+#endif /* PACKET_ACCOUNTING_H */
@@ -9,12 +9,14 @@
 
 #include "buffer.h"
 #include "header.h"
+#include "packet-accounting.h"
 #include "trailer.h"
 
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
+#include <algorithm>
 #include <list>
 #include <utility>
 
@@ -25,20 +27,26 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
+bool PacketMetadata::m_enableFixedWidth = false;
+#ifdef NS3_MTP
+std::atomic<bool> PacketMetadata::m_metadataSkipped = false;
+std::atomic<uint16_t> PacketMetadata::m_chunkUid = 0;
+#else
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+#endif
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
 
-PacketMetadata::DataFreeList::~DataFreeList()
-{
-    NS_LOG_FUNCTION(this);
-    for (auto i = begin(); i != end(); i++)
-    {
-        PacketMetadata::Deallocate(*i);
-    }
-    PacketMetadata::m_enable = false;
-}
+/**
+ * @relates PacketMetadata
+ * The maximum number of metadata storages cached in each size class.
+ */
+static std::atomic<uint32_t> g_poolHighWaterMark = 1000;
+/**
+ * @relates PacketMetadata
+ * The pool of the metadata storages of the thread.
+ */
+static constinit thread_local SizeClassPool g_pool(&g_poolHighWaterMark);
 
 void
 PacketMetadata::Enable()
@@ -62,6 +70,27 @@ PacketMetadata::EnableChecking()
     m_enableChecking = true;
 }
 
+void
+PacketMetadata::EnableFixedWidth()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    Enable();
+    m_enableFixedWidth = true;
+}
+
+void
+PacketMetadata::DisableFixedWidth()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_enableFixedWidth = false;
+}
+
+bool
+PacketMetadata::IsFixedWidthEnabled()
+{
+    return m_enableFixedWidth;
+}
+
 void
 PacketMetadata::ReserveCopy(uint32_t size)
 {
@@ -69,8 +98,8 @@ PacketMetadata::ReserveCopy(uint32_t size)
     PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
     memcpy(newData->m_data, m_data->m_data, m_used);
     newData->m_dirtyEnd = m_used;
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    newData->m_fixedWidth = m_data->m_fixedWidth;
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -93,8 +122,13 @@ PacketMetadata::Reserve(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     NS_ASSERT(m_data != nullptr);
+#ifdef NS3_MTP
+    // another thread may append to shared data concurrently
+    if (m_data->m_size >= m_used + size && m_data->m_count == 1)
+#else
     if (m_data->m_size >= m_used + size &&
         (m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
+#endif
     {
         /* enough room, not dirty. */
     }
@@ -373,8 +407,12 @@ PacketMetadata::AddSmall(const PacketMetadata::SmallItem* item)
     uint32_t typeUidSize = GetUleb128Size(item->typeUid);
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2;
+#ifdef NS3_MTP
+    if (m_used + n > m_data->m_size || m_data->m_count != 1)
+#else
     if (m_used + n > m_data->m_size ||
         (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+#endif
     {
         ReserveCopy(n);
     }
@@ -410,8 +448,12 @@ PacketMetadata::AddBig(uint32_t next,
     uint32_t fragEndSize = GetUleb128Size(extraItem->fragmentEnd);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
+#ifdef NS3_MTP
+    if (m_used + n > m_data->m_size || m_data->m_count != 1)
+#else
     if (m_used + n > m_data->m_size ||
         (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+#endif
     {
         ReserveCopy(n);
     }
@@ -499,17 +541,246 @@ PacketMetadata::ReplaceTail(PacketMetadata::SmallItem* item,
         PacketMetadata::SmallItem tmpItem;
         PacketMetadata::ExtraItem tmpExtraItem;
         ReadItems(current, &tmpItem, &tmpExtraItem);
-        uint16_t written = h.AddBig(0xffff, h.m_tail, &tmpItem, &tmpExtraItem);
-        h.UpdateTail(written);
+        h.AppendItem(&tmpItem, &tmpExtraItem);
         current = tmpItem.next;
     }
     // append new tail.
-    uint16_t written = h.AddBig(0xffff, h.m_tail, item, extraItem);
-    h.UpdateTail(written);
+    h.AppendItem(item, extraItem);
 
     *this = h;
 }
 
+void
+PacketMetadata::AppendItem(const PacketMetadata::SmallItem* item,
+                           const PacketMetadata::ExtraItem* extraItem)
+{
+    NS_LOG_FUNCTION(this << item->typeUid << item->size << item->chunkUid
+                         << extraItem->fragmentStart << extraItem->fragmentEnd
+                         << extraItem->packetUid);
+    if (m_data->m_fixedWidth)
+    {
+        PacketMetadata::SmallItem bigItem = *item;
+        bigItem.typeUid |= 0x1;
+        AddRecord(false, &bigItem, extraItem);
+        return;
+    }
+    uint16_t written = AddBig(0xffff, m_tail, item, extraItem);
+    UpdateTail(written);
+}
+
+void
+PacketMetadata::PrependItem(const PacketMetadata::SmallItem* item,
+                            const PacketMetadata::ExtraItem* extraItem)
+{
+    NS_LOG_FUNCTION(this << item->typeUid << item->size << item->chunkUid
+                         << extraItem->fragmentStart << extraItem->fragmentEnd
+                         << extraItem->packetUid);
+    if (m_data->m_fixedWidth)
+    {
+        PacketMetadata::SmallItem bigItem = *item;
+        bigItem.typeUid |= 0x1;
+        AddRecord(true, &bigItem, extraItem);
+        return;
+    }
+    uint16_t written = AddBig(m_head, 0xffff, item, extraItem);
+    UpdateHead(written);
+}
+
+void
+PacketMetadata::ReserveRecords(uint32_t front, uint32_t back)
+{
+    NS_LOG_FUNCTION(this << front << back);
+    NS_ASSERT(m_data != nullptr && m_data->m_fixedWidth);
+    bool empty = m_head == 0xffff;
+    // an empty array starts and ends at m_used
+    uint16_t head = empty ? m_used : m_head;
+    uint32_t used = m_used - head;
+
+    // the records which stop being the head or the tail store their trimmed bytes
+    bool storeHead = false;
+    bool storeTail = false;
+    if (!empty)
+    {
+        Record record;
+        memcpy(&record, &m_data->m_data[m_head], RECORD_SIZE);
+        storeHead = front > 0 && record.fragmentStart != m_headFragmentStart;
+        memcpy(&record, &m_data->m_data[m_tail], RECORD_SIZE);
+        storeTail = back > 0 && record.fragmentEnd != m_tailFragmentEnd;
+    }
+
+    bool owned = m_data->m_count == 1;
+    // the offsets of the records must fit in 16 bits, and 0xffff marks the end of the list
+    uint32_t capacity = std::min<uint32_t>(m_data->m_size, 0xffff) / RECORD_SIZE * RECORD_SIZE;
+#ifdef NS3_MTP
+    // another thread may add records to shared data concurrently
+    bool frontFree = owned;
+    bool backFree = owned;
+#else
+    bool frontFree = owned || head == m_data->m_dirtyStart;
+    bool backFree = owned || m_used == m_data->m_dirtyEnd;
+#endif
+    if ((front == 0 || (frontFree && head >= front * RECORD_SIZE)) &&
+        (back == 0 || (backFree && m_used + back * RECORD_SIZE <= capacity)) &&
+        (owned || (!storeHead && !storeTail)))
+    {
+        /* enough room, not dirty. */
+    }
+    else
+    {
+        uint32_t needed = used + (front + back) * RECORD_SIZE;
+        PacketMetadata::Data* data = m_data;
+        if (!owned || capacity < needed)
+        {
+            // with room for more records, so that the next ones are written in place
+            data = PacketMetadata::Create(needed + needed / 2);
+            data->m_fixedWidth = true;
+            capacity = std::min<uint32_t>(data->m_size, 0xffff) / RECORD_SIZE * RECORD_SIZE;
+            NS_ABORT_MSG_IF(capacity < needed, "Too many packet metadata items");
+        }
+        // leave most of the free records on the side which grows
+        uint32_t spare = (capacity - needed) / RECORD_SIZE;
+        uint32_t before = front + ((back > front) ? spare / 4 : spare - spare / 4);
+        uint16_t start = before * RECORD_SIZE;
+        if (used > 0)
+        {
+            memmove(&data->m_data[start], &m_data->m_data[head], used);
+        }
+        if (data != m_data)
+        {
+            if (--m_data->m_count == 0)
+            {
+                PacketMetadata::Recycle(m_data);
+            }
+            m_data = data;
+        }
+        if (!empty)
+        {
+            m_tail = start + (m_tail - m_head);
+            m_head = start;
+        }
+        m_used = start + used;
+        m_data->m_dirtyStart = start;
+        m_data->m_dirtyEnd = m_used;
+    }
+
+    if (storeHead || storeTail)
+    {
+        NS_ASSERT(m_data->m_count == 1);
+        PacketMetadata::SmallItem item;
+        PacketMetadata::ExtraItem extraItem;
+        if (storeHead)
+        {
+            ReadItems(m_head, &item, &extraItem);
+            WriteRecord(m_head, &item, &extraItem);
+        }
+        if (storeTail)
+        {
+            ReadItems(m_tail, &item, &extraItem);
+            WriteRecord(m_tail, &item, &extraItem);
+        }
+    }
+}
+
+void
+PacketMetadata::AddRecord(bool atHead,
+                          const PacketMetadata::SmallItem* item,
+                          const PacketMetadata::ExtraItem* extraItem)
+{
+    NS_LOG_FUNCTION(this << atHead << item->typeUid << item->size << item->chunkUid
+                         << extraItem->fragmentStart << extraItem->fragmentEnd
+                         << extraItem->packetUid);
+    if (atHead)
+    {
+        ReserveRecords(1, 0);
+    }
+    else
+    {
+        ReserveRecords(0, 1);
+    }
+    uint16_t current;
+    if (m_head == 0xffff)
+    {
+        current = atHead ? m_used - RECORD_SIZE : m_used;
+        m_head = current;
+        m_tail = current;
+        m_used = current + RECORD_SIZE;
+        m_headFragmentStart = extraItem->fragmentStart;
+        m_tailFragmentEnd = extraItem->fragmentEnd;
+    }
+    else if (atHead)
+    {
+        m_head -= RECORD_SIZE;
+        current = m_head;
+        m_headFragmentStart = extraItem->fragmentStart;
+    }
+    else
+    {
+        current = m_used;
+        m_tail = current;
+        m_used += RECORD_SIZE;
+        m_tailFragmentEnd = extraItem->fragmentEnd;
+    }
+    WriteRecord(current, item, extraItem);
+    m_data->m_dirtyStart = std::min(m_data->m_dirtyStart, m_head);
+    m_data->m_dirtyEnd = std::max<uint32_t>(m_data->m_dirtyEnd, m_used);
+}
+
+void
+PacketMetadata::WriteRecord(uint16_t current,
+                            const PacketMetadata::SmallItem* item,
+                            const PacketMetadata::ExtraItem* extraItem)
+{
+    NS_LOG_FUNCTION(this << current << item->typeUid << item->size << item->chunkUid
+                         << extraItem->fragmentStart << extraItem->fragmentEnd
+                         << extraItem->packetUid);
+    NS_ASSERT(static_cast<uint32_t>(current) + RECORD_SIZE <= m_data->m_size);
+    Record record;
+    record.typeUid = item->typeUid;
+    record.size = item->size;
+    record.fragmentStart = extraItem->fragmentStart;
+    record.fragmentEnd = extraItem->fragmentEnd;
+    record.packetUid = extraItem->packetUid;
+    record.chunkUid = item->chunkUid;
+    memcpy(&m_data->m_data[current], &record, RECORD_SIZE);
+}
+
+void
+PacketMetadata::RemoveHeadRecord()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_head == m_tail)
+    {
+        m_used = m_head;
+        m_head = 0xffff;
+        m_tail = 0xffff;
+        return;
+    }
+    PacketMetadata::SmallItem item;
+    PacketMetadata::ExtraItem extraItem;
+    ReadItems(m_head + RECORD_SIZE, &item, &extraItem);
+    m_head += RECORD_SIZE;
+    m_headFragmentStart = extraItem.fragmentStart;
+}
+
+void
+PacketMetadata::RemoveTailRecord()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_head == m_tail)
+    {
+        m_used = m_head;
+        m_head = 0xffff;
+        m_tail = 0xffff;
+        return;
+    }
+    PacketMetadata::SmallItem item;
+    PacketMetadata::ExtraItem extraItem;
+    ReadItems(m_tail - RECORD_SIZE, &item, &extraItem);
+    m_tail -= RECORD_SIZE;
+    m_used -= RECORD_SIZE;
+    m_tailFragmentEnd = extraItem.fragmentEnd;
+}
+
 uint32_t
 PacketMetadata::ReadItems(uint16_t current,
                           PacketMetadata::SmallItem* item,
@@ -519,6 +790,32 @@ PacketMetadata::ReadItems(uint16_t current,
                          << item->typeUid << extraItem->fragmentEnd << extraItem->fragmentStart
                          << extraItem->packetUid);
     NS_ASSERT(current <= m_data->m_size);
+    if (m_data->m_fixedWidth)
+    {
+        Record record;
+        memcpy(&record, &m_data->m_data[current], RECORD_SIZE);
+        item->next = (current == m_tail) ? 0xffff : current + RECORD_SIZE;
+        item->prev = (current == m_head) ? 0xffff : current - RECORD_SIZE;
+        item->typeUid = record.typeUid;
+        item->size = record.size;
+        item->chunkUid = record.chunkUid;
+        extraItem->fragmentStart = record.fragmentStart;
+        extraItem->fragmentEnd = record.fragmentEnd;
+        extraItem->packetUid =
+            ((record.typeUid & 0x1) == 0x1) ? record.packetUid : m_packetUid;
+        // the bytes trimmed from the head and the tail are not stored in their records
+        if (current == m_head && m_headFragmentStart != extraItem->fragmentStart)
+        {
+            extraItem->fragmentStart = m_headFragmentStart;
+            item->typeUid |= 0x1;
+        }
+        if (current == m_tail && m_tailFragmentEnd != extraItem->fragmentEnd)
+        {
+            extraItem->fragmentEnd = m_tailFragmentEnd;
+            item->typeUid |= 0x1;
+        }
+        return RECORD_SIZE;
+    }
     const uint8_t* buffer = &m_data->m_data[current];
     item->next = buffer[0];
     item->next |= (buffer[1]) << 8;
@@ -557,72 +854,58 @@ PacketMetadata::Create(uint32_t size)
 {
     NS_LOG_FUNCTION(size);
     NS_LOG_LOGIC("create size=" << size << ", max=" << m_maxSize);
-    if (size > m_maxSize)
-    {
-        m_maxSize = size;
-    }
-    while (!m_freeList.empty())
-    {
-        PacketMetadata::Data* data = m_freeList.back();
-        m_freeList.pop_back();
-        if (data->m_size >= size)
-        {
-            NS_LOG_LOGIC("create found size=" << data->m_size);
-            data->m_count = 1;
-            return data;
-        }
-        NS_LOG_LOGIC("create dealloc size=" << data->m_size);
-        PacketMetadata::Deallocate(data);
-    }
-    NS_LOG_LOGIC("create alloc size=" << m_maxSize);
-    return PacketMetadata::Allocate(m_maxSize);
+    m_maxSize = std::max(m_maxSize, size);
+    uint32_t n = std::max<uint32_t>(m_maxSize, PACKET_METADATA_DATA_M_DATA_SIZE);
+    uint32_t blockSize = sizeof(Data) + n - PACKET_METADATA_DATA_M_DATA_SIZE;
+    bool allocated;
+    auto data = static_cast<PacketMetadata::Data*>(g_pool.Acquire(blockSize, allocated));
+    // The block of the size class may be larger than requested
+    data->m_size = blockSize - sizeof(Data) + PACKET_METADATA_DATA_M_DATA_SIZE;
+    data->m_count = 1;
+    data->m_dirtyEnd = 0;
+    data->m_dirtyStart = 0xffff;
+    data->m_fixedWidth = m_enableFixedWidth;
+    data->m_accounting = PacketAccounting::IsEnabled() ? PacketAccounting::AddBytes(blockSize) : 0;
+    return data;
 }
 
 void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
-    {
-        PacketMetadata::Deallocate(data);
-        return;
-    }
-    NS_LOG_LOGIC("recycle size=" << data->m_size << ", list=" << m_freeList.size());
     NS_ASSERT(data->m_count == 0);
-    if (m_freeList.size() > 1000 || data->m_size < m_maxSize)
-    {
-        PacketMetadata::Deallocate(data);
-    }
-    else
+    uint32_t blockSize = sizeof(Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE;
+    if (data->m_accounting != 0)
     {
-        m_freeList.push_back(data);
+        PacketAccounting::RemoveBytes(data->m_accounting, blockSize);
     }
+    g_pool.Release(data, blockSize);
 }
 
-PacketMetadata::Data*
-PacketMetadata::Allocate(uint32_t n)
+SizeClassPool::Statistics
+PacketMetadata::GetPoolStatistics()
 {
-    NS_LOG_FUNCTION(n);
-    uint32_t size = sizeof(Data);
-    if (n <= PACKET_METADATA_DATA_M_DATA_SIZE)
-    {
-        n = PACKET_METADATA_DATA_M_DATA_SIZE;
-    }
-    size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-    auto buf = new uint8_t[size];
-    auto data = (PacketMetadata::Data*)buf;
-    data->m_size = n;
-    data->m_count = 1;
-    data->m_dirtyEnd = 0;
-    return data;
+    return g_pool.GetStatistics();
 }
 
 void
-PacketMetadata::Deallocate(PacketMetadata::Data* data)
+PacketMetadata::ResetPoolStatistics()
 {
-    NS_LOG_FUNCTION(data);
-    auto buf = (uint8_t*)data;
-    delete[] buf;
+    g_pool.ResetStatistics();
+}
+
+void
+PacketMetadata::SetPoolHighWaterMark(uint32_t blocks)
+{
+    NS_LOG_FUNCTION(blocks);
+    g_poolHighWaterMark = blocks;
+}
+
+void
+PacketMetadata::ClearPool()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    g_pool.Clear();
 }
 
 PacketMetadata
@@ -659,8 +942,16 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
     item.prev = 0xffff;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = m_chunkUid++;
+    if (m_data->m_fixedWidth)
+    {
+        PacketMetadata::ExtraItem extraItem;
+        extraItem.fragmentStart = 0;
+        extraItem.fragmentEnd = size;
+        extraItem.packetUid = m_packetUid;
+        AddRecord(true, &item, &extraItem);
+        return;
+    }
     uint16_t written = AddSmall(&item);
     UpdateHead(written);
 }
@@ -694,6 +985,12 @@ PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
         }
         return;
     }
+    if (m_data->m_fixedWidth)
+    {
+        RemoveHeadRecord();
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     if (m_head + read == m_used)
     {
         m_used = m_head;
@@ -725,8 +1022,17 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
     item.prev = m_tail;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = m_chunkUid++;
+    if (m_data->m_fixedWidth)
+    {
+        PacketMetadata::ExtraItem extraItem;
+        extraItem.fragmentStart = 0;
+        extraItem.fragmentEnd = size;
+        extraItem.packetUid = m_packetUid;
+        AddRecord(false, &item, &extraItem);
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     uint16_t written = AddSmall(&item);
     UpdateTail(written);
     NS_ASSERT(IsStateOk());
@@ -761,6 +1067,12 @@ PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
         }
         return;
     }
+    if (m_data->m_fixedWidth)
+    {
+        RemoveTailRecord();
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     if (m_tail + read == m_used)
     {
         m_used = m_tail;
@@ -786,6 +1098,13 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
         m_metadataSkipped = true;
         return;
     }
+    if (&o == this)
+    {
+        // the items are read while this metadata is extended
+        PacketMetadata copy = o;
+        AddAtEnd(copy);
+        return;
+    }
     if (m_tail == 0xffff)
     {
         // We have no items so 'AddAtEnd' is
@@ -822,7 +1141,15 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
          * location.
          */
         tailExtraItem.fragmentEnd = extraItem.fragmentEnd;
-        ReplaceTail(&tailItem, &tailExtraItem, tailSize);
+        if (m_data->m_fixedWidth)
+        {
+            // the records may be shared, the tail record is extended in this metadata only
+            m_tailFragmentEnd = tailExtraItem.fragmentEnd;
+        }
+        else
+        {
+            ReplaceTail(&tailItem, &tailExtraItem, tailSize);
+        }
         if (o.m_head == o.m_tail)
         {
             // there is only one item to append to self from other.
@@ -839,11 +1166,37 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
      * next packet, we just append all items from the next packet
      * to the current packet.
      */
+    if (m_data == o.m_data && m_data->m_fixedWidth && current == m_used &&
+        m_packetUid == o.m_packetUid)
+    {
+        /* The next records already follow the tail in the data buffer,
+         * as when the fragments of a packet are put back together: if the
+         * bytes trimmed from the tail and from the head of the other
+         * metadata are the ones stored, its records are shared too.
+         */
+        Record tailRecord;
+        Record nextRecord;
+        memcpy(&tailRecord, &m_data->m_data[m_tail], RECORD_SIZE);
+        memcpy(&nextRecord, &m_data->m_data[current], RECORD_SIZE);
+        if (tailRecord.fragmentEnd == m_tailFragmentEnd &&
+            (current != o.m_head || nextRecord.fragmentStart == o.m_headFragmentStart))
+        {
+            m_tail = o.m_tail;
+            m_used = o.m_used;
+            m_tailFragmentEnd = o.m_tailFragmentEnd;
+            NS_ASSERT(IsStateOk());
+            return;
+        }
+    }
+    if (m_data->m_fixedWidth && o.m_data->m_fixedWidth)
+    {
+        // make room for all the records at once
+        ReserveRecords(0, (o.m_tail - current) / RECORD_SIZE + 1);
+    }
     while (current != 0xffff)
     {
         o.ReadItems(current, &item, &extraItem);
-        uint16_t written = AddBig(0xffff, m_tail, &item, &extraItem);
-        UpdateTail(written);
+        AppendItem(&item, &extraItem);
         if (current == o.m_tail)
         {
             break;
@@ -875,6 +1228,30 @@ PacketMetadata::RemoveAtStart(uint32_t start)
     }
     NS_ASSERT(m_data != nullptr);
     uint32_t leftToRemove = start;
+    if (m_data->m_fixedWidth)
+    {
+        while (m_head != 0xffff && leftToRemove > 0)
+        {
+            PacketMetadata::SmallItem item;
+            PacketMetadata::ExtraItem extraItem;
+            ReadItems(m_head, &item, &extraItem);
+            uint32_t itemRealSize = extraItem.fragmentEnd - extraItem.fragmentStart;
+            if (itemRealSize <= leftToRemove)
+            {
+                RemoveHeadRecord();
+                leftToRemove -= itemRealSize;
+            }
+            else
+            {
+                // trim the head record, which may be shared, in this metadata only.
+                m_headFragmentStart += leftToRemove;
+                leftToRemove = 0;
+            }
+        }
+        NS_ASSERT(leftToRemove == 0);
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     uint16_t current = m_head;
     while (current != 0xffff && leftToRemove > 0)
     {
@@ -902,14 +1279,12 @@ PacketMetadata::RemoveAtStart(uint32_t start)
             PacketMetadata fragment(m_packetUid, 0);
             extraItem.fragmentStart += leftToRemove;
             leftToRemove = 0;
-            uint16_t written = fragment.AddBig(0xffff, fragment.m_tail, &item, &extraItem);
-            fragment.UpdateTail(written);
+            fragment.AppendItem(&item, &extraItem);
             while (current != 0xffff && current != m_tail)
             {
                 current = item.next;
                 ReadItems(current, &item, &extraItem);
-                written = fragment.AddBig(0xffff, fragment.m_tail, &item, &extraItem);
-                fragment.UpdateTail(written);
+                fragment.AppendItem(&item, &extraItem);
             }
             *this = fragment;
         }
@@ -937,6 +1312,30 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
     NS_ASSERT(m_data != nullptr);
 
     uint32_t leftToRemove = end;
+    if (m_data->m_fixedWidth)
+    {
+        while (m_tail != 0xffff && leftToRemove > 0)
+        {
+            PacketMetadata::SmallItem item;
+            PacketMetadata::ExtraItem extraItem;
+            ReadItems(m_tail, &item, &extraItem);
+            uint32_t itemRealSize = extraItem.fragmentEnd - extraItem.fragmentStart;
+            if (itemRealSize <= leftToRemove)
+            {
+                RemoveTailRecord();
+                leftToRemove -= itemRealSize;
+            }
+            else
+            {
+                // trim the tail record, which may be shared, in this metadata only.
+                m_tailFragmentEnd -= leftToRemove;
+                leftToRemove = 0;
+            }
+        }
+        NS_ASSERT(leftToRemove == 0);
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     uint16_t current = m_tail;
     while (current != 0xffff && leftToRemove > 0)
     {
@@ -965,14 +1364,12 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
             NS_ASSERT(extraItem.fragmentEnd > leftToRemove);
             extraItem.fragmentEnd -= leftToRemove;
             leftToRemove = 0;
-            uint16_t written = fragment.AddBig(fragment.m_head, 0xffff, &item, &extraItem);
-            fragment.UpdateHead(written);
+            fragment.PrependItem(&item, &extraItem);
             while (current != 0xffff && current != m_head)
             {
                 current = item.prev;
                 ReadItems(current, &item, &extraItem);
-                written = fragment.AddBig(fragment.m_head, 0xffff, &item, &extraItem);
-                fragment.UpdateHead(written);
+                fragment.PrependItem(&item, &extraItem);
             }
             *this = fragment;
         }
@@ -1306,8 +1703,7 @@ PacketMetadata::Deserialize(const uint8_t* buffer, uint32_t size)
                              << ", chunkUid=" << item.chunkUid << ", fragmentStart="
                              << extraItem.fragmentStart << ", fragmentEnd=" << extraItem.fragmentEnd
                              << ", packetUid=" << extraItem.packetUid);
-        uint32_t tmp = AddBig(0xffff, m_tail, &item, &extraItem);
-        UpdateTail(tmp);
+        AppendItem(&item, &extraItem);
     }
     NS_ASSERT(desSize == 0);
     return (desSize != 0) ? 0 : 1;
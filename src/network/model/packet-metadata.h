@@ -9,6 +9,7 @@
 #define PACKET_METADATA_H
 
 #include "buffer.h"
+#include "size-class-pool.h"
 
 #include "ns3/assert.h"
 #include "ns3/callback.h"
@@ -18,6 +19,10 @@
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -65,6 +70,18 @@ class Trailer;
  * integers, and some others as variable-size 32-bit integers.
  * The variable-size 32 bit integers are stored using the uleb128
  * encoding.
+ *
+ * Alternatively, when enabled with PacketMetadata::EnableFixedWidth,
+ * the items are stored as a flat array of fixed-size records, ordered
+ * from the head to the tail, without next and prev fields and without
+ * any encoding.  Like the bytes of a Buffer, this array grows in place
+ * at both ends as long as no other metadata sharing the data buffer
+ * has written there, so that the copies of a packet share the records
+ * written before they diverged.  The bytes trimmed from the head and
+ * the tail records are kept in the PacketMetadata itself, so that the
+ * fragments of a packet share its records too.  The encoding is
+ * recorded in each data buffer, so that the metadata created before
+ * and after the selection of the encoding can be mixed.
  */
 class PacketMetadata
 {
@@ -158,6 +175,56 @@ class PacketMetadata
      * @brief Enable the packet metadata checking
      */
     static void EnableChecking();
+    /**
+     * @brief Enable the packet metadata, stored as fixed-width records
+     *
+     * The metadata of the packets created afterwards is stored as a flat
+     * array of fixed-size records instead of a list of variable-size
+     * items, which is faster to update but uses more memory.
+     */
+    static void EnableFixedWidth();
+    /**
+     * @brief Store the metadata of the packets created afterwards as
+     * variable-size items again
+     *
+     * The packet metadata stays enabled, and the packets created while the
+     * fixed-width records were enabled keep them.
+     */
+    static void DisableFixedWidth();
+    /**
+     * @brief Check whether the packet metadata is stored as fixed-width records
+     *
+     * @returns true if the packets created now store fixed-width records
+     */
+    static bool IsFixedWidthEnabled();
+
+    /**
+     * @brief Get the statistics on the pool of the metadata storages
+     *
+     * The metadata storages are recycled through a pool owned by each
+     * thread, whose statistics are returned for the calling thread.
+     *
+     * @returns the statistics since the last reset
+     */
+    static SizeClassPool::Statistics GetPoolStatistics();
+    /**
+     * @brief Reset the statistics on the pool of the metadata storages
+     */
+    static void ResetPoolStatistics();
+    /**
+     * @brief Set the maximum number of metadata storages cached
+     *
+     * The value applies to the pools of all the threads, for each size
+     * class, and each pool caches at most SizeClassPool::BUDGET_PER_BLOCK
+     * bytes per block of this value.  The default is 1000.
+     *
+     * @param blocks the maximum number of metadata storages of a size class
+     */
+    static void SetPoolHighWaterMark(uint32_t blocks);
+    /**
+     * @brief Free the metadata storages cached by the pool of the calling thread
+     */
+    static void ClearPool();
 
     /**
      * @brief Constructor
@@ -415,11 +482,22 @@ class PacketMetadata
     struct Data
     {
         /** number of references to this struct Data instance. */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /** size (in bytes) of m_data buffer below */
         uint32_t m_size;
         /** max of the m_used field over all objects which reference this struct Data instance */
         uint16_t m_dirtyEnd;
+        /** min of the m_head field over all objects which reference this struct Data
+            instance, if the items are stored as fixed-size records */
+        uint16_t m_dirtyStart;
+        /** true if the items are stored as fixed-width records */
+        bool m_fixedWidth;
+        /** the slot of the creator, if accounted by PacketAccounting, or zero */
+        uint32_t m_accounting;
         /** variable-sized buffer of bytes */
         uint8_t m_data[PACKET_METADATA_DATA_M_DATA_SIZE];
     };
@@ -499,15 +577,26 @@ class PacketMetadata
     };
 
     /**
-     * @brief Class to hold all the metadata
+     * @brief Record structure
+     *
+     * An item stored in the flat array of fixed-size records: the fields
+     * of a SmallItem, without the next and prev fields, and of an
+     * ExtraItem.  The fields of the ExtraItem are stored even if the low
+     * bit of typeUid is zero.
      */
-    class DataFreeList : public std::vector<Data*>
+    struct Record
     {
-      public:
-        ~DataFreeList();
+        uint32_t typeUid;       //!< the typeUid field of the SmallItem
+        uint32_t size;          //!< the size field of the SmallItem
+        uint32_t fragmentStart; //!< the fragmentStart field of the ExtraItem
+        uint32_t fragmentEnd;   //!< the fragmentEnd field of the ExtraItem
+        uint64_t packetUid;     //!< the packetUid field of the ExtraItem
+        uint16_t chunkUid;      //!< the chunkUid field of the SmallItem
     };
 
-    friend DataFreeList::~DataFreeList();
+    /// the size of a record of the flat array
+    static constexpr uint16_t RECORD_SIZE = sizeof(Record);
+
     /// Friend class
     friend class ItemIterator;
 
@@ -590,6 +679,64 @@ class PacketMetadata
      */
     void AppendValueExtra(uint32_t value, uint8_t* buffer);
 
+    /**
+     * @brief Append an item after the tail, in the encoding of the data
+     * buffer, as an ExtraItem
+     * @param item the SmallItem to add
+     * @param extraItem the ExtraItem to add
+     */
+    void AppendItem(const PacketMetadata::SmallItem* item,
+                    const PacketMetadata::ExtraItem* extraItem);
+    /**
+     * @brief Prepend an item before the head, in the encoding of the data
+     * buffer, as an ExtraItem
+     * @param item the SmallItem to add
+     * @param extraItem the ExtraItem to add
+     */
+    void PrependItem(const PacketMetadata::SmallItem* item,
+                     const PacketMetadata::ExtraItem* extraItem);
+
+    /**
+     * @brief Make room for records before the head and after the tail
+     *
+     * The records are written in place if no other metadata sharing the
+     * data buffer has written there.  Otherwise, they are moved within the
+     * data buffer if it is not shared, or copied to a new one.  The bytes
+     * trimmed from the head and the tail records are stored in them if
+     * records are added before the head and after the tail respectively.
+     *
+     * @param front the number of records to add before the head
+     * @param back the number of records to add after the tail
+     */
+    void ReserveRecords(uint32_t front, uint32_t back);
+    /**
+     * @brief Add a record before the head or after the tail
+     * @param atHead true to add the record before the head
+     * @param item the SmallItem to add
+     * @param extraItem the ExtraItem to add, even if the low bit of
+     *        the typeUid field of item is zero
+     */
+    void AddRecord(bool atHead,
+                   const PacketMetadata::SmallItem* item,
+                   const PacketMetadata::ExtraItem* extraItem);
+    /**
+     * @brief Write a record
+     * @param current the offset of the record
+     * @param item the SmallItem to write
+     * @param extraItem the ExtraItem to write
+     */
+    void WriteRecord(uint16_t current,
+                     const PacketMetadata::SmallItem* item,
+                     const PacketMetadata::ExtraItem* extraItem);
+    /**
+     * @brief Remove the head record
+     */
+    void RemoveHeadRecord();
+    /**
+     * @brief Remove the tail record
+     */
+    void RemoveTailRecord();
+
     /**
      * @brief Reserve space
      * @param n space to reserve
@@ -652,31 +799,28 @@ class PacketMetadata
      * @returns a pointer to the created buffer storage
      */
     static PacketMetadata::Data* Create(uint32_t size);
-    /**
-     * @brief Allocate a buffer data storage
-     * @param n the storage size to create
-     * @returns a pointer to the allocated buffer storage
-     */
-    static PacketMetadata::Data* Allocate(uint32_t n);
-    /**
-     * @brief Deallocate the buffer memory
-     * @param data the buffer data storage
-     */
-    static void Deallocate(PacketMetadata::Data* data);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
     static bool m_enable;           //!< Enable the packet metadata
     static bool m_enableChecking;   //!< Enable the packet metadata checking
+    static bool m_enableFixedWidth; //!< Store the packet metadata as fixed-width records
 
     /**
      * Set to true when adding metadata to a packet is skipped because
      * m_enable is false; used to detect enabling of metadata in the
      * middle of a simulation, which isn't allowed.
      */
+#ifdef NS3_MTP
+    static std::atomic<bool> m_metadataSkipped;
+#else
     static bool m_metadataSkipped;
+#endif
 
-    static uint32_t m_maxSize;  //!< maximum metadata size
+    static thread_local uint32_t m_maxSize; //!< maximum metadata size
+#ifdef NS3_MTP
+    static std::atomic<uint16_t> m_chunkUid; //!< Chunk Uid
+#else
     static uint16_t m_chunkUid; //!< Chunk Uid
+#endif
 
     Data* m_data; //!< Metadata storage
     /*
@@ -688,6 +832,10 @@ class PacketMetadata
     uint16_t m_tail;      //!< list tail
     uint32_t m_used;      //!< used portion
     uint64_t m_packetUid; //!< packet Uid
+    /** fragmentStart of the head record, if the items are stored as fixed-size records */
+    uint32_t m_headFragmentStart;
+    /** fragmentEnd of the tail record, if the items are stored as fixed-size records */
+    uint32_t m_tailFragmentEnd;
 };
 
 } // namespace ns3
@@ -700,7 +848,9 @@ PacketMetadata::PacketMetadata(uint64_t uid, uint32_t size)
       m_head(0xffff),
       m_tail(0xffff),
       m_used(0),
-      m_packetUid(uid)
+      m_packetUid(uid),
+      m_headFragmentStart(0),
+      m_tailFragmentEnd(0)
 {
     memset(m_data->m_data, 0xff, 4);
     if (size > 0)
@@ -714,7 +864,9 @@ PacketMetadata::PacketMetadata(const PacketMetadata& o)
       m_head(o.m_head),
       m_tail(o.m_tail),
       m_used(o.m_used),
-      m_packetUid(o.m_packetUid)
+      m_packetUid(o.m_packetUid),
+      m_headFragmentStart(o.m_headFragmentStart),
+      m_tailFragmentEnd(o.m_tailFragmentEnd)
 {
     NS_ASSERT(m_data != nullptr);
     NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
@@ -728,8 +880,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
     {
         // not self assignment
         NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             PacketMetadata::Recycle(m_data);
         }
@@ -741,14 +892,15 @@ PacketMetadata::operator=(const PacketMetadata& o)
     m_tail = o.m_tail;
     m_used = o.m_used;
     m_packetUid = o.m_packetUid;
+    m_headFragmentStart = o.m_headFragmentStart;
+    m_tailFragmentEnd = o.m_tailFragmentEnd;
     return *this;
 }
 
 PacketMetadata::~PacketMetadata()
 {
     NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -34,13 +34,27 @@ PacketTagList::CreateTagData(size_t dataSize)
                                             << std::numeric_limits<decltype(TagData::size)>::max());
 
     void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
+    // The matching frees are in RemoveAll, RemoveWriter and ReleaseTagData
 
     auto tag = new (p) TagData;
     tag->size = dataSize;
     return tag;
 }
 
+void
+PacketTagList::ReleaseTagData(TagData* data)
+{
+    // The count can only drop to zero here when another list sharing
+    // the node unmerged it concurrently (multithreaded simulations)
+    while (data != nullptr && --data->count == 0)
+    {
+        TagData* next = data->next;
+        data->~TagData();
+        std::free(data);
+        data = next;
+    }
+}
+
 bool
 PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 {
@@ -139,7 +153,6 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
     {
         NS_ASSERT(cur != nullptr);
         NS_ASSERT(cur->count > 1);
-        cur->count--; // unmerge cur
         TagData* copy = CreateTagData(cur->size);
         copy->tid = cur->tid;
         copy->count = 1;
@@ -147,6 +160,7 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
         memcpy(copy->data, cur->data, copy->size);
         copy->next = cur->next; // merge into tail
         copy->next->count++;    // mark new merge
+        ReleaseTagData(cur);    // unmerge cur
         *prevNext = copy;       // point prior list at copy
         prevNext = &copy->next; // advance
         cur = copy->next;
@@ -161,9 +175,28 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
     return found;
 }
 
+void
+PacketTagList::RemoveInline(uint32_t i)
+{
+    NS_ASSERT(i < m_inlineCount);
+    m_inlineCount--;
+    for (; i < m_inlineCount; i++)
+    {
+        m_inline[i] = m_inline[i + 1];
+    }
+}
+
 bool
 PacketTagList::Remove(Tag& tag)
 {
+    uint32_t i = FindInline(tag.GetInstanceTypeId());
+    if (i != INLINE_TAGS)
+    {
+        InlineTag& cur = m_inline[i];
+        tag.Deserialize(TagBuffer(cur.data, cur.data + cur.size));
+        RemoveInline(i);
+        return true;
+    }
     return COWTraverse(tag, &PacketTagList::RemoveWriter);
 }
 
@@ -190,13 +223,13 @@ PacketTagList::RemoveWriter(Tag& tag,
     else
     {
         // cur is always a merge at this point
-        // unmerge cur, since we linked around it already
-        cur->count--;
         if (cur->next != nullptr)
         {
             // there's a next, so make it a merge
             cur->next->count++;
         }
+        // unmerge cur, since we linked around it already
+        ReleaseTagData(cur);
     }
     return found;
 }
@@ -204,6 +237,21 @@ PacketTagList::RemoveWriter(Tag& tag,
 bool
 PacketTagList::Replace(Tag& tag)
 {
+    uint32_t i = FindInline(tag.GetInstanceTypeId());
+    if (i != INLINE_TAGS)
+    {
+        uint32_t size = tag.GetSerializedSize();
+        if (size > INLINE_SIZE)
+        {
+            RemoveInline(i);
+            Add(tag);
+            return true;
+        }
+        InlineTag& cur = m_inline[i];
+        cur.size = size;
+        tag.Serialize(TagBuffer(cur.data, cur.data + cur.size));
+        return true;
+    }
     bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
     if (!found)
     {
@@ -232,7 +280,6 @@ PacketTagList::ReplaceWriter(Tag& tag,
     {
         // cur is always a merge at this point
         // need to copy, replace, and link past cur
-        cur->count--; // unmerge cur
         TagData* copy = CreateTagData(tag.GetSerializedSize());
         copy->tid = tag.GetInstanceTypeId();
         copy->count = 1;
@@ -242,7 +289,8 @@ PacketTagList::ReplaceWriter(Tag& tag,
         {
             copy->next->count++; // mark new merge
         }
-        *prevNext = copy; // point prior list at copy
+        ReleaseTagData(cur); // unmerge cur
+        *prevNext = copy;    // point prior list at copy
     }
     return found;
 }
@@ -251,17 +299,32 @@ void
 PacketTagList::Add(const Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
+    TypeId tid = tag.GetInstanceTypeId();
     // ensure this id was not yet added
+    NS_ASSERT_MSG(FindInline(tid) == INLINE_TAGS,
+                  "Error: cannot add the same kind of tag twice. The tag type is "
+                      << tid.GetName());
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
-        NS_ASSERT_MSG(cur->tid != tag.GetInstanceTypeId(),
+        NS_ASSERT_MSG(cur->tid != tid,
                       "Error: cannot add the same kind of tag twice. The tag type is "
-                          << tag.GetInstanceTypeId().GetName());
+                          << tid.GetName());
+    }
+    uint32_t size = tag.GetSerializedSize();
+    if (m_inlineCount < INLINE_TAGS && size <= INLINE_SIZE)
+    {
+        auto self = const_cast<PacketTagList*>(this);
+        InlineTag& cur = self->m_inline[m_inlineCount];
+        cur.tid = tid;
+        cur.size = size;
+        tag.Serialize(TagBuffer(cur.data, cur.data + cur.size));
+        self->m_inlineCount++;
+        return;
     }
-    TagData* head = CreateTagData(tag.GetSerializedSize());
+    TagData* head = CreateTagData(size);
     head->count = 1;
     head->next = nullptr;
-    head->tid = tag.GetInstanceTypeId();
+    head->tid = tid;
     head->next = m_next;
     tag.Serialize(TagBuffer(head->data, head->data + head->size));
 
@@ -273,6 +336,14 @@ PacketTagList::Peek(Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
     TypeId tid = tag.GetInstanceTypeId();
+    uint32_t i = FindInline(tid);
+    if (i != INLINE_TAGS)
+    {
+        const InlineTag& cur = m_inline[i];
+        tag.Deserialize(TagBuffer(const_cast<uint8_t*>(cur.data),
+                                  const_cast<uint8_t*>(cur.data) + cur.size));
+        return true;
+    }
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
         if (cur->tid == tid)
@@ -313,6 +384,10 @@ PacketTagList::GetSerializedSize() const
         uint32_t tagWordSize = (cur->size + 3) & (~3);
         size += tagWordSize;
     }
+    for (uint32_t i = 0; i < m_inlineCount; i++)
+    {
+        size += 4 + ((sizeof(TypeId::hash_t) + 3) & (~3)) + ((m_inline[i].size + 3) & (~3));
+    }
 
     return size;
 }
@@ -335,18 +410,18 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
     uint32_t* numberOfTags = p;
     *p++ = 0;
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
+    // Serialize a tag, returning false if it does not fit
+    auto serializeTag = [&](TypeId tagTid, uint32_t tagSize, const uint8_t* data) {
         size += 4;
 
         if (size > maxSize)
         {
-            return 0;
+            return false;
         }
 
-        *p++ = cur->size;
+        *p++ = tagSize;
 
-        NS_LOG_INFO("Serializing tag id " << cur->tid);
+        NS_LOG_INFO("Serializing tag id " << tagTid);
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
         uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
@@ -354,26 +429,44 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
 
         if (size > maxSize)
         {
-            return 0;
+            return false;
         }
 
-        TypeId::hash_t tid = cur->tid.GetHash();
+        TypeId::hash_t tid = tagTid.GetHash();
         memcpy(p, &tid, sizeof(TypeId::hash_t));
         p += hashSize / 4;
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
-        uint32_t tagWordSize = (cur->size + 3) & (~3);
+        uint32_t tagWordSize = (tagSize + 3) & (~3);
         size += tagWordSize;
 
         if (size > maxSize)
         {
-            return 0;
+            return false;
         }
 
-        memcpy(p, cur->data, cur->size);
+        memcpy(p, data, tagSize);
         p += tagWordSize / 4;
 
         (*numberOfTags)++;
+        return true;
+    };
+
+    // Most recent tags first, as they are deserialized in the list
+    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    {
+        if (!serializeTag(cur->tid, cur->size, cur->data))
+        {
+            return 0;
+        }
+    }
+    for (uint32_t i = m_inlineCount; i > 0; i--)
+    {
+        const InlineTag& cur = m_inline[i - 1];
+        if (!serializeTag(cur.tid, cur.size, cur.data))
+        {
+            return 0;
+        }
     }
 
     // Serialized successfully
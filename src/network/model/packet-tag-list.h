@@ -18,6 +18,10 @@
 #include <ostream>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -109,6 +113,21 @@ class Tag;
  *       The portion of the list between the first branch and the target is
  *       shared. This portion is copied before the #Remove or #Replace is
  *       performed.
+ *
+ * @par <b> Inline tags </b>
+ *
+ *   Most packets carry a few small tags, so the first INLINE_TAGS tags
+ *   whose serialized size is at most INLINE_SIZE bytes are stored in an
+ *   array inside the PacketTagList, rather than in the tree.  These tags
+ *   are found by comparing their TypeId, and are copied with the list,
+ *   without any allocation nor reference count.  The other tags are
+ *   stored in the tree.
+ *
+ *   The inline array makes the PacketTagList, hence each Packet, 72 bytes
+ *   larger on 64-bit platforms.  The tags of the tree are iterated before
+ *   the ones stored inline (see PacketTagIterator), so the tags are no
+ *   longer iterated in the reverse order of their addition; within the
+ *   library, only Packet::PrintPacketTags() iterates over them.
  */
 class PacketTagList
 {
@@ -130,13 +149,35 @@ class PacketTagList
      */
     struct TagData
     {
-        TagData* next;   //!< Pointer to next in list
-        uint32_t count;  //!< Number of incoming links
+        TagData* next; //!< Pointer to next in list
+#ifdef NS3_MTP
+        std::atomic<uint32_t> count; //!< Number of incoming links
+#else
+        uint32_t count; //!< Number of incoming links
+#endif
         TypeId tid;      //!< Type of the tag serialized into #data
         uint32_t size;   //!< Size of the \c data buffer
         uint8_t data[1]; //!< Serialization buffer
     };
 
+    /** The maximum number of tags stored inline. */
+    static constexpr uint32_t INLINE_TAGS = 4;
+    /** The maximum serialized size of a tag stored inline. */
+    static constexpr uint32_t INLINE_SIZE = 12;
+
+    /**
+     * A tag stored inline.
+     *
+     * @internal
+     * This has to be public for PacketTagIterator, like TagData.
+     */
+    struct InlineTag
+    {
+        TypeId tid;                //!< Type of the tag serialized into #data
+        uint8_t size;              //!< Size of the serialized tag
+        uint8_t data[INLINE_SIZE]; //!< Serialization buffer
+    };
+
     /**
      * Create a new PacketTagList.
      */
@@ -204,9 +245,18 @@ class PacketTagList
      */
     inline void RemoveAll();
     /**
-     * @returns pointer to head of tag list
+     * @returns pointer to head of the tags which are not stored inline
      */
     const PacketTagList::TagData* Head() const;
+    /**
+     * @returns the number of tags stored inline
+     */
+    inline uint32_t GetInlineCount() const;
+    /**
+     * @param [in] i The index of the tag, less than GetInlineCount().
+     * @returns the tag stored inline at this index
+     */
+    inline const PacketTagList::InlineTag& GetInline(uint32_t i) const;
     /**
      * Returns number of bytes required for packet serialization.
      *
@@ -241,6 +291,13 @@ class PacketTagList
      * @returns The newly constructed TagData object.
      */
     static TagData* CreateTagData(size_t dataSize);
+    /**
+     * Drop one incoming link to a TagData struct, freeing it (and
+     * the links it holds down the list) once it is no longer referenced.
+     *
+     * @param [in] data The TagData object to unlink.
+     */
+    static void ReleaseTagData(TagData* data);
 
     /**
      * Typedef of method function pointer for copy-on-write operations
@@ -290,10 +347,28 @@ class PacketTagList
      */
     bool ReplaceWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
 
+    /**
+     * Find a tag stored inline.
+     *
+     * @param [in] tid The type of the tag.
+     * @returns The index of the tag, or INLINE_TAGS if not found.
+     */
+    inline uint32_t FindInline(TypeId tid) const;
+    /**
+     * Remove a tag stored inline.
+     *
+     * @param [in] i The index of the tag.
+     */
+    void RemoveInline(uint32_t i);
+
     /**
      * Pointer to first \ref TagData on the list
      */
     TagData* m_next;
+    /** The number of tags stored inline. */
+    uint32_t m_inlineCount;
+    /** The tags stored inline, in the order they were added. */
+    InlineTag m_inline[INLINE_TAGS];
 };
 
 } // namespace ns3
@@ -306,32 +381,46 @@ namespace ns3
 {
 
 PacketTagList::PacketTagList()
-    : m_next()
+    : m_next(),
+      m_inlineCount(0)
 {
 }
 
 PacketTagList::PacketTagList(const PacketTagList& o)
-    : m_next(o.m_next)
+    : m_next(o.m_next),
+      m_inlineCount(o.m_inlineCount)
 {
     if (m_next != nullptr)
     {
         m_next->count++;
     }
+    for (uint32_t i = 0; i < m_inlineCount; i++)
+    {
+        m_inline[i] = o.m_inline[i];
+    }
 }
 
 PacketTagList&
 PacketTagList::operator=(const PacketTagList& o)
 {
     // self assignment
-    if (m_next == o.m_next)
+    if (this == &o)
     {
         return *this;
     }
-    RemoveAll();
-    m_next = o.m_next;
-    if (m_next != nullptr)
+    if (m_next != o.m_next)
     {
-        m_next->count++;
+        RemoveAll();
+        m_next = o.m_next;
+        if (m_next != nullptr)
+        {
+            m_next->count++;
+        }
+    }
+    m_inlineCount = o.m_inlineCount;
+    for (uint32_t i = 0; i < m_inlineCount; i++)
+    {
+        m_inline[i] = o.m_inline[i];
     }
     return *this;
 }
@@ -347,8 +436,7 @@ PacketTagList::RemoveAll()
     TagData* prev = nullptr;
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
-        cur->count--;
-        if (cur->count > 0)
+        if (--cur->count > 0)
         {
             break;
         }
@@ -365,6 +453,32 @@ PacketTagList::RemoveAll()
         std::free(prev);
     }
     m_next = nullptr;
+    m_inlineCount = 0;
+}
+
+uint32_t
+PacketTagList::GetInlineCount() const
+{
+    return m_inlineCount;
+}
+
+const PacketTagList::InlineTag&
+PacketTagList::GetInline(uint32_t i) const
+{
+    return m_inline[i];
+}
+
+uint32_t
+PacketTagList::FindInline(TypeId tid) const
+{
+    for (uint32_t i = 0; i < m_inlineCount; i++)
+    {
+        if (m_inline[i].tid == tid)
+        {
+            return i;
+        }
+    }
+    return INLINE_TAGS;
 }
 
 } // namespace ns3
@@ -7,6 +7,8 @@
  */
 #include "packet.h"
 
+#include "packet-accounting.h"
+
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -19,7 +21,12 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
+#ifdef NS3_MTP
+thread_local uint64_t Packet::m_globalUid = 0;
+#else
 uint32_t Packet::m_globalUid = 0;
+#endif
+bool Packet::m_enableHeaderCache = false;
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -78,42 +85,53 @@ ByteTagIterator::ByteTagIterator(ByteTagList::Iterator i)
 {
 }
 
-PacketTagIterator::PacketTagIterator(const PacketTagList::TagData* head)
-    : m_current(head)
+PacketTagIterator::PacketTagIterator(const PacketTagList& list)
+    : m_list(&list),
+      m_current(list.Head()),
+      m_inline(list.GetInlineCount())
 {
 }
 
 bool
 PacketTagIterator::HasNext() const
 {
-    return m_current != nullptr;
+    return m_current != nullptr || m_inline != 0;
 }
 
 PacketTagIterator::Item
 PacketTagIterator::Next()
 {
     NS_ASSERT(HasNext());
-    const PacketTagList::TagData* prev = m_current;
-    m_current = m_current->next;
-    return PacketTagIterator::Item(prev);
+    // The tags of the tree first, then the ones stored inline, each most recent first
+    if (m_current != nullptr)
+    {
+        const PacketTagList::TagData* prev = m_current;
+        m_current = m_current->next;
+        return PacketTagIterator::Item(prev->tid, prev->data, prev->size);
+    }
+    m_inline--;
+    const PacketTagList::InlineTag& tag = m_list->GetInline(m_inline);
+    return PacketTagIterator::Item(tag.tid, tag.data, tag.size);
 }
 
-PacketTagIterator::Item::Item(const PacketTagList::TagData* data)
-    : m_data(data)
+PacketTagIterator::Item::Item(TypeId tid, const uint8_t* data, uint32_t size)
+    : m_tid(tid),
+      m_data(data),
+      m_size(size)
 {
 }
 
 TypeId
 PacketTagIterator::Item::GetTypeId() const
 {
-    return m_data->tid;
+    return m_tid;
 }
 
 void
 PacketTagIterator::Item::GetTag(Tag& tag) const
 {
-    NS_ASSERT(tag.GetInstanceTypeId() == m_data->tid);
-    tag.Deserialize(TagBuffer((uint8_t*)m_data->data, (uint8_t*)m_data->data + m_data->size));
+    NS_ASSERT(tag.GetInstanceTypeId() == m_tid);
+    tag.Deserialize(TagBuffer((uint8_t*)m_data, (uint8_t*)m_data + m_size));
 }
 
 Ptr<Packet>
@@ -135,21 +153,31 @@ Packet::Packet()
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
-      m_nixVector(nullptr)
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, 0),
+      m_nixVector(nullptr),
+      m_accounting(PacketAccounting::IsEnabled() ? PacketAccounting::AddPacket() : 0)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
     : m_buffer(o.m_buffer),
       m_byteTagList(o.m_byteTagList),
       m_packetTagList(o.m_packetTagList),
-      m_metadata(o.m_metadata)
+      m_metadata(o.m_metadata),
+      m_accounting(PacketAccounting::IsEnabled() ? PacketAccounting::AddPacket(o.m_accounting)
+                                                 : 0)
 {
     o.m_nixVector ? m_nixVector = o.m_nixVector->Copy() : m_nixVector = nullptr;
 }
 
+Packet::~Packet()
+{
+    if (m_accounting != 0)
+    {
+        PacketAccounting::RemovePacket(m_accounting);
+    }
+}
+
 Packet&
 Packet::operator=(const Packet& o)
 {
@@ -162,6 +190,7 @@ Packet::operator=(const Packet& o)
     m_packetTagList = o.m_packetTagList;
     m_metadata = o.m_metadata;
     o.m_nixVector ? m_nixVector = o.m_nixVector->Copy() : m_nixVector = nullptr;
+    m_headerCache.reset();
     return *this;
 }
 
@@ -175,10 +204,10 @@ Packet::Packet(uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
-      m_nixVector(nullptr)
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, size),
+      m_nixVector(nullptr),
+      m_accounting(PacketAccounting::IsEnabled() ? PacketAccounting::AddPacket() : 0)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -186,7 +215,8 @@ Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
       m_byteTagList(),
       m_packetTagList(),
       m_metadata(0, 0),
-      m_nixVector(nullptr)
+      m_nixVector(nullptr),
+      m_accounting(PacketAccounting::IsEnabled() ? PacketAccounting::AddPacket() : 0)
 {
     NS_ASSERT(magic);
     Deserialize(buffer, size);
@@ -202,10 +232,10 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
-      m_nixVector(nullptr)
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, size),
+      m_nixVector(nullptr),
+      m_accounting(PacketAccounting::IsEnabled() ? PacketAccounting::AddPacket() : 0)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -219,7 +249,8 @@ Packet::Packet(const Buffer& buffer,
       m_byteTagList(byteTagList),
       m_packetTagList(packetTagList),
       m_metadata(metadata),
-      m_nixVector(nullptr)
+      m_nixVector(nullptr),
+      m_accounting(PacketAccounting::IsEnabled() ? PacketAccounting::AddPacket() : 0)
 {
 }
 
@@ -258,21 +289,30 @@ Packet::AddHeader(const Header& header)
 {
     uint32_t size = header.GetSerializedSize();
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << size);
-    m_buffer.AddAtStart(size);
+    m_headerCache.reset();
+    uint8_t* start = m_buffer.AddAtStartContiguous(size);
     m_byteTagList.Adjust(size);
     m_byteTagList.AddAtStart(size);
-    header.Serialize(m_buffer.Begin());
+    if (!header.SerializeContiguous(start, m_buffer.GetSize()))
+    {
+        header.Serialize(m_buffer.Begin());
+    }
     m_metadata.AddHeader(header, size);
 }
 
 uint32_t
 Packet::RemoveHeader(Header& header, uint32_t size)
 {
-    Buffer::Iterator end;
-    end = m_buffer.Begin();
-    end.Next(size);
-    uint32_t deserialized = header.Deserialize(m_buffer.Begin(), end);
+    uint32_t deserialized;
+    if (!PeekCachedHeader(header, true, size, deserialized))
+    {
+        Buffer::Iterator start = m_buffer.Begin();
+        Buffer::Iterator end = start;
+        end.Next(size);
+        deserialized = header.Deserialize(start, end);
+    }
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
+    m_headerCache.reset();
     m_buffer.RemoveAtStart(deserialized);
     m_byteTagList.Adjust(-deserialized);
     m_metadata.RemoveHeader(header, deserialized);
@@ -282,8 +322,13 @@ Packet::RemoveHeader(Header& header, uint32_t size)
 uint32_t
 Packet::RemoveHeader(Header& header)
 {
-    uint32_t deserialized = header.Deserialize(m_buffer.Begin());
+    uint32_t deserialized;
+    if (!PeekCachedHeader(header, false, 0, deserialized))
+    {
+        deserialized = header.Deserialize(m_buffer.Begin());
+    }
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
+    m_headerCache.reset();
     m_buffer.RemoveAtStart(deserialized);
     m_byteTagList.Adjust(-deserialized);
     m_metadata.RemoveHeader(header, deserialized);
@@ -293,7 +338,12 @@ Packet::RemoveHeader(Header& header)
 uint32_t
 Packet::PeekHeader(Header& header) const
 {
-    uint32_t deserialized = header.Deserialize(m_buffer.Begin());
+    uint32_t deserialized;
+    if (!PeekCachedHeader(header, false, 0, deserialized))
+    {
+        deserialized = header.Deserialize(m_buffer.Begin());
+        CacheHeader(header, false, 0, deserialized);
+    }
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
     return deserialized;
 }
@@ -301,19 +351,83 @@ Packet::PeekHeader(Header& header) const
 uint32_t
 Packet::PeekHeader(Header& header, uint32_t size) const
 {
-    Buffer::Iterator end;
-    end = m_buffer.Begin();
-    end.Next(size);
-    uint32_t deserialized = header.Deserialize(m_buffer.Begin(), end);
+    uint32_t deserialized;
+    if (!PeekCachedHeader(header, true, size, deserialized))
+    {
+        Buffer::Iterator start = m_buffer.Begin();
+        Buffer::Iterator end = start;
+        end.Next(size);
+        deserialized = header.Deserialize(start, end);
+        CacheHeader(header, true, size, deserialized);
+    }
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
     return deserialized;
 }
 
+bool
+Packet::PeekCachedHeader(Header& header,
+                         bool bounded,
+                         uint32_t size,
+                         uint32_t& deserialized) const
+{
+    if (!m_headerCache)
+    {
+        return false;
+    }
+    TypeId tid = header.GetInstanceTypeId();
+    for (const auto& cached : *m_headerCache)
+    {
+        if (cached.tid == tid && cached.bounded == bounded && (!bounded || cached.size == size))
+        {
+            // the header may have to verify a checksum on the bytes
+            if (!header.AssignHeader(*cached.header))
+            {
+                return false;
+            }
+            deserialized = cached.deserialized;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+Packet::CacheHeader(const Header& header, bool bounded, uint32_t size, uint32_t deserialized) const
+{
+    if (!m_enableHeaderCache)
+    {
+        return;
+    }
+    TypeId tid = header.GetInstanceTypeId();
+    if (m_headerCache)
+    {
+        for (const auto& cached : *m_headerCache)
+        {
+            if (cached.tid == tid && cached.bounded == bounded && (!bounded || cached.size == size))
+            {
+                // the header was deserialized again to verify its checksum
+                return;
+            }
+        }
+    }
+    Header* copy = header.CopyHeader();
+    if (copy == nullptr)
+    {
+        return;
+    }
+    if (!m_headerCache)
+    {
+        m_headerCache = std::make_unique<std::vector<CachedHeader>>();
+    }
+    m_headerCache->push_back({tid, bounded, size, deserialized, std::unique_ptr<Header>(copy)});
+}
+
 void
 Packet::AddTrailer(const Trailer& trailer)
 {
     uint32_t size = trailer.GetSerializedSize();
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << size);
+    m_headerCache.reset();
     m_byteTagList.AddAtEnd(GetSize());
     m_buffer.AddAtEnd(size);
     Buffer::Iterator end = m_buffer.End();
@@ -326,6 +440,7 @@ Packet::RemoveTrailer(Trailer& trailer)
 {
     uint32_t deserialized = trailer.Deserialize(m_buffer.End());
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << deserialized);
+    m_headerCache.reset();
     m_buffer.RemoveAtEnd(deserialized);
     m_metadata.RemoveTrailer(trailer, deserialized);
     return deserialized;
@@ -346,8 +461,12 @@ Packet::AddAtEnd(Ptr<const Packet> packet)
     m_byteTagList.AddAtEnd(GetSize());
     ByteTagList copy = packet->m_byteTagList;
     copy.AddAtStart(0);
+    // cut the copy to the end of the packet too, so that the tags of the
+    // aggregated packet need not be cut again by the next aggregation
+    copy.AddAtEnd(packet->GetSize());
     copy.Adjust(GetSize());
     m_byteTagList.Add(copy);
+    m_headerCache.reset();
     m_buffer.AddAtEnd(packet->m_buffer);
     m_metadata.AddAtEnd(packet->m_metadata);
 }
@@ -357,7 +476,8 @@ Packet::AddPaddingAtEnd(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     m_byteTagList.AddAtEnd(GetSize());
-    m_buffer.AddAtEnd(size);
+    m_headerCache.reset();
+    m_buffer.AddZeroesAtEnd(size);
     m_metadata.AddPaddingAtEnd(size);
 }
 
@@ -365,6 +485,7 @@ void
 Packet::RemoveAtEnd(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
+    m_headerCache.reset();
     m_buffer.RemoveAtEnd(size);
     m_metadata.RemoveAtEnd(size);
 }
@@ -373,6 +494,7 @@ void
 Packet::RemoveAtStart(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
+    m_headerCache.reset();
     m_buffer.RemoveAtStart(size);
     m_byteTagList.Adjust(-size);
     m_metadata.RemoveAtStart(size);
@@ -595,6 +717,32 @@ Packet::EnableChecking()
     PacketMetadata::EnableChecking();
 }
 
+void
+Packet::EnableHeaderCache()
+{
+    NS_LOG_FUNCTION_NOARGS();
+#ifdef NS3_MTP
+    NS_LOG_WARN("The header cache is not used by the multithreaded simulator");
+#else
+    m_enableHeaderCache = true;
+#endif
+}
+
+#ifdef NS3_MTP
+uint64_t
+Packet::GetNextUid()
+{
+    return m_globalUid;
+}
+
+void
+Packet::SetNextUid(uint64_t uid)
+{
+    NS_LOG_FUNCTION(uid);
+    m_globalUid = uid;
+}
+#endif
+
 uint32_t
 Packet::GetSerializedSize() const
 {
@@ -1008,7 +1156,7 @@ Packet::PrintPacketTags(std::ostream& os) const
 PacketTagIterator
 Packet::GetPacketTagIterator() const
 {
-    return PacketTagIterator(m_packetTagList.Head());
+    return PacketTagIterator(m_packetTagList);
 }
 
 std::ostream&
@@ -22,7 +22,9 @@
 #include "ns3/mac48-address.h"
 #include "ns3/ptr.h"
 
+#include <memory>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -120,6 +122,11 @@ class ByteTagIterator
  * @brief Iterator over the set of packet tags in a packet
  *
  * This is a java-style iterator.
+ *
+ * The tags stored in the tree of the PacketTagList are visited first,
+ * then the tags stored inline, each in the reverse order of their
+ * addition.  A tag stored inline is thus visited after the tags of the
+ * tree, even if it was added before them.
  */
 class PacketTagIterator
 {
@@ -149,10 +156,14 @@ class PacketTagIterator
         friend class PacketTagIterator;
         /**
          * Constructor
-         * @param data the data to copy.
+         * @param tid the type of the tag.
+         * @param data the serialized tag.
+         * @param size the size of the serialized tag.
          */
-        Item(const PacketTagList::TagData* data);
-        const PacketTagList::TagData* m_data; //!< the tag data
+        Item(TypeId tid, const uint8_t* data, uint32_t size);
+        TypeId m_tid;          //!< the type of the tag
+        const uint8_t* m_data; //!< the serialized tag
+        uint32_t m_size;       //!< the size of the serialized tag
     };
 
     /**
@@ -169,10 +180,12 @@ class PacketTagIterator
     friend class Packet;
     /**
      * Constructor
-     * @param head head of the items
+     * @param list the tags of the packet
      */
-    PacketTagIterator(const PacketTagList::TagData* head);
-    const PacketTagList::TagData* m_current; //!< actual position over the set of tags in a packet
+    PacketTagIterator(const PacketTagList& list);
+    const PacketTagList* m_list;             //!< the tags of the packet
+    const PacketTagList::TagData* m_current; //!< actual position over the tags of the tree
+    uint32_t m_inline; //!< number of the tags stored inline which remain to be visited
 };
 
 /**
@@ -243,6 +256,7 @@ class Packet : public SimpleRefCount<Packet>
      * @return the copied object
      */
     Packet& operator=(const Packet& o);
+    ~Packet();
     /**
      * @brief Create a packet with a zero-filled payload.
      *
@@ -525,6 +539,41 @@ class Packet : public SimpleRefCount<Packet>
      * errors will be detected and will abort the program.
      */
     static void EnableChecking();
+    /**
+     * @brief Enable the cache of the deserialized headers.
+     *
+     * Each packet keeps a copy of the headers deserialized by PeekHeader,
+     * keyed by their TypeId and by the number of bytes they were allowed
+     * to read, so that peeking the same header again, or removing it,
+     * copies the cached header instead of deserializing it.  Any change
+     * of the packet buffer empties the cache.  Only the headers which
+     * implement Header::CopyHeader are cached, and a header which
+     * verifies a checksum is always deserialized.
+     *
+     * The cache is not used by the multithreaded simulator, since a
+     * packet can be peeked by several threads at the same time.
+     */
+    static void EnableHeaderCache();
+
+#ifdef NS3_MTP
+    /**
+     * @brief Get the uid of the next packet created by the calling thread.
+     *
+     * @returns the uid of the next packet created by the calling thread
+     */
+    static uint64_t GetNextUid();
+    /**
+     * @brief Set the uid of the next packet created by the calling thread.
+     *
+     * Each thread numbers the packets it creates with its own counter.
+     * The multithreaded simulator gives each partition its own range of
+     * uids, so that the uids of the packets created by different
+     * partitions never collide.
+     *
+     * @param uid the uid of the next packet created by the calling thread
+     */
+    static void SetNextUid(uint64_t uid);
+#endif
 
     /**
      * @brief Returns number of bytes required for packet
@@ -676,6 +725,9 @@ class Packet : public SimpleRefCount<Packet>
      *
      * @returns an object which can be used to iterate over the list of
      *  packet tags.
+     *
+     * The tags are not visited in the order they were added: see
+     * PacketTagIterator.
      */
     PacketTagIterator GetPacketTagIterator() const;
 
@@ -776,6 +828,39 @@ class Packet : public SimpleRefCount<Packet>
      */
     uint32_t Deserialize(const uint8_t* buffer, uint32_t size);
 
+    /**
+     * @brief A header deserialized from the start of the packet buffer.
+     */
+    struct CachedHeader
+    {
+        TypeId tid;                     //!< the type of the header
+        bool bounded;                   //!< whether the header was deserialized with a size
+        uint32_t size;                  //!< the size given to Deserialize, if bounded
+        uint32_t deserialized;          //!< the number of bytes deserialized
+        std::unique_ptr<Header> header; //!< the deserialized header
+    };
+
+    /**
+     * @brief Copy a cached header.
+     * @param header the header to set
+     * @param bounded whether the header is deserialized with a size
+     * @param size the size given to Deserialize, if bounded
+     * @param deserialized set to the number of bytes deserialized, if found
+     * @returns true if the header was found in the cache
+     */
+    bool PeekCachedHeader(Header& header,
+                          bool bounded,
+                          uint32_t size,
+                          uint32_t& deserialized) const;
+    /**
+     * @brief Add a deserialized header to the cache.
+     * @param header the header
+     * @param bounded whether the header was deserialized with a size
+     * @param size the size given to Deserialize, if bounded
+     * @param deserialized the number of bytes deserialized
+     */
+    void CacheHeader(const Header& header, bool bounded, uint32_t size, uint32_t deserialized) const;
+
     Buffer m_buffer;               //!< the packet buffer (it's actual contents)
     ByteTagList m_byteTagList;     //!< the ByteTag list
     PacketTagList m_packetTagList; //!< the packet's Tag list
@@ -784,7 +869,16 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+    /// the deserialized headers, allocated by the first header cached
+    mutable std::unique_ptr<std::vector<CachedHeader>> m_headerCache;
+    uint32_t m_accounting; //!< the slot of the creator, if accounted by PacketAccounting
+    static bool m_enableHeaderCache; //!< Enable the cache of the headers
+
+#ifdef NS3_MTP
+    static thread_local uint64_t m_globalUid; //!< Counter of the packets Uid of the thread
+#else
     static uint32_t m_globalUid; //!< Global counter of packets Uid
+#endif
 };
 
 /**
@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "size-class-pool.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <bit>
+#include <new>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup packet
+ * ns3::SizeClassPool implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SizeClassPool");
+
+uint32_t
+SizeClassPool::GetClass(uint32_t size)
+{
+    NS_ASSERT(size <= MAX_BLOCK);
+    if (size <= MIN_BLOCK)
+    {
+        return 0;
+    }
+    // 2^shift < size <= 2^(shift+1), split into four classes
+    uint32_t shift = std::bit_width(size - 1) - 1;
+    uint32_t step = 1U << (shift - 2);
+    uint32_t sub = (size - 1 - (1U << shift)) / step;
+    return 1 + (shift - MIN_SHIFT) * 4 + sub;
+}
+
+uint32_t
+SizeClassPool::GetClassSize(uint32_t sizeClass)
+{
+    if (sizeClass == 0)
+    {
+        return MIN_BLOCK;
+    }
+    uint32_t shift = MIN_SHIFT + (sizeClass - 1) / 4;
+    uint32_t sub = (sizeClass - 1) % 4;
+    return (1U << shift) + (sub + 1) * (1U << (shift - 2));
+}
+
+void*
+SizeClassPool::Acquire(uint32_t& size, bool& allocated)
+{
+    allocated = true;
+    if (size > MAX_BLOCK)
+    {
+        m_statistics.misses++;
+        return ::operator new(size);
+    }
+    uint32_t sizeClass = GetClass(size);
+    size = GetClassSize(sizeClass);
+    Block* block = m_heads[sizeClass];
+    if (block != nullptr)
+    {
+        m_heads[sizeClass] = block->m_next;
+        m_counts[sizeClass]--;
+        m_cachedBytes -= size;
+        m_statistics.hits++;
+        allocated = false;
+        return block;
+    }
+    if (!m_registered)
+    {
+        Register();
+    }
+    m_statistics.misses++;
+    return ::operator new(size);
+}
+
+void
+SizeClassPool::Release(void* block, uint32_t size)
+{
+    if (size <= MAX_BLOCK && !m_closed)
+    {
+        uint32_t sizeClass = GetClass(size);
+        NS_ASSERT_MSG(GetClassSize(sizeClass) == size, "Block of size " << size << " not acquired");
+        uint32_t highWaterMark = m_highWaterMark->load(std::memory_order_relaxed);
+        if (m_counts[sizeClass] < highWaterMark &&
+            m_cachedBytes + size <= uint64_t(highWaterMark) * BUDGET_PER_BLOCK)
+        {
+            auto cached = static_cast<Block*>(block);
+            cached->m_next = m_heads[sizeClass];
+            m_heads[sizeClass] = cached;
+            m_counts[sizeClass]++;
+            m_cachedBytes += size;
+            m_statistics.releases++;
+            if (!m_registered)
+            {
+                Register();
+            }
+            return;
+        }
+    }
+    m_statistics.overflows++;
+    ::operator delete(block);
+}
+
+void
+SizeClassPool::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    for (uint32_t i = 0; i < CLASSES; i++)
+    {
+        while (m_heads[i] != nullptr)
+        {
+            Block* block = m_heads[i];
+            m_heads[i] = block->m_next;
+            ::operator delete(block);
+        }
+        m_counts[i] = 0;
+    }
+    m_cachedBytes = 0;
+}
+
+SizeClassPool::Statistics
+SizeClassPool::GetStatistics() const
+{
+    return m_statistics;
+}
+
+void
+SizeClassPool::ResetStatistics()
+{
+    m_statistics = {0, 0, 0, 0};
+}
+
+void
+SizeClassPool::Register()
+{
+    /**
+     * Close the pools of a thread when it exits.  The thread_local
+     * objects of the main thread are destroyed before the static ones.
+     */
+    struct Closer
+    {
+        std::vector<SizeClassPool*> m_pools; //!< The pools of the thread.
+
+        ~Closer()
+        {
+            for (auto pool : m_pools)
+            {
+                pool->Close();
+            }
+        }
+    };
+
+    static thread_local Closer closer;
+    closer.m_pools.push_back(this);
+    m_registered = true;
+}
+
+void
+SizeClassPool::Close()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+    m_closed = true;
+}
+
+} // namespace ns3
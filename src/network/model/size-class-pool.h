@@ -0,0 +1,159 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SIZE_CLASS_POOL_H
+#define SIZE_CLASS_POOL_H
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * @file
+ * @ingroup packet
+ * ns3::SizeClassPool declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup packet
+ * @brief A cache of memory blocks, segregated by size class.
+ *
+ * The data storages of Buffer and PacketMetadata are recycled through
+ * pools, instead of being freed and allocated again for every packet.
+ * A pool is owned by a thread: it is declared as a constinit
+ * thread_local variable, so that its accesses need no lock nor
+ * initialization guard.  A block can be released by another thread
+ * than the one which acquired it, in which case it is cached by the
+ * pool of the releasing thread.
+ *
+ * The blocks are rounded up to size classes, four classes for each
+ * power of two from MIN_BLOCK to MAX_BLOCK bytes: a block released in a
+ * class can be reused for any request of this class.  Larger blocks are
+ * not cached.  Each class caches at most the high-water mark number of
+ * blocks, which is shared by all the threads, and a pool caches at most
+ * BUDGET_PER_BLOCK bytes for each block of the high-water mark: the large
+ * classes cannot hold the high-water mark number of blocks each.
+ *
+ * When its thread exits, the pool frees its blocks and stops caching:
+ * the blocks released later, by the destructors of static objects,
+ * are freed.
+ */
+class SizeClassPool
+{
+  public:
+    /**
+     * Statistics on the use of a pool.
+     */
+    struct Statistics
+    {
+        uint64_t hits;      //!< Number of blocks acquired from the cache
+        uint64_t misses;    //!< Number of blocks allocated
+        uint64_t releases;  //!< Number of blocks released to the cache
+        uint64_t overflows; //!< Number of blocks freed on release
+    };
+
+    /** The size of the smallest block, in bytes. */
+    static constexpr uint32_t MIN_BLOCK = 64;
+    /** The size of the largest block cached, in bytes. */
+    static constexpr uint32_t MAX_BLOCK = 65536;
+    /** The bytes cached by a pool for each block of the high-water mark. */
+    static constexpr uint32_t BUDGET_PER_BLOCK = 2048;
+
+    /**
+     * Constructor.
+     *
+     * @param [in] highWaterMark The maximum number of blocks cached in
+     *             each size class.
+     */
+    constexpr SizeClassPool(const std::atomic<uint32_t>* highWaterMark)
+        : m_highWaterMark(highWaterMark),
+          m_heads{},
+          m_counts{},
+          m_cachedBytes(0),
+          m_statistics{0, 0, 0, 0},
+          m_registered(false),
+          m_closed(false)
+    {
+    }
+
+    /**
+     * Acquire a block.
+     *
+     * @param [in,out] size The requested size of the block, in bytes; set
+     *                 to the size of the block acquired, which may be larger.
+     * @param [out] allocated Whether the block was allocated, rather than
+     *              taken from the cache.
+     * @returns The block.
+     */
+    void* Acquire(uint32_t& size, bool& allocated);
+    /**
+     * Release a block.
+     *
+     * @param [in] block The block.
+     * @param [in] size The size of the block, as returned by Acquire().
+     */
+    void Release(void* block, uint32_t size);
+    /**
+     * Free all the blocks cached.
+     */
+    void Clear();
+
+    /**
+     * @returns The statistics on the use of the pool since the last reset.
+     */
+    Statistics GetStatistics() const;
+    /**
+     * Reset the statistics on the use of the pool.
+     */
+    void ResetStatistics();
+
+  private:
+    /** The link between the blocks cached. */
+    struct Block
+    {
+        Block* m_next; //!< The next block of the class.
+    };
+
+    /** Log2 of MIN_BLOCK. */
+    static constexpr uint32_t MIN_SHIFT = 6;
+    /** The number of size classes. */
+    static constexpr uint32_t CLASSES = 1 + 4 * 10;
+
+    /**
+     * Get the class of a size.
+     *
+     * @param [in] size The size, at most MAX_BLOCK.
+     * @returns The class of the smallest blocks holding size bytes.
+     */
+    static uint32_t GetClass(uint32_t size);
+    /**
+     * Get the size of the blocks of a class.
+     *
+     * @param [in] sizeClass The class.
+     * @returns The size of the blocks, in bytes.
+     */
+    static uint32_t GetClassSize(uint32_t sizeClass);
+    /**
+     * Free the blocks when the thread exits.
+     */
+    void Register();
+    /**
+     * Free the blocks, and stop caching them.
+     */
+    void Close();
+
+    const std::atomic<uint32_t>* m_highWaterMark; //!< The maximum number of blocks of a class.
+    Block* m_heads[CLASSES];                      //!< The blocks cached in each class.
+    uint32_t m_counts[CLASSES];                   //!< The number of blocks of each class.
+    uint64_t m_cachedBytes;                       //!< The bytes of the blocks cached.
+    Statistics m_statistics;                      //!< The statistics.
+    bool m_registered; //!< Whether the blocks are freed when the thread exits.
+    bool m_closed;     //!< Whether the thread exited.
+};
+
+} // namespace ns3
+
+#endif /* SIZE_CLASS_POOL_H */
@@ -11,6 +11,10 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/test.h"
 
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -382,6 +386,383 @@ BufferTest::DoRun()
     val2 <<= 8;
     val2 |= i.ReadU8();
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
+
+    // The zero areas remain virtual when they are extended, or concatenated
+    buffer = Buffer(0);
+    buffer.AddAtStart(2);
+    i = buffer.Begin();
+    i.WriteU8(0x1);
+    i.WriteU8(0x2);
+    Buffer::ResetAllocationStatistics();
+    buffer.AddZeroesAtEnd(1000);
+    NS_TEST_ASSERT_MSG_EQ(buffer.GetSize(), 1002, "Bad size after AddZeroesAtEnd");
+    NS_TEST_ASSERT_MSG_EQ(Buffer::GetAllocationStatistics().allocations, 0, "Zeroes allocated");
+    NS_TEST_ASSERT_MSG_EQ(Buffer::GetAllocationStatistics().zeroBytes, 0, "Zeroes written");
+    i = buffer.Begin();
+    NS_TEST_ASSERT_MSG_EQ(i.ReadNtohU16(), 0x0102, "Bad data before the zeroes");
+    i.Next(998);
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU16(), 0, "Bad zeroes");
+    NS_TEST_ASSERT_MSG_EQ(i.IsEnd(), true, "Bad end after the zeroes");
+
+    // Fragments which share their data
+    Buffer whole = Buffer(1500);
+    Buffer fragment = whole.CreateFragment(0, 500);
+    fragment.AddAtEnd(whole.CreateFragment(500, 700));
+    fragment.AddAtEnd(whole.CreateFragment(1200, 300));
+    fragment.AddZeroesAtEnd(100);
+    NS_TEST_ASSERT_MSG_EQ(fragment.GetSize(), 1600, "Bad size of the fragments");
+#ifndef NS3_MTP
+    // the multithreaded simulator does not extend the zero area of shared data
+    NS_TEST_ASSERT_MSG_EQ(Buffer::GetAllocationStatistics().zeroBytes,
+                          0,
+                          "Zeroes of the fragments written");
+#endif
+    whole.AddAtEnd(1);
+    i = whole.End();
+    i.Prev();
+    i.WriteU8(0x3);
+    fragment.AddAtEnd(1);
+    i = fragment.End();
+    i.Prev();
+    i.WriteU8(0x7);
+    i = whole.End();
+    i.Prev();
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0x3, "Data overwritten by a fragment");
+    i = fragment.End();
+    i.Prev(2);
+    i.Prev();
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0, "Fragment overwritten");
+
+    // Data after the largest zero area
+    other = Buffer(0);
+    other.AddAtStart(3);
+    i = other.Begin();
+    i.WriteU8(0x4);
+    i.WriteU8(0x5);
+    i.WriteU8(0x6);
+    buffer.AddAtEnd(other);
+    NS_TEST_ASSERT_MSG_EQ(buffer.GetSize(), 1005, "Bad size after the data");
+    i = buffer.End();
+    i.Prev(4);
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0, "Bad zeroes before the data");
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0x4, "Bad data after the zeroes");
+    NS_TEST_ASSERT_MSG_EQ(i.ReadNtohU16(), 0x0506, "Bad data after the zeroes");
+
+    // Data before the largest zero area
+    other.AddAtEnd(buffer);
+    NS_TEST_ASSERT_MSG_EQ(other.GetSize(), 1008, "Bad size before the zeroes");
+    i = other.Begin();
+    i.Next(3);
+    NS_TEST_ASSERT_MSG_EQ(i.ReadNtohU16(), 0x0102, "Bad data before the zeroes");
+    i.Next(1000);
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0x4, "Bad data after the zeroes");
+#ifndef NS3_MTP
+    NS_TEST_ASSERT_MSG_EQ(Buffer::GetAllocationStatistics().zeroBytes,
+                          0,
+                          "Zeroes of the concatenation written");
+#endif
+    Buffer::Iterator end = other.End();
+    end.Prev(5);
+    NS_TEST_ASSERT_MSG_EQ(end.ReadU8(), 0, "Bad zeroes");
+
+    // Data after the zero areas of both buffers, which are merged
+    Buffer payload = Buffer(500);
+    payload.AddAtEnd(2);
+    i = payload.End();
+    i.Prev(2);
+    i.WriteU8(0x8);
+    i.WriteU8(0x9);
+    Buffer zeroes = Buffer(1000);
+    zeroes.AddAtEnd(payload);
+    NS_TEST_ASSERT_MSG_EQ(zeroes.GetSize(), 1502, "Bad size after the merged zeroes");
+    i = zeroes.End();
+    i.Prev(3);
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0, "Bad merged zeroes");
+    NS_TEST_ASSERT_MSG_EQ(i.ReadNtohU16(), 0x0809, "Bad data after the merged zeroes");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Buffer data storage pool tests.
+ */
+class BufferPoolTest : public TestCase
+{
+  public:
+    BufferPoolTest();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+BufferPoolTest::BufferPoolTest()
+    : TestCase("Buffer data storage pools")
+{
+}
+
+void
+BufferPoolTest::DoRun()
+{
+    Buffer::ClearPool();
+    Buffer::ResetPoolStatistics();
+    Buffer::ResetAllocationStatistics();
+    {
+        Buffer buffer(1000);
+    }
+    SizeClassPool::Statistics stats = Buffer::GetPoolStatistics();
+    NS_TEST_ASSERT_MSG_EQ(stats.misses, 1, "Storage not allocated");
+    NS_TEST_ASSERT_MSG_EQ(stats.releases, 1, "Storage not cached");
+    {
+        Buffer buffer(1000);
+    }
+    stats = Buffer::GetPoolStatistics();
+    NS_TEST_ASSERT_MSG_EQ(stats.hits, 1, "Storage not reused");
+    Buffer::AllocationStatistics allocations = Buffer::GetAllocationStatistics();
+    NS_TEST_ASSERT_MSG_EQ(allocations.allocations, 2, "Storages not counted");
+    NS_TEST_ASSERT_MSG_EQ(allocations.heapAllocations, 1, "Reused storage counted as allocated");
+
+    // A storage of another size class is allocated
+    {
+        Buffer buffer;
+        buffer.AddAtStart(10000);
+    }
+    stats = Buffer::GetPoolStatistics();
+    NS_TEST_ASSERT_MSG_EQ(stats.misses, 2, "Storage of another size class reused");
+
+    // Buffers created by another thread are cached by the thread which
+    // destroys them, while the pool of the other thread is not touched
+    std::vector<Buffer> buffers;
+    SizeClassPool::Statistics threadStats;
+    std::thread thread([&buffers, &threadStats]() {
+        for (uint32_t i = 0; i < 10; i++)
+        {
+            buffers.emplace_back(1000);
+        }
+        threadStats = Buffer::GetPoolStatistics();
+    });
+    thread.join();
+    NS_TEST_ASSERT_MSG_EQ(threadStats.hits, 0, "Pool of the main thread used by another thread");
+    NS_TEST_ASSERT_MSG_EQ(threadStats.misses, 10, "Storages not allocated by another thread");
+    uint64_t releases = Buffer::GetPoolStatistics().releases;
+    buffers.clear();
+    stats = Buffer::GetPoolStatistics();
+    NS_TEST_ASSERT_MSG_EQ(stats.releases - releases, 10, "Storages of another thread not cached");
+
+    // No storage is cached beyond the high-water mark
+    Buffer::SetPoolHighWaterMark(0);
+    {
+        Buffer buffer(1000);
+    }
+    stats = Buffer::GetPoolStatistics();
+    NS_TEST_ASSERT_MSG_EQ(stats.overflows, 1, "Storage cached beyond the high-water mark");
+
+    // The large storages are bounded by the bytes cached, before their number
+    Buffer::ClearPool();
+    Buffer::ResetPoolStatistics();
+    Buffer::SetPoolHighWaterMark(4);
+    buffers.clear();
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Buffer buffer;
+        buffer.AddAtStart(3000);
+        buffers.push_back(buffer);
+    }
+    SizeClassPool::Statistics before = Buffer::GetPoolStatistics();
+    buffers.clear();
+    stats = Buffer::GetPoolStatistics();
+    NS_TEST_ASSERT_MSG_EQ(stats.releases - before.releases, 2, "Storages not cached");
+    NS_TEST_ASSERT_MSG_EQ(stats.overflows - before.overflows,
+                          1,
+                          "Storages cached beyond the bytes of the pool");
+}
+
+void
+BufferPoolTest::DoTeardown()
+{
+    Buffer::SetPoolHighWaterMark(1000);
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Buffer scatter-gather mode tests.
+ */
+class BufferScatterGatherTest : public TestCase
+{
+  public:
+    BufferScatterGatherTest();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+    /**
+     * Checks the buffer content, read in place and through an iterator
+     * @param b The buffer to check
+     * @param expected The bytes which should be in the buffer
+     * @param msg Message
+     */
+    void Check(const Buffer& b, const std::vector<uint8_t>& expected, const std::string& msg);
+};
+
+BufferScatterGatherTest::BufferScatterGatherTest()
+    : TestCase("Buffer scatter-gather mode")
+{
+}
+
+void
+BufferScatterGatherTest::Check(const Buffer& b,
+                               const std::vector<uint8_t>& expected,
+                               const std::string& msg)
+{
+    NS_TEST_ASSERT_MSG_EQ(b.GetSize(), expected.size(), msg << ": bad size");
+    std::vector<uint8_t> data(expected.size() + 1);
+    NS_TEST_ASSERT_MSG_EQ(b.CopyData(data.data(), data.size()),
+                          expected.size(),
+                          msg << ": bad size copied");
+    data.pop_back();
+    NS_TEST_EXPECT_MSG_EQ((data == expected), true, msg << ": bad bytes copied");
+    Buffer flat = b;
+    Buffer::Iterator i = flat.Begin();
+    NS_TEST_EXPECT_MSG_EQ(i.GetSize(), expected.size(), msg << ": bad size of the iterator");
+    bool ok = true;
+    for (auto byte : expected)
+    {
+        ok = ok && (i.ReadU8() == byte);
+    }
+    NS_TEST_EXPECT_MSG_EQ(ok, true, msg << ": bad bytes read");
+    NS_TEST_EXPECT_MSG_EQ(i.IsEnd(), true, msg << ": bytes left");
+}
+
+void
+BufferScatterGatherTest::DoRun()
+{
+    Buffer::EnableScatterGather();
+
+    std::vector<Buffer> buffers;
+    std::vector<std::vector<uint8_t>> bytes;
+    for (uint32_t size : {300, 400, 500})
+    {
+        std::vector<uint8_t> data(size);
+        for (uint32_t k = 0; k < size; k++)
+        {
+            data[k] = static_cast<uint8_t>(k * 7 + size);
+        }
+        Buffer buffer;
+        buffer.AddAtStart(size);
+        buffer.Begin().Write(data.data(), size);
+        buffers.push_back(buffer);
+        bytes.push_back(data);
+    }
+
+    // The buffers are aggregated without allocating a storage
+    Buffer::ResetAllocationStatistics();
+    Buffer a = buffers[0];
+    a.AddAtEnd(buffers[1]);
+    a.AddAtEnd(buffers[2]);
+    std::vector<uint8_t> expected;
+    for (const auto& data : bytes)
+    {
+        expected.insert(expected.end(), data.begin(), data.end());
+    }
+    std::vector<uint8_t> copied(expected.size());
+    a.CopyData(copied.data(), copied.size());
+    NS_TEST_EXPECT_MSG_EQ((copied == expected), true, "Bad bytes of the chain");
+    NS_TEST_EXPECT_MSG_EQ(Buffer::GetAllocationStatistics().allocations,
+                          0,
+                          "Buffers copied when aggregated");
+
+    // Fragments are sliced by reference across the buffers
+    std::vector<std::pair<uint32_t, uint32_t>> ranges =
+        {{0, 1200}, {0, 300}, {300, 400}, {250, 100}, {299, 502}, {700, 500}, {1199, 1}, {600, 0}};
+    std::vector<Buffer> fragments;
+    for (auto [start, length] : ranges)
+    {
+        fragments.push_back(a.CreateFragment(start, length));
+    }
+    NS_TEST_EXPECT_MSG_EQ(Buffer::GetAllocationStatistics().allocations,
+                          0,
+                          "Buffers copied when fragmented");
+    for (std::size_t k = 0; k < ranges.size(); k++)
+    {
+        auto [start, length] = ranges[k];
+        std::vector<uint8_t> slice(expected.begin() + start, expected.begin() + start + length);
+        Check(fragments[k],
+              slice,
+              "Fragment " + std::to_string(start) + "+" + std::to_string(length));
+    }
+
+    // The chain is flattened once for the copies of a buffer
+    Buffer b = a;
+    Check(a, expected, "Chain");
+    uint64_t allocations = Buffer::GetAllocationStatistics().allocations;
+    Check(b, expected, "Copy of a chain");
+    NS_TEST_EXPECT_MSG_EQ(Buffer::GetAllocationStatistics().allocations,
+                          allocations,
+                          "Chain flattened twice");
+
+    // Bytes added at the start precede the chain
+    b = buffers[0];
+    b.AddAtEnd(buffers[1]);
+    b.AddAtStart(2);
+    b.AddAtStartContiguous(1)[0] = 0xaa;
+    std::vector<uint8_t> added = {0xaa, 0x33, 0x33};
+    added.insert(added.end(), expected.begin(), expected.begin() + 700);
+    Buffer::Iterator i = b.Begin();
+    i.Next();
+    i.WriteU8(0x33, 2);
+    Check(b, added, "Bytes added at the start");
+
+    // Small buffers and zeroes are appended to the last buffer of the chain
+    b = buffers[0];
+    b.AddAtEnd(buffers[1]);
+    Buffer small;
+    small.AddAtStart(3);
+    small.Begin().WriteU8(0x55, 3);
+    b.AddAtEnd(small);
+    b.AddZeroesAtEnd(1000);
+    b.AddAtEnd(Buffer(1000));
+    added.assign(expected.begin(), expected.begin() + 700);
+    added.insert(added.end(), 3, 0x55);
+    added.insert(added.end(), 2000, 0);
+    Buffer c = b;
+    c.RemoveAtStart(299);
+    c.RemoveAtEnd(1500);
+    Check(c, std::vector<uint8_t>(added.begin() + 299, added.end() - 1500), "Trimmed chain");
+    Check(b, added, "Small buffers and zeroes");
+
+    // Bytes added at the end are written through an iterator on the whole chain
+    c = a;
+    c.AddAtEnd(4);
+    Buffer::Iterator trailer = c.End();
+    NS_TEST_EXPECT_MSG_EQ(trailer.GetSize(), expected.size() + 4, "Chain not flattened");
+    trailer.Prev(4);
+    trailer.WriteU8(0x77, 4);
+    added = expected;
+    added.insert(added.end(), 4, 0x77);
+    Check(c, added, "Bytes added at the end");
+
+    // A chain can be appended to itself, or to its fragment
+    c = a;
+    c.AddAtEnd(c);
+    added = expected;
+    added.insert(added.end(), expected.begin(), expected.end());
+    Check(c, added, "Chain appended to itself");
+    c = a.CreateFragment(100, 300);
+    c.AddAtEnd(a);
+    added.assign(expected.begin() + 100, expected.begin() + 400);
+    added.insert(added.end(), expected.begin(), expected.end());
+    Check(c, added, "Chain appended to a fragment");
+    c.RemoveAtStart(1500);
+    Check(c, {}, "Chain removed");
+}
+
+void
+BufferScatterGatherTest::DoTeardown()
+{
+    Buffer::DisableScatterGather();
 }
 
 /**
@@ -400,6 +781,10 @@ BufferTestSuite::BufferTestSuite()
     : TestSuite("buffer", Type::UNIT)
 {
     AddTestCase(new BufferTest, TestCase::Duration::QUICK);
+    AddTestCase(new BufferPoolTest, TestCase::Duration::QUICK);
+#ifndef NS3_MTP
+    AddTestCase(new BufferScatterGatherTest, TestCase::Duration::QUICK);
+#endif
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
@@ -8,6 +8,8 @@
 #include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -76,6 +78,65 @@ DropTailQueueTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(packet, nullptr, "There are really no packets in there");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * DropTailQueue batch enqueue unit tests.
+ */
+class DropTailQueueBatchTestCase : public TestCase
+{
+  public:
+    DropTailQueueBatchTestCase();
+    void DoRun() override;
+};
+
+DropTailQueueBatchTestCase::DropTailQueueBatchTestCase()
+    : TestCase("Check the batch enqueue of the drop tail queue")
+{
+}
+
+void
+DropTailQueueBatchTestCase::DoRun()
+{
+    Ptr<DropTailQueue<Packet>> queue = CreateObject<DropTailQueue<Packet>>();
+    queue->SetAttribute("MaxSize", StringValue("1000B"));
+    std::vector<uint32_t> sizes; // the number of packets in the queue at each enqueue trace
+    uint32_t dropped = 0;
+    queue->TraceConnectWithoutContext(
+        "Enqueue",
+        Callback<void, Ptr<const Packet>>(
+            [&sizes, q = PeekPointer(queue)](Ptr<const Packet> packet) {
+                sizes.push_back(q->GetNPackets());
+            }));
+    queue->TraceConnectWithoutContext(
+        "DropBeforeEnqueue",
+        Callback<void, Ptr<const Packet>>([&dropped](Ptr<const Packet> packet) { dropped++; }));
+
+    // the third packet does not fit, but the fourth one does
+    std::vector<Ptr<Packet>> packets = {Create<Packet>(300),
+                                        Create<Packet>(400),
+                                        Create<Packet>(500),
+                                        Create<Packet>(200),
+                                        Create<Packet>(150)};
+    std::vector<Ptr<Packet>> batch = packets;
+    NS_TEST_EXPECT_MSG_EQ(queue->EnqueueBatch(batch), 3, "Wrong number of packets enqueued");
+    NS_TEST_EXPECT_MSG_EQ((sizes == std::vector<uint32_t>(3, 3)),
+                          true,
+                          "Packets not traced as enqueued once the size is updated");
+    NS_TEST_EXPECT_MSG_EQ(dropped, 2, "Wrong number of packets traced as dropped");
+    NS_TEST_ASSERT_MSG_EQ(batch.size(), 2, "Wrong number of packets returned as dropped");
+    NS_TEST_EXPECT_MSG_EQ(batch[0], packets[2], "Wrong first packet dropped");
+    NS_TEST_EXPECT_MSG_EQ(batch[1], packets[4], "Wrong second packet dropped");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNBytes(), 900, "Wrong number of bytes in the queue");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetTotalReceivedBytes(), 900, "Wrong number of bytes received");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetTotalDroppedPackets(), 2, "Wrong number of packets dropped");
+    for (auto index : {0, 1, 3})
+    {
+        NS_TEST_EXPECT_MSG_EQ(queue->Dequeue(), packets[index], "Wrong order of the packets");
+    }
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -89,6 +150,7 @@ class DropTailQueueTestSuite : public TestSuite
         : TestSuite("drop-tail-queue", Type::UNIT)
     {
         AddTestCase(new DropTailQueueTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new DropTailQueueBatchTestCase(), TestCase::Duration::QUICK);
     }
 };
 
@@ -315,7 +315,11 @@ HistoryTrailer<N>::Deserialize(Buffer::Iterator start)
 class PacketMetadataTest : public TestCase
 {
   public:
-    PacketMetadataTest();
+    /**
+     * Constructor
+     * @param fixedWidth Whether the metadata is stored as fixed-width records
+     */
+    PacketMetadataTest(bool fixedWidth);
     ~PacketMetadataTest() override;
     /**
      * Checks the packet header and trailer history
@@ -324,7 +328,9 @@ class PacketMetadataTest : public TestCase
      * @param ... The variable arguments
      */
     void CheckHistory(Ptr<Packet> p, uint32_t n, ...);
+    void DoSetup() override;
     void DoRun() override;
+    void DoTeardown() override;
 
   private:
     /**
@@ -333,10 +339,15 @@ class PacketMetadataTest : public TestCase
      * @return The packet with the header added.
      */
     Ptr<Packet> DoAddHeader(Ptr<Packet> p);
+
+    bool m_fixedWidth;    //!< Whether the metadata is stored as fixed-width records
+    bool m_wasFixedWidth; //!< Whether fixed-width records were selected before the test
 };
 
-PacketMetadataTest::PacketMetadataTest()
-    : TestCase("Packet metadata")
+PacketMetadataTest::PacketMetadataTest(bool fixedWidth)
+    : TestCase(fixedWidth ? "Packet metadata, fixed-width records" : "Packet metadata"),
+      m_fixedWidth(fixedWidth),
+      m_wasFixedWidth(false)
 {
 }
 
@@ -466,10 +477,23 @@ PacketMetadataTest::DoAddHeader(Ptr<Packet> p)
 }
 
 void
-PacketMetadataTest::DoRun()
+PacketMetadataTest::DoSetup()
 {
-    PacketMetadata::Enable();
+    m_wasFixedWidth = PacketMetadata::IsFixedWidthEnabled();
+    if (m_fixedWidth)
+    {
+        PacketMetadata::EnableFixedWidth();
+    }
+    else
+    {
+        PacketMetadata::Enable();
+        PacketMetadata::DisableFixedWidth();
+    }
+}
 
+void
+PacketMetadataTest::DoRun()
+{
     Ptr<Packet> p = Create<Packet>(0);
     Ptr<Packet> p1 = Create<Packet>(0);
 
@@ -870,6 +894,20 @@ PacketMetadataTest::DoRun()
                           "Could not find original data in received packet");
 }
 
+void
+PacketMetadataTest::DoTeardown()
+{
+    // restore the encoding selected before the test, even if it failed
+    if (m_wasFixedWidth)
+    {
+        PacketMetadata::EnableFixedWidth();
+    }
+    else
+    {
+        PacketMetadata::DisableFixedWidth();
+    }
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -885,7 +923,8 @@ class PacketMetadataTestSuite : public TestSuite
 PacketMetadataTestSuite::PacketMetadataTestSuite()
     : TestSuite("packet-metadata", Type::UNIT)
 {
-    AddTestCase(new PacketMetadataTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketMetadataTest(false), TestCase::Duration::QUICK);
+    AddTestCase(new PacketMetadataTest(true), TestCase::Duration::QUICK);
 }
 
 static PacketMetadataTestSuite g_packetMetadataTest; //!< Static variable for test initialization
@@ -5,16 +5,22 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/ethernet-header.h"
+#include "ns3/nstime.h"
+#include "ns3/packet-accounting.h"
 #include "ns3/packet-tag-list.h"
 #include "ns3/packet.h"
+#include "ns3/simulator.h"
 #include "ns3/test.h"
 
 #include <cstdarg>
+#include <cstring>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
 #include <limits> // std:numeric_limits
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -939,12 +945,101 @@ PacketTest::DoRun()
         CHECK(tmp, 1, E(25, 0, 50));
     }
 
+    /* Test aggregating contiguous fragments of a tagged packet */
+    {
+        Ptr<Packet> tmp = Create<Packet>(1000);
+        tmp->AddByteTag(ATestTag<20>());
+        Ptr<Packet> a = tmp->CreateFragment(0, 100);
+        a->AddAtEnd(tmp->CreateFragment(100, 200));
+        CHECK(a, 1, E(20, 0, 300));
+        a->AddAtEnd(tmp->CreateFragment(500, 100));
+        CHECK(a, 1, E(20, 0, 400));
+        Ptr<Packet> b = Create<Packet>(10);
+        b->AddByteTag(ATestTag<20>(1));
+        a->AddAtEnd(b);
+        CHECK_DATA(a, 2, E_DATA(20, 0, 400, 0), E_DATA(20, 400, 410, 1));
+        CHECK(tmp, 1, E(20, 0, 1000));
+    }
+
+    /* Test aggregating a packet whose tag extends before its start */
+    {
+        Ptr<Packet> tmp = Create<Packet>(100);
+        tmp->AddByteTag(ATestTag<21>());
+        tmp->RemoveAtStart(50);
+        Ptr<Packet> a = Create<Packet>(100);
+        a->AddByteTag(ATestTag<22>());
+        a->AddAtEnd(tmp);
+        CHECK_DATA(a, 2, E_DATA(22, 0, 100, 0), E_DATA(21, 100, 150, 0));
+    }
+
+    /* Test the fragments of a packet aggregating many tagged packets */
+    for (bool overall : {false, true})
+    {
+        Ptr<Packet> tmp = Create<Packet>(0);
+        for (uint8_t i = 0; i < 100; i++)
+        {
+            Ptr<Packet> a = Create<Packet>(10);
+            a->AddByteTag(ATestTag<2>(i));
+            tmp->AddAtEnd(a);
+        }
+        if (overall)
+        {
+            tmp->AddByteTag(ATestTag<3>(7));
+        }
+        Ptr<Packet> frag = tmp->CreateFragment(205, 20);
+        if (overall)
+        {
+            CHECK_DATA(frag,
+                       4,
+                       E_DATA(2, 0, 5, 20),
+                       E_DATA(2, 5, 15, 21),
+                       E_DATA(2, 15, 20, 22),
+                       E_DATA(3, 0, 20, 7));
+        }
+        else
+        {
+            CHECK_DATA(frag,
+                       3,
+                       E_DATA(2, 0, 5, 20),
+                       E_DATA(2, 5, 15, 21),
+                       E_DATA(2, 15, 20, 22));
+        }
+        frag = tmp->CreateFragment(990, 10);
+        frag->AddHeader(ATestHeader<10>());
+        CHECK_DATA(frag, overall ? 2 : 1, E_DATA(2, 10, 20, 99), E_DATA(3, 10, 20, 7));
+        frag = tmp->CreateFragment(1000, 0);
+        CHECK(frag, 0, E(0, 0, 0));
+    }
+
     /* Test ALargeTestTag */
     {
         Ptr<Packet> tmp = Create<Packet>(0);
         ALargeTestTag a;
         tmp->AddPacketTag(a);
     }
+
+    /* Test the contiguous serialization of a header */
+    for (bool preamble : {false, true})
+    {
+        EthernetHeader header(preamble);
+        header.SetSource(Mac48Address("00:00:00:00:00:01"));
+        header.SetDestination(Mac48Address("00:00:00:00:00:02"));
+        header.SetLengthType(0x0800);
+        header.SetPreambleSfd(0x0123456789abcdefULL);
+        uint32_t size = header.GetSerializedSize();
+
+        Buffer buffer;
+        buffer.AddAtStart(size);
+        header.Serialize(buffer.Begin());
+
+        Ptr<Packet> tmp = Create<Packet>(10);
+        tmp->AddHeader(header);
+        std::vector<uint8_t> contiguous(size);
+        tmp->CopyData(contiguous.data(), size);
+        NS_TEST_EXPECT_MSG_EQ((std::memcmp(buffer.PeekData(), contiguous.data(), size) == 0),
+                              true,
+                              "Contiguous serialization differs, preamble " << preamble);
+    }
 }
 
 /**
@@ -1194,6 +1289,64 @@ PacketTagListTest::DoRun()
         ReplaceCheck(7);
     }
 
+    // Tags stored inline and in the tree
+    {
+        std::cout << GetName() << "check iteration and serialization" << std::endl;
+        Ptr<Packet> p = Create<Packet>(10);
+        p->AddPacketTag(t1);
+        p->AddPacketTag(t2);
+        p->AddPacketTag(t3);
+        ALargeTestTag large;
+        p->AddPacketTag(large); // too large to be stored inline
+        p->AddPacketTag(t4);
+        p->AddPacketTag(t5); // no room left inline
+        p->AddPacketTag(t6);
+        p->AddPacketTag(t7);
+
+        // Most recent tags first, except for the ones stored inline
+        std::vector<TypeId> expected{t7.GetInstanceTypeId(),
+                                     t6.GetInstanceTypeId(),
+                                     t5.GetInstanceTypeId(),
+                                     large.GetInstanceTypeId(),
+                                     t4.GetInstanceTypeId(),
+                                     t3.GetInstanceTypeId(),
+                                     t2.GetInstanceTypeId(),
+                                     t1.GetInstanceTypeId()};
+        std::vector<TypeId> found;
+        PacketTagIterator i = p->GetPacketTagIterator();
+        while (i.HasNext())
+        {
+            found.push_back(i.Next().GetTypeId());
+        }
+        NS_TEST_EXPECT_MSG_EQ((found == expected), true, "Wrong order of the tags");
+
+        std::vector<uint8_t> buffer(p->GetSerializedSize());
+        NS_TEST_ASSERT_MSG_EQ(p->Serialize(buffer.data(), buffer.size()), 1, "Not serialized");
+        Ptr<Packet> q = Create<Packet>(buffer.data(), buffer.size(), true);
+        found.clear();
+        i = q->GetPacketTagIterator();
+        while (i.HasNext())
+        {
+            found.push_back(i.Next().GetTypeId());
+        }
+        NS_TEST_EXPECT_MSG_EQ((found == expected), true, "Wrong tags deserialized");
+        ATestTag<3> t3Copy;
+        NS_TEST_EXPECT_MSG_EQ(q->PeekPacketTag(t3Copy), true, "Tag stored inline not deserialized");
+        NS_TEST_EXPECT_MSG_EQ(t3Copy.GetData(),
+                              t3.GetData(),
+                              "Wrong tag stored inline deserialized");
+
+        // Removing a tag stored inline makes room for the next one
+        p->RemovePacketTag(t2);
+        ATestTag<8> t8(3);
+        p->AddPacketTag(t8);
+        Ptr<Packet> copy = p->Copy();
+        ATestTag<8> t8Copy;
+        NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(t8Copy), true, "Tag not copied");
+        NS_TEST_EXPECT_MSG_EQ(t8Copy.GetData(), 3, "Wrong tag copied");
+        NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(t2), false, "Removed tag copied");
+    }
+
     // Timing
     {
         std::cout << GetName() << "add+remove timing" << std::endl;
@@ -1257,6 +1410,243 @@ PacketTagListTest::DoRun()
     } // Timing
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test header which counts its deserializations, and can be cached.
+ *
+ * @note Class internal to packet-test-suite.cc
+ */
+class ACachedTestHeader : public Header
+{
+  public:
+    /**
+     * Register this type.
+     * @return The TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("anon::ACachedTestHeader")
+                                .SetParent<Header>()
+                                .SetGroupName("Network")
+                                .HideFromDocumentation()
+                                .AddConstructor<ACachedTestHeader>();
+        return tid;
+    }
+
+    TypeId GetInstanceTypeId() const override
+    {
+        return GetTypeId();
+    }
+
+    uint32_t GetSerializedSize() const override
+    {
+        return 4;
+    }
+
+    void Serialize(Buffer::Iterator iter) const override
+    {
+        iter.WriteHtonU32(m_value);
+    }
+
+    uint32_t Deserialize(Buffer::Iterator iter) override
+    {
+        m_deserializations++;
+        m_value = iter.ReadNtohU32();
+        return 4;
+    }
+
+    void Print(std::ostream& os) const override
+    {
+        os << m_value;
+    }
+
+    Header* CopyHeader() const override
+    {
+        return new ACachedTestHeader(*this);
+    }
+
+    bool AssignHeader(const Header& header) override
+    {
+        m_value = static_cast<const ACachedTestHeader&>(header).m_value;
+        return true;
+    }
+
+    uint32_t m_value{0};                //!< Header value
+    static uint32_t m_deserializations; //!< Number of deserializations
+};
+
+uint32_t ACachedTestHeader::m_deserializations = 0;
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Packet header cache unit tests.
+ */
+class PacketHeaderCacheTest : public TestCase
+{
+  public:
+    PacketHeaderCacheTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketHeaderCacheTest::PacketHeaderCacheTest()
+    : TestCase("Packet header cache")
+{
+}
+
+void
+PacketHeaderCacheTest::DoRun()
+{
+    Packet::EnableHeaderCache();
+    ACachedTestHeader::m_deserializations = 0;
+
+    ACachedTestHeader header;
+    header.m_value = 42;
+    Ptr<Packet> p = Create<Packet>(10);
+    p->AddHeader(header);
+
+    ACachedTestHeader peeked;
+    NS_TEST_EXPECT_MSG_EQ(p->PeekHeader(peeked), 4, "Wrong size peeked");
+    NS_TEST_EXPECT_MSG_EQ(peeked.m_value, 42, "Wrong header peeked");
+    peeked.m_value = 0;
+    NS_TEST_EXPECT_MSG_EQ(p->PeekHeader(peeked), 4, "Wrong size peeked from the cache");
+    NS_TEST_EXPECT_MSG_EQ(peeked.m_value, 42, "Wrong header peeked from the cache");
+    NS_TEST_EXPECT_MSG_EQ(ACachedTestHeader::m_deserializations, 1, "Header not cached");
+
+    // a header deserialized with a size is cached separately
+    NS_TEST_EXPECT_MSG_EQ(p->PeekHeader(peeked, 4), 4, "Wrong size peeked");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekHeader(peeked, 4), 4, "Wrong size peeked");
+    NS_TEST_EXPECT_MSG_EQ(ACachedTestHeader::m_deserializations, 2, "Bounded header not cached");
+
+    // a copy of the packet does not share the cache
+    Ptr<Packet> copy = p->Copy();
+    copy->PeekHeader(peeked);
+    NS_TEST_EXPECT_MSG_EQ(ACachedTestHeader::m_deserializations, 3, "Cache copied");
+
+    // any change of the buffer empties the cache
+    p->AddPaddingAtEnd(2);
+    p->PeekHeader(peeked);
+    NS_TEST_EXPECT_MSG_EQ(ACachedTestHeader::m_deserializations, 4, "Cache not emptied");
+
+    // removing a peeked header uses the cache
+    ACachedTestHeader removed;
+    NS_TEST_EXPECT_MSG_EQ(p->RemoveHeader(removed), 4, "Wrong size removed");
+    NS_TEST_EXPECT_MSG_EQ(removed.m_value, 42, "Wrong header removed");
+    NS_TEST_EXPECT_MSG_EQ(ACachedTestHeader::m_deserializations, 4, "Cache not used by remove");
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 12, "Header not removed");
+
+    // a new header replaces the cached one
+    header.m_value = 7;
+    p->AddHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(p->PeekHeader(peeked), 4, "Wrong size peeked");
+    NS_TEST_EXPECT_MSG_EQ(peeked.m_value, 7, "Stale header peeked");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Packet accounting unit tests.
+ */
+class PacketAccountingTest : public TestCase
+{
+  public:
+    PacketAccountingTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Count the samples of a creator.
+     * @param creator the creator sampled
+     * @param usage the usage of the creator
+     */
+    void Sampled(TypeId creator, const PacketAccounting::Usage& usage);
+
+    uint32_t m_samples{0}; //!< Number of samples of the usage of the test creator
+};
+
+PacketAccountingTest::PacketAccountingTest()
+    : TestCase("Packet accounting")
+{
+}
+
+void
+PacketAccountingTest::Sampled(TypeId creator, const PacketAccounting::Usage& usage)
+{
+    if (creator == PacketAccounting::GetTypeId())
+    {
+        NS_TEST_EXPECT_MSG_EQ(usage.packets, 1, "Wrong number of packets sampled");
+        m_samples++;
+    }
+}
+
+void
+PacketAccountingTest::DoRun()
+{
+    PacketAccounting::Enable();
+    // creators which no other test attributes packets to
+    TypeId creator = PacketAccounting::GetTypeId();
+    TypeId inner = TypeId::LookupByName("ns3::Object");
+
+    Ptr<Packet> p1;
+    Ptr<Packet> p2;
+    Ptr<Packet> p3;
+    {
+        PacketAccounting::Scope scope(creator);
+        p1 = Create<Packet>(100);
+        p2 = Create<Packet>(200);
+        {
+            PacketAccounting::Scope innerScope(inner);
+            p3 = Create<Packet>(300);
+        }
+        p2->AddAtEnd(Create<Packet>(50));
+    }
+    // copies are attributed to the creator of the packet copied
+    Ptr<Packet> copy = p1->Copy();
+
+    auto usage = PacketAccounting::GetUsage();
+    NS_TEST_ASSERT_MSG_EQ((usage.count(creator) == 1), true, "Creator not accounted");
+    NS_TEST_EXPECT_MSG_EQ(usage[creator].packets, 3, "Wrong number of packets");
+    NS_TEST_EXPECT_MSG_EQ(usage[creator].peakPackets, 3, "Wrong peak number of packets");
+    NS_TEST_EXPECT_MSG_GT(usage[creator].bytes, 0, "Data storages not accounted");
+    NS_TEST_EXPECT_MSG_EQ(usage[inner].packets, 1, "Inner scope not accounted");
+
+    p1 = nullptr;
+    p2 = nullptr;
+    p3 = nullptr;
+    usage = PacketAccounting::GetUsage();
+    NS_TEST_EXPECT_MSG_EQ(usage[creator].packets, 1, "Packets not released");
+    NS_TEST_EXPECT_MSG_EQ(usage[inner].packets, 0, "Packets not released");
+    NS_TEST_EXPECT_MSG_EQ(usage[inner].bytes, 0, "Data storages not released");
+    NS_TEST_EXPECT_MSG_EQ(usage[creator].peakPackets, 3, "Peak lost");
+
+    PacketAccounting::ResetPeaks();
+    usage = PacketAccounting::GetUsage();
+    NS_TEST_EXPECT_MSG_EQ(usage[creator].peakPackets, 1, "Peak not reset");
+
+    // the usage is sampled at 0, 1 and 2 seconds
+    auto accounting = CreateObjectWithAttributes<PacketAccounting>("Interval",
+                                                                  TimeValue(Seconds(1)));
+    accounting->TraceConnectWithoutContext(
+        "Usage",
+        MakeCallback(&PacketAccountingTest::Sampled, this));
+    accounting->Start();
+    Simulator::Stop(Seconds(2.5));
+    Simulator::Run();
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(m_samples, 3, "Wrong number of samples");
+
+    copy = nullptr;
+    usage = PacketAccounting::GetUsage();
+    NS_TEST_EXPECT_MSG_EQ(usage[creator].packets, 0, "Copy not released");
+    NS_TEST_EXPECT_MSG_EQ(usage[creator].bytes, 0, "Data storages not released");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1274,6 +1664,10 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+#ifndef NS3_MTP
+    AddTestCase(new PacketHeaderCacheTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketAccountingTest, TestCase::Duration::QUICK);
+#endif
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
@@ -36,6 +36,7 @@ class DropTailQueue : public Queue<Item>
     ~DropTailQueue() override;
 
     bool Enqueue(Ptr<Item> item) override;
+    uint32_t EnqueueBatch(std::vector<Ptr<Item>>& items) override;
     Ptr<Item> Dequeue() override;
     Ptr<Item> Remove() override;
     Ptr<const Item> Peek() const override;
@@ -43,6 +44,7 @@ class DropTailQueue : public Queue<Item>
   private:
     using Queue<Item>::GetContainer;
     using Queue<Item>::DoEnqueue;
+    using Queue<Item>::DoEnqueueBatch;
     using Queue<Item>::DoDequeue;
     using Queue<Item>::DoRemove;
     using Queue<Item>::DoPeek;
@@ -94,6 +96,15 @@ DropTailQueue<Item>::Enqueue(Ptr<Item> item)
     return DoEnqueue(GetContainer().end(), item);
 }
 
+template <typename Item>
+uint32_t
+DropTailQueue<Item>::EnqueueBatch(std::vector<Ptr<Item>>& items)
+{
+    NS_LOG_FUNCTION(this << items.size());
+
+    return DoEnqueueBatch(GetContainer().end(), items);
+}
+
 template <typename Item>
 Ptr<Item>
 DropTailQueue<Item>::Dequeue()
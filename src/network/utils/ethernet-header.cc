@@ -167,6 +167,25 @@ EthernetHeader::Serialize(Buffer::Iterator start) const
     i.WriteHtonU16(m_lengthType);
 }
 
+bool
+EthernetHeader::SerializeContiguous(uint8_t* start, uint32_t size) const
+{
+    NS_LOG_FUNCTION(this << &start << size);
+    uint8_t* i = start;
+
+    if (m_enPreambleSfd)
+    {
+        i = WriteHtolsbU32(i, m_preambleSfd & 0xffffffff);
+        i = WriteHtolsbU32(i, m_preambleSfd >> 32);
+    }
+    m_destination.CopyTo(i);
+    i += MAC_ADDR_SIZE;
+    m_source.CopyTo(i);
+    i += MAC_ADDR_SIZE;
+    WriteHtonU16(i, m_lengthType);
+    return true;
+}
+
 uint32_t
 EthernetHeader::Deserialize(Buffer::Iterator start)
 {
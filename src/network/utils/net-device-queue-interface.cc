@@ -14,6 +14,8 @@
 #include "ns3/abort.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -44,6 +46,7 @@ NetDeviceQueue::~NetDeviceQueue()
     m_queueLimits = nullptr;
     m_wakeCallback.Nullify();
     m_device = nullptr;
+    m_queueRoom = nullptr;
 }
 
 bool
@@ -53,6 +56,28 @@ NetDeviceQueue::IsStopped() const
     return m_stoppedByDevice || m_stoppedByQueueLimits;
 }
 
+uint32_t
+NetDeviceQueue::GetAvailablePackets() const
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_queueRoom)
+    {
+        return 1;
+    }
+
+    uint32_t room = m_queueRoom();
+    if (m_queueLimits)
+    {
+        // the queue is stopped by BQL once the queue limits are exceeded
+        int32_t available = m_queueLimits->Available();
+        uint32_t limit =
+            (available < 0 ? 0 : static_cast<uint32_t>(available) / m_device->GetMtu() + 1);
+        room = std::min(room, limit);
+    }
+    return room;
+}
+
 void
 NetDeviceQueue::Start()
 {
@@ -14,6 +14,7 @@
 #include "ns3/object-factory.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/queue-size.h"
 #include "ns3/simulator.h"
 
 #include <functional>
@@ -83,6 +84,17 @@ class NetDeviceQueue : public Object
      */
     virtual bool IsStopped() const;
 
+    /**
+     * @brief Get the number of packets the device transmission queue can take.
+     * @return the number of packets of the size of the MTU which can be queued to
+     *         the device queue without overflowing it, and without exceeding the
+     *         queue limits by more than one packet, or 1 if the traces of the
+     *         device queue are not connected.
+     *
+     * Called by queue discs to bound the number of packets sent to the device at once.
+     */
+    uint32_t GetAvailablePackets() const;
+
     /**
      * @brief Notify this NetDeviceQueue that the NetDeviceQueueInterface was
      *        aggregated to an object.
@@ -199,6 +211,7 @@ class NetDeviceQueue : public Object
     Ptr<QueueLimits> m_queueLimits; //!< Queue limits object
     WakeCallback m_wakeCallback;    //!< Wake callback
     Ptr<NetDevice> m_device;        //!< the netdevice aggregated to the NetDeviceQueueInterface
+    std::function<uint32_t()> m_queueRoom; //!< Room in the device queue, in MTU-sized packets
 
     NS_LOG_TEMPLATE_DECLARE; //!< redefinition of the log component
 };
@@ -323,6 +336,18 @@ NetDeviceQueue::ConnectQueueTraces(Ptr<QueueType> queue)
     queue->TraceConnectWithoutContext(
         "DropBeforeEnqueue",
         MakeCallback(&NetDeviceQueue::PacketDiscarded<QueueType>, this).Bind(PeekPointer(queue)));
+    m_queueRoom = [this, queue = PeekPointer(queue)]() -> uint32_t {
+        QueueSize maxSize = queue->GetMaxSize();
+        QueueSize size = queue->GetCurrentSize();
+        uint32_t room =
+            maxSize.GetValue() > size.GetValue() ? maxSize.GetValue() - size.GetValue() : 0;
+        if (maxSize.GetUnit() == QueueSizeUnit::BYTES)
+        {
+            NS_ASSERT_MSG(m_device, "Aggregated NetDevice not set");
+            room /= m_device->GetMtu();
+        }
+        return room;
+    };
 }
 
 template <typename QueueType>
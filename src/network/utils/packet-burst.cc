@@ -76,6 +76,13 @@ PacketBurst::AddPacket(Ptr<Packet> packet)
     }
 }
 
+void
+PacketBurst::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_packets.clear();
+}
+
 std::list<Ptr<Packet>>
 PacketBurst::GetPackets() const
 {
@@ -41,6 +41,10 @@ class PacketBurst : public Object
      * @param packet the packet to add
      */
     void AddPacket(Ptr<Packet> packet);
+    /**
+     * @brief remove all the packets from the burst, so that it can be reused
+     */
+    void Clear();
     /**
      * @return the list of packet of this burst
      */
@@ -24,6 +24,7 @@
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 namespace ns3
 {
@@ -272,6 +273,15 @@ class Queue : public QueueBase
      */
     virtual bool Enqueue(Ptr<Item> item) = 0;
 
+    /**
+     * Place the items into the Queue, in order, as Enqueue does for each of
+     * them: every item is counted and traced as enqueued or as dropped.
+     * @param [in,out] items the items to enqueue; on return, the items which
+     *        have been dropped
+     * @return the number of items enqueued
+     */
+    virtual uint32_t EnqueueBatch(std::vector<Ptr<Item>>& items);
+
     /**
      * Remove an item from the Queue (each subclass defines the position),
      * counting it and tracing it as dequeued
@@ -333,6 +343,19 @@ class Queue : public QueueBase
      */
     bool DoEnqueue(ConstIterator pos, Ptr<Item> item, Iterator& ret);
 
+    /**
+     * Push several items in the queue, in order, before the same position.
+     * Each item is admitted if it fits in the queue with the items admitted
+     * before it, as DoEnqueue would do, but the size of the queue and its
+     * statistics are updated once for the whole batch, before the items
+     * are traced as enqueued or dropped.
+     * @param pos the position before which the items will be inserted
+     * @param [in,out] items the items to enqueue; on return, the items which
+     *        have been dropped
+     * @return the number of items enqueued
+     */
+    uint32_t DoEnqueueBatch(ConstIterator pos, std::vector<Ptr<Item>>& items);
+
     /**
      * Pull the item to dequeue from the queue
      * @param pos the position of the item to dequeue
@@ -495,6 +518,25 @@ Queue<Item, Container>::GetContainer() const
     return m_packets;
 }
 
+template <typename Item, typename Container>
+uint32_t
+Queue<Item, Container>::EnqueueBatch(std::vector<Ptr<Item>>& items)
+{
+    NS_LOG_FUNCTION(this << items.size());
+
+    std::size_t nDropped = 0;
+    for (auto& item : items)
+    {
+        if (!Enqueue(item))
+        {
+            items[nDropped++] = item;
+        }
+    }
+    uint32_t nEnqueued = items.size() - nDropped;
+    items.resize(nDropped);
+    return nEnqueued;
+}
+
 template <typename Item, typename Container>
 bool
 Queue<Item, Container>::DoEnqueue(ConstIterator pos, Ptr<Item> item)
@@ -531,6 +573,65 @@ Queue<Item, Container>::DoEnqueue(ConstIterator pos, Ptr<Item> item, Iterator& r
     return true;
 }
 
+template <typename Item, typename Container>
+uint32_t
+Queue<Item, Container>::DoEnqueueBatch(ConstIterator pos, std::vector<Ptr<Item>>& items)
+{
+    NS_LOG_FUNCTION(this << items.size());
+
+    QueueSize maxSize = GetMaxSize();
+    bool inPackets = (maxSize.GetUnit() == QueueSizeUnit::PACKETS);
+    uint32_t current = inPackets ? m_nPackets.Get() : m_nBytes.Get();
+    // whether an item fits in the queue filled up to used
+    auto admit = [inPackets, &maxSize](uint32_t& used, const Ptr<Item>& item) {
+        uint32_t size = inPackets ? 1 : item->GetSize();
+        if (used + size > maxSize.GetValue())
+        {
+            return false;
+        }
+        used += size;
+        return true;
+    };
+
+    uint32_t nPackets = 0;
+    uint32_t nBytes = 0;
+    uint32_t used = current;
+    for (const auto& item : items)
+    {
+        if (admit(used, item))
+        {
+            m_packets.insert(pos, item);
+            nPackets++;
+            nBytes += item->GetSize();
+        }
+    }
+
+    m_nBytes += nBytes;
+    m_nTotalReceivedBytes += nBytes;
+    m_nPackets += nPackets;
+    m_nTotalReceivedPackets += nPackets;
+
+    // trace the items in order, taking the same decisions again
+    std::size_t nDropped = 0;
+    used = current;
+    for (auto& item : items)
+    {
+        if (admit(used, item))
+        {
+            NS_LOG_LOGIC("m_traceEnqueue (p)");
+            m_traceEnqueue(item);
+        }
+        else
+        {
+            NS_LOG_LOGIC("Queue full -- dropping pkt");
+            DropBeforeEnqueue(item);
+            items[nDropped++] = item;
+        }
+    }
+    items.resize(nDropped);
+    return nPackets;
+}
+
 template <typename Item, typename Container>
 Ptr<Item>
 Queue<Item, Container>::DoDequeue(ConstIterator pos)
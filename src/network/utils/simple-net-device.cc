@@ -8,6 +8,7 @@
 #include "simple-net-device.h"
 
 #include "error-model.h"
+#include "packet-burst.h"
 #include "queue.h"
 #include "simple-channel.h"
 
@@ -449,6 +450,36 @@ SimpleNetDevice::SendFrom(Ptr<Packet> p,
     return false;
 }
 
+uint32_t
+SimpleNetDevice::SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << burst << dest << protocolNumber);
+
+    SimpleTag tag;
+    tag.SetSrc(m_address);
+    tag.SetDst(Mac48Address::ConvertFrom(dest));
+    tag.SetProto(protocolNumber);
+
+    std::vector<Ptr<Packet>> packets;
+    packets.reserve(burst->GetNPackets());
+    for (auto it = burst->Begin(); it != burst->End(); ++it)
+    {
+        if ((*it)->GetSize() <= GetMtu())
+        {
+            (*it)->AddPacketTag(tag);
+            packets.push_back(*it);
+        }
+    }
+
+    bool idle = m_queue->GetNPackets() == 0 && !FinishTransmissionEvent.IsPending();
+    uint32_t nEnqueued = m_queue->EnqueueBatch(packets);
+    if (idle && nEnqueued > 0)
+    {
+        StartTransmission();
+    }
+    return nEnqueued;
+}
+
 void
 SimpleNetDevice::StartTransmission()
 {
@@ -113,6 +113,9 @@ class SimpleNetDevice : public NetDevice
     bool IsPointToPoint() const override;
     bool IsBridge() const override;
     bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) override;
+    uint32_t SendBurst(Ptr<PacketBurst> burst,
+                       const Address& dest,
+                       uint16_t protocolNumber) override;
     bool SendFrom(Ptr<Packet> packet,
                   const Address& source,
                   const Address& dest,
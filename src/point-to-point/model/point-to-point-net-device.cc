@@ -13,6 +13,7 @@
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
 #include "ns3/mac48-address.h"
+#include "ns3/packet-burst.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
@@ -548,6 +549,51 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
     return false;
 }
 
+uint32_t
+PointToPointNetDevice::SendBurst(Ptr<PacketBurst> burst,
+                                 const Address& dest,
+                                 uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << burst << dest << protocolNumber);
+
+    if (!IsLinkUp())
+    {
+        for (auto it = burst->Begin(); it != burst->End(); ++it)
+        {
+            m_macTxDropTrace(*it);
+        }
+        return 0;
+    }
+
+    std::vector<Ptr<Packet>> packets;
+    packets.reserve(burst->GetNPackets());
+    for (auto it = burst->Begin(); it != burst->End(); ++it)
+    {
+        AddHeader(*it, protocolNumber);
+        m_macTxTrace(*it);
+        packets.push_back(*it);
+    }
+
+    //
+    // Enqueue the whole burst, then start transmitting its first packet if
+    // the channel is ready, as Send does for a single packet.
+    //
+    uint32_t nEnqueued = m_queue->EnqueueBatch(packets);
+    for (const auto& packet : packets)
+    {
+        m_macTxDropTrace(packet);
+    }
+
+    if (nEnqueued > 0 && m_txMachineState == READY)
+    {
+        Ptr<Packet> packet = m_queue->Dequeue();
+        m_snifferTrace(packet);
+        m_promiscSnifferTrace(packet);
+        TransmitStart(packet);
+    }
+    return nEnqueued;
+}
+
 bool
 PointToPointNetDevice::SendFrom(Ptr<Packet> packet,
                                 const Address& source,
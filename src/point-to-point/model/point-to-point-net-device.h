@@ -170,6 +170,9 @@ class PointToPointNetDevice : public NetDevice
     bool IsBridge() const override;
 
     bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) override;
+    uint32_t SendBurst(Ptr<PacketBurst> burst,
+                       const Address& dest,
+                       uint16_t protocolNumber) override;
     bool SendFrom(Ptr<Packet> packet,
                   const Address& source,
                   const Address& dest,
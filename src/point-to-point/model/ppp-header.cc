@@ -75,6 +75,13 @@ PppHeader::Serialize(Buffer::Iterator start) const
     start.WriteHtonU16(m_protocol);
 }
 
+bool
+PppHeader::SerializeContiguous(uint8_t* start, uint32_t size) const
+{
+    WriteHtonU16(start, m_protocol);
+    return true;
+}
+
 uint32_t
 PppHeader::Deserialize(Buffer::Iterator start)
 {
@@ -63,6 +63,7 @@ class PppHeader : public Header
 
     void Print(std::ostream& os) const override;
     void Serialize(Buffer::Iterator start) const override;
+    bool SerializeContiguous(uint8_t* start, uint32_t size) const override;
     uint32_t Deserialize(Buffer::Iterator start) override;
     uint32_t GetSerializedSize() const override;
 
@@ -10,6 +10,7 @@
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/point-to-point-net-device.h"
+#include "ns3/ppp-header.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
@@ -128,6 +129,49 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @brief Test of the contiguous serialization of PppHeader
+ *
+ * It checks that SerializeContiguous writes the bytes written by Serialize.
+ */
+class PppHeaderContiguousTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    PppHeaderContiguousTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+};
+
+PppHeaderContiguousTest::PppHeaderContiguousTest()
+    : TestCase("PppHeader contiguous serialization")
+{
+}
+
+void
+PppHeaderContiguousTest::DoRun()
+{
+    for (uint16_t protocol : {0x0021, 0x0057, 0xc021, 0xfedc})
+    {
+        PppHeader header;
+        header.SetProtocol(protocol);
+        Buffer buffer;
+        buffer.AddAtStart(header.GetSerializedSize());
+        header.Serialize(buffer.Begin());
+
+        uint8_t contiguous[2];
+        NS_TEST_ASSERT_MSG_EQ(header.SerializeContiguous(contiguous, 2), true, "Not serialized");
+        NS_TEST_EXPECT_MSG_EQ(memcmp(buffer.PeekData(), contiguous, 2),
+                              0,
+                              "Contiguous serialization differs, protocol " << protocol);
+    }
+}
+
 /**
  * @brief TestSuite for PointToPoint module
  */
@@ -144,6 +188,7 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PppHeaderContiguousTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -8,9 +8,12 @@
 #ifndef PROPAGATION_CACHE_H_
 #define PROPAGATION_CACHE_H_
 
+#include "ns3/callback.h"
 #include "ns3/mobility-model.h"
 
 #include <map>
+#include <tuple>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -143,6 +146,205 @@ class PropagationCache
   private:
     PathCache m_pathCache; //!< Path cache
 };
+
+/**
+ * @ingroup propagation
+ * @brief Cache of values computed for each directed propagation link, identified by the
+ * MobilityModels of the transmitter and of the receiver and by a model UID.
+ *
+ * A value remains valid until the CourseChange trace of the mobility model of either end
+ * of the link is fired. Since a mobility model with a non-zero velocity moves without
+ * notifying a course change, the positions of such an end are also compared, when the
+ * value is looked up, with the positions at which the value was computed: the value is
+ * no longer valid if either end moved by more than a tolerance.
+ */
+template <class T>
+class PropagationLinkCache
+{
+  public:
+    PropagationLinkCache()
+        : m_positionTolerance(0)
+    {
+    }
+
+    ~PropagationLinkCache()
+    {
+        Cleanup();
+    }
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    PropagationLinkCache(const PropagationLinkCache&) = delete;
+    PropagationLinkCache& operator=(const PropagationLinkCache&) = delete;
+
+    /**
+     * Set the distance by which a moving end of a link can move before the values of the
+     * link are no longer valid.
+     *
+     * @param tolerance the tolerance, in meters
+     */
+    void SetPositionTolerance(double tolerance)
+    {
+        m_positionTolerance = tolerance;
+    }
+
+    /**
+     * @return the distance by which a moving end of a link can move before the values of
+     * the link are no longer valid, in meters
+     */
+    double GetPositionTolerance() const
+    {
+        return m_positionTolerance;
+    }
+
+    /**
+     * Get the value of the link, if it is still valid.
+     * @param a mobility model of the transmitter
+     * @param b mobility model of the receiver
+     * @param modelUid model UID
+     * @return a pointer to the value, or a null pointer if it is not found or no longer valid
+     */
+    const T* Find(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid) const
+    {
+        auto it = m_links.find({PeekPointer(a), PeekPointer(b), modelUid});
+        if (it == m_links.end())
+        {
+            return nullptr;
+        }
+        const auto& link = it->second;
+        if (link.versionA != m_mobilities.at(PeekPointer(a)).version ||
+            link.versionB != m_mobilities.at(PeekPointer(b)).version)
+        {
+            return nullptr;
+        }
+        if ((link.movingA &&
+             CalculateDistance(a->GetPosition(), link.positionA) > m_positionTolerance) ||
+            (link.movingB &&
+             CalculateDistance(b->GetPosition(), link.positionB) > m_positionTolerance))
+        {
+            return nullptr;
+        }
+        return &link.value;
+    }
+
+    /**
+     * Set the value of the link, computed at the current positions of its ends.
+     * @param value the value
+     * @param a mobility model of the transmitter
+     * @param b mobility model of the receiver
+     * @param modelUid model UID
+     */
+    void Add(T value, Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid)
+    {
+        auto& link = m_links[{PeekPointer(a), PeekPointer(b), modelUid}];
+        link.value = std::move(value);
+        link.versionA = Track(a);
+        link.versionB = Track(b);
+        link.movingA = IsMoving(a);
+        link.movingB = IsMoving(b);
+        link.positionA = a->GetPosition();
+        link.positionB = b->GetPosition();
+    }
+
+    /**
+     * Clean the cache
+     */
+    void Cleanup()
+    {
+        for (auto& [pointer, mobility] : m_mobilities)
+        {
+            // connecting a trace sink does not modify the mobility model
+            ConstCast<MobilityModel>(mobility.model)
+                ->TraceDisconnectWithoutContext(
+                    "CourseChange",
+                    MakeCallback(&PropagationLinkCache<T>::CourseChanged, this));
+        }
+        m_mobilities.clear();
+        m_links.clear();
+    }
+
+  private:
+    /// A link is identified by the mobility models of its ends and by a model UID
+    using LinkIdentifier = std::tuple<const MobilityModel*, const MobilityModel*, uint32_t>;
+
+    /// Hash function of the identifier of a link
+    struct LinkIdentifierHash
+    {
+        /**
+         * @param id the identifier of a link
+         * @return the hash of the identifier
+         */
+        std::size_t operator()(const LinkIdentifier& id) const
+        {
+            const auto [a, b, modelUid] = id;
+            return std::hash<const MobilityModel*>{}(a) ^
+                   (std::hash<const MobilityModel*>{}(b) << 1) ^
+                   (static_cast<std::size_t>(modelUid) << 2);
+        }
+    };
+
+    /// The value of a link and the state of its ends when it was computed
+    struct Link
+    {
+        T value;          //!< the value
+        uint64_t versionA; //!< the course change count of the transmitter
+        uint64_t versionB; //!< the course change count of the receiver
+        bool movingA;     //!< whether the transmitter was moving
+        bool movingB;     //!< whether the receiver was moving
+        Vector positionA; //!< the position of the transmitter
+        Vector positionB; //!< the position of the receiver
+    };
+
+    /// A mobility model whose course changes are counted
+    struct TrackedMobility
+    {
+        Ptr<const MobilityModel> model; //!< the mobility model
+        uint64_t version;               //!< the number of course changes
+    };
+
+    /**
+     * @param mobility a mobility model
+     * @return whether the mobility model has a non-zero velocity
+     */
+    static bool IsMoving(Ptr<const MobilityModel> mobility)
+    {
+        const auto velocity = mobility->GetVelocity();
+        return velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+    }
+
+    /**
+     * Count the course changes of a mobility model, if not done yet.
+     * @param mobility the mobility model
+     * @return the number of course changes of the mobility model
+     */
+    uint64_t Track(Ptr<const MobilityModel> mobility)
+    {
+        auto [it, inserted] = m_mobilities.try_emplace(PeekPointer(mobility));
+        if (inserted)
+        {
+            it->second = {mobility, 0};
+            // connecting a trace sink does not modify the mobility model
+            ConstCast<MobilityModel>(mobility)->TraceConnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&PropagationLinkCache<T>::CourseChanged, this));
+        }
+        return it->second.version;
+    }
+
+    /**
+     * Callback for the CourseChange trace of the mobility models.
+     * @param mobility the mobility model whose course changed
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility)
+    {
+        m_mobilities.at(PeekPointer(mobility)).version++;
+    }
+
+    double m_positionTolerance; //!< the tolerance on the positions of the moving ends
+    std::unordered_map<LinkIdentifier, Link, LinkIdentifierHash> m_links; //!< the links
+    std::unordered_map<const MobilityModel*, TrackedMobility>
+        m_mobilities; //!< the mobility models of the ends of the links
+};
+
 } // namespace ns3
 
 #endif // PROPAGATION_CACHE_H_
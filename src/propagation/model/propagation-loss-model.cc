@@ -951,4 +951,96 @@ RangePropagationLossModel::DoAssignStreams(int64_t stream)
 
 // ------------------------------------------------------------------------- //
 
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationLossModel>()
+            .AddAttribute("PropagationLossModel",
+                          "The propagation loss model whose loss is cached for each pair of "
+                          "transmitter and receiver.",
+                          PointerValue(),
+                          MakePointerAccessor(&CachedPropagationLossModel::SetPropagationLossModel,
+                                              &CachedPropagationLossModel::GetPropagationLossModel),
+                          MakePointerChecker<PropagationLossModel>())
+            .AddAttribute("PositionTolerance",
+                          "The distance (meters) by which a transmitter or a receiver whose "
+                          "velocity is not zero can move before the loss is computed again. "
+                          "The loss is always computed again after a course change.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&CachedPropagationLossModel::SetPositionTolerance,
+                                             &CachedPropagationLossModel::GetPositionTolerance),
+                          MakeDoubleChecker<double>(0));
+    return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel()
+{
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel()
+{
+}
+
+void
+CachedPropagationLossModel::DoDispose()
+{
+    m_lossCache.Cleanup();
+    m_model = nullptr;
+    PropagationLossModel::DoDispose();
+}
+
+void
+CachedPropagationLossModel::SetPropagationLossModel(Ptr<PropagationLossModel> model)
+{
+    m_model = model;
+    m_lossCache.Cleanup();
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetPropagationLossModel() const
+{
+    return m_model;
+}
+
+void
+CachedPropagationLossModel::SetPositionTolerance(double tolerance)
+{
+    m_lossCache.SetPositionTolerance(tolerance);
+}
+
+double
+CachedPropagationLossModel::GetPositionTolerance() const
+{
+    return m_lossCache.GetPositionTolerance();
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                          Ptr<MobilityModel> a,
+                                          Ptr<MobilityModel> b) const
+{
+    NS_ASSERT_MSG(m_model, "No propagation loss model to cache");
+    if (const auto loss = m_lossCache.Find(a, b, 0))
+    {
+        return txPowerDbm - *loss;
+    }
+    const auto rxPowerDbm = m_model->CalcRxPower(txPowerDbm, a, b);
+    m_lossCache.Add(txPowerDbm - rxPowerDbm, a, b, 0);
+    return rxPowerDbm;
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return m_model ? m_model->AssignStreams(stream) : 0;
+}
+
+// ------------------------------------------------------------------------- //
+
 } // namespace ns3
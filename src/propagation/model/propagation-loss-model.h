@@ -13,6 +13,8 @@
 #ifndef PROPAGATION_LOSS_MODEL_H
 #define PROPAGATION_LOSS_MODEL_H
 
+#include "propagation-cache.h"
+
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 
@@ -795,6 +797,73 @@ class RangePropagationLossModel : public PropagationLossModel
     double m_range; //!< Maximum Transmission Range (meters)
 };
 
+/**
+ * @ingroup propagation
+ *
+ * @brief Caches the loss computed by another propagation loss model for each
+ * pair of transmitter and receiver.
+ *
+ * The loss computed by the model set through the PropagationLossModel attribute
+ * (including the models chained to it) is reused until the transmitter or the
+ * receiver notifies a course change, or, if its velocity is not zero, moves by
+ * more than the PositionTolerance attribute. Static deployments thus compute the
+ * loss of each link once rather than once per packet.
+ *
+ * The cached model must be deterministic and its loss must not depend on the
+ * transmit power: the random losses (e.g., NakagamiPropagationLossModel) would be
+ * drawn once per link and position. Models depending on time rather than on the
+ * positions should not be cached either.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    CachedPropagationLossModel();
+    ~CachedPropagationLossModel() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    CachedPropagationLossModel(const CachedPropagationLossModel&) = delete;
+    CachedPropagationLossModel& operator=(const CachedPropagationLossModel&) = delete;
+
+    /**
+     * @param model the propagation loss model whose loss is cached
+     */
+    void SetPropagationLossModel(Ptr<PropagationLossModel> model);
+    /**
+     * @return the propagation loss model whose loss is cached
+     */
+    Ptr<PropagationLossModel> GetPropagationLossModel() const;
+
+    /**
+     * @param tolerance the distance, in meters, by which a moving transmitter or
+     * receiver can move before the loss is computed again
+     */
+    void SetPositionTolerance(double tolerance);
+    /**
+     * @return the distance, in meters, by which a moving transmitter or receiver
+     * can move before the loss is computed again
+     */
+    double GetPositionTolerance() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    Ptr<PropagationLossModel> m_model;                 //!< the model whose loss is cached
+    mutable PropagationLinkCache<double> m_lossCache; //!< the loss (dB) of each link
+};
+
 } // namespace ns3
 
 #endif /* PROPAGATION_LOSS_MODEL_H */
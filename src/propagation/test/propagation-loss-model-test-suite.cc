@@ -7,10 +7,13 @@
 #include "ns3/abort.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
+#include "ns3/pointer.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
 using namespace ns3;
@@ -478,6 +481,93 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief CachedPropagationLossModel Test
+ *
+ * A random loss is cached, so that a new loss is drawn only when the loss
+ * of a link is computed again.
+ */
+class CachedPropagationLossModelTestCase : public TestCase
+{
+  public:
+    CachedPropagationLossModelTestCase();
+    ~CachedPropagationLossModelTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase()
+    : TestCase("Test CachedPropagationLossModel")
+{
+}
+
+CachedPropagationLossModelTestCase::~CachedPropagationLossModelTestCase()
+{
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun()
+{
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(100, 0, 0));
+    Ptr<ConstantVelocityMobilityModel> c = CreateObject<ConstantVelocityMobilityModel>();
+    c->SetPosition(Vector(0, 100, 0));
+    c->SetVelocity(Vector(1, 0, 0));
+
+    auto random = CreateObject<RandomPropagationLossModel>();
+    random->SetAttribute("Variable", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=100.0]"));
+    auto lossModel = CreateObject<CachedPropagationLossModel>();
+    lossModel->SetAttribute("PropagationLossModel", PointerValue(random));
+    lossModel->SetAttribute("PositionTolerance", DoubleValue(10));
+
+    const double txPowerDbm = 20;
+    const auto rxPowerAb = lossModel->CalcRxPower(txPowerDbm, a, b);
+    NS_TEST_EXPECT_MSG_EQ(lossModel->CalcRxPower(txPowerDbm, a, b),
+                          rxPowerAb,
+                          "The loss of a static link should be cached");
+    NS_TEST_EXPECT_MSG_EQ_TOL(lossModel->CalcRxPower(txPowerDbm - 10, a, b),
+                              rxPowerAb - 10,
+                              1e-9,
+                              "The cached loss should not depend on the TX power");
+    const auto rxPowerBa = lossModel->CalcRxPower(txPowerDbm, b, a);
+    NS_TEST_EXPECT_MSG_NE(rxPowerBa, rxPowerAb, "The links are directed");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->CalcRxPower(txPowerDbm, b, a),
+                          rxPowerBa,
+                          "The loss of the reverse link should be cached");
+
+    // a course change of an end invalidates the loss of its links
+    b->SetPosition(Vector(200, 0, 0));
+    const auto rxPowerAbMoved = lossModel->CalcRxPower(txPowerDbm, a, b);
+    NS_TEST_EXPECT_MSG_NE(rxPowerAbMoved, rxPowerAb, "The loss should have been computed again");
+    NS_TEST_EXPECT_MSG_NE(lossModel->CalcRxPower(txPowerDbm, b, a),
+                          rxPowerBa,
+                          "The loss should have been computed again");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->CalcRxPower(txPowerDbm, a, b),
+                          rxPowerAbMoved,
+                          "The new loss should be cached");
+
+    // an end moving with a constant velocity invalidates the loss of its links
+    // once it moved by more than the tolerance
+    const auto rxPowerAc = lossModel->CalcRxPower(txPowerDbm, a, c);
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(lossModel->CalcRxPower(txPowerDbm, a, c),
+                          rxPowerAc,
+                          "The moving end is still within the tolerance");
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_NE(lossModel->CalcRxPower(txPowerDbm, a, c),
+                          rxPowerAc,
+                          "The moving end is beyond the tolerance");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup propagation-tests
  *
@@ -489,6 +579,7 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - CachedPropagationLossModel
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -504,6 +595,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new CachedPropagationLossModelTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
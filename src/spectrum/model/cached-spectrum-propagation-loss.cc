@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "cached-spectrum-propagation-loss.h"
+
+#include "spectrum-signal-parameters.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CachedSpectrumPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED(CachedSpectrumPropagationLossModel);
+
+CachedSpectrumPropagationLossModel::CachedSpectrumPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+CachedSpectrumPropagationLossModel::~CachedSpectrumPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+CachedSpectrumPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedSpectrumPropagationLossModel")
+            .SetParent<SpectrumPropagationLossModel>()
+            .SetGroupName("Spectrum")
+            .AddConstructor<CachedSpectrumPropagationLossModel>()
+            .AddAttribute(
+                "SpectrumPropagationLossModel",
+                "The spectrum propagation loss model whose gain is cached for each pair of "
+                "transmitter and receiver.",
+                PointerValue(),
+                MakePointerAccessor(
+                    &CachedSpectrumPropagationLossModel::SetSpectrumPropagationLossModel,
+                    &CachedSpectrumPropagationLossModel::GetSpectrumPropagationLossModel),
+                MakePointerChecker<SpectrumPropagationLossModel>())
+            .AddAttribute(
+                "PositionTolerance",
+                "The distance (meters) by which a transmitter or a receiver whose velocity "
+                "is not zero can move before the gain is computed again. The gain is always "
+                "computed again after a course change.",
+                DoubleValue(0),
+                MakeDoubleAccessor(&CachedSpectrumPropagationLossModel::SetPositionTolerance,
+                                   &CachedSpectrumPropagationLossModel::GetPositionTolerance),
+                MakeDoubleChecker<double>(0));
+    return tid;
+}
+
+void
+CachedSpectrumPropagationLossModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_gainCache.Cleanup();
+    m_model = nullptr;
+    SpectrumPropagationLossModel::DoDispose();
+}
+
+void
+CachedSpectrumPropagationLossModel::SetSpectrumPropagationLossModel(
+    Ptr<SpectrumPropagationLossModel> model)
+{
+    NS_LOG_FUNCTION(this << model);
+    m_model = model;
+    m_gainCache.Cleanup();
+}
+
+Ptr<SpectrumPropagationLossModel>
+CachedSpectrumPropagationLossModel::GetSpectrumPropagationLossModel() const
+{
+    return m_model;
+}
+
+void
+CachedSpectrumPropagationLossModel::SetPositionTolerance(double tolerance)
+{
+    NS_LOG_FUNCTION(this << tolerance);
+    m_gainCache.SetPositionTolerance(tolerance);
+}
+
+double
+CachedSpectrumPropagationLossModel::GetPositionTolerance() const
+{
+    return m_gainCache.GetPositionTolerance();
+}
+
+Ptr<SpectrumValue>
+CachedSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity(
+    Ptr<const SpectrumSignalParameters> params,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b) const
+{
+    NS_LOG_FUNCTION(this << params << a << b);
+    NS_ASSERT_MSG(m_model, "No spectrum propagation loss model to cache");
+
+    const auto modelUid = params->psd->GetSpectrumModelUid();
+    Ptr<const SpectrumValue> gain;
+    if (const auto cachedGain = m_gainCache.Find(a, b, modelUid))
+    {
+        gain = *cachedGain;
+    }
+    else
+    {
+        // the gain of each band is the PSD received for a PSD of one
+        auto unitParams = params->Copy();
+        unitParams->psd = Create<SpectrumValue>(params->psd->GetSpectrumModel());
+        *unitParams->psd = 1.0;
+        gain = m_model->CalcRxPowerSpectralDensity(unitParams, a, b);
+        m_gainCache.Add(gain, a, b, modelUid);
+    }
+
+    auto rxPsd = Copy<SpectrumValue>(params->psd);
+    *rxPsd *= *gain;
+    return rxPsd;
+}
+
+int64_t
+CachedSpectrumPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return m_model ? m_model->AssignStreams(stream) : 0;
+}
+
+} // namespace ns3
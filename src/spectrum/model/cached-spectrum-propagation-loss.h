@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef CACHED_SPECTRUM_PROPAGATION_LOSS_H
+#define CACHED_SPECTRUM_PROPAGATION_LOSS_H
+
+#include "spectrum-propagation-loss-model.h"
+#include "spectrum-value.h"
+
+#include "ns3/propagation-cache.h"
+
+namespace ns3
+{
+
+/**
+ * @ingroup spectrum
+ *
+ * @brief Caches the gain computed by another spectrum propagation loss model
+ * for each pair of transmitter and receiver.
+ *
+ * The gain of each band is computed by passing a PSD of one to the model set
+ * through the SpectrumPropagationLossModel attribute, and is applied to the PSD
+ * of the following signals of the same SpectrumModel, until the transmitter or
+ * the receiver notifies a course change, or, if its velocity is not zero, moves
+ * by more than the PositionTolerance attribute.
+ *
+ * The cached model must be deterministic, linear in the transmitted PSD, and
+ * must not depend on the other signal parameters nor on time.
+ */
+class CachedSpectrumPropagationLossModel : public SpectrumPropagationLossModel
+{
+  public:
+    CachedSpectrumPropagationLossModel();
+    ~CachedSpectrumPropagationLossModel() override;
+
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @param model the spectrum propagation loss model whose gain is cached
+     */
+    void SetSpectrumPropagationLossModel(Ptr<SpectrumPropagationLossModel> model);
+    /**
+     * @return the spectrum propagation loss model whose gain is cached
+     */
+    Ptr<SpectrumPropagationLossModel> GetSpectrumPropagationLossModel() const;
+
+    /**
+     * @param tolerance the distance, in meters, by which a moving transmitter or
+     * receiver can move before the gain is computed again
+     */
+    void SetPositionTolerance(double tolerance);
+    /**
+     * @return the distance, in meters, by which a moving transmitter or receiver
+     * can move before the gain is computed again
+     */
+    double GetPositionTolerance() const;
+
+  protected:
+    void DoDispose() override;
+    int64_t DoAssignStreams(int64_t stream) override;
+
+  private:
+    Ptr<SpectrumValue> DoCalcRxPowerSpectralDensity(Ptr<const SpectrumSignalParameters> params,
+                                                    Ptr<const MobilityModel> a,
+                                                    Ptr<const MobilityModel> b) const override;
+
+    Ptr<SpectrumPropagationLossModel> m_model; //!< the model whose gain is cached
+    mutable PropagationLinkCache<Ptr<const SpectrumValue>>
+        m_gainCache; //!< the gain of each link, per SpectrumModel UID
+};
+
+} // namespace ns3
+
+#endif /* CACHED_SPECTRUM_PROPAGATION_LOSS_H */
@@ -70,7 +70,9 @@ RxSpectrumModelInfo::RxSpectrumModelInfo(Ptr<const SpectrumModel> rxSpectrumMode
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel()
-    : m_numDevices{0}
+    : m_numDevices{0},
+      m_maxRange{0},
+      m_rxIndexOutdated{true}
 {
     NS_LOG_FUNCTION(this);
 }
@@ -81,6 +83,9 @@ MultiModelSpectrumChannel::DoDispose()
     NS_LOG_FUNCTION(this);
     m_txSpectrumModelInfoMap.clear();
     m_rxSpectrumModelInfoMap.clear();
+    m_rxIndex.Clear();
+    m_indexedRxPhys.clear();
+    m_unlocatedRxPhys.clear();
     SpectrumChannel::DoDispose();
 }
 
@@ -91,11 +96,38 @@ MultiModelSpectrumChannel::GetTypeId()
                             .SetParent<SpectrumChannel>()
                             .SetGroupName("Spectrum")
                             .AddConstructor<MultiModelSpectrumChannel>()
-
-        ;
+                            .AddAttribute(
+                                "MaxRange",
+                                "The maximum distance, in meters, between the transmitter and "
+                                "the receivers to which a signal is propagated. The receivers "
+                                "within this distance are found in a spatial index, kept up to "
+                                "date by the CourseChange notifications of their mobility "
+                                "models, and the propagation loss towards the others is not "
+                                "computed. Zero propagates the signals to all the receivers.",
+                                DoubleValue(0),
+                                MakeDoubleAccessor(&MultiModelSpectrumChannel::SetMaxRange,
+                                                   &MultiModelSpectrumChannel::GetMaxRange),
+                                MakeDoubleChecker<double>(0));
     return tid;
 }
 
+void
+MultiModelSpectrumChannel::SetMaxRange(double maxRange)
+{
+    NS_LOG_FUNCTION(this << maxRange);
+    m_maxRange = maxRange;
+    if (maxRange > 0)
+    {
+        m_rxIndex.SetCellSize(maxRange);
+    }
+}
+
+double
+MultiModelSpectrumChannel::GetMaxRange() const
+{
+    return m_maxRange;
+}
+
 void
 MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
 {
@@ -116,6 +148,7 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
         {
             rxInfoIterator->second.m_rxPhys.erase(phyIt);
             --m_numDevices;
+            m_rxIndexOutdated = true;
             break; // there should be at most one entry
         }
     }
@@ -144,6 +177,7 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     // rxInfoIterator points either to the newly inserted element or to the element that
     // prevented insertion. In both cases, add the phy to the element pointed to by rxInfoIterator
     rxInfoIterator->second.m_rxPhys.push_back(phy);
+    m_rxIndexOutdated = true;
 
     if (inserted)
     {
@@ -268,100 +302,165 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         convertedPsds.emplace(rxSpectrumModelUid, convertedTxPowerSpectrum);
     }
 
-    for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
-         rxInfoIterator != m_rxSpectrumModelInfoMap.end();
-         ++rxInfoIterator)
-    {
-        const auto rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
+    std::vector<Reception> receptions;
+
+    auto isOrthogonal = [&](SpectrumModelUid_t rxSpectrumModelUid) {
+        // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
+        return (txSpectrumModelUid != rxSpectrumModelUid) &&
+               !txInfoIterator->second.m_spectrumConverterMap.contains(rxSpectrumModelUid);
+    };
+
+    auto propagateTo = [&](Ptr<SpectrumPhy> rxPhy, SpectrumModelUid_t rxSpectrumModelUid) {
+        NS_ASSERT_MSG(rxPhy->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
+                      "SpectrumModel change was not notified to MultiModelSpectrumChannel "
+                      "(i.e., AddRx should be called again after model is changed)");
 
-        if ((txSpectrumModelUid != rxSpectrumModelUid) &&
-            !txInfoIterator->second.m_spectrumConverterMap.contains(rxSpectrumModelUid))
+        if (rxPhy == txParams->txPhy)
         {
-            // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
-            continue;
+            return;
         }
 
-        for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
-             rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
-             ++rxPhyIterator)
-        {
-            NS_ASSERT_MSG((*rxPhyIterator)->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
-                          "SpectrumModel change was not notified to MultiModelSpectrumChannel "
-                          "(i.e., AddRx should be called again after model is changed)");
+        auto txAntennaGain{0.0};
+        auto rxNetDevice = rxPhy->GetDevice();
+        auto txNetDevice = txParams->txPhy->GetDevice();
 
-            auto txAntennaGain{0.0};
-            if ((*rxPhyIterator) != txParams->txPhy)
+        if (rxNetDevice && txNetDevice)
+        {
+            // we assume that devices are attached to a node
+            if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
             {
-                auto rxNetDevice = (*rxPhyIterator)->GetDevice();
-                auto txNetDevice = txParams->txPhy->GetDevice();
-
-                if (rxNetDevice && txNetDevice)
-                {
-                    // we assume that devices are attached to a node
-                    if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
-                    {
-                        NS_LOG_DEBUG(
-                            "Skipping the pathloss calculation among different antennas of the "
-                            "same node, not supported yet by any pathloss model in ns-3.");
-                        continue;
-                    }
-                }
+                NS_LOG_DEBUG("Skipping the pathloss calculation among different antennas of the "
+                             "same node, not supported yet by any pathloss model in ns-3.");
+                return;
+            }
+        }
 
-                if (m_filter && m_filter->Filter(txParams, *rxPhyIterator))
-                {
-                    continue;
-                }
+        if (m_filter && m_filter->Filter(txParams, rxPhy))
+        {
+            return;
+        }
 
-                NS_LOG_LOGIC("copying signal parameters " << txParams);
-                auto rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(convertedPsds.at(rxSpectrumModelUid));
-                Time delay{0};
+        NS_LOG_LOGIC("copying signal parameters " << txParams);
+        auto rxParams = txParams->Copy();
+        rxParams->psd = Copy<SpectrumValue>(convertedPsds.at(rxSpectrumModelUid));
+        Time delay{0};
 
-                auto receiverMobility = (*rxPhyIterator)->GetMobility();
+        auto receiverMobility = rxPhy->GetMobility();
 
-                if (txMobility && receiverMobility)
-                {
-                    if (rxParams->txAntenna)
-                    {
-                        Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
-                        txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
-                        NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
-                    }
-                    if (m_propagationDelay)
-                    {
-                        delay = m_propagationDelay->GetDelay(txMobility, receiverMobility);
-                    }
-                }
+        if (txMobility && receiverMobility)
+        {
+            if (rxParams->txAntenna)
+            {
+                Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
+                txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
+                NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
+            }
+            if (m_propagationDelay)
+            {
+                delay = m_propagationDelay->GetDelay(txMobility, receiverMobility);
+            }
+        }
 
-                if (rxNetDevice)
-                {
-                    // the receiver has a NetDevice, so we expect that it is attached to a Node
-                    auto dstNode = rxNetDevice->GetNode()->GetId();
-                    Simulator::ScheduleWithContext(dstNode,
-                                                   delay,
-                                                   &MultiModelSpectrumChannel::StartRx,
-                                                   this,
-                                                   txParams->psd,
-                                                   txAntennaGain,
-                                                   rxParams,
-                                                   *rxPhyIterator,
-                                                   convertedPsds);
-                }
-                else
-                {
-                    // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                    // attached to a node
-                    Simulator::Schedule(delay,
-                                        &MultiModelSpectrumChannel::StartRx,
+        // the receiver has a NetDevice, so we expect that it is attached to a Node;
+        // otherwise we cannot assume that it is attached to a node, and the
+        // reception keeps the current context
+        auto context = rxNetDevice ? rxNetDevice->GetNode()->GetId() : Simulator::GetContext();
+        receptions.push_back({delay,
+                              context,
+                              MakeEvent(&MultiModelSpectrumChannel::StartRx,
                                         this,
                                         txParams->psd,
                                         txAntennaGain,
                                         rxParams,
-                                        *rxPhyIterator,
-                                        convertedPsds);
+                                        rxPhy,
+                                        convertedPsds)});
+    };
+
+    if (m_maxRange > 0 && txMobility)
+    {
+        // the mobility models may have been installed after the PHYs were added
+        for (const auto i : m_unlocatedRxPhys)
+        {
+            if (m_indexedRxPhys[i].second->GetMobility())
+            {
+                m_rxIndexOutdated = true;
+            }
+        }
+        if (m_rxIndexOutdated)
+        {
+            m_rxIndex.Clear();
+            m_indexedRxPhys.clear();
+            m_unlocatedRxPhys.clear();
+            for (const auto& [rxSpectrumModelUid, rxInfo] : m_rxSpectrumModelInfoMap)
+            {
+                for (const auto& rxPhy : rxInfo.m_rxPhys)
+                {
+                    auto mobility = rxPhy->GetMobility();
+                    if (!mobility)
+                    {
+                        m_unlocatedRxPhys.push_back(m_indexedRxPhys.size());
+                    }
+                    m_rxIndex.Add(m_indexedRxPhys.size(), mobility);
+                    m_indexedRxPhys.emplace_back(rxSpectrumModelUid, rxPhy);
                 }
             }
+            m_rxIndexOutdated = false;
+        }
+        // the receivers are sorted as in m_rxSpectrumModelInfoMap
+        for (const auto i : m_rxIndex.GetItemsInRange(txMobility->GetPosition(), m_maxRange))
+        {
+            const auto& [rxSpectrumModelUid, rxPhy] = m_indexedRxPhys[i];
+            if (!isOrthogonal(rxSpectrumModelUid))
+            {
+                propagateTo(rxPhy, rxSpectrumModelUid);
+            }
+        }
+    }
+    else
+    {
+        for (const auto& [rxSpectrumModelUid, rxInfo] : m_rxSpectrumModelInfoMap)
+        {
+            if (isOrthogonal(rxSpectrumModelUid))
+            {
+                continue;
+            }
+            for (const auto& rxPhy : rxInfo.m_rxPhys)
+            {
+                propagateTo(rxPhy, rxSpectrumModelUid);
+            }
+        }
+    }
+    ScheduleReceptions(receptions);
+}
+
+void
+MultiModelSpectrumChannel::ScheduleReceptions(std::vector<Reception>& receptions)
+{
+    // the events at the same time keep the order in which they were found
+    std::stable_sort(receptions.begin(),
+                     receptions.end(),
+                     [](const Reception& a, const Reception& b) { return a.delay < b.delay; });
+    auto start = receptions.begin();
+    while (start != receptions.end())
+    {
+        auto end = std::find_if(start, receptions.end(), [start](const Reception& reception) {
+            return reception.delay != start->delay;
+        });
+        if (end - start == 1)
+        {
+            Simulator::ScheduleWithContext(start->context, start->delay, start->event);
+        }
+        else
+        {
+            EventBatch batch;
+            batch.reserve(end - start);
+            for (auto it = start; it != end; ++it)
+            {
+                batch.emplace_back(it->context, it->event);
+            }
+            Simulator::ScheduleWithContextBatch(start->delay, std::move(batch));
         }
+        start = end;
     }
 }
 
@@ -14,6 +14,8 @@
 #include "spectrum-propagation-loss-model.h"
 #include "spectrum-value.h"
 
+#include "ns3/event-impl.h"
+#include "ns3/mobility-grid-index.h"
 #include "ns3/propagation-delay-model.h"
 
 #include <map>
@@ -109,6 +111,20 @@ class MultiModelSpectrumChannel : public SpectrumChannel
     std::size_t GetNDevices() const override;
     Ptr<NetDevice> GetDevice(std::size_t i) const override;
 
+    /**
+     * Set the maximum distance between the transmitter and the receivers to
+     * which a signal is propagated. The receivers within this distance are
+     * found in a spatial index, without computing the propagation loss
+     * towards the others.
+     *
+     * @param maxRange the maximum range in meters, zero to propagate to all the receivers
+     */
+    void SetMaxRange(double maxRange);
+    /**
+     * @return the maximum range in meters, zero if all the receivers are reached
+     */
+    double GetMaxRange() const;
+
   protected:
     void DoDispose() override;
 
@@ -142,6 +158,25 @@ class MultiModelSpectrumChannel : public SpectrumChannel
         Ptr<SpectrumPhy> receiver,
         const std::map<SpectrumModelUid_t, Ptr<SpectrumValue>>& availableConvertedPsds);
 
+    /**
+     * The reception of a transmission by a receiver, not scheduled yet.
+     */
+    struct Reception
+    {
+        Time delay;       //!< the propagation delay
+        uint32_t context; //!< the context of the reception
+        EventImpl* event; //!< the event which starts the reception
+    };
+
+    /**
+     * Schedule the receptions of a transmission.  The receptions after the
+     * same delay are scheduled as a single batch, in the order they were
+     * found, and the other ones one by one.
+     *
+     * @param receptions the receptions, in the order they were found
+     */
+    static void ScheduleReceptions(std::vector<Reception>& receptions);
+
     /**
      * Data structure holding, for each TX SpectrumModel,  all the
      * converters to any RX SpectrumModel, and all the corresponding
@@ -160,6 +195,33 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * Number of devices connected to the channel.
      */
     std::size_t m_numDevices;
+
+    /**
+     * Maximum range of the transmissions, in meters (0 if unlimited).
+     */
+    double m_maxRange;
+
+    /**
+     * Index of the receivers, by position in m_indexedRxPhys.
+     */
+    MobilityGridIndex m_rxIndex;
+
+    /**
+     * The receivers, with the UID of their RX SpectrumModel, in the order of
+     * m_rxSpectrumModelInfoMap, when m_rxIndex was built.
+     */
+    std::vector<std::pair<SpectrumModelUid_t, Ptr<SpectrumPhy>>> m_indexedRxPhys;
+
+    /**
+     * The positions in m_indexedRxPhys of the receivers indexed without a
+     * mobility model.
+     */
+    std::vector<std::size_t> m_unlocatedRxPhys;
+
+    /**
+     * Whether m_rxIndex must be rebuilt before use.
+     */
+    bool m_rxIndexOutdated;
 };
 
 } // namespace ns3
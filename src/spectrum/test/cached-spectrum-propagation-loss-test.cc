@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/cached-spectrum-propagation-loss.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/friis-spectrum-propagation-loss.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-model-ism2400MHz-res1MHz.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Test the CachedSpectrumPropagationLossModel
+ *
+ * Check that the PSDs received through the cache are those computed by the
+ * cached Friis model, for several transmitted PSDs, before and after a course
+ * change of the receiver.
+ */
+class CachedSpectrumPropagationLossTestCase : public TestCase
+{
+  public:
+    CachedSpectrumPropagationLossTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the PSDs received through the cache for several transmitted PSDs.
+     *
+     * @param a the mobility model of the transmitter
+     * @param b the mobility model of the receiver
+     */
+    void CheckRxPsds(Ptr<MobilityModel> a, Ptr<MobilityModel> b);
+
+    Ptr<FriisSpectrumPropagationLossModel> m_friis;         //!< the cached model
+    Ptr<CachedSpectrumPropagationLossModel> m_cachedFriis; //!< the cache under test
+};
+
+CachedSpectrumPropagationLossTestCase::CachedSpectrumPropagationLossTestCase()
+    : TestCase("Check the PSDs received through the CachedSpectrumPropagationLossModel")
+{
+}
+
+void
+CachedSpectrumPropagationLossTestCase::CheckRxPsds(Ptr<MobilityModel> a, Ptr<MobilityModel> b)
+{
+    auto params = Create<SpectrumSignalParameters>();
+    params->psd = Create<SpectrumValue>(SpectrumModelIsm2400MhzRes1Mhz());
+    for (const auto txPsd : {1e-3, 5e-6, 0.0})
+    {
+        *params->psd = txPsd;
+        // half of the bands are not used
+        for (std::size_t i = 0; i < params->psd->GetValuesN(); i += 2)
+        {
+            (*params->psd)[i] = 0;
+        }
+        const auto expected = m_friis->CalcRxPowerSpectralDensity(params, a, b);
+        const auto rxPsd = m_cachedFriis->CalcRxPowerSpectralDensity(params, a, b);
+        for (std::size_t i = 0; i < expected->GetValuesN(); ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ_TOL((*rxPsd)[i],
+                                      (*expected)[i],
+                                      (*expected)[i] * 1e-12,
+                                      "Unexpected PSD received in band " << i);
+        }
+    }
+}
+
+void
+CachedSpectrumPropagationLossTestCase::DoRun()
+{
+    m_friis = CreateObject<FriisSpectrumPropagationLossModel>();
+    m_cachedFriis = CreateObject<CachedSpectrumPropagationLossModel>();
+    m_cachedFriis->SetAttribute("SpectrumPropagationLossModel", PointerValue(m_friis));
+
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(10, 0, 0));
+
+    CheckRxPsds(a, b);
+    b->SetPosition(Vector(250, 0, 0));
+    CheckRxPsds(a, b);
+    CheckRxPsds(b, a);
+
+    m_cachedFriis->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief CachedSpectrumPropagationLossModel test suite
+ */
+class CachedSpectrumPropagationLossTestSuite : public TestSuite
+{
+  public:
+    CachedSpectrumPropagationLossTestSuite();
+};
+
+CachedSpectrumPropagationLossTestSuite::CachedSpectrumPropagationLossTestSuite()
+    : TestSuite("cached-spectrum-propagation-loss", Type::UNIT)
+{
+    AddTestCase(new CachedSpectrumPropagationLossTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static CachedSpectrumPropagationLossTestSuite g_cachedSpectrumPropagationLossTestSuite;
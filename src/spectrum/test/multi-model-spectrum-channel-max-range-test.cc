@@ -0,0 +1,347 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-model-ism2400MHz-res1MHz.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief SpectrumPhy recording the signals it starts to receive
+ */
+class MaxRangeTestSpectrumPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param id the identifier recorded for each signal received
+     * @param receptions the identifiers of the PHYs receiving the signals, in reception order
+     */
+    MaxRangeTestSpectrumPhy(uint32_t id, std::vector<uint32_t>& receptions);
+
+    void SetDevice(Ptr<NetDevice> d) override;
+    Ptr<NetDevice> GetDevice() const override;
+    void SetMobility(Ptr<MobilityModel> m) override;
+    Ptr<MobilityModel> GetMobility() const override;
+    void SetChannel(Ptr<SpectrumChannel> c) override;
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override;
+    Ptr<Object> GetAntenna() const override;
+    void StartRx(Ptr<SpectrumSignalParameters> params) override;
+
+  private:
+    uint32_t m_id;                       //!< the identifier of this PHY
+    std::vector<uint32_t>& m_receptions; //!< the identifiers of the receiving PHYs
+    Ptr<MobilityModel> m_mobility;       //!< the mobility model, if any
+};
+
+MaxRangeTestSpectrumPhy::MaxRangeTestSpectrumPhy(uint32_t id, std::vector<uint32_t>& receptions)
+    : m_id(id),
+      m_receptions(receptions)
+{
+}
+
+void
+MaxRangeTestSpectrumPhy::SetDevice(Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+MaxRangeTestSpectrumPhy::GetDevice() const
+{
+    return nullptr;
+}
+
+void
+MaxRangeTestSpectrumPhy::SetMobility(Ptr<MobilityModel> m)
+{
+    m_mobility = m;
+}
+
+Ptr<MobilityModel>
+MaxRangeTestSpectrumPhy::GetMobility() const
+{
+    return m_mobility;
+}
+
+void
+MaxRangeTestSpectrumPhy::SetChannel(Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+MaxRangeTestSpectrumPhy::GetRxSpectrumModel() const
+{
+    return SpectrumModelIsm2400MhzRes1Mhz();
+}
+
+Ptr<Object>
+MaxRangeTestSpectrumPhy::GetAntenna() const
+{
+    return nullptr;
+}
+
+void
+MaxRangeTestSpectrumPhy::StartRx(Ptr<SpectrumSignalParameters> params)
+{
+    m_receptions.push_back(m_id);
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Test the MaxRange attribute of the MultiModelSpectrumChannel
+ *
+ * Check that a transmission with a MaxRange reaches the receivers reached
+ * without it that are within range, in the same order, after receivers are
+ * added, after a mobility model is installed on a receiver indexed without one,
+ * after a receiver moves and while receivers move with a constant velocity.
+ */
+class MultiModelSpectrumChannelMaxRangeTestCase : public TestCase
+{
+  public:
+    MultiModelSpectrumChannelMaxRangeTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Add a receiver to the channel.
+     *
+     * @param position the position of the receiver, if it has a mobility model
+     * @param velocity the constant velocity of the receiver
+     */
+    void AddPhy(std::optional<Vector> position, const Vector& velocity = Vector(0, 0, 0));
+
+    /**
+     * Transmit a signal from the first PHY with and without a MaxRange and
+     * check the receivers.
+     *
+     * @param context the context of the check
+     */
+    void CheckReceivers(const std::string& context);
+
+    /**
+     * Transmit a signal from the first PHY with a MaxRange and check that the
+     * receivers are those within range, in the order they were added. Unlike
+     * CheckReceivers, the MaxRange is left unchanged, so that the channel keeps
+     * its index of the receivers.
+     *
+     * @param context the context of the check
+     */
+    void CheckReceiversInRange(const std::string& context);
+
+    /**
+     * Transmit a signal from the first PHY.
+     *
+     * @param maxRange the value of the MaxRange attribute, set if it changed
+     * @return the identifiers of the PHYs receiving the signal, in reception order
+     */
+    std::vector<uint32_t> Transmit(double maxRange);
+
+    static constexpr double MAX_RANGE = 100; //!< the range of the transmissions, in meters
+
+    Ptr<MultiModelSpectrumChannel> m_channel;         //!< the channel under test
+    std::vector<Ptr<MaxRangeTestSpectrumPhy>> m_phys; //!< the PHYs, the first one transmits
+    std::vector<uint32_t> m_receptions;               //!< the PHYs receiving the last signal
+};
+
+MultiModelSpectrumChannelMaxRangeTestCase::MultiModelSpectrumChannelMaxRangeTestCase()
+    : TestCase("Check the receivers of the MultiModelSpectrumChannel within MaxRange")
+{
+}
+
+void
+MultiModelSpectrumChannelMaxRangeTestCase::AddPhy(std::optional<Vector> position,
+                                                  const Vector& velocity)
+{
+    auto phy = CreateObject<MaxRangeTestSpectrumPhy>(m_phys.size(), m_receptions);
+    if (position && velocity != Vector(0, 0, 0))
+    {
+        auto mobility = CreateObject<ConstantVelocityMobilityModel>();
+        mobility->SetPosition(*position);
+        mobility->SetVelocity(velocity);
+        phy->SetMobility(mobility);
+    }
+    else if (position)
+    {
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(*position);
+        phy->SetMobility(mobility);
+    }
+    m_channel->AddRx(phy);
+    m_phys.push_back(phy);
+}
+
+std::vector<uint32_t>
+MultiModelSpectrumChannelMaxRangeTestCase::Transmit(double maxRange)
+{
+    if (m_channel->GetMaxRange() != maxRange)
+    {
+        m_channel->SetAttribute("MaxRange", DoubleValue(maxRange));
+    }
+    auto params = Create<SpectrumSignalParameters>();
+    params->psd = Create<SpectrumValue>(SpectrumModelIsm2400MhzRes1Mhz());
+    *params->psd = 1e-9;
+    params->duration = MicroSeconds(100);
+    params->txPhy = m_phys.front();
+    m_receptions.clear();
+    m_channel->StartTx(params);
+    Simulator::Run();
+    return m_receptions;
+}
+
+void
+MultiModelSpectrumChannelMaxRangeTestCase::CheckReceivers(const std::string& context)
+{
+    const auto txPosition = m_phys.front()->GetMobility()->GetPosition();
+    std::vector<uint32_t> expected;
+    for (const auto id : Transmit(0))
+    {
+        auto mobility = m_phys[id]->GetMobility();
+        if (!mobility || CalculateDistance(mobility->GetPosition(), txPosition) <= MAX_RANGE)
+        {
+            expected.push_back(id);
+        }
+    }
+    const auto receivers = Transmit(MAX_RANGE);
+    NS_TEST_ASSERT_MSG_EQ(receivers.size(),
+                          expected.size(),
+                          "Unexpected number of receivers " << context);
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(receivers[i], expected[i], "Unexpected receiver " << context);
+    }
+}
+
+void
+MultiModelSpectrumChannelMaxRangeTestCase::CheckReceiversInRange(const std::string& context)
+{
+    const auto txPosition = m_phys.front()->GetMobility()->GetPosition();
+    std::vector<uint32_t> expected;
+    for (uint32_t id = 1; id < m_phys.size(); ++id)
+    {
+        auto mobility = m_phys[id]->GetMobility();
+        if (!mobility || CalculateDistance(mobility->GetPosition(), txPosition) <= MAX_RANGE)
+        {
+            expected.push_back(id);
+        }
+    }
+    const auto receivers = Transmit(MAX_RANGE);
+    NS_TEST_ASSERT_MSG_EQ(receivers.size(),
+                          expected.size(),
+                          "Unexpected number of receivers " << context);
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(receivers[i], expected[i], "Unexpected receiver " << context);
+    }
+}
+
+void
+MultiModelSpectrumChannelMaxRangeTestCase::DoRun()
+{
+    m_channel = CreateObject<MultiModelSpectrumChannel>();
+    m_phys.clear();
+
+    AddPhy(Vector(0, 0, 0));
+    AddPhy(Vector(50, 0, 0));
+    AddPhy(Vector(150, 0, 0));
+    AddPhy(Vector(-99, 0, 0));
+    AddPhy(Vector(0, 300, 0));
+    AddPhy(Vector(30, -40, 10));
+    CheckReceivers("with the initial receivers");
+    NS_TEST_EXPECT_MSG_EQ(m_receptions.size(), 3, "Unexpected receivers within range");
+
+    AddPhy(Vector(10, 10, 0));
+    AddPhy(Vector(200, 200, 0));
+    CheckReceivers("after receivers are added");
+    NS_TEST_EXPECT_MSG_EQ(m_receptions.size(), 4, "Added receiver not reached");
+
+    // a receiver without mobility model is reached from anywhere
+    AddPhy(std::nullopt);
+    CheckReceivers("with a receiver without mobility model");
+    NS_TEST_EXPECT_MSG_EQ(m_receptions.back(), 8, "Receiver without mobility model not reached");
+
+    auto mobility = CreateObject<ConstantPositionMobilityModel>();
+    mobility->SetPosition(Vector(500, 0, 0));
+    m_phys.back()->SetMobility(mobility);
+    CheckReceivers("after a mobility model is installed");
+    NS_TEST_EXPECT_MSG_EQ(m_receptions.size(), 4, "Receiver out of range reached");
+
+    mobility->SetPosition(Vector(20, 0, 0));
+    m_phys[1]->GetMobility()->SetPosition(Vector(120, 0, 0));
+    CheckReceivers("after receivers move");
+    NS_TEST_EXPECT_MSG_EQ(m_receptions.back(), 8, "Receiver moved into range not reached");
+    NS_TEST_EXPECT_MSG_EQ(m_receptions.front(), 3, "Receiver moved out of range reached");
+
+    // receivers moving without course change, across the cells of the index
+    AddPhy(Vector(-390, 0, 0), Vector(20, 0, 0));
+    AddPhy(Vector(50, 0, 0), Vector(0, -15, 0));
+    AddPhy(Vector(300, 300, 0), Vector(-10, -10, 0));
+    // receivers far away, so that the index does not look at every occupied cell
+    for (uint32_t i = 0; i < 30; ++i)
+    {
+        AddPhy(Vector(1000 + 200 * i, -1000, 0));
+    }
+    auto reached = [this](uint32_t id) {
+        return std::find(m_receptions.cbegin(), m_receptions.cend(), id) != m_receptions.cend();
+    };
+    CheckReceiversInRange("before receivers move");
+    NS_TEST_EXPECT_MSG_EQ(reached(10), true, "Moving receiver within range not reached");
+    for (uint32_t step = 1; step <= 80; ++step)
+    {
+        Simulator::Stop(MilliSeconds(500));
+        Simulator::Run();
+        CheckReceiversInRange("at " + std::to_string(Simulator::Now().GetSeconds()) + "s");
+        if (step == 40)
+        {
+            NS_TEST_EXPECT_MSG_EQ(reached(9), true, "Receiver moving into range not reached");
+            NS_TEST_EXPECT_MSG_EQ(reached(10), false, "Receiver moving out of range reached");
+            NS_TEST_EXPECT_MSG_EQ(reached(11), false, "Receiver out of range reached");
+        }
+        else if (step == 60)
+        {
+            NS_TEST_EXPECT_MSG_EQ(reached(9), false, "Receiver moving out of range reached");
+            NS_TEST_EXPECT_MSG_EQ(reached(11), true, "Receiver moving into range not reached");
+        }
+    }
+
+    m_channel->Dispose();
+    m_phys.clear();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief MultiModelSpectrumChannel MaxRange test suite
+ */
+class MultiModelSpectrumChannelMaxRangeTestSuite : public TestSuite
+{
+  public:
+    MultiModelSpectrumChannelMaxRangeTestSuite();
+};
+
+MultiModelSpectrumChannelMaxRangeTestSuite::MultiModelSpectrumChannelMaxRangeTestSuite()
+    : TestSuite("multi-model-spectrum-channel-max-range", Type::UNIT)
+{
+    AddTestCase(new MultiModelSpectrumChannelMaxRangeTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static MultiModelSpectrumChannelMaxRangeTestSuite g_multiModelSpectrumChannelMaxRangeTestSuite;
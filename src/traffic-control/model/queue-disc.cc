@@ -18,6 +18,8 @@
 #include "ns3/socket.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -246,6 +248,13 @@ QueueDisc::GetTypeId()
                           UintegerValue(DEFAULT_QUOTA),
                           MakeUintegerAccessor(&QueueDisc::SetQuota, &QueueDisc::GetQuota),
                           MakeUintegerChecker<uint32_t>())
+            .AddAttribute("MaxBurstSize",
+                          "The maximum number of packets dequeued at once and sent to the "
+                          "device as a burst, if the device queue can take them (1 disables "
+                          "bulk dequeues)",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&QueueDisc::m_maxBurstSize),
+                          MakeUintegerChecker<uint32_t>(1))
             .AddAttribute("InternalQueueList",
                           "The list of internal queues.",
                           ObjectVectorValue(),
@@ -370,6 +379,7 @@ QueueDisc::DoDispose()
     m_classes.clear();
     m_devQueueIface = nullptr;
     m_send = nullptr;
+    m_sendBurst = nullptr;
     m_requeued = nullptr;
     m_internalQueueDbeFunctor = nullptr;
     m_internalQueueDadFunctor = nullptr;
@@ -544,6 +554,20 @@ QueueDisc::GetSendCallback() const
     return m_send;
 }
 
+void
+QueueDisc::SetSendBurstCallback(SendBurstCallback func)
+{
+    NS_LOG_FUNCTION(this);
+    m_sendBurst = func;
+}
+
+QueueDisc::SendBurstCallback
+QueueDisc::GetSendBurstCallback() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_sendBurst;
+}
+
 void
 QueueDisc::SetQuota(const uint32_t quota)
 {
@@ -938,13 +962,22 @@ QueueDisc::Run()
     if (RunBegin())
     {
         uint32_t quota = m_quota;
-        while (Restart())
+        if (m_maxBurstSize > 1 && m_sendBurst)
         {
-            quota -= 1;
-            if (quota <= 0)
+            while (quota > 0 && RestartBurst(quota))
             {
-                /// @todo netif_schedule (q);
-                break;
+            }
+        }
+        else
+        {
+            while (Restart())
+            {
+                quota -= 1;
+                if (quota <= 0)
+                {
+                    /// @todo netif_schedule (q);
+                    break;
+                }
             }
         }
         RunEnd();
@@ -985,6 +1018,56 @@ QueueDisc::Restart()
     return Transmit(item);
 }
 
+bool
+QueueDisc::RestartBurst(uint32_t& quota)
+{
+    NS_LOG_FUNCTION(this << quota);
+
+    // Bulk dequeues are only performed for single queue devices, and are bounded
+    // by the room in the device queue, so that the device does not drop packets
+    // of the burst nor receives packets once its queue has been stopped
+    uint32_t maxSize = std::min(quota, m_maxBurstSize);
+    if (m_devQueueIface)
+    {
+        maxSize = (m_devQueueIface->GetNTxQueues() > 1
+                       ? 1
+                       : std::min(maxSize, m_devQueueIface->GetTxQueue(0)->GetAvailablePackets()));
+    }
+    if (maxSize <= 1)
+    {
+        quota -= 1;
+        return Restart();
+    }
+
+    // Run is not reentrant, so the storage of the items can be reused
+    NS_ASSERT(m_burst.empty());
+    while (m_burst.size() < maxSize)
+    {
+        Ptr<QueueDiscItem> item = DequeuePacket();
+        if (!item)
+        {
+            break;
+        }
+        // a single queue device makes no use of the priority tag
+        SocketPriorityTag priorityTag;
+        item->GetPacket()->RemovePacketTag(priorityTag);
+        m_burst.push_back(item);
+    }
+    if (m_burst.empty())
+    {
+        NS_LOG_LOGIC("No packet to send");
+        return false;
+    }
+
+    quota -= m_burst.size();
+    m_sendBurst(m_burst);
+    m_burst.clear();
+
+    // as in Transmit, the packets sent to the device are never requeued
+    return !(GetNPackets() == 0 ||
+             (m_devQueueIface && m_devQueueIface->GetTxQueue(0)->IsStopped()));
+}
+
 Ptr<QueueDiscItem>
 QueueDisc::DequeuePacket()
 {
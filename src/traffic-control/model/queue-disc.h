@@ -367,6 +367,26 @@ class QueueDisc : public Object
      */
     SendCallback GetSendCallback() const;
 
+    /// Callback invoked to send a burst of packets to the receiving object when Run is called
+    typedef std::function<void(const std::vector<Ptr<QueueDiscItem>>&)> SendBurstCallback;
+
+    /**
+     * @param func the callback to send a burst of packets to the receiving object.
+     *
+     * Set the callback used by the Run method to send the packets of a bulk
+     * dequeue to the receiving object.  Bulk dequeues are performed only if
+     * this callback is set and the MaxBurstSize attribute is greater than 1.
+     */
+    void SetSendBurstCallback(SendBurstCallback func);
+
+    /**
+     * @return the callback to send a burst of packets to the receiving object.
+     *
+     * Get the callback used by the Run method to send the packets of a bulk
+     * dequeue to the receiving object.
+     */
+    SendBurstCallback GetSendBurstCallback() const;
+
     /**
      * @brief Set the maximum number of dequeue operations following a packet enqueue
      * @param quota the maximum number of dequeue operations following a packet enqueue.
@@ -637,6 +657,16 @@ class QueueDisc : public Object
      */
     bool Restart();
 
+    /**
+     * Modelled after the bulk dequeue of the Linux function dequeue_skb (net/sched/sch_generic.c)
+     * Dequeue as many packets as the device queue can take (by calling DequeuePacket) and
+     * send them to the device as a burst.
+     * @param [in,out] quota the number of packets which can still be dequeued in this run,
+     *        decreased by the number of packets dequeued
+     * @return true if the device queue is not stopped and the queue disc is not empty
+     */
+    bool RestartBurst(uint32_t& quota);
+
     /**
      * Modelled after the Linux function dequeue_skb (net/sched/sch_generic.c)
      * @return the requeued packet, if any, or the packet dequeued by the queue disc, otherwise.
@@ -689,6 +719,9 @@ class QueueDisc : public Object
     uint32_t m_quota; //!< Maximum number of packets dequeued in a qdisc run
     Ptr<NetDeviceQueueInterface> m_devQueueIface; //!< NetDevice queue interface
     SendCallback m_send;           //!< Callback used to send a packet to the receiving object
+    SendBurstCallback m_sendBurst; //!< Callback used to send a burst to the receiving object
+    uint32_t m_maxBurstSize;       //!< Maximum number of packets dequeued at once
+    std::vector<Ptr<QueueDiscItem>> m_burst; //!< The items of the burst, whose storage is reused
     bool m_running;                //!< The queue disc is performing multiple dequeue operations
     Ptr<QueueDiscItem> m_requeued; //!< The last packet that failed to be transmitted
     bool m_peeked;                 //!< A packet was dequeued because Peek was called
@@ -12,6 +12,7 @@
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/object-map.h"
+#include "ns3/packet-burst.h"
 #include "ns3/packet.h"
 #include "ns3/socket.h"
 
@@ -201,6 +202,27 @@ TrafficControlLayer::ScanDevices()
                 q->SetSendCallback([dev](Ptr<QueueDiscItem> item) {
                     dev->Send(item->GetPacket(), item->GetAddress(), item->GetProtocol());
                 });
+                // consecutive packets with the same destination and protocol are
+                // sent to the device as a single burst. The queue disc does not send
+                // a burst while sending another one, so all its bursts reuse the same
+                // PacketBurst
+                auto burst = CreateObject<PacketBurst>();
+                q->SetSendBurstCallback([dev, burst](const std::vector<Ptr<QueueDiscItem>>& items) {
+                    auto it = items.begin();
+                    while (it != items.end())
+                    {
+                        auto first = it;
+                        burst->Clear();
+                        for (; it != items.end() && (*it)->GetAddress() == (*first)->GetAddress() &&
+                               (*it)->GetProtocol() == (*first)->GetProtocol();
+                             ++it)
+                        {
+                            burst->AddPacket((*it)->GetPacket());
+                        }
+                        dev->SendBurst(burst, (*first)->GetAddress(), (*first)->GetProtocol());
+                    }
+                    burst->Clear();
+                });
             }
         }
     }
@@ -265,6 +287,7 @@ TrafficControlLayer::DeleteRootQueueDiscOnDevice(Ptr<NetDevice> device)
     {
         q->SetNetDeviceQueueInterface(nullptr);
         q->SetSendCallback(nullptr);
+        q->SetSendBurstCallback(nullptr);
     }
     ndi->second.m_queueDiscsToWake.clear();
 
@@ -481,6 +481,131 @@ TcFlowControlTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Traffic Control Bulk Dequeue Test Case
+ *
+ * Packets are accumulated in the queue disc while the device queue is stopped
+ * and sent to the device as bursts when the device queue is woken up. The
+ * bursts must be bounded by the room in the device queue, so that no packet is
+ * dropped by the device and the device queue ends up in the same state as if
+ * the packets were sent one at a time.
+ */
+class TcBulkDequeueTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param tt the unit of the device queue size
+     * @param deviceQueueLength the queue length of the device
+     * @param deviceQueuePackets the expected number of packets in the device queue
+     * @param qdiscPackets the expected number of packets in the queue disc
+     */
+    TcBulkDequeueTestCase(QueueSizeUnit tt,
+                          uint32_t deviceQueueLength,
+                          uint32_t deviceQueuePackets,
+                          uint32_t qdiscPackets);
+
+  private:
+    void DoRun() override;
+    /**
+     * Check the number of packets in the device queue and in the queue disc
+     * @param dev the device
+     */
+    void CheckPackets(Ptr<NetDevice> dev);
+    QueueSizeUnit m_type;          //!< the unit of the device queue size
+    uint32_t m_deviceQueueLength;  //!< the queue length of the device
+    uint32_t m_deviceQueuePackets; //!< the expected number of packets in the device queue
+    uint32_t m_qdiscPackets;       //!< the expected number of packets in the queue disc
+};
+
+TcBulkDequeueTestCase::TcBulkDequeueTestCase(QueueSizeUnit tt,
+                                             uint32_t deviceQueueLength,
+                                             uint32_t deviceQueuePackets,
+                                             uint32_t qdiscPackets)
+    : TestCase("Test the bulk dequeue of packets sent to the device as bursts"),
+      m_type(tt),
+      m_deviceQueueLength(deviceQueueLength),
+      m_deviceQueuePackets(deviceQueuePackets),
+      m_qdiscPackets(qdiscPackets)
+{
+}
+
+void
+TcBulkDequeueTestCase::CheckPackets(Ptr<NetDevice> dev)
+{
+    PointerValue ptr;
+    dev->GetAttributeFailSafe("TxQueue", ptr);
+    Ptr<Queue<Packet>> queue = ptr.Get<Queue<Packet>>();
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(),
+                          m_deviceQueuePackets,
+                          "Unexpected number of packets in the device queue");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetTotalDroppedPackets(),
+                          0,
+                          "No packet of a burst must be dropped by the device");
+
+    Ptr<NetDeviceQueueInterface> ndqi = dev->GetObject<NetDeviceQueueInterface>();
+    NS_TEST_EXPECT_MSG_EQ(ndqi->GetTxQueue(0)->IsStopped(),
+                          (m_qdiscPackets > 0),
+                          "The device queue must be stopped if packets are left in the queue disc");
+
+    Ptr<TrafficControlLayer> tc = dev->GetNode()->GetObject<TrafficControlLayer>();
+    NS_TEST_EXPECT_MSG_EQ(tc->GetRootQueueDiscOnDevice(dev)->GetNPackets(),
+                          m_qdiscPackets,
+                          "Unexpected number of packets in the queue disc");
+}
+
+void
+TcBulkDequeueTestCase::DoRun()
+{
+    NodeContainer n;
+    n.Create(2);
+
+    n.Get(0)->AggregateObject(CreateObject<TrafficControlLayer>());
+    n.Get(1)->AggregateObject(CreateObject<TrafficControlLayer>());
+
+    SimpleNetDeviceHelper simple;
+
+    NetDeviceContainer rxDevC = simple.Install(n.Get(1));
+
+    simple.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mb/s")));
+    simple.SetQueue("ns3::DropTailQueue",
+                    "MaxSize",
+                    StringValue(m_type == QueueSizeUnit::PACKETS
+                                    ? std::to_string(m_deviceQueueLength) + "p"
+                                    : std::to_string(m_deviceQueueLength) + "B"));
+
+    Ptr<NetDevice> txDev;
+    txDev =
+        simple.Install(n.Get(0), DynamicCast<SimpleChannel>(rxDevC.Get(0)->GetChannel())).Get(0);
+    txDev->SetMtu(2500);
+
+    TrafficControlHelper tch;
+    tch.SetRootQueueDisc("ns3::FifoQueueDisc", "MaxBurstSize", UintegerValue(4));
+    tch.Install(txDev);
+
+    // accumulate 10 packets in the queue disc while the device queue is stopped
+    Ptr<NetDeviceQueue> txQueue = txDev->GetObject<NetDeviceQueueInterface>()->GetTxQueue(0);
+    Ptr<TrafficControlLayer> tc = n.Get(0)->GetObject<TrafficControlLayer>();
+    Simulator::Schedule(Seconds(0), [=]() {
+        txQueue->Stop();
+        for (uint16_t i = 0; i < 10; i++)
+        {
+            tc->Send(txDev, Create<QueueDiscTestItem>(Create<Packet>(1000)));
+        }
+        txQueue->Wake();
+    });
+
+    // The transmission of each packet takes 1000B/1Mbps = 8ms, hence one packet
+    // is being transmitted after 1ms
+    Simulator::Schedule(MilliSeconds(1), &TcBulkDequeueTestCase::CheckPackets, this, txDev);
+
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup traffic-control-test
  *
@@ -515,5 +640,12 @@ static class TcFlowControlTestSuite : public TestSuite
         // also be made parametric.
         AddTestCase(new TcFlowControlTestCase(QueueSizeUnit::BYTES, 5000, 10),
                     TestCase::Duration::QUICK);
+
+        AddTestCase(new TcBulkDequeueTestCase(QueueSizeUnit::PACKETS, 100, 9, 0),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new TcBulkDequeueTestCase(QueueSizeUnit::PACKETS, 3, 3, 6),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new TcBulkDequeueTestCase(QueueSizeUnit::BYTES, 5000, 3, 6),
+                    TestCase::Duration::QUICK);
     }
 } g_tcFlowControlTestSuite; ///< the test suite
@@ -0,0 +1,100 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "error-rate-cache.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <tuple>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ErrorRateCache");
+
+namespace
+{
+
+/// The tables, indexed by family of curves, curve and precision
+using ErrorRateTables = std::map<std::tuple<std::string, uint32_t, dB_u>, std::vector<double>>;
+
+/**
+ * Get the tables shared by all the caches.
+ *
+ * @return the tables
+ */
+ErrorRateTables&
+GetTables()
+{
+    static ErrorRateTables tables;
+    return tables;
+}
+
+/// The mutex protecting the insertion of the tables, which are read-only once built
+std::mutex g_tablesMutex;
+
+} // unnamed namespace
+
+ErrorRateCache::ErrorRateCache(const std::string& family)
+    : m_family(family),
+      m_precision(0)
+{
+    NS_LOG_FUNCTION(this << family);
+}
+
+void
+ErrorRateCache::SetPrecision(dB_u precision)
+{
+    NS_LOG_FUNCTION(this << precision);
+    NS_ABORT_MSG_IF(precision < 0, "The precision of the error rate tables cannot be negative");
+    NS_ABORT_MSG_IF(precision > 0 && (MAX_SNR - MIN_SNR) / precision > 1e6,
+                    "The precision of the error rate tables is too fine: " << precision << " dB");
+    m_precision = precision;
+    m_tables.clear();
+}
+
+dB_u
+ErrorRateCache::GetPrecision() const
+{
+    return m_precision;
+}
+
+bool
+ErrorRateCache::IsEnabled() const
+{
+    return m_precision > 0;
+}
+
+const std::vector<double>&
+ErrorRateCache::GetTable(uint32_t curve, const ErrorFunction& compute) const
+{
+    NS_LOG_FUNCTION(this << curve);
+    NS_ASSERT(IsEnabled());
+    std::unique_lock lock{g_tablesMutex};
+    auto [it, inserted] = GetTables().try_emplace({m_family, curve, m_precision});
+    auto& table = it->second;
+    if (inserted)
+    {
+        const auto n = static_cast<std::size_t>((MAX_SNR - MIN_SNR) / m_precision) + 1;
+        NS_LOG_DEBUG("Build the table of curve " << curve << " of " << m_family << " with " << n
+                                                 << " samples");
+        table.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const auto snr = std::pow(10.0, (MIN_SNR + i * m_precision) / 10);
+            // the probabilities which underflow are kept finite to be interpolated
+            const auto p = std::clamp(compute(snr), std::numeric_limits<double>::min(), 1.0);
+            table.push_back(std::log(p));
+        }
+    }
+    m_tables.emplace(curve, &table);
+    return table;
+}
+
+} // namespace ns3
@@ -0,0 +1,169 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ERROR_RATE_CACHE_H
+#define ERROR_RATE_CACHE_H
+
+#include "wifi-units.h"
+
+#include <cmath>
+#include <functional>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup wifi
+ * @brief Interpolated lookup tables of the bit error probabilities of an error rate model.
+ *
+ * The error rate models which compute the success rate of a chunk of n bits as (1 - p)^n,
+ * p being the probability that a bit is in error after decoding, can look up p in a table
+ * instead of computing it in closed form for every chunk.  The probabilities of each curve
+ * (e.g. each constellation and code rate) are sampled every given precision, in dB, between
+ * MIN_SNR and MAX_SNR, and linearly interpolated in between in the logarithmic domain.  The
+ * probabilities out of this range are computed in closed form.
+ *
+ * A table is built when a curve is first looked up, and is then shared, read-only, with all
+ * the caches of the same family of curves and the same precision, in all the threads.
+ */
+class ErrorRateCache
+{
+  public:
+    /// Compute the probability of error of a bit in closed form, given the SNR (linear scale).
+    using ErrorFunction = std::function<double(double)>;
+
+    static constexpr dB_u MIN_SNR{-20}; //!< the lowest SNR in the tables
+    static constexpr dB_u MAX_SNR{60};  //!< the highest SNR in the tables
+
+    /**
+     * Constructor
+     *
+     * @param family the name of the family of curves, e.g. the name of the error rate model
+     */
+    ErrorRateCache(const std::string& family);
+
+    /**
+     * Set the width of the SNR buckets of the tables, zero disabling the tables.
+     *
+     * @param precision the precision of the tables
+     */
+    void SetPrecision(dB_u precision);
+
+    /**
+     * @return the width of the SNR buckets of the tables, zero if the tables are disabled
+     */
+    dB_u GetPrecision() const;
+
+    /**
+     * @return whether the probabilities are looked up in tables
+     */
+    bool IsEnabled() const;
+
+    /**
+     * Look up the probability of error of a bit at the given SNR.
+     *
+     * @tparam F \deduced the type of the function computing the probability in closed form
+     * @param curve the curve, unique within the family
+     * @param snr the SNR (linear scale)
+     * @param compute the function computing the probability of the curve in closed form
+     * @return the probability of error of a bit
+     */
+    template <typename F>
+    double Lookup(uint32_t curve, double snr, const F& compute) const;
+
+    /**
+     * Look up the probabilities of error of a bit at several SNRs of the same curve.
+     *
+     * @tparam F \deduced the type of the function computing the probability in closed form
+     * @param curve the curve, unique within the family
+     * @param snrs the SNRs (linear scale)
+     * @param [out] probabilities the probability of error of a bit at each SNR
+     * @param compute the function computing the probability of the curve in closed form
+     */
+    template <typename F>
+    void Lookup(uint32_t curve,
+                const std::vector<double>& snrs,
+                std::vector<double>& probabilities,
+                const F& compute) const;
+
+  private:
+    /**
+     * Get the table of a curve, building it if needed.
+     *
+     * @param curve the curve
+     * @param compute the function computing the probability of the curve in closed form
+     * @return the natural logarithms of the probabilities sampled from MIN_SNR
+     */
+    const std::vector<double>& GetTable(uint32_t curve, const ErrorFunction& compute) const;
+
+    /**
+     * Interpolate the probability of error at a position of a table.
+     *
+     * @param table the table
+     * @param position the position of the SNR in the table, in buckets from MIN_SNR
+     * @return the probability of error
+     */
+    static double Interpolate(const std::vector<double>& table, double position);
+
+    std::string m_family; //!< the name of the family of curves
+    dB_u m_precision;     //!< the width of the SNR buckets, zero if the tables are disabled
+    mutable std::map<uint32_t, const std::vector<double>*>
+        m_tables; //!< the tables of the curves looked up so far
+};
+
+template <typename F>
+double
+ErrorRateCache::Lookup(uint32_t curve, double snr, const F& compute) const
+{
+    auto it = m_tables.find(curve);
+    const auto& table = (it != m_tables.end()) ? *it->second : GetTable(curve, compute);
+    const auto position = (10 * std::log10(snr) - MIN_SNR) / m_precision;
+    // the negation also catches the NaN position of a null SNR
+    if (!(position >= 0) || position >= table.size() - 1)
+    {
+        return compute(snr);
+    }
+    return Interpolate(table, position);
+}
+
+template <typename F>
+void
+ErrorRateCache::Lookup(uint32_t curve,
+                       const std::vector<double>& snrs,
+                       std::vector<double>& probabilities,
+                       const F& compute) const
+{
+    auto it = m_tables.find(curve);
+    const auto& table = (it != m_tables.end()) ? *it->second : GetTable(curve, compute);
+    const auto n = snrs.size();
+    probabilities.resize(n);
+    // the positions are computed in a first pass, which the compiler can vectorize
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        probabilities[i] = (10 * std::log10(snrs[i]) - MIN_SNR) / m_precision;
+    }
+    const double last = table.size() - 1;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto position = probabilities[i];
+        probabilities[i] = (!(position >= 0) || position >= last) ? compute(snrs[i])
+                                                                  : Interpolate(table, position);
+    }
+}
+
+inline double
+ErrorRateCache::Interpolate(const std::vector<double>& table, double position)
+{
+    const auto index = static_cast<std::size_t>(position);
+    const auto fraction = position - index;
+    return std::exp(table[index] + fraction * (table[index + 1] - table[index]));
+}
+
+} // namespace ns3
+
+#endif /* ERROR_RATE_CACHE_H */
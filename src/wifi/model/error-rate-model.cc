@@ -83,6 +83,50 @@ ErrorRateModel::GetChunkSuccessRate(WifiMode mode,
     return 0;
 }
 
+void
+ErrorRateModel::GetChunkSuccessRates(WifiMode mode,
+                                     const WifiTxVector& txVector,
+                                     const std::vector<double>& snrs,
+                                     const std::vector<uint64_t>& nbits,
+                                     std::vector<double>& rates,
+                                     uint8_t numRxAntennas,
+                                     WifiPpduField field,
+                                     uint16_t staId) const
+{
+    NS_ASSERT(snrs.size() == nbits.size());
+    if (mode.GetModulationClass() == WIFI_MOD_CLASS_DSSS ||
+        mode.GetModulationClass() == WIFI_MOD_CLASS_HR_DSSS)
+    {
+        rates.resize(snrs.size());
+        for (std::size_t i = 0; i < snrs.size(); ++i)
+        {
+            rates[i] = GetChunkSuccessRate(mode, txVector, snrs[i], nbits[i]);
+        }
+    }
+    else
+    {
+        DoGetChunkSuccessRates(mode, txVector, snrs, nbits, rates, numRxAntennas, field, staId);
+    }
+}
+
+void
+ErrorRateModel::DoGetChunkSuccessRates(WifiMode mode,
+                                       const WifiTxVector& txVector,
+                                       const std::vector<double>& snrs,
+                                       const std::vector<uint64_t>& nbits,
+                                       std::vector<double>& rates,
+                                       uint8_t numRxAntennas,
+                                       WifiPpduField field,
+                                       uint16_t staId) const
+{
+    rates.resize(snrs.size());
+    for (std::size_t i = 0; i < snrs.size(); ++i)
+    {
+        rates[i] =
+            DoGetChunkSuccessRate(mode, txVector, snrs[i], nbits[i], numRxAntennas, field, staId);
+    }
+}
+
 bool
 ErrorRateModel::IsAwgn() const
 {
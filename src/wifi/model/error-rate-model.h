@@ -13,6 +13,8 @@
 
 #include "ns3/object.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -81,6 +83,31 @@ class ErrorRateModel : public Object
                                WifiPpduField field = WIFI_PPDU_FIELD_DATA,
                                uint16_t staId = SU_STA_ID) const;
 
+    /**
+     * This method returns the probabilities that several chunks of a PPDU field,
+     * all transmitted with the same mode, are successfully received.  It is
+     * equivalent to calling GetChunkSuccessRate() for each chunk, but lets the
+     * subclasses resolve the mode once and process the chunks as arrays.
+     *
+     * @param mode the Wi-Fi mode applicable to the chunks
+     * @param txVector TXVECTOR of the overall transmission
+     * @param snrs the SNR of each chunk
+     * @param nbits the number of bits in each chunk
+     * @param [out] rates the probability of successfully receiving each chunk
+     * @param numRxAntennas the number of active RX antennas (1 if not provided)
+     * @param field the PPDU field to which the chunks belong to (assumes this is for the payload
+     * part if not provided)
+     * @param staId the station ID for MU
+     */
+    void GetChunkSuccessRates(WifiMode mode,
+                              const WifiTxVector& txVector,
+                              const std::vector<double>& snrs,
+                              const std::vector<uint64_t>& nbits,
+                              std::vector<double>& rates,
+                              uint8_t numRxAntennas = 1,
+                              WifiPpduField field = WIFI_PPDU_FIELD_DATA,
+                              uint16_t staId = SU_STA_ID) const;
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model. Return the number of streams (possibly zero) that
@@ -112,6 +139,28 @@ class ErrorRateModel : public Object
                                          uint8_t numRxAntennas,
                                          WifiPpduField field,
                                          uint16_t staId) const = 0;
+
+    /**
+     * Compute the success rates of several chunks of the same mode.  The default
+     * implementation calls DoGetChunkSuccessRate() for each chunk.
+     *
+     * @param mode the Wi-Fi mode applicable to the chunks
+     * @param txVector TXVECTOR of the overall transmission
+     * @param snrs the SNR of each chunk
+     * @param nbits the number of bits in each chunk
+     * @param [out] rates the probability of successfully receiving each chunk
+     * @param numRxAntennas the number of active RX antennas
+     * @param field the PPDU field to which the chunks belong to
+     * @param staId the station ID for MU
+     */
+    virtual void DoGetChunkSuccessRates(WifiMode mode,
+                                        const WifiTxVector& txVector,
+                                        const std::vector<double>& snrs,
+                                        const std::vector<uint64_t>& nbits,
+                                        std::vector<double>& rates,
+                                        uint8_t numRxAntennas,
+                                        WifiPpduField field,
+                                        uint16_t staId) const;
 };
 
 } // namespace ns3
@@ -134,11 +134,6 @@ InterferenceHelper::NiChange::NiChange(Watt_u power, Ptr<Event> event)
 {
 }
 
-InterferenceHelper::NiChange::~NiChange()
-{
-    m_event = nullptr;
-}
-
 Watt_u
 InterferenceHelper::NiChange::GetPower() const
 {
@@ -362,8 +357,9 @@ InterferenceHelper::AppendEvent(Ptr<Event> event,
         if (const auto rxing = (m_rxing.contains(freqRange) && m_rxing.at(freqRange)); !rxing)
         {
             m_firstPowers.find(band)->second = previousPowerStart;
-            // Always leave the first zero power noise event in the list
-            niIt->second.erase(++(niIt->second.begin()), ++previousPowerPosition);
+            // Always leave the first zero power noise event in the list, the storage of the
+            // erased changes is reused by the following ones
+            niIt->second.erase(niIt->second.begin() + 1, previousPowerPosition + 1);
         }
         else if (isStartHePortionRxing)
         {
@@ -374,8 +370,10 @@ InterferenceHelper::AppendEvent(Ptr<Event> event,
         }
         auto first =
             AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt);
+        // the end change is inserted after the start change, which keeps its index
+        const auto firstIndex = first - niIt->second.begin();
         auto last = AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
-        for (auto i = first; i != last; ++i)
+        for (auto i = niIt->second.begin() + firstIndex; i != last; ++i)
         {
             i->second.AddPower(power);
         }
@@ -445,7 +443,12 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
     auto niIt = m_niChanges.find(band);
     NS_ABORT_IF(niIt == m_niChanges.end());
     const auto now = Simulator::Now();
-    auto it = niIt->second.find(event->GetStartTime());
+    const auto start = std::ranges::lower_bound(niIt->second,
+                                                event->GetStartTime(),
+                                                {},
+                                                &NiChanges::value_type::first);
+    NS_ABORT_IF(start == niIt->second.end() || start->first != event->GetStartTime());
+    auto it = start;
     const auto muMimoPower = (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
                                  ? CalculateMuMimoPowerW(event, band)
                                  : Watt_u{0.0};
@@ -465,20 +468,18 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
             noiseInterference = Watt_u{0.0};
         }
     }
-    it = niIt->second.find(event->GetStartTime());
-    NS_ABORT_IF(it == niIt->second.end());
-    for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
+    for (it = start; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
     {
         ;
     }
     NiChanges ni;
-    ni.emplace(event->GetStartTime(), NiChange(Watt_u{0}, event));
+    ni.emplace_back(event->GetStartTime(), NiChange(Watt_u{0}, event));
     while (++it != niIt->second.end() && it->second.GetEvent() != event)
     {
-        ni.insert(*it);
+        ni.push_back(*it);
     }
-    ni.emplace(event->GetEndTime(), NiChange(Watt_u{0}, event));
-    nis.insert({band, ni});
+    ni.emplace_back(event->GetEndTime(), NiChange(Watt_u{0}, event));
+    nis.insert({band, std::move(ni)});
     NS_ASSERT_MSG(noiseInterference >= Watt_u{0.0},
                   "CalculateNoiseInterferenceW returns negative value " << noiseInterference);
     return noiseInterference;
@@ -549,12 +550,8 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
     {
         return 1.0;
     }
-    const auto mode = txVector.GetMode(staId);
-    const auto rate = mode.GetDataRate(txVector, staId);
-    auto nbits = static_cast<uint64_t>(rate * duration.GetSeconds());
-    nbits /= txVector.GetNss(staId); // divide effective number of bits by NSS to achieve same chunk
-                                     // error rate as SISO for AWGN
-    double csr = m_errorRateModel->GetChunkSuccessRate(mode,
+    const auto nbits = GetPayloadChunkBits(duration, txVector, staId);
+    double csr = m_errorRateModel->GetChunkSuccessRate(txVector.GetMode(staId),
                                                        txVector,
                                                        snir,
                                                        nbits,
@@ -564,6 +561,18 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
     return csr;
 }
 
+uint64_t
+InterferenceHelper::GetPayloadChunkBits(Time duration,
+                                        const WifiTxVector& txVector,
+                                        uint16_t staId) const
+{
+    const auto rate = txVector.GetMode(staId).GetDataRate(txVector, staId);
+    auto nbits = static_cast<uint64_t>(rate * duration.GetSeconds());
+    nbits /= txVector.GetNss(staId); // divide effective number of bits by NSS to achieve same chunk
+                                     // error rate as SISO for AWGN
+    return nbits;
+}
+
 double
 InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
                                         MHz_u channelWidth,
@@ -573,7 +582,9 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
                                         std::pair<Time, Time> window) const
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << window.first << window.second);
-    double psr = 1.0; /* Packet Success Rate */
+    // the chunks of the window are collected, then their success rates computed at once
+    m_chunkSnrs.clear();
+    m_chunkBits.clear();
     const auto& niIt = nis->find(band)->second;
     auto j = niIt.cbegin();
     auto previous = j->first;
@@ -605,26 +616,27 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
                                       noiseInterference,
                                       channelWidth,
                                       event->GetPpdu()->GetTxVector().GetNss(staId));
+        Time duration;
         // Case 1: Both previous and current point to the windowed payload
         if (previous >= windowStart)
         {
-            psr *= CalculatePayloadChunkSuccessRate(snr,
-                                                    Min(windowEnd, current) - previous,
-                                                    event->GetPpdu()->GetTxVector(),
-                                                    staId);
+            duration = Min(windowEnd, current) - previous;
             NS_LOG_DEBUG("Both previous and current point to the windowed payload: mode="
-                         << payloadMode << ", psr=" << psr);
+                         << payloadMode << ", snr=" << snr << ", duration=" << duration);
         }
         // Case 2: previous is before windowed payload and current is in the windowed payload
         else if (current >= windowStart)
         {
-            psr *= CalculatePayloadChunkSuccessRate(snr,
-                                                    Min(windowEnd, current) - windowStart,
-                                                    event->GetPpdu()->GetTxVector(),
-                                                    staId);
+            duration = Min(windowEnd, current) - windowStart;
             NS_LOG_DEBUG(
                 "previous is before windowed payload and current is in the windowed payload: mode="
-                << payloadMode << ", psr=" << psr);
+                << payloadMode << ", snr=" << snr << ", duration=" << duration);
+        }
+        if (!duration.IsZero())
+        {
+            m_chunkSnrs.push_back(snr);
+            m_chunkBits.push_back(
+                GetPayloadChunkBits(duration, event->GetPpdu()->GetTxVector(), staId));
         }
         noiseInterference = j->second.GetPower() - power;
         if (IsSameMuMimoTransmission(event, j->second.GetEvent()))
@@ -641,6 +653,23 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
             break;
         }
     }
+    double psr = 1.0; /* Packet Success Rate */
+    if (!m_chunkSnrs.empty())
+    {
+        m_errorRateModel->GetChunkSuccessRates(payloadMode,
+                                               event->GetPpdu()->GetTxVector(),
+                                               m_chunkSnrs,
+                                               m_chunkBits,
+                                               m_chunkRates,
+                                               m_numRxAntennas,
+                                               WIFI_PPDU_FIELD_DATA,
+                                               staId);
+        for (const auto csr : m_chunkRates)
+        {
+            psr *= csr;
+        }
+    }
+    NS_LOG_DEBUG("mode=" << payloadMode << ", chunks=" << m_chunkSnrs.size() << ", psr=" << psr);
     const auto per = 1.0 - psr;
     return per;
 }
@@ -655,7 +684,7 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(
 {
     NS_LOG_FUNCTION(this << band);
     double psr = 1.0; /* Packet Success Rate */
-    auto niIt = nis->find(band)->second;
+    const auto& niIt = nis->find(band)->second;
     auto j = niIt.begin();
 
     NS_ASSERT(!phyHeaderSections.empty());
@@ -717,7 +746,7 @@ InterferenceHelper::CalculatePhyHeaderPer(Ptr<const Event> event,
                                           WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    auto niIt = nis->find(band)->second;
+    const auto& niIt = nis->find(band)->second;
     auto phyEntity =
         WifiPhy::GetStaticPhyEntity(event->GetPpdu()->GetTxVector().GetModulationClass());
 
@@ -797,7 +826,7 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetNextPosition(Time moment, NiChangesPerBand::iterator niIt)
 {
-    return niIt->second.upper_bound(moment);
+    return std::ranges::upper_bound(niIt->second, moment, {}, &NiChanges::value_type::first);
 }
 
 InterferenceHelper::NiChanges::iterator
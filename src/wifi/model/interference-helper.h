@@ -13,6 +13,10 @@
 
 #include "ns3/object.h"
 
+#include <map>
+#include <utility>
+#include <vector>
+
 namespace ns3
 {
 
@@ -365,7 +369,6 @@ class InterferenceHelper : public Object
          * @param event causes this NI change
          */
         NiChange(Watt_u power, Ptr<Event> event);
-        ~NiChange();
         /**
          * Return the power
          *
@@ -391,9 +394,12 @@ class InterferenceHelper : public Object
     };
 
     /**
-     * typedef for a multimap of NiChange
+     * Time-ordered NI changes of a band. The changes are stored contiguously, the changes which
+     * occur at the same time being kept in their order of insertion, and the changes which
+     * precede the current reception are pruned in place, so that the storage is reused from
+     * one frame to the next.
      */
-    using NiChanges = std::multimap<Time, NiChange>;
+    using NiChanges = std::vector<std::pair<Time, NiChange>>;
 
     /**
      * Map of NiChanges per band
@@ -514,12 +520,28 @@ class InterferenceHelper : public Object
                                         MHz_u channelWidth,
                                         const WifiSpectrumBandInfo& band,
                                         PhyEntity::PhyHeaderSections phyHeaderSections) const;
+    /**
+     * Calculate the number of bits of a payload chunk given its duration and the TXVECTOR.
+     *
+     * @param duration the duration of the chunk
+     * @param txVector the TXVECTOR
+     * @param staId the station ID of the PSDU (only used for MU)
+     *
+     * @return the effective number of bits of the chunk
+     */
+    uint64_t GetPayloadChunkBits(Time duration,
+                                 const WifiTxVector& txVector,
+                                 uint16_t staId) const;
 
     double m_noiseFigure;                 //!< noise figure (linear)
     Ptr<ErrorRateModel> m_errorRateModel; //!< error rate model
     uint8_t m_numRxAntennas;         //!< the number of RX antennas in the corresponding receiver
     FirstPowerPerBand m_firstPowers; //!< first power of each band
 
+    mutable std::vector<double> m_chunkSnrs;   //!< the SNRs of the payload chunks of a window
+    mutable std::vector<uint64_t> m_chunkBits; //!< the number of bits of these chunks
+    mutable std::vector<double> m_chunkRates;  //!< the success rates of these chunks
+
     /**
      * Returns an iterator to the first NiChange that is later than moment
      *
@@ -539,7 +561,8 @@ class InterferenceHelper : public Object
 
     /**
      * Add NiChange to the list at the appropriate position and
-     * return the iterator of the new event.
+     * return the iterator of the new event. This invalidates the
+     * iterators to the NI changes of the band.
      *
      * @param moment time to check from
      * @param change the NiChange to add
@@ -11,8 +11,10 @@
 
 #include "wifi-tx-vector.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 
+#include <algorithm>
 #include <bitset>
 #include <cmath>
 
@@ -26,17 +28,40 @@ NS_OBJECT_ENSURE_REGISTERED(NistErrorRateModel);
 TypeId
 NistErrorRateModel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::NistErrorRateModel")
-                            .SetParent<ErrorRateModel>()
-                            .SetGroupName("Wifi")
-                            .AddConstructor<NistErrorRateModel>();
+    static TypeId tid =
+        TypeId("ns3::NistErrorRateModel")
+            .SetParent<ErrorRateModel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<NistErrorRateModel>()
+            .AddAttribute("LookupPrecision",
+                          "The width in dB of the SNR buckets of the tables in which the bit "
+                          "error probabilities are looked up, or zero to compute them in closed "
+                          "form for each chunk.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&NistErrorRateModel::SetLookupPrecision,
+                                             &NistErrorRateModel::GetLookupPrecision),
+                          MakeDoubleChecker<dB_u>(0));
     return tid;
 }
 
 NistErrorRateModel::NistErrorRateModel()
+    : m_cache("ns3::NistErrorRateModel")
 {
 }
 
+void
+NistErrorRateModel::SetLookupPrecision(dB_u precision)
+{
+    NS_LOG_FUNCTION(this << precision);
+    m_cache.SetPrecision(precision);
+}
+
+dB_u
+NistErrorRateModel::GetLookupPrecision() const
+{
+    return m_cache.GetPrecision();
+}
+
 double
 NistErrorRateModel::GetBpskBer(double snr) const
 {
@@ -70,36 +95,6 @@ NistErrorRateModel::GetQamBer(uint16_t constellationSize, double snr) const
     return ber;
 }
 
-double
-NistErrorRateModel::GetFecBpskBer(double snr, uint64_t nbits, uint8_t bValue) const
-{
-    NS_LOG_FUNCTION(this << snr << nbits << +bValue);
-    double ber = GetBpskBer(snr);
-    if (ber == 0.0)
-    {
-        return 1.0;
-    }
-    double pe = CalculatePe(ber, bValue);
-    pe = std::min(pe, 1.0);
-    double pms = std::pow(1 - pe, nbits);
-    return pms;
-}
-
-double
-NistErrorRateModel::GetFecQpskBer(double snr, uint64_t nbits, uint8_t bValue) const
-{
-    NS_LOG_FUNCTION(this << snr << nbits << +bValue);
-    double ber = GetQpskBer(snr);
-    if (ber == 0.0)
-    {
-        return 1.0;
-    }
-    double pe = CalculatePe(ber, bValue);
-    pe = std::min(pe, 1.0);
-    double pms = std::pow(1 - pe, nbits);
-    return pms;
-}
-
 double
 NistErrorRateModel::CalculatePe(double p, uint8_t bValue) const
 {
@@ -152,21 +147,28 @@ NistErrorRateModel::CalculatePe(double p, uint8_t bValue) const
 }
 
 double
-NistErrorRateModel::GetFecQamBer(uint16_t constellationSize,
-                                 double snr,
-                                 uint64_t nbits,
-                                 uint8_t bValue) const
+NistErrorRateModel::GetFecBer(uint16_t constellationSize, double snr, uint8_t bValue) const
 {
-    NS_LOG_FUNCTION(this << constellationSize << snr << nbits << +bValue);
-    double ber = GetQamBer(constellationSize, snr);
+    NS_LOG_FUNCTION(this << constellationSize << snr << +bValue);
+    double ber;
+    if (constellationSize == 2)
+    {
+        ber = GetBpskBer(snr);
+    }
+    else if (constellationSize == 4)
+    {
+        ber = GetQpskBer(snr);
+    }
+    else
+    {
+        ber = GetQamBer(constellationSize, snr);
+    }
     if (ber == 0.0)
     {
-        return 1.0;
+        return 0.0;
     }
     double pe = CalculatePe(ber, bValue);
-    pe = std::min(pe, 1.0);
-    double pms = std::pow(1 - pe, nbits);
-    return pms;
+    return std::min(pe, 1.0);
 }
 
 uint8_t
@@ -202,23 +204,56 @@ NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
     NS_LOG_FUNCTION(this << mode << snr << nbits << +numRxAntennas << field << staId);
     if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
     {
-        if (mode.GetConstellationSize() == 2)
-        {
-            return GetFecBpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
-        }
-        else if (mode.GetConstellationSize() == 4)
+        const auto constellationSize = mode.GetConstellationSize();
+        const auto bValue = GetBValue(mode.GetCodeRate());
+        double pe;
+        if (m_cache.IsEnabled())
         {
-            return GetFecQpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
+            pe = m_cache.Lookup(constellationSize << 3 | bValue, snr, [=, this](double x) {
+                return GetFecBer(constellationSize, x, bValue);
+            });
         }
         else
         {
-            return GetFecQamBer(mode.GetConstellationSize(),
-                                snr,
-                                nbits,
-                                GetBValue(mode.GetCodeRate()));
+            pe = GetFecBer(constellationSize, snr, bValue);
         }
+        return std::pow(1 - pe, nbits);
     }
     return 0;
 }
 
+void
+NistErrorRateModel::DoGetChunkSuccessRates(WifiMode mode,
+                                           const WifiTxVector& txVector,
+                                           const std::vector<double>& snrs,
+                                           const std::vector<uint64_t>& nbits,
+                                           std::vector<double>& rates,
+                                           uint8_t numRxAntennas,
+                                           WifiPpduField field,
+                                           uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << mode << snrs.size() << +numRxAntennas << field << staId);
+    if (mode.GetModulationClass() < WIFI_MOD_CLASS_ERP_OFDM)
+    {
+        rates.assign(snrs.size(), 0);
+        return;
+    }
+    const auto constellationSize = mode.GetConstellationSize();
+    const auto bValue = GetBValue(mode.GetCodeRate());
+    auto compute = [=, this](double x) { return GetFecBer(constellationSize, x, bValue); };
+    if (m_cache.IsEnabled())
+    {
+        m_cache.Lookup(constellationSize << 3 | bValue, snrs, rates, compute);
+    }
+    else
+    {
+        rates.resize(snrs.size());
+        std::transform(snrs.cbegin(), snrs.cend(), rates.begin(), compute);
+    }
+    for (std::size_t i = 0; i < rates.size(); ++i)
+    {
+        rates[i] = std::pow(1 - rates[i], nbits[i]);
+    }
+}
+
 } // namespace ns3
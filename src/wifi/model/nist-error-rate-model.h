@@ -9,6 +9,7 @@
 #ifndef NIST_ERROR_RATE_MODEL_H
 #define NIST_ERROR_RATE_MODEL_H
 
+#include "error-rate-cache.h"
 #include "error-rate-model.h"
 #include "wifi-mode.h"
 
@@ -22,6 +23,10 @@ namespace ns3
  * the model description and validation can be found in
  * http://www.nsnam.org/~pei/80211ofdm.pdf.  For DSSS modulations (802.11b),
  * the model uses the DsssErrorRateModel.
+ *
+ * The bit error probabilities of the OFDM modes can be looked up in interpolated
+ * tables, shared by all the models, rather than computed for every chunk: see the
+ * LookupPrecision attribute and ErrorRateCache.
  */
 class NistErrorRateModel : public ErrorRateModel
 {
@@ -42,6 +47,14 @@ class NistErrorRateModel : public ErrorRateModel
                                  uint8_t numRxAntennas,
                                  WifiPpduField field,
                                  uint16_t staId) const override;
+    void DoGetChunkSuccessRates(WifiMode mode,
+                                const WifiTxVector& txVector,
+                                const std::vector<double>& snrs,
+                                const std::vector<uint64_t>& nbits,
+                                std::vector<double>& rates,
+                                uint8_t numRxAntennas,
+                                WifiPpduField field,
+                                uint16_t staId) const override;
     /**
      * Return the bValue such that coding rate = bValue / (bValue + 1).
      *
@@ -84,39 +97,27 @@ class NistErrorRateModel : public ErrorRateModel
      */
     double GetQamBer(uint16_t constellationSize, double snr) const;
     /**
-     * Return BER of BPSK at the given SNR after applying FEC.
+     * Return the probability of error of a bit after FEC decoding.
      *
+     * @param constellationSize the constellation size (M)
      * @param snr SNR ratio (in linear scale)
-     * @param nbits the number of bits in the chunk
      * @param bValue the bValue such that coding rate = bValue / (bValue + 1)
      *
-     * @return BER of BPSK at the given SNR after applying FEC
+     * @return the probability of error of a bit at the given SNR after FEC decoding
      */
-    double GetFecBpskBer(double snr, uint64_t nbits, uint8_t bValue) const;
+    double GetFecBer(uint16_t constellationSize, double snr, uint8_t bValue) const;
     /**
-     * Return BER of QPSK at the given SNR after applying FEC.
-     *
-     * @param snr SNR ratio (in linear scale)
-     * @param nbits the number of bits in the chunk
-     * @param bValue the bValue such that coding rate = bValue / (bValue + 1)
+     * Set the width of the SNR buckets of the lookup tables.
      *
-     * @return BER of QPSK at the given SNR after applying FEC
+     * @param precision the precision of the lookup tables, zero to disable them
      */
-    double GetFecQpskBer(double snr, uint64_t nbits, uint8_t bValue) const;
+    void SetLookupPrecision(dB_u precision);
     /**
-     * Return BER of QAM for a given constellation size at the given SNR after applying FEC.
-     *
-     * @param constellationSize the constellation size (M)
-     * @param snr SNR ratio (in linear scale)
-     * @param nbits the number of bits in the chunk
-     * @param bValue the bValue such that coding rate = bValue / (bValue + 1)
-     *
-     * @return BER of QAM for a given constellation size at the given SNR after applying FEC
+     * @return the width of the SNR buckets of the lookup tables
      */
-    double GetFecQamBer(uint16_t constellationSize,
-                        double snr,
-                        uint64_t nbits,
-                        uint8_t bValue) const;
+    dB_u GetLookupPrecision() const;
+
+    ErrorRateCache m_cache; //!< the lookup tables of the bit error probabilities
 };
 
 } // namespace ns3
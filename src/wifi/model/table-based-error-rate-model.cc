@@ -178,49 +178,31 @@ TableBasedErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
     auto errorTable = (ldpc ? AwgnErrorTableLdpc1458
                             : (size < m_threshold ? AwgnErrorTableBcc32 : AwgnErrorTableBcc1458));
     const auto& itVector = errorTable[mcs];
-    auto itTable =
-        std::find_if(itVector.cbegin(), itVector.cend(), [&roundedSnr](const auto& element) {
-            return element.first == roundedSnr;
-        });
-    const auto minSnr = itVector.cbegin()->first;
-    const auto maxSnr = (--itVector.cend())->first;
+    // the tables are sorted by increasing SNR
+    auto itTable = std::lower_bound(itVector.cbegin(),
+                                    itVector.cend(),
+                                    roundedSnr,
+                                    [](const auto& element, dB_u value) {
+                                        return element.first < value;
+                                    });
     double per;
-    if (itTable == itVector.cend())
+    if (itTable != itVector.cend() && itTable->first == roundedSnr)
     {
-        if (roundedSnr < minSnr)
-        {
-            per = 1.0;
-        }
-        else if (roundedSnr > maxSnr)
-        {
-            per = 0.0;
-        }
-        else
-        {
-            double a = 0.0;
-            double b = 0.0;
-            dB_u previousSnr{0.0};
-            dB_u nextSnr{0.0};
-            for (auto i = itVector.cbegin(); i != itVector.cend(); ++i)
-            {
-                if (i->first < roundedSnr)
-                {
-                    previousSnr = i->first;
-                    a = i->second;
-                }
-                else
-                {
-                    nextSnr = i->first;
-                    b = i->second;
-                    break;
-                }
-            }
-            per = a + (roundedSnr - previousSnr) * (b - a) / (nextSnr - previousSnr);
-        }
+        per = itTable->second;
+    }
+    else if (itTable == itVector.cbegin())
+    {
+        per = 1.0;
+    }
+    else if (itTable == itVector.cend())
+    {
+        per = 0.0;
     }
     else
     {
-        per = itTable->second;
+        const auto [previousSnr, a] = *std::prev(itTable);
+        const auto [nextSnr, b] = *itTable;
+        per = a + (roundedSnr - previousSnr) * (b - a) / (nextSnr - previousSnr);
     }
 
     uint16_t tableSize = (ldpc ? ERROR_TABLE_LDPC_FRAME_SIZE
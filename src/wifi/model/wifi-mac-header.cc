@@ -1266,6 +1266,68 @@ WifiMacHeader::Serialize(Buffer::Iterator i) const
     }
 }
 
+bool
+WifiMacHeader::SerializeContiguous(uint8_t* start, uint32_t size) const
+{
+    uint8_t* i = start;
+    auto writeAddress = [&i](Mac48Address address) {
+        address.CopyTo(i);
+        i += 6;
+    };
+
+    i = WriteHtolsbU16(i, GetFrameControl());
+    i = WriteHtolsbU16(i, m_duration);
+    writeAddress(m_addr1);
+    switch (m_ctrlType)
+    {
+    case TYPE_MGT:
+        writeAddress(m_addr2);
+        writeAddress(m_addr3);
+        WriteHtolsbU16(i, GetSequenceControl());
+        break;
+    case TYPE_CTL:
+        switch (m_ctrlSubtype)
+        {
+        case SUBTYPE_CTL_PSPOLL:
+        case SUBTYPE_CTL_RTS:
+        case SUBTYPE_CTL_TRIGGER:
+        case SUBTYPE_CTL_BACKREQ:
+        case SUBTYPE_CTL_BACKRESP:
+        case SUBTYPE_CTL_END:
+        case SUBTYPE_CTL_END_ACK:
+            writeAddress(m_addr2);
+            break;
+        case SUBTYPE_CTL_CTS:
+        case SUBTYPE_CTL_ACK:
+            break;
+        default:
+            // NOTREACHED
+            NS_ASSERT(false);
+            break;
+        }
+        break;
+    case TYPE_DATA: {
+        writeAddress(m_addr2);
+        writeAddress(m_addr3);
+        i = WriteHtolsbU16(i, GetSequenceControl());
+        if (m_ctrlToDs && m_ctrlFromDs)
+        {
+            writeAddress(m_addr4);
+        }
+        if (m_ctrlSubtype & 0x08)
+        {
+            WriteHtolsbU16(i, GetQosControl());
+        }
+    }
+    break;
+    default:
+        // NOTREACHED
+        NS_ASSERT(false);
+        break;
+    }
+    return true;
+}
+
 uint32_t
 WifiMacHeader::Deserialize(Buffer::Iterator start)
 {
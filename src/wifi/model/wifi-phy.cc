@@ -36,7 +36,10 @@
 #include "ns3/vht-configuration.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <numeric>
+#include <unordered_map>
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT                                                                      \
@@ -50,6 +53,66 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("WifiPhy");
 
+namespace
+{
+
+/// The parameters on which the TX duration of a SU transmission depends
+struct TxDurationKey
+{
+    uint32_t size;         //!< the size of the PSDU
+    uint32_t modeUid;      //!< the UID of the mode
+    int64_t guardInterval; //!< the guard interval, in nanoseconds
+    MHz_u channelWidth;    //!< the channel width
+    uint16_t staId;        //!< the STA-ID of the recipient
+    WifiPreamble preamble; //!< the preamble type
+    WifiPhyBand band;      //!< the frequency band
+    uint8_t nss;           //!< the number of spatial streams
+    uint8_t ness;          //!< the number of extension spatial streams
+    uint8_t ehtPpduType;   //!< the EHT PPDU type
+    bool stbc;             //!< whether STBC is used
+    bool ldpc;             //!< whether LDPC is used
+
+    /**
+     * @param other the key to compare with
+     * @return whether the keys are equal
+     */
+    bool operator==(const TxDurationKey& other) const = default;
+};
+
+/// Hash function of the TxDurationKey
+struct TxDurationKeyHash
+{
+    /**
+     * @param key the key
+     * @return the hash of the key
+     */
+    std::size_t operator()(const TxDurationKey& key) const
+    {
+        std::size_t hash = std::hash<double>{}(key.channelWidth);
+        for (const uint64_t value : {static_cast<uint64_t>(key.size),
+                                     static_cast<uint64_t>(key.modeUid),
+                                     static_cast<uint64_t>(key.guardInterval),
+                                     static_cast<uint64_t>(key.staId),
+                                     static_cast<uint64_t>(key.preamble),
+                                     static_cast<uint64_t>(key.band),
+                                     static_cast<uint64_t>(key.nss) << 16 | key.ness << 8 |
+                                         key.ehtPpduType << 2 | key.stbc << 1 | key.ldpc})
+        {
+            hash ^= std::hash<uint64_t>{}(value) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+};
+
+/// The maximum number of durations in the cache of each thread
+std::atomic<std::size_t> g_txDurationCacheCapacity = 4096;
+/// The TX durations computed by the thread
+thread_local std::unordered_map<TxDurationKey, Time, TxDurationKeyHash> g_txDurations;
+/// The statistics on the cache of the thread
+thread_local WifiPhy::TxDurationCacheStatistics g_txDurationStatistics = {0, 0, 0};
+
+} // unnamed namespace
+
 /****************************************************************
  *       The actual WifiPhy class
  ****************************************************************/
@@ -1589,12 +1652,71 @@ WifiPhy::CalculateTxDuration(uint32_t size,
                              WifiPhyBand band,
                              uint16_t staId)
 {
+    // the durations of the MU transmissions also depend on the RUs and on the other users
+    const auto capacity = g_txDurationCacheCapacity.load(std::memory_order_relaxed);
+    if (capacity == 0 || txVector.IsMu())
+    {
+        Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
+                        GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
+        NS_ASSERT(duration.IsStrictlyPositive());
+        return duration;
+    }
+
+    const TxDurationKey key{size,
+                           txVector.GetMode().GetUid(),
+                           txVector.GetGuardInterval().GetNanoSeconds(),
+                           txVector.GetChannelWidth(),
+                           staId,
+                           txVector.GetPreambleType(),
+                           band,
+                           txVector.GetNss(),
+                           txVector.GetNess(),
+                           txVector.GetEhtPpduType(),
+                           txVector.IsStbc(),
+                           txVector.IsLdpc()};
+    if (auto it = g_txDurations.find(key); it != g_txDurations.end())
+    {
+        g_txDurationStatistics.hits++;
+        return it->second;
+    }
+    g_txDurationStatistics.misses++;
     Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
                     GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
     NS_ASSERT(duration.IsStrictlyPositive());
+    if (g_txDurations.size() >= capacity)
+    {
+        g_txDurationStatistics.flushes++;
+        g_txDurations.clear();
+    }
+    g_txDurations.emplace(key, duration);
     return duration;
 }
 
+void
+WifiPhy::SetTxDurationCacheCapacity(std::size_t capacity)
+{
+    g_txDurationCacheCapacity.store(capacity, std::memory_order_relaxed);
+    g_txDurations.clear();
+}
+
+std::size_t
+WifiPhy::GetTxDurationCacheCapacity()
+{
+    return g_txDurationCacheCapacity.load(std::memory_order_relaxed);
+}
+
+WifiPhy::TxDurationCacheStatistics
+WifiPhy::GetTxDurationCacheStatistics()
+{
+    return g_txDurationStatistics;
+}
+
+void
+WifiPhy::ResetTxDurationCacheStatistics()
+{
+    g_txDurationStatistics = {0, 0, 0};
+}
+
 Time
 WifiPhy::CalculateTxDuration(Ptr<const WifiPsdu> psdu,
                              const WifiTxVector& txVector,
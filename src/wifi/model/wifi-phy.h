@@ -239,6 +239,10 @@ class WifiPhy : public Object
      * @param band the frequency band being used
      * @param staId the STA-ID of the recipient (only used for MU)
      *
+     * The durations of the SU transmissions are memoized, per thread, in a cache
+     * keyed by the size, the band and the fields of the TXVECTOR they depend on
+     * (see SetTxDurationCacheCapacity).
+     *
      * @return the total amount of time this PHY will stay busy for the transmission of these bytes.
      */
     static Time CalculateTxDuration(uint32_t size,
@@ -273,6 +277,41 @@ class WifiPhy : public Object
                                     const WifiTxVector& txVector,
                                     WifiPhyBand band);
 
+    /**
+     * Statistics on the cache of the TX durations of the SU transmissions.
+     */
+    struct TxDurationCacheStatistics
+    {
+        uint64_t hits;    //!< Number of durations found in the cache
+        uint64_t misses;  //!< Number of durations computed and inserted in the cache
+        uint64_t flushes; //!< Number of times the cache was emptied because it was full
+    };
+
+    /**
+     * Set the maximum number of durations held in the cache of CalculateTxDuration()
+     * of each thread, which is emptied when it is full. A capacity of zero disables
+     * the cache. The cache of the calling thread is emptied.
+     *
+     * @param capacity the maximum number of durations in the cache (4096 by default)
+     */
+    static void SetTxDurationCacheCapacity(std::size_t capacity);
+    /**
+     * @return the maximum number of durations held in the cache of CalculateTxDuration()
+     */
+    static std::size_t GetTxDurationCacheCapacity();
+    /**
+     * @brief Get the statistics on the cache of CalculateTxDuration()
+     *
+     * The statistics are kept by each thread.
+     *
+     * @returns the statistics since the last reset
+     */
+    static TxDurationCacheStatistics GetTxDurationCacheStatistics();
+    /**
+     * @brief Reset the statistics on the cache of CalculateTxDuration()
+     */
+    static void ResetTxDurationCacheStatistics();
+
     /**
      * @param txVector the transmission parameters used for this packet
      *
@@ -12,8 +12,10 @@
 #include "wifi-tx-vector.h"
 #include "wifi-utils.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace ns3
@@ -26,41 +28,59 @@ NS_OBJECT_ENSURE_REGISTERED(YansErrorRateModel);
 TypeId
 YansErrorRateModel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::YansErrorRateModel")
-                            .SetParent<ErrorRateModel>()
-                            .SetGroupName("Wifi")
-                            .AddConstructor<YansErrorRateModel>();
+    static TypeId tid =
+        TypeId("ns3::YansErrorRateModel")
+            .SetParent<ErrorRateModel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<YansErrorRateModel>()
+            .AddAttribute("LookupPrecision",
+                          "The width in dB of the Eb/No buckets of the tables in which the bit "
+                          "error probabilities are looked up, or zero to compute them in closed "
+                          "form for each chunk.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansErrorRateModel::SetLookupPrecision,
+                                             &YansErrorRateModel::GetLookupPrecision),
+                          MakeDoubleChecker<dB_u>(0));
     return tid;
 }
 
 YansErrorRateModel::YansErrorRateModel()
+    : m_cache("ns3::YansErrorRateModel")
 {
 }
 
+void
+YansErrorRateModel::SetLookupPrecision(dB_u precision)
+{
+    NS_LOG_FUNCTION(this << precision);
+    m_cache.SetPrecision(precision);
+}
+
+dB_u
+YansErrorRateModel::GetLookupPrecision() const
+{
+    return m_cache.GetPrecision();
+}
+
 double
-YansErrorRateModel::GetBpskBer(double snr, MHz_u signalSpread, uint64_t phyRate) const
+YansErrorRateModel::GetBpskBer(double ebNo) const
 {
-    NS_LOG_FUNCTION(this << snr << signalSpread << phyRate);
-    double EbNo = snr * signalSpread * 1e6 / phyRate;
-    double z = std::sqrt(EbNo);
+    NS_LOG_FUNCTION(this << ebNo);
+    double z = std::sqrt(ebNo);
     double ber = 0.5 * erfc(z);
-    NS_LOG_INFO("bpsk snr=" << snr << " ber=" << ber);
+    NS_LOG_INFO("bpsk ebNo=" << ebNo << " ber=" << ber);
     return ber;
 }
 
 double
-YansErrorRateModel::GetQamBer(double snr,
-                              unsigned int m,
-                              MHz_u signalSpread,
-                              uint64_t phyRate) const
+YansErrorRateModel::GetQamBer(double ebNo, unsigned int m) const
 {
-    NS_LOG_FUNCTION(this << snr << m << signalSpread << phyRate);
-    double EbNo = snr * signalSpread * 1e6 / phyRate;
-    double z = std::sqrt((1.5 * log2(m) * EbNo) / (m - 1.0));
+    NS_LOG_FUNCTION(this << ebNo << m);
+    double z = std::sqrt((1.5 * log2(m) * ebNo) / (m - 1.0));
     double z1 = ((1.0 - 1.0 / std::sqrt(m)) * erfc(z));
     double z2 = 1 - std::pow((1 - z1), 2);
     double ber = z2 / log2(m);
-    NS_LOG_INFO("Qam m=" << m << " rate=" << phyRate << " snr=" << snr << " ber=" << ber);
+    NS_LOG_INFO("Qam m=" << m << " ebNo=" << ebNo << " ber=" << ber);
     return ber;
 }
 
@@ -134,52 +154,82 @@ YansErrorRateModel::CalculatePd(double ber, unsigned int d) const
 }
 
 double
-YansErrorRateModel::GetFecBpskBer(double snr,
-                                  uint64_t nbits,
-                                  MHz_u signalSpread,
-                                  uint64_t phyRate,
-                                  uint32_t dFree,
-                                  uint32_t adFree) const
+YansErrorRateModel::GetFecBer(double ebNo, uint32_t m, const FecParameters& fec) const
 {
-    NS_LOG_FUNCTION(this << snr << nbits << signalSpread << phyRate << dFree << adFree);
-    double ber = GetBpskBer(snr, signalSpread, phyRate);
+    NS_LOG_FUNCTION(this << ebNo << m << fec.dFree << fec.adFree << fec.adFreePlusOne);
+    double ber = (m == 2) ? GetBpskBer(ebNo) : GetQamBer(ebNo, m);
     if (ber == 0.0)
     {
-        return 1.0;
+        return 0.0;
+    }
+    /* first term */
+    double pd = CalculatePd(ber, fec.dFree);
+    double pmu = fec.adFree * pd;
+    if (m != 2)
+    {
+        /* second term */
+        pd = CalculatePd(ber, fec.dFree + 1);
+        pmu += fec.adFreePlusOne * pd;
     }
-    double pd = CalculatePd(ber, dFree);
-    double pmu = adFree * pd;
-    pmu = std::min(pmu, 1.0);
-    double pms = std::pow(1 - pmu, nbits);
-    return pms;
+    return std::min(pmu, 1.0);
 }
 
 double
-YansErrorRateModel::GetFecQamBer(double snr,
-                                 uint64_t nbits,
-                                 MHz_u signalSpread,
-                                 uint64_t phyRate,
-                                 uint32_t m,
-                                 uint32_t dFree,
-                                 uint32_t adFree,
-                                 uint32_t adFreePlusOne) const
+YansErrorRateModel::GetEbNoRatio(WifiMode mode, const WifiTxVector& txVector, uint16_t staId) const
 {
-    NS_LOG_FUNCTION(this << snr << nbits << signalSpread << phyRate << m << dFree << adFree
-                         << adFreePlusOne);
-    double ber = GetQamBer(snr, m, signalSpread, phyRate);
-    if (ber == 0.0)
+    uint64_t phyRate;
+    if ((txVector.IsMu() && (staId == SU_STA_ID)) || (mode != txVector.GetMode(staId)))
     {
-        return 1.0;
+        phyRate = mode.GetPhyRate(txVector.GetChannelWidth() >= MHz_u{40}
+                                      ? MHz_u{20}
+                                      : txVector.GetChannelWidth()); // This is the PHY header
+    }
+    else
+    {
+        phyRate = mode.GetPhyRate(txVector, staId);
+    }
+    // the signal spread is the width of the channel
+    return txVector.GetChannelWidth() * 1e6 / phyRate;
+}
+
+bool
+YansErrorRateModel::GetFecParameters(WifiMode mode, FecParameters& fec) const
+{
+    switch (mode.GetConstellationSize())
+    {
+    case 2:
+        fec = (mode.GetCodeRate() == WIFI_CODE_RATE_1_2) ? FecParameters{10, 11, 0}
+                                                         : FecParameters{5, 8, 0};
+        return true;
+    case 4:
+    case 16:
+        fec = (mode.GetCodeRate() == WIFI_CODE_RATE_1_2) ? FecParameters{10, 11, 0}
+                                                         : FecParameters{5, 8, 31};
+        return true;
+    case 64:
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_2_3)
+        {
+            fec = {6, 1, 16};
+        }
+        else if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
+        {
+            // Table B.32  in Pâl Frenger et al., "Multi-rate Convolutional Codes".
+            fec = {4, 14, 69};
+        }
+        else
+        {
+            fec = {5, 8, 31};
+        }
+        return true;
+    case 256:
+    case 1024:
+    case 4096:
+        fec = (mode.GetCodeRate() == WIFI_CODE_RATE_5_6) ? FecParameters{4, 14, 69}
+                                                         : FecParameters{5, 8, 31};
+        return true;
+    default:
+        return false;
     }
-    /* first term */
-    double pd = CalculatePd(ber, dFree);
-    double pmu = adFree * pd;
-    /* second term */
-    pd = CalculatePd(ber, dFree + 1);
-    pmu += adFreePlusOne * pd;
-    pmu = std::min(pmu, 1.0);
-    double pms = std::pow(1 - pmu, nbits);
-    return pms;
 }
 
 double
@@ -192,210 +242,64 @@ YansErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
                                           uint16_t staId) const
 {
     NS_LOG_FUNCTION(this << mode << txVector << snr << nbits << +numRxAntennas << field << staId);
-    if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
+    FecParameters fec;
+    if (mode.GetModulationClass() < WIFI_MOD_CLASS_ERP_OFDM || !GetFecParameters(mode, fec))
     {
-        uint64_t phyRate;
-        if ((txVector.IsMu() && (staId == SU_STA_ID)) || (mode != txVector.GetMode(staId)))
-        {
-            phyRate = mode.GetPhyRate(txVector.GetChannelWidth() >= MHz_u{40}
-                                          ? MHz_u{20}
-                                          : txVector.GetChannelWidth()); // This is the PHY header
-        }
-        else
-        {
-            phyRate = mode.GetPhyRate(txVector, staId);
-        }
-        if (mode.GetConstellationSize() == 2)
-        {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
-            {
-                return GetFecBpskBer(snr,
-                                     nbits,
-                                     txVector.GetChannelWidth(), // signal spread
-                                     phyRate,                    // PHY rate
-                                     10,                         // dFree
-                                     11);                        // adFree
-            }
-            else
-            {
-                return GetFecBpskBer(snr,
-                                     nbits,
-                                     txVector.GetChannelWidth(), // signal spread
-                                     phyRate,                    // PHY rate
-                                     5,                          // dFree
-                                     8);                         // adFree
-            }
-        }
-        else if (mode.GetConstellationSize() == 4)
-        {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    4,                          // m
-                                    10,                         // dFree
-                                    11,                         // adFree
-                                    0);                         // adFreePlusOne
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    4,                          // m
-                                    5,                          // dFree
-                                    8,                          // adFree
-                                    31);                        // adFreePlusOne
-            }
-        }
-        else if (mode.GetConstellationSize() == 16)
-        {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    16,                         // m
-                                    10,                         // dFree
-                                    11,                         // adFree
-                                    0);                         // adFreePlusOne
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    16,                         // m
-                                    5,                          // dFree
-                                    8,                          // adFree
-                                    31);                        // adFreePlusOne
-            }
-        }
-        else if (mode.GetConstellationSize() == 64)
-        {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_2_3)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    64,                         // m
-                                    6,                          // dFree
-                                    1,                          // adFree
-                                    16);                        // adFreePlusOne
-            }
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                // Table B.32  in Pâl Frenger et al., "Multi-rate Convolutional Codes".
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    64,                         // m
-                                    4,                          // dFree
-                                    14,                         // adFree
-                                    69);                        // adFreePlusOne
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    64,                         // m
-                                    5,                          // dFree
-                                    8,                          // adFree
-                                    31);                        // adFreePlusOne
-            }
-        }
-        else if (mode.GetConstellationSize() == 256)
-        {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    256,                        // m
-                                    4,                          // dFree
-                                    14,                         // adFree
-                                    69                          // adFreePlusOne
-                );
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    256,                        // m
-                                    5,                          // dFree
-                                    8,                          // adFree
-                                    31                          // adFreePlusOne
-                );
-            }
-        }
-        else if (mode.GetConstellationSize() == 1024)
-        {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    1024,                       // m
-                                    4,                          // dFree
-                                    14,                         // adFree
-                                    69                          // adFreePlusOne
-                );
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    1024,                       // m
-                                    5,                          // dFree
-                                    8,                          // adFree
-                                    31                          // adFreePlusOne
-                );
-            }
-        }
-        else if (mode.GetConstellationSize() == 4096)
-        {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    4096,                       // m
-                                    4,                          // dFree
-                                    14,                         // adFree
-                                    69                          // adFreePlusOne
-                );
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    4096,                       // m
-                                    5,                          // dFree
-                                    8,                          // adFree
-                                    31                          // adFreePlusOne
-                );
-            }
-        }
+        return 0;
+    }
+    const uint32_t m = mode.GetConstellationSize();
+    const auto ebNo = snr * GetEbNoRatio(mode, txVector, staId);
+    double pmu;
+    if (m_cache.IsEnabled())
+    {
+        pmu = m_cache.Lookup(m << 3 | mode.GetCodeRate(), ebNo, [&, this](double x) {
+            return GetFecBer(x, m, fec);
+        });
+    }
+    else
+    {
+        pmu = GetFecBer(ebNo, m, fec);
+    }
+    return std::pow(1 - pmu, nbits);
+}
+
+void
+YansErrorRateModel::DoGetChunkSuccessRates(WifiMode mode,
+                                           const WifiTxVector& txVector,
+                                           const std::vector<double>& snrs,
+                                           const std::vector<uint64_t>& nbits,
+                                           std::vector<double>& rates,
+                                           uint8_t numRxAntennas,
+                                           WifiPpduField field,
+                                           uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << mode << txVector << snrs.size() << +numRxAntennas << field << staId);
+    FecParameters fec;
+    if (mode.GetModulationClass() < WIFI_MOD_CLASS_ERP_OFDM || !GetFecParameters(mode, fec))
+    {
+        rates.assign(snrs.size(), 0);
+        return;
+    }
+    const uint32_t m = mode.GetConstellationSize();
+    const auto ratio = GetEbNoRatio(mode, txVector, staId);
+    std::vector<double> ebNos(snrs.size());
+    std::transform(snrs.cbegin(), snrs.cend(), ebNos.begin(), [=](double snr) {
+        return snr * ratio;
+    });
+    auto compute = [&, this](double x) { return GetFecBer(x, m, fec); };
+    if (m_cache.IsEnabled())
+    {
+        m_cache.Lookup(m << 3 | mode.GetCodeRate(), ebNos, rates, compute);
+    }
+    else
+    {
+        rates.resize(ebNos.size());
+        std::transform(ebNos.cbegin(), ebNos.cend(), rates.begin(), compute);
+    }
+    for (std::size_t i = 0; i < rates.size(); ++i)
+    {
+        rates[i] = std::pow(1 - rates[i], nbits[i]);
     }
-    return 0;
 }
 
 } // namespace ns3
@@ -9,6 +9,7 @@
 #ifndef YANS_ERROR_RATE_MODEL_H
 #define YANS_ERROR_RATE_MODEL_H
 
+#include "error-rate-cache.h"
 #include "error-rate-model.h"
 
 namespace ns3
@@ -38,6 +39,10 @@ namespace ns3
  *      57(2):440-449, February 2009.
  *    - More detailed description and validation can be found in
  *      http://www.nsnam.org/~pei/80211b.pdf
+ *
+ * The bit error probabilities of the OFDM modes, function of the Eb/No of the chunk, can be
+ * looked up in interpolated tables, shared by all the models, rather than computed for every
+ * chunk: see the LookupPrecision attribute and ErrorRateCache.
  */
 class YansErrorRateModel : public ErrorRateModel
 {
@@ -51,6 +56,14 @@ class YansErrorRateModel : public ErrorRateModel
     YansErrorRateModel();
 
   private:
+    /// The parameters of the convolutional code of a mode
+    struct FecParameters
+    {
+        uint32_t dFree;         //!< the free distance of the code
+        uint32_t adFree;        //!< the number of paths at the free distance
+        uint32_t adFreePlusOne; //!< the number of paths at the free distance plus one
+    };
+
     double DoGetChunkSuccessRate(WifiMode mode,
                                  const WifiTxVector& txVector,
                                  double snr,
@@ -58,27 +71,50 @@ class YansErrorRateModel : public ErrorRateModel
                                  uint8_t numRxAntennas,
                                  WifiPpduField field,
                                  uint16_t staId) const override;
+    void DoGetChunkSuccessRates(WifiMode mode,
+                                const WifiTxVector& txVector,
+                                const std::vector<double>& snrs,
+                                const std::vector<uint64_t>& nbits,
+                                std::vector<double>& rates,
+                                uint8_t numRxAntennas,
+                                WifiPpduField field,
+                                uint16_t staId) const override;
+    /**
+     * Return the ratio between the Eb/No and the SNR of the chunks of the given mode.
+     *
+     * @param mode the Wi-Fi mode the chunks are sent with
+     * @param txVector TXVECTOR of the PPDU
+     * @param staId the station ID for MU
+     *
+     * @return the ratio between the Eb/No and the SNR
+     */
+    double GetEbNoRatio(WifiMode mode, const WifiTxVector& txVector, uint16_t staId) const;
+    /**
+     * Return the parameters of the convolutional code of the given mode.
+     *
+     * @param mode the Wi-Fi mode
+     * @param [out] fec the parameters of the code
+     *
+     * @return whether the mode is modeled
+     */
+    bool GetFecParameters(WifiMode mode, FecParameters& fec) const;
     /**
      * Return BER of BPSK with the given parameters.
      *
-     * @param snr SNR ratio (not dB)
-     * @param signalSpread
-     * @param phyRate
+     * @param ebNo Eb/No ratio (not dB)
      *
-     * @return BER of BPSK at the given SNR
+     * @return BER of BPSK at the given Eb/No
      */
-    double GetBpskBer(double snr, MHz_u signalSpread, uint64_t phyRate) const;
+    double GetBpskBer(double ebNo) const;
     /**
      * Return BER of QAM-m with the given parameters.
      *
-     * @param snr SNR ratio (not dB)
+     * @param ebNo Eb/No ratio (not dB)
      * @param m
-     * @param signalSpread
-     * @param phyRate
      *
-     * @return BER of BPSK at the given SNR
+     * @return BER of QAM-m at the given Eb/No
      */
-    double GetQamBer(double snr, unsigned int m, MHz_u signalSpread, uint64_t phyRate) const;
+    double GetQamBer(double ebNo, unsigned int m) const;
     /**
      * Return k!
      *
@@ -119,41 +155,27 @@ class YansErrorRateModel : public ErrorRateModel
      */
     double CalculatePd(double ber, unsigned int d) const;
     /**
-     * @param snr SNR ratio (not dB)
-     * @param nbits
-     * @param signalSpread
-     * @param phyRate
-     * @param dFree
-     * @param adFree
+     * Return the probability of error of a bit after FEC decoding.
      *
-     * @return double
+     * @param ebNo Eb/No ratio (not dB)
+     * @param m the constellation size
+     * @param fec the parameters of the convolutional code
+     *
+     * @return the probability of error of a bit at the given Eb/No after FEC decoding
      */
-    double GetFecBpskBer(double snr,
-                         uint64_t nbits,
-                         MHz_u signalSpread,
-                         uint64_t phyRate,
-                         uint32_t dFree,
-                         uint32_t adFree) const;
+    double GetFecBer(double ebNo, uint32_t m, const FecParameters& fec) const;
     /**
-     * @param snr SNR ratio (not dB)
-     * @param nbits
-     * @param signalSpread
-     * @param phyRate
-     * @param m
-     * @param dfree
-     * @param adFree
-     * @param adFreePlusOne
+     * Set the width of the Eb/No buckets of the lookup tables.
      *
-     * @return double
+     * @param precision the precision of the lookup tables, zero to disable them
+     */
+    void SetLookupPrecision(dB_u precision);
+    /**
+     * @return the width of the Eb/No buckets of the lookup tables
      */
-    double GetFecQamBer(double snr,
-                        uint64_t nbits,
-                        MHz_u signalSpread,
-                        uint64_t phyRate,
-                        uint32_t m,
-                        uint32_t dfree,
-                        uint32_t adFree,
-                        uint32_t adFreePlusOne) const;
+    dB_u GetLookupPrecision() const;
+
+    ErrorRateCache m_cache; //!< the lookup tables of the bit error probabilities
 };
 
 } // namespace ns3
@@ -14,6 +14,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -22,6 +23,8 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -46,11 +49,25 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("MaxRange",
+                          "The maximum distance, in meters, between the sender and the receivers "
+                          "to which a PPDU is delivered. The receivers within this distance are "
+                          "found in a spatial index, kept up to date by the CourseChange "
+                          "notifications of their mobility models, and the propagation loss "
+                          "towards the others is not computed. Choose a distance beyond which "
+                          "the received power is certainly below the sensitivity of the "
+                          "receivers. Zero delivers the PPDUs to all the receivers.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::SetMaxRange,
+                                             &YansWifiChannel::GetMaxRange),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_maxRange(0),
+      m_rxIndexOutdated(true)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -61,6 +78,16 @@ YansWifiChannel::~YansWifiChannel()
     m_phyList.clear();
 }
 
+void
+YansWifiChannel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    // the index holds the mobility models and is connected to their course changes
+    m_rxIndex.Clear();
+    m_unlocatedPhys.clear();
+    Channel::DoDispose();
+}
+
 void
 YansWifiChannel::SetPropagationLossModel(const Ptr<PropagationLossModel> loss)
 {
@@ -75,50 +102,141 @@ YansWifiChannel::SetPropagationDelayModel(const Ptr<PropagationDelayModel> delay
     m_delay = delay;
 }
 
+void
+YansWifiChannel::SetMaxRange(double maxRange)
+{
+    NS_LOG_FUNCTION(this << maxRange);
+    m_maxRange = maxRange;
+    if (maxRange > 0)
+    {
+        m_rxIndex.SetCellSize(maxRange);
+    }
+}
+
+double
+YansWifiChannel::GetMaxRange() const
+{
+    return m_maxRange;
+}
+
 void
 YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u txPower) const
 {
     NS_LOG_FUNCTION(this << sender << ppdu << txPower);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    std::vector<Reception> receptions;
+    if (m_maxRange > 0)
     {
-        if (sender != (*i))
+        // the mobility models may have been installed after the PHYs were added
+        for (const auto i : m_unlocatedPhys)
         {
-            // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
+            if (m_phyList[i]->GetMobility())
             {
-                continue;
+                m_rxIndexOutdated = true;
             }
-
-            auto receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPower << "dBm, rxPower=" << rxPower << "dBm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            auto dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
+        }
+        if (m_rxIndexOutdated)
+        {
+            m_rxIndex.Clear();
+            m_unlocatedPhys.clear();
+            for (std::size_t i = 0; i < m_phyList.size(); ++i)
             {
-                dstNode = 0xffffffff;
+                auto mobility = m_phyList[i]->GetMobility();
+                m_rxIndex.Add(i, mobility);
+                if (!mobility)
+                {
+                    m_unlocatedPhys.push_back(i);
+                }
             }
-            else
+            m_rxIndexOutdated = false;
+        }
+        for (const auto i : m_rxIndex.GetItemsInRange(senderMobility->GetPosition(), m_maxRange))
+        {
+            SendTo(sender, m_phyList[i], ppdu, txPower, receptions);
+        }
+    }
+    else
+    {
+        for (const auto& receiver : m_phyList)
+        {
+            SendTo(sender, receiver, ppdu, txPower, receptions);
+        }
+    }
+    ScheduleReceptions(receptions);
+}
+
+void
+YansWifiChannel::ScheduleReceptions(std::vector<Reception>& receptions)
+{
+    // the events at the same time keep the order in which they were added
+    std::stable_sort(receptions.begin(),
+                     receptions.end(),
+                     [](const Reception& a, const Reception& b) { return a.delay < b.delay; });
+    auto start = receptions.begin();
+    while (start != receptions.end())
+    {
+        auto end = std::find_if(start, receptions.end(), [start](const Reception& reception) {
+            return reception.delay != start->delay;
+        });
+        if (end - start == 1)
+        {
+            Simulator::ScheduleWithContext(start->context, start->delay, start->event);
+        }
+        else
+        {
+            EventBatch batch;
+            batch.reserve(end - start);
+            for (auto it = start; it != end; ++it)
             {
-                dstNode = dstNetDevice->GetNode()->GetId();
+                batch.emplace_back(it->context, it->event);
             }
-
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPower);
+            Simulator::ScheduleWithContextBatch(start->delay, std::move(batch));
         }
+        start = end;
     }
 }
 
+void
+YansWifiChannel::SendTo(Ptr<YansWifiPhy> sender,
+                        Ptr<YansWifiPhy> receiver,
+                        Ptr<const WifiPpdu> ppdu,
+                        dBm_u txPower,
+                        std::vector<Reception>& receptions) const
+{
+    if (sender == receiver)
+    {
+        return;
+    }
+    // For now don't account for inter channel interference nor channel bonding
+    if (receiver->GetChannelNumber() != sender->GetChannelNumber())
+    {
+        return;
+    }
+
+    auto senderMobility = sender->GetMobility();
+    auto receiverMobility = receiver->GetMobility()->GetObject<MobilityModel>();
+    const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
+    const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
+    NS_LOG_DEBUG("propagation: txPower="
+                 << txPower << "dBm, rxPower=" << rxPower << "dBm, "
+                 << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                 << "m, delay=" << delay);
+    auto dstNetDevice = receiver->GetDevice();
+    uint32_t dstNode;
+    if (!dstNetDevice)
+    {
+        dstNode = 0xffffffff;
+    }
+    else
+    {
+        dstNode = dstNetDevice->GetNode()->GetId();
+    }
+
+    receptions.push_back(
+        {delay, dstNode, MakeEvent(&YansWifiChannel::Receive, receiver, ppdu, rxPower)});
+}
+
 void
 YansWifiChannel::Receive(Ptr<YansWifiPhy> phy, Ptr<const WifiPpdu> ppdu, dBm_u rxPower)
 {
@@ -158,6 +276,7 @@ YansWifiChannel::Add(Ptr<YansWifiPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
     m_phyList.push_back(phy);
+    m_rxIndexOutdated = true;
 }
 
 int64_t
@@ -12,6 +12,9 @@
 #include "wifi-units.h"
 
 #include "ns3/channel.h"
+#include "ns3/event-impl.h"
+#include "ns3/mobility-grid-index.h"
+#include "ns3/nstime.h"
 
 namespace ns3
 {
@@ -21,7 +24,6 @@ class PropagationLossModel;
 class PropagationDelayModel;
 class YansWifiPhy;
 class Packet;
-class Time;
 class WifiPpdu;
 
 /**
@@ -72,7 +74,8 @@ class YansWifiChannel : public Channel
      * This method should not be invoked by normal users. It is
      * currently invoked only from YansWifiPhy::StartTx.  The channel
      * attempts to deliver the PPDU to all other YansWifiPhy objects
-     * on the channel (except for the sender).
+     * on the channel (except for the sender), or only to those within the
+     * MaxRange of the sender if it is set.
      */
     void Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u txPower) const;
 
@@ -87,12 +90,38 @@ class YansWifiChannel : public Channel
      */
     int64_t AssignStreams(int64_t stream);
 
+    /**
+     * Set the maximum distance between the sender and the receivers to which
+     * a PPDU is delivered. The receivers within this distance are found in a
+     * spatial index, without computing the propagation loss towards the others.
+     *
+     * @param maxRange the maximum range in meters, zero to deliver to all the receivers
+     */
+    void SetMaxRange(double maxRange);
+    /**
+     * @return the maximum range in meters, zero if all the receivers are reached
+     */
+    double GetMaxRange() const;
+
+  protected:
+    void DoDispose() override;
+
   private:
     /**
      * A vector of pointers to YansWifiPhy.
      */
     typedef std::vector<Ptr<YansWifiPhy>> PhyList;
 
+    /**
+     * The reception of a PPDU by a receiver, not scheduled yet.
+     */
+    struct Reception
+    {
+        Time delay;       //!< the propagation delay
+        uint32_t context; //!< the node of the receiver
+        EventImpl* event; //!< the event which delivers the PPDU
+    };
+
     /**
      * This method is scheduled by Send for each associated YansWifiPhy.
      * The method then calls the corresponding YansWifiPhy that the first
@@ -104,9 +133,38 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, dBm_u txPower);
 
+    /**
+     * Deliver a PPDU to a receiver after its propagation delay.
+     *
+     * @param sender the PHY object from which the PPDU is originating
+     * @param receiver the PHY object to which the PPDU is delivered
+     * @param ppdu the PPDU being sent
+     * @param txPower the TX power associated to the PPDU
+     * @param receptions the receptions of the PPDU, to which this one is added
+     */
+    void SendTo(Ptr<YansWifiPhy> sender,
+                Ptr<YansWifiPhy> receiver,
+                Ptr<const WifiPpdu> ppdu,
+                dBm_u txPower,
+                std::vector<Reception>& receptions) const;
+
+    /**
+     * Schedule the receptions of a PPDU.  The receptions after the same
+     * delay are scheduled as a single batch, in the order of the list of
+     * PHYs, and the other ones one by one.
+     *
+     * @param receptions the receptions, in the order of the list of PHYs
+     */
+    static void ScheduleReceptions(std::vector<Reception>& receptions);
+
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    double m_maxRange;                  //!< Maximum range of the transmissions (0 if unlimited)
+    mutable MobilityGridIndex m_rxIndex; //!< Index of the PHYs, by position in the PHY list
+    mutable bool m_rxIndexOutdated;      //!< Whether the index must be rebuilt before use
+    /// Positions in the PHY list of the PHYs indexed without a mobility model
+    mutable std::vector<std::size_t> m_unlocatedPhys;
 };
 
 } // namespace ns3
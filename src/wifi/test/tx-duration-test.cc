@@ -1925,6 +1925,132 @@ PhyHeaderSectionsTest::DoRun()
     CheckPhyHeaderSections(phyEntity->GetPhyHeaderSections(txVector, ppduStart), sections);
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the cache of the TX durations
+ *
+ * Check that the TX durations returned from the cache are those computed without it,
+ * that the TXVECTORs which only differ in one of the fields on which the duration
+ * depends have distinct entries, that the cache is bounded and that the durations
+ * of the MU transmissions are not cached.
+ */
+class TxDurationCacheTest : public TestCase
+{
+  public:
+    TxDurationCacheTest();
+    void DoRun() override;
+};
+
+TxDurationCacheTest::TxDurationCacheTest()
+    : TestCase("Cache of the TX durations")
+{
+}
+
+void
+TxDurationCacheTest::DoRun()
+{
+    const auto capacity = WifiPhy::GetTxDurationCacheCapacity();
+
+    WifiTxVector ht(HtPhy::GetHtMcs7(), 0, WIFI_PREAMBLE_HT_MF, NanoSeconds(800), 1, 1, 0, 20, 0);
+    auto htStbc = ht;
+    htStbc.SetStbc(true);
+    auto htNess = ht;
+    htNess.SetNess(1);
+    WifiTxVector he(HePhy::GetHeMcs11(), 0, WIFI_PREAMBLE_HE_SU, NanoSeconds(800), 2, 2, 0, 160, 0);
+    auto heGi = he;
+    heGi.SetGuardInterval(NanoSeconds(3200));
+    auto heNss = he;
+    heNss.SetNss(1);
+    WifiTxVector eht(EhtPhy::GetEhtMcs13(),
+                     0,
+                     WIFI_PREAMBLE_EHT_MU,
+                     NanoSeconds(800),
+                     1,
+                     1,
+                     0,
+                     320,
+                     0);
+    const std::list<std::pair<WifiTxVector, WifiPhyBand>> txVectors{
+        {WifiTxVector(DsssPhy::GetDsssRate1Mbps(), 0, WIFI_PREAMBLE_LONG, Time(), 1, 1, 0, 22, 0),
+         WIFI_PHY_BAND_2_4GHZ},
+        {WifiTxVector(DsssPhy::GetDsssRate2Mbps(), 0, WIFI_PREAMBLE_SHORT, Time(), 1, 1, 0, 22, 0),
+         WIFI_PHY_BAND_2_4GHZ},
+        {WifiTxVector(OfdmPhy::GetOfdmRate6Mbps(), 0, WIFI_PREAMBLE_LONG, Time(), 1, 1, 0, 20, 0),
+         WIFI_PHY_BAND_5GHZ},
+        {WifiTxVector(OfdmPhy::GetOfdmRate6Mbps(), 0, WIFI_PREAMBLE_LONG, Time(), 1, 1, 0, 20, 0),
+         WIFI_PHY_BAND_2_4GHZ},
+        {ht, WIFI_PHY_BAND_5GHZ},
+        {htStbc, WIFI_PHY_BAND_5GHZ},
+        {htNess, WIFI_PHY_BAND_5GHZ},
+        {he, WIFI_PHY_BAND_5GHZ},
+        {heGi, WIFI_PHY_BAND_5GHZ},
+        {heNss, WIFI_PHY_BAND_5GHZ},
+        {eht, WIFI_PHY_BAND_6GHZ},
+    };
+    const std::list<uint32_t> sizes{1, 150, 1500, 4095};
+
+    // the durations computed without the cache
+    WifiPhy::SetTxDurationCacheCapacity(0);
+    std::list<Time> expected;
+    for (const auto& [txVector, band] : txVectors)
+    {
+        for (const auto size : sizes)
+        {
+            expected.push_back(WifiPhy::CalculateTxDuration(size, txVector, band));
+        }
+    }
+
+    WifiPhy::SetTxDurationCacheCapacity(4096);
+    WifiPhy::ResetTxDurationCacheStatistics();
+    for (uint32_t round = 0; round < 2; ++round)
+    {
+        auto it = expected.cbegin();
+        for (const auto& [txVector, band] : txVectors)
+        {
+            for (const auto size : sizes)
+            {
+                NS_TEST_EXPECT_MSG_EQ(WifiPhy::CalculateTxDuration(size, txVector, band),
+                                      *it++,
+                                      "Unexpected duration for " << size << " bytes sent with "
+                                                                 << txVector);
+            }
+        }
+    }
+    auto statistics = WifiPhy::GetTxDurationCacheStatistics();
+    NS_TEST_EXPECT_MSG_EQ(statistics.misses, expected.size(), "Each duration is computed once");
+    NS_TEST_EXPECT_MSG_EQ(statistics.hits, expected.size(), "Each duration is then found");
+
+    // the durations of the MU transmissions are not cached
+    WifiTxVector mu;
+    mu.SetPreambleType(WIFI_PREAMBLE_HE_MU);
+    mu.SetChannelWidth(MHz_u{20});
+    mu.SetGuardInterval(NanoSeconds(3200));
+    mu.SetHeMuUserInfo(1, {{HeRu::RU_106_TONE, 1, true}, 11, 1});
+    mu.SetHeMuUserInfo(2, {{HeRu::RU_106_TONE, 2, true}, 10, 1});
+    mu.SetSigBMode(VhtPhy::GetVhtMcs5());
+    WifiPhy::ResetTxDurationCacheStatistics();
+    WifiPhy::CalculateTxDuration(1500, mu, WIFI_PHY_BAND_5GHZ, 1);
+    WifiPhy::CalculateTxDuration(1500, mu, WIFI_PHY_BAND_5GHZ, 1);
+    statistics = WifiPhy::GetTxDurationCacheStatistics();
+    NS_TEST_EXPECT_MSG_EQ(statistics.hits + statistics.misses, 0, "MU durations are not cached");
+
+    // the cache is emptied when it is full
+    WifiPhy::SetTxDurationCacheCapacity(2);
+    WifiPhy::ResetTxDurationCacheStatistics();
+    for (const auto size : {100, 200, 300, 300})
+    {
+        WifiPhy::CalculateTxDuration(size, he, WIFI_PHY_BAND_5GHZ);
+    }
+    statistics = WifiPhy::GetTxDurationCacheStatistics();
+    NS_TEST_EXPECT_MSG_EQ(statistics.misses, 3, "Unexpected number of misses");
+    NS_TEST_EXPECT_MSG_EQ(statistics.hits, 1, "Unexpected number of hits");
+    NS_TEST_EXPECT_MSG_EQ(statistics.flushes, 1, "Unexpected number of flushes");
+
+    WifiPhy::SetTxDurationCacheCapacity(capacity);
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -1942,6 +2068,8 @@ TxDurationTestSuite::TxDurationTestSuite()
 {
     AddTestCase(new TxDurationTest, TestCase::Duration::QUICK);
 
+    AddTestCase(new TxDurationCacheTest, TestCase::Duration::QUICK);
+
     AddTestCase(new PhyHeaderSectionsTest, TestCase::Duration::QUICK);
 
     // 20 MHz band, HeSigBDurationTest::OFDMA, even number of users per HE-SIG-B content channel
@@ -14,11 +14,13 @@
 #include <gsl/gsl_sf_bessel.h>
 #endif
 
+#include "ns3/double.h"
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
 #include "ns3/log.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/object-factory.h"
 #include "ns3/table-based-error-rate-model.h"
 #include "ns3/test.h"
 #include "ns3/wifi-phy.h"
@@ -1011,6 +1013,109 @@ std::map<std::pair<uint8_t /* mcs */, uint32_t /* size */>,
          }},
 };
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Wifi Error Rate Models Test Case Lookup
+ *
+ * Check that the chunk success rates of the NIST and YANS error rate models are close
+ * to those computed in closed form when the bit error probabilities are looked up in
+ * tables, and that the success rates of several chunks computed at once are those
+ * computed one by one.
+ */
+class WifiErrorRateModelsTestCaseLookup : public TestCase
+{
+  public:
+    WifiErrorRateModelsTestCaseLookup();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the lookup tables of an error rate model.
+     *
+     * @param typeId the TypeId of the error rate model
+     */
+    void CheckModel(const std::string& typeId);
+};
+
+WifiErrorRateModelsTestCaseLookup::WifiErrorRateModelsTestCaseLookup()
+    : TestCase("WifiErrorRateModel test case lookup tables")
+{
+}
+
+void
+WifiErrorRateModelsTestCaseLookup::CheckModel(const std::string& typeId)
+{
+    ObjectFactory factory(typeId);
+    auto exact = factory.Create<ErrorRateModel>();
+    factory.Set("LookupPrecision", DoubleValue(0.01));
+    auto cached = factory.Create<ErrorRateModel>();
+
+    const uint64_t nbits = 12000;
+    for (const auto& mode : {WifiMode("OfdmRate6Mbps"),
+                             WifiMode("OfdmRate18Mbps"),
+                             WifiMode("OfdmRate36Mbps"),
+                             WifiMode("OfdmRate48Mbps"),
+                             WifiMode("OfdmRate54Mbps"),
+                             HtPhy::GetHtMcs7(),
+                             VhtPhy::GetVhtMcs8(),
+                             HePhy::GetHeMcs11()})
+    {
+        WifiTxVector txVector(mode,
+                              0,
+                              GetPreambleForTransmission(mode.GetModulationClass(), false),
+                              NanoSeconds(800),
+                              1,
+                              1,
+                              0,
+                              MHz_u{20},
+                              false);
+        std::vector<double> snrs;
+        std::vector<uint64_t> bits;
+        // the SNRs do not fall on the samples of the tables, some are out of the tables
+        for (dB_u snr = -30.13; snr <= dB_u{70}; snr += dB_u{0.37})
+        {
+            const auto ratio = DbToRatio(snr);
+            const auto expected = exact->GetChunkSuccessRate(mode, txVector, ratio, nbits);
+            const auto ps = cached->GetChunkSuccessRate(mode, txVector, ratio, nbits);
+            NS_TEST_ASSERT_MSG_EQ_TOL(ps,
+                                      expected,
+                                      1e-4,
+                                      typeId << " " << mode << ": lookup at " << snr
+                                             << " dB not equal within tolerance");
+            snrs.push_back(ratio);
+            bits.push_back(nbits + snrs.size());
+        }
+
+        for (const auto& model : {exact, cached})
+        {
+            std::vector<double> rates;
+            model->GetChunkSuccessRates(mode, txVector, snrs, bits, rates);
+            NS_TEST_ASSERT_MSG_EQ(rates.size(), snrs.size(), "Unexpected number of rates");
+            for (std::size_t i = 0; i < snrs.size(); ++i)
+            {
+                NS_TEST_ASSERT_MSG_EQ_TOL(rates[i],
+                                          model->GetChunkSuccessRate(mode,
+                                                                     txVector,
+                                                                     snrs[i],
+                                                                     bits[i]),
+                                          1e-12,
+                                          typeId << " " << mode
+                                                 << ": batch and single rates differ");
+            }
+        }
+    }
+}
+
+void
+WifiErrorRateModelsTestCaseLookup::DoRun()
+{
+    CheckModel("ns3::NistErrorRateModel");
+    CheckModel("ns3::YansErrorRateModel");
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -1120,6 +1225,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
     AddTestCase(new WifiErrorRateModelsTestCaseDsss, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseNist, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseMimo, TestCase::Duration::QUICK);
+    AddTestCase(new WifiErrorRateModelsTestCaseLookup, TestCase::Duration::QUICK);
     AddTestCase(new TableBasedErrorRateTestCase("DefaultTableBasedHtMcs0-1458bytes",
                                                 HtPhy::GetHtMcs0(),
                                                 1458),
@@ -14,6 +14,7 @@
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/constant-rate-wifi-manager.h"
+#include "ns3/double.h"
 #include "ns3/error-model.h"
 #include "ns3/fcfs-wifi-queue-scheduler.h"
 #include "ns3/he-frame-exchange-manager.h"
@@ -24,10 +25,14 @@
 #include "ns3/mgt-headers.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/ofdm-phy.h"
+#include "ns3/ofdm-ppdu.h"
 #include "ns3/packet-socket-client.h"
 #include "ns3/packet-socket-helper.h"
 #include "ns3/packet-socket-server.h"
 #include "ns3/pointer.h"
+#include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/rng-seed-manager.h"
 #include "ns3/socket.h"
@@ -48,6 +53,7 @@
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/yans-wifi-phy.h"
 
+#include <cstring>
 #include <optional>
 
 using namespace ns3;
@@ -420,6 +426,212 @@ InterferenceHelperSequenceTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief InterferenceHelper NI changes Test
+ *
+ * Drive an InterferenceHelper directly with overlapping signals, some of which
+ * start or end at the same time, and check the SNIR, the PER and the energy
+ * duration against values computed by hand, before and after the NI changes
+ * preceding a reception are pruned.
+ *
+ * The signals are (start and end in microseconds, power in watts):
+ * - A: interference, [0, 200], 1e-10
+ * - B: received, [50, 150], 2e-10
+ * - C: interference, [100, 150], 1e-10
+ * - D: received, [300, 400], 4e-10
+ * - E: interference, [300, 340], 2e-10
+ *
+ * B and D are 6 Mbps OFDM PPDUs, whose preamble and header last 20 us.
+ */
+class InterferenceHelperNiChangesTest : public TestCase
+{
+  public:
+    InterferenceHelperNiChangesTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Add a signal to the InterferenceHelper.
+     *
+     * @param duration the duration of the signal
+     * @param power the received power of the signal
+     * @return the event of the signal
+     */
+    Ptr<Event> AddSignal(Time duration, Watt_u power);
+
+    /**
+     * Check the SNIR of a received signal, computed at the current time.
+     *
+     * @param event the event of the signal
+     * @param expectedSnr the expected SNIR (linear)
+     */
+    void CheckSnr(Ptr<Event> event, double expectedSnr);
+
+    /**
+     * Check the SNIR and the PER of the payload of a received signal.
+     *
+     * @param event the event of the signal
+     * @param expectedSnr the expected SNIR at the current time (linear)
+     * @param chunks the SNIR (linear) and the duration of the chunks of the payload
+     */
+    void CheckPayloadSnrPer(Ptr<Event> event,
+                            double expectedSnr,
+                            const std::vector<std::pair<double, Time>>& chunks);
+
+    /**
+     * Check the time until the noise and interference falls below a threshold.
+     *
+     * @param energy the threshold
+     * @param expectedDuration the expected duration
+     */
+    void CheckEnergyDuration(Watt_u energy, Time expectedDuration);
+
+    Ptr<InterferenceHelper> m_interference; //!< the InterferenceHelper under test
+    Ptr<ErrorRateModel> m_errorRateModel;   //!< the error rate model
+    WifiSpectrumBandInfo m_band;            //!< the band of the signals
+    WifiTxVector m_txVector;                //!< the TXVECTOR of the PPDUs
+};
+
+InterferenceHelperNiChangesTest::InterferenceHelperNiChangesTest()
+    : TestCase("Check the SNIR and PER computed from the NI changes of the InterferenceHelper")
+{
+}
+
+Ptr<Event>
+InterferenceHelperNiChangesTest::AddSignal(Time duration, Watt_u power)
+{
+    WifiMacHeader hdr(WIFI_MAC_DATA);
+    auto ppdu = Create<WifiPpdu>(Create<WifiPsdu>(Create<Packet>(100), hdr),
+                                 m_txVector,
+                                 WifiPhyOperatingChannel());
+    RxPowerWattPerChannelBand rxPower{{m_band, power}};
+    return m_interference->Add(ppdu, duration, rxPower, WIFI_SPECTRUM_5_GHZ);
+}
+
+void
+InterferenceHelperNiChangesTest::CheckSnr(Ptr<Event> event, double expectedSnr)
+{
+    const auto snr = m_interference->CalculateSnr(event, MHz_u{20}, 1, m_band);
+    NS_TEST_EXPECT_MSG_EQ_TOL(snr,
+                              expectedSnr,
+                              expectedSnr * 1e-9,
+                              "Unexpected SNIR at " << Simulator::Now().As(Time::US));
+}
+
+void
+InterferenceHelperNiChangesTest::CheckPayloadSnrPer(
+    Ptr<Event> event,
+    double expectedSnr,
+    const std::vector<std::pair<double, Time>>& chunks)
+{
+    const auto payloadDuration = event->GetDuration() - MicroSeconds(20);
+    const auto snrPer = m_interference->CalculatePayloadSnrPer(event,
+                                                               MHz_u{20},
+                                                               m_band,
+                                                               SU_STA_ID,
+                                                               {Time{0}, payloadDuration});
+    NS_TEST_EXPECT_MSG_EQ_TOL(snrPer.snr,
+                              expectedSnr,
+                              expectedSnr * 1e-9,
+                              "Unexpected SNIR at " << Simulator::Now().As(Time::US));
+    double psr = 1;
+    for (const auto& [snr, duration] : chunks)
+    {
+        // 6 Mb/s
+        const auto nbits = static_cast<uint64_t>(6e6 * duration.GetSeconds());
+        psr *= m_errorRateModel->GetChunkSuccessRate(m_txVector.GetMode(), m_txVector, snr, nbits);
+    }
+    NS_TEST_EXPECT_MSG_GT(1 - psr, 1e-3, "The PER should not be negligible");
+    NS_TEST_EXPECT_MSG_EQ_TOL(snrPer.per,
+                              1 - psr,
+                              (1 - psr) * 1e-9,
+                              "Unexpected PER at " << Simulator::Now().As(Time::US));
+}
+
+void
+InterferenceHelperNiChangesTest::CheckEnergyDuration(Watt_u energy, Time expectedDuration)
+{
+    NS_TEST_EXPECT_MSG_EQ(m_interference->GetEnergyDuration(energy, m_band),
+                          expectedDuration,
+                          "Unexpected energy duration at " << Simulator::Now().As(Time::US));
+}
+
+void
+InterferenceHelperNiChangesTest::DoRun()
+{
+    const double noiseFigure = 2;
+    m_errorRateModel = CreateObject<NistErrorRateModel>();
+    m_interference = CreateObject<InterferenceHelper>();
+    m_interference->SetNoiseFigure(noiseFigure);
+    m_interference->SetErrorRateModel(m_errorRateModel);
+    m_band = {{{0, 0}}, {{MHzToHz(MHz_u{5170}), MHzToHz(MHz_u{5190})}}};
+    m_interference->AddBand(m_band);
+    m_txVector = WifiTxVector(OfdmPhy::GetOfdmRate6Mbps(),
+                              0,
+                              WIFI_PREAMBLE_LONG,
+                              NanoSeconds(800),
+                              1,
+                              1,
+                              0,
+                              MHz_u{20},
+                              false);
+
+    // thermal noise over 20 MHz at 290 K, times the noise figure
+    const Watt_u noise{noiseFigure * 1.3803e-23 * 290 * 20e6};
+    const Watt_u pA{1e-10};
+    const Watt_u pB{2e-10};
+    const Watt_u pC{1e-10};
+    const Watt_u pD{4e-10};
+    const Watt_u pE{2e-10};
+    Ptr<Event> b;
+    Ptr<Event> d;
+
+    Simulator::Schedule(Time{0}, [=, this]() { AddSignal(MicroSeconds(200), pA); });
+    Simulator::Schedule(MicroSeconds(50), [&, this]() {
+        // the start of A is pruned, its power is the first power of the band
+        b = AddSignal(MicroSeconds(100), pB);
+        m_interference->NotifyRxStart(WIFI_SPECTRUM_5_GHZ);
+        CheckSnr(b, pB / (noise + pA));
+    });
+    // C ends at the same time as B
+    Simulator::Schedule(MicroSeconds(100), [=, this]() { AddSignal(MicroSeconds(50), pC); });
+    Simulator::Schedule(MicroSeconds(150), [&, this]() {
+        // the payload starts at 70 us, C adds interference from 100 us
+        CheckPayloadSnrPer(b,
+                           pB / (noise + pA + pC),
+                           {{pB / (noise + pA), MicroSeconds(30)},
+                            {pB / (noise + pA + pC), MicroSeconds(50)}});
+        m_interference->NotifyRxEnd(Simulator::Now(), WIFI_SPECTRUM_5_GHZ);
+        // A is the only signal left
+        CheckEnergyDuration(pA, MicroSeconds(50));
+        CheckEnergyDuration(pA * 1.01, Time{0});
+    });
+    Simulator::Schedule(MicroSeconds(300), [&, this]() {
+        // all the changes before D are pruned, and E starts at the same time as D
+        d = AddSignal(MicroSeconds(100), pD);
+        m_interference->NotifyRxStart(WIFI_SPECTRUM_5_GHZ);
+        AddSignal(MicroSeconds(40), pE);
+        CheckSnr(d, pD / noise);
+        CheckEnergyDuration(pD, MicroSeconds(100));
+        CheckEnergyDuration(pD + pE, MicroSeconds(40));
+    });
+    Simulator::Schedule(MicroSeconds(400), [&, this]() {
+        // the payload starts at 320 us, E ends at 340 us
+        CheckPayloadSnrPer(d,
+                           pD / noise,
+                           {{pD / (noise + pE), MicroSeconds(20)}, {pD / noise, MicroSeconds(60)}});
+        m_interference->NotifyRxEnd(Simulator::Now(), WIFI_SPECTRUM_5_GHZ);
+    });
+
+    Simulator::Run();
+    m_interference->Dispose();
+    Simulator::Destroy();
+}
+
 //-----------------------------------------------------------------------------
 /**
  * Make sure that when multiple broadcast packets are queued on the same
@@ -3961,6 +4173,283 @@ DsssModulationTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_received, 4, "Did not receive four DSSS packets");
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief WifiMacHeader contiguous serialization Test
+ *
+ * Check that SerializeContiguous writes the bytes written by Serialize, for
+ * management, control and data frames.
+ */
+class WifiMacHeaderContiguousTest : public TestCase
+{
+  public:
+    WifiMacHeaderContiguousTest();
+
+  private:
+    void DoRun() override;
+};
+
+WifiMacHeaderContiguousTest::WifiMacHeaderContiguousTest()
+    : TestCase("Check the contiguous serialization of the MAC header")
+{
+}
+
+void
+WifiMacHeaderContiguousTest::DoRun()
+{
+    for (auto type : {WIFI_MAC_MGT_BEACON,
+                      WIFI_MAC_MGT_ACTION,
+                      WIFI_MAC_CTL_TRIGGER,
+                      WIFI_MAC_CTL_PSPOLL,
+                      WIFI_MAC_CTL_RTS,
+                      WIFI_MAC_CTL_CTS,
+                      WIFI_MAC_CTL_ACK,
+                      WIFI_MAC_CTL_BACKREQ,
+                      WIFI_MAC_CTL_BACKRESP,
+                      WIFI_MAC_CTL_END,
+                      WIFI_MAC_CTL_END_ACK,
+                      WIFI_MAC_DATA,
+                      WIFI_MAC_DATA_NULL,
+                      WIFI_MAC_QOSDATA,
+                      WIFI_MAC_QOSDATA_NULL})
+    {
+        for (bool fourAddresses : {false, true})
+        {
+            WifiMacHeader header(type);
+            header.SetAddr1(Mac48Address("00:00:00:00:00:01"));
+            header.SetAddr2(Mac48Address("00:00:00:00:00:02"));
+            header.SetAddr3(Mac48Address("00:00:00:00:00:03"));
+            header.SetAddr4(Mac48Address("00:00:00:00:00:04"));
+            header.SetRawDuration(0x1234);
+            header.SetSequenceNumber(0x567);
+            header.SetFragmentNumber(3);
+            header.SetRetry();
+            header.SetMoreFragments();
+            if (header.IsData())
+            {
+                if (fourAddresses)
+                {
+                    header.SetDsFrom();
+                    header.SetDsTo();
+                }
+                if (header.IsQosData())
+                {
+                    header.SetQosTid(5);
+                    header.SetQosAckPolicy(WifiMacHeader::BLOCK_ACK);
+                    header.SetQosAmsdu();
+                    header.SetQosTxopLimit(0x42);
+                }
+            }
+            uint32_t size = header.GetSerializedSize();
+            Buffer buffer;
+            buffer.AddAtStart(size);
+            header.Serialize(buffer.Begin());
+
+            std::vector<uint8_t> contiguous(size);
+            NS_TEST_ASSERT_MSG_EQ(header.SerializeContiguous(contiguous.data(), size),
+                                  true,
+                                  "Header not serialized");
+            NS_TEST_EXPECT_MSG_EQ(std::memcmp(buffer.PeekData(), contiguous.data(), size),
+                                  0,
+                                  "Contiguous serialization differs for "
+                                      << header.GetTypeString() << ", four addresses "
+                                      << fourAddresses);
+        }
+    }
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief YansWifiChannel MaxRange Test
+ *
+ * Check that a PPDU sent with a MaxRange reaches the PHYs reached without it
+ * that are within range, in the same order, after PHYs are added, after a
+ * mobility model is installed on a PHY added without one and after PHYs move.
+ */
+class YansWifiChannelMaxRangeTest : public TestCase
+{
+  public:
+    YansWifiChannelMaxRangeTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Add a PHY to the channel.
+     *
+     * @param position the position of the PHY, if it has a mobility model
+     */
+    void AddPhy(std::optional<Vector> position);
+
+    /**
+     * Send a PPDU from the first PHY with and without a MaxRange and check the
+     * receivers.
+     *
+     * @param context the context of the check
+     */
+    void CheckReceivers(const std::string& context);
+
+    /**
+     * Send a PPDU from the first PHY.
+     *
+     * @param maxRange the value of the MaxRange attribute
+     * @return the indices of the PHYs receiving the PPDU, in arrival order
+     */
+    std::vector<std::size_t> Send(double maxRange);
+
+    /**
+     * Notify the arrival of a signal at a PHY.
+     *
+     * @param index the index of the PHY
+     * @param ppdu the PPDU
+     * @param rxPowerDbm the received power
+     * @param duration the duration of the signal
+     */
+    void NotifySignalArrival(std::size_t index,
+                             Ptr<const WifiPpdu> ppdu,
+                             double rxPowerDbm,
+                             Time duration);
+
+    static constexpr double MAX_RANGE = 100; //!< the range of the transmissions, in meters
+
+    Ptr<YansWifiChannel> m_channel;       //!< the channel under test
+    std::vector<Ptr<YansWifiPhy>> m_phys; //!< the PHYs, the first one transmits
+    std::vector<std::size_t> m_arrivals;  //!< the PHYs reached by the last PPDU
+};
+
+YansWifiChannelMaxRangeTest::YansWifiChannelMaxRangeTest()
+    : TestCase("Check the PHYs reached through a YansWifiChannel within MaxRange")
+{
+}
+
+void
+YansWifiChannelMaxRangeTest::NotifySignalArrival(std::size_t index,
+                                                 Ptr<const WifiPpdu> ppdu,
+                                                 double rxPowerDbm,
+                                                 Time duration)
+{
+    m_arrivals.push_back(index);
+}
+
+void
+YansWifiChannelMaxRangeTest::AddPhy(std::optional<Vector> position)
+{
+    auto phy = CreateObject<YansWifiPhy>();
+    phy->SetInterferenceHelper(CreateObject<InterferenceHelper>());
+    phy->SetErrorRateModel(CreateObject<YansErrorRateModel>());
+    if (position)
+    {
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(*position);
+        phy->SetMobility(mobility);
+    }
+    phy->SetChannel(m_channel);
+    phy->ConfigureStandard(WIFI_STANDARD_80211a);
+    phy->TraceConnectWithoutContext(
+        "SignalArrival",
+        MakeCallback(&YansWifiChannelMaxRangeTest::NotifySignalArrival, this, m_phys.size()));
+    m_phys.push_back(phy);
+}
+
+std::vector<std::size_t>
+YansWifiChannelMaxRangeTest::Send(double maxRange)
+{
+    m_channel->SetAttribute("MaxRange", DoubleValue(maxRange));
+    WifiTxVector txVector{OfdmPhy::GetOfdmRate6Mbps(),
+                          0,
+                          WIFI_PREAMBLE_LONG,
+                          NanoSeconds(800),
+                          1,
+                          1,
+                          0,
+                          MHz_u{20},
+                          false};
+    WifiMacHeader hdr(WIFI_MAC_DATA);
+    auto psdu = Create<WifiPsdu>(Create<Packet>(100), hdr);
+    auto ppdu = Create<OfdmPpdu>(psdu, txVector, m_phys.front()->GetOperatingChannel(), 0);
+    m_arrivals.clear();
+    m_channel->Send(m_phys.front(), ppdu, dBm_u{20});
+    Simulator::Run();
+    return m_arrivals;
+}
+
+void
+YansWifiChannelMaxRangeTest::CheckReceivers(const std::string& context)
+{
+    const auto txPosition = m_phys.front()->GetMobility()->GetPosition();
+    std::vector<std::size_t> expected;
+    for (const auto index : Send(0))
+    {
+        const auto position = m_phys[index]->GetMobility()->GetPosition();
+        if (CalculateDistance(position, txPosition) <= MAX_RANGE)
+        {
+            expected.push_back(index);
+        }
+    }
+    const auto arrivals = Send(MAX_RANGE);
+    NS_TEST_ASSERT_MSG_EQ(arrivals.size(),
+                          expected.size(),
+                          "Unexpected number of receivers " << context);
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(arrivals[i], expected[i], "Unexpected receiver " << context);
+    }
+}
+
+void
+YansWifiChannelMaxRangeTest::DoRun()
+{
+    m_channel = CreateObject<YansWifiChannel>();
+    // the PPDUs arrive at the same time, below the RX sensitivity
+    m_channel->SetPropagationDelayModel(
+        CreateObjectWithAttributes<ConstantSpeedPropagationDelayModel>("Speed",
+                                                                       DoubleValue(1e15)));
+    m_channel->SetPropagationLossModel(
+        CreateObjectWithAttributes<FixedRssLossModel>("Rss", DoubleValue(-150)));
+    m_phys.clear();
+
+    AddPhy(Vector(0, 0, 0));
+    AddPhy(Vector(50, 0, 0));
+    AddPhy(Vector(150, 0, 0));
+    AddPhy(Vector(-99, 0, 0));
+    AddPhy(Vector(0, 300, 0));
+    AddPhy(Vector(30, -40, 10));
+    CheckReceivers("with the initial PHYs");
+    NS_TEST_EXPECT_MSG_EQ(m_arrivals.size(), 3, "Unexpected PHYs within range");
+    NS_TEST_EXPECT_MSG_EQ(m_arrivals.front(), 1, "PHYs not reached in list order");
+
+    AddPhy(Vector(10, 10, 0));
+    AddPhy(Vector(200, 200, 0));
+    CheckReceivers("after PHYs are added");
+    NS_TEST_EXPECT_MSG_EQ(m_arrivals.back(), 6, "Added PHY not reached");
+
+    // the mobility model is installed after the PHY is added to the channel
+    AddPhy(std::nullopt);
+    auto mobility = CreateObject<ConstantPositionMobilityModel>();
+    mobility->SetPosition(Vector(500, 0, 0));
+    m_phys.back()->SetMobility(mobility);
+    CheckReceivers("after a mobility model is installed");
+    NS_TEST_EXPECT_MSG_EQ(m_arrivals.size(), 4, "PHY out of range reached");
+
+    mobility->SetPosition(Vector(20, 0, 0));
+    m_phys[1]->GetMobility()->SetPosition(Vector(120, 0, 0));
+    CheckReceivers("after PHYs move");
+    NS_TEST_EXPECT_MSG_EQ(m_arrivals.back(), 8, "PHY moved into range not reached");
+    NS_TEST_EXPECT_MSG_EQ(m_arrivals.front(), 3, "PHY moved out of range reached");
+
+    for (auto& phy : m_phys)
+    {
+        phy->Dispose();
+    }
+    m_phys.clear();
+    m_channel = nullptr;
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -3979,6 +4468,7 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new WifiTest, TestCase::Duration::QUICK);
     AddTestCase(new QosUtilsIsOldPacketTest, TestCase::Duration::QUICK);
     AddTestCase(new InterferenceHelperSequenceTest, TestCase::Duration::QUICK); // Bug 991
+    AddTestCase(new InterferenceHelperNiChangesTest, TestCase::Duration::QUICK);
     AddTestCase(new DcfImmediateAccessBroadcastTestCase, TestCase::Duration::QUICK);
     AddTestCase(new Bug730TestCase, TestCase::Duration::QUICK); // Bug 730
     AddTestCase(new QosFragmentationTestCase, TestCase::Duration::QUICK);
@@ -3994,6 +4484,8 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new IdealRateManagerMimoTest, TestCase::Duration::QUICK);
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::Duration::QUICK);
     AddTestCase(new WifiMgtHeaderTest, TestCase::Duration::QUICK);
+    AddTestCase(new WifiMacHeaderContiguousTest, TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelMaxRangeTest, TestCase::Duration::QUICK);
     AddTestCase(new DsssModulationTest, TestCase::Duration::QUICK);
 }
 
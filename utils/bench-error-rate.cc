@@ -0,0 +1,183 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the computation of the chunk success
+// rates by the NIST and YANS error rate models, in closed form and looked up
+// in their tables.  It reports the wall clock time spent per chunk, one by one
+// and in batches, and the largest difference between the success rates looked
+// up and those computed in closed form.
+// Sample usage:  ./ns3 run 'bench-error-rate --chunks=1000000 --precision=0.01'
+
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/error-rate-model.h"
+#include "ns3/he-phy.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-tx-vector.h"
+#include "ns3/wifi-utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <vector>
+
+using namespace ns3;
+
+/// The chunks of the benchmark, all of the same mode
+struct Chunks
+{
+    WifiMode mode;              //!< the mode of the chunks
+    WifiTxVector txVector;      //!< the TXVECTOR of the PPDU
+    std::vector<double> snrs;   //!< the SNR of each chunk
+    std::vector<uint64_t> bits; //!< the number of bits of each chunk
+};
+
+/**
+ * Compute the success rates of the chunks one by one.
+ *
+ * @param model the error rate model
+ * @param chunks the chunks
+ * @param [out] rates the success rate of each chunk
+ * @return the wall clock time spent, in milliseconds
+ */
+int64_t
+RunSingle(Ptr<ErrorRateModel> model, const Chunks& chunks, std::vector<double>& rates)
+{
+    rates.resize(chunks.snrs.size());
+    SystemWallClockMs clock;
+    clock.Start();
+    for (std::size_t i = 0; i < chunks.snrs.size(); ++i)
+    {
+        rates[i] = model->GetChunkSuccessRate(chunks.mode,
+                                              chunks.txVector,
+                                              chunks.snrs[i],
+                                              chunks.bits[i]);
+    }
+    return clock.End();
+}
+
+/**
+ * Compute the success rates of the chunks in batches.
+ *
+ * @param model the error rate model
+ * @param chunks the chunks
+ * @param batch the number of chunks per batch
+ * @param [out] rates the success rate of each chunk
+ * @return the wall clock time spent, in milliseconds
+ */
+int64_t
+RunBatch(Ptr<ErrorRateModel> model,
+         const Chunks& chunks,
+         uint32_t batch,
+         std::vector<double>& rates)
+{
+    rates.clear();
+    std::vector<double> snrs;
+    std::vector<uint64_t> bits;
+    std::vector<double> batchRates;
+    SystemWallClockMs clock;
+    clock.Start();
+    for (std::size_t i = 0; i < chunks.snrs.size(); i += batch)
+    {
+        const auto end = std::min(chunks.snrs.size(), i + batch);
+        snrs.assign(chunks.snrs.cbegin() + i, chunks.snrs.cbegin() + end);
+        bits.assign(chunks.bits.cbegin() + i, chunks.bits.cbegin() + end);
+        model->GetChunkSuccessRates(chunks.mode, chunks.txVector, snrs, bits, batchRates);
+        rates.insert(rates.end(), batchRates.cbegin(), batchRates.cend());
+    }
+    return clock.End();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nChunks = 0;
+    uint32_t batch = 8;
+    dB_u precision{0.01};
+    dB_u minSnr{0};
+    dB_u maxSnr{40};
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the chunk success rates of the NIST and YANS error rate models");
+    cmd.AddValue("chunks", "number of chunks per mode", nChunks);
+    cmd.AddValue("batch", "number of chunks per batch", batch);
+    cmd.AddValue("precision", "width in dB of the buckets of the lookup tables", precision);
+    cmd.AddValue("min-snr", "lowest SNR of the chunks in dB", minSnr);
+    cmd.AddValue("max-snr", "highest SNR of the chunks in dB", maxSnr);
+    cmd.Parse(argc, argv);
+
+    if (nChunks == 0)
+    {
+        std::cerr << "Error-- number of chunks must be specified "
+                  << "by command-line argument --chunks=(number of chunks)" << std::endl;
+        exit(1);
+    }
+    if (batch == 0 || precision <= 0 || minSnr > maxSnr)
+    {
+        std::cerr << "Error-- the batches must not be empty, the precision must be positive "
+                  << "and the lowest SNR must be at most the highest SNR" << std::endl;
+        exit(1);
+    }
+
+    auto snr = CreateObject<UniformRandomVariable>();
+    auto bits = CreateObject<UniformRandomVariable>();
+    std::vector<Chunks> allChunks;
+    for (const auto& mode :
+         {WifiMode("OfdmRate6Mbps"), WifiMode("OfdmRate54Mbps"), HePhy::GetHeMcs11()})
+    {
+        Chunks chunks{mode,
+                      WifiTxVector(mode,
+                                   0,
+                                   GetPreambleForTransmission(mode.GetModulationClass(), false),
+                                   NanoSeconds(800),
+                                   1,
+                                   1,
+                                   0,
+                                   MHz_u{20},
+                                   false),
+                      {},
+                      {}};
+        for (uint32_t i = 0; i < nChunks; ++i)
+        {
+            chunks.snrs.push_back(DbToRatio(dB_u{snr->GetValue(minSnr, maxSnr)}));
+            chunks.bits.push_back(bits->GetInteger(8, 12000));
+        }
+        allChunks.push_back(chunks);
+    }
+
+    for (const auto typeId : {"ns3::NistErrorRateModel", "ns3::YansErrorRateModel"})
+    {
+        ObjectFactory factory(typeId);
+        auto exact = factory.Create<ErrorRateModel>();
+        factory.Set("LookupPrecision", DoubleValue(precision));
+        auto cached = factory.Create<ErrorRateModel>();
+
+        for (const auto& chunks : allChunks)
+        {
+            std::vector<double> expected;
+            std::vector<double> rates;
+            const auto exactTime = RunSingle(exact, chunks, expected);
+            // the first lookup builds the table, which is then shared
+            RunSingle(cached, chunks, rates);
+            const auto cachedTime = RunSingle(cached, chunks, rates);
+            double maxError = 0;
+            for (std::size_t i = 0; i < rates.size(); ++i)
+            {
+                maxError = std::max(maxError, std::abs(rates[i] - expected[i]));
+            }
+            const auto batchTime = RunBatch(cached, chunks, batch, rates);
+
+            std::cout << typeId << " " << chunks.mode << " chunks=" << nChunks
+                      << " exact=" << (1e6 * exactTime) / nChunks << "ns"
+                      << " lookup=" << (1e6 * cachedTime) / nChunks << "ns"
+                      << " batch=" << (1e6 * batchTime) / nChunks << "ns"
+                      << " max-error=" << maxError << std::endl;
+        }
+    }
+
+    return 0;
+}
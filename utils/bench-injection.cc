@@ -0,0 +1,195 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup system-tests-perf
+ *
+ * Measure the latency of the events scheduled from other threads with
+ * Simulator::ScheduleWithContext(), until they run in the main loop.
+ */
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/** The clock timing the injected events. */
+using Clock = std::chrono::steady_clock;
+
+/** The injection benchmark. */
+class BenchInjection
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] threads The number of injecting threads.
+     * @param [in] events The number of events injected by each thread.
+     * @param [in] poll The simulation time between the polling events.
+     */
+    BenchInjection(uint32_t threads, uint32_t events, Time poll);
+
+    /** Run the simulation and print the results. */
+    void Run();
+
+  private:
+    /**
+     * Inject the events, from another thread.
+     *
+     * @param [in] context The context of the events.
+     */
+    void Inject(uint32_t context);
+    /**
+     * Receive an injected event in the main loop.
+     *
+     * @param [in] sent The time the event was scheduled.
+     */
+    void Receive(Clock::time_point sent);
+    /** Keep the main loop busy until all the events are received. */
+    void Poll();
+
+    uint32_t m_threads;                //!< Number of injecting threads.
+    uint32_t m_events;                 //!< Number of events per thread.
+    Time m_poll;                       //!< Simulation time between polls.
+    std::atomic<bool> m_start{false};  //!< Flag starting the injection.
+    std::vector<double> m_latencies;   //!< The latency of each event, in ns.
+    Clock::time_point m_first;         //!< The time of the first injection.
+    Clock::time_point m_last;          //!< The time of the last reception.
+};
+
+BenchInjection::BenchInjection(uint32_t threads, uint32_t events, Time poll)
+    : m_threads(threads),
+      m_events(events),
+      m_poll(poll)
+{
+    m_latencies.reserve(uint64_t(threads) * events);
+}
+
+void
+BenchInjection::Inject(uint32_t context)
+{
+    while (!m_start.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+    for (uint32_t i = 0; i < m_events; ++i)
+    {
+        Simulator::ScheduleWithContext(context,
+                                       Time(0),
+                                       &BenchInjection::Receive,
+                                       this,
+                                       Clock::now());
+    }
+}
+
+void
+BenchInjection::Receive(Clock::time_point sent)
+{
+    m_last = Clock::now();
+    m_latencies.push_back(std::chrono::duration<double, std::nano>(m_last - sent).count());
+}
+
+void
+BenchInjection::Poll()
+{
+    if (!m_start.load(std::memory_order_relaxed))
+    {
+        // Start the injection once the main loop runs
+        m_first = Clock::now();
+        m_start.store(true, std::memory_order_release);
+    }
+    if (m_latencies.size() < uint64_t(m_threads) * m_events)
+    {
+        Simulator::Schedule(m_poll, &BenchInjection::Poll, this);
+    }
+    else
+    {
+        Simulator::Stop();
+    }
+}
+
+void
+BenchInjection::Run()
+{
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < m_threads; ++i)
+    {
+        threads.emplace_back(&BenchInjection::Inject, this, i);
+    }
+    Simulator::Schedule(Time(0), &BenchInjection::Poll, this);
+    Simulator::Run();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    Simulator::Destroy();
+
+    std::sort(m_latencies.begin(), m_latencies.end());
+    auto percentile = [this](double p) {
+        return m_latencies[std::min<std::size_t>(p * m_latencies.size(), m_latencies.size() - 1)];
+    };
+    double total = 0;
+    for (auto latency : m_latencies)
+    {
+        total += latency;
+    }
+    double elapsed = std::chrono::duration<double>(m_last - m_first).count();
+
+    const int w = 14;
+    LOG(std::setw(8) << "Threads" << std::setw(w) << "Events/s" << std::setw(w) << "Mean (us)"
+                     << std::setw(w) << "p50 (us)" << std::setw(w) << "p99 (us)" << std::setw(w)
+                     << "Max (us)");
+    LOG(std::setw(8) << m_threads << std::setw(w) << std::fixed << std::setprecision(0)
+                     << m_latencies.size() / elapsed << std::setprecision(3) << std::setw(w)
+                     << total / m_latencies.size() / 1000 << std::setw(w)
+                     << percentile(0.5) / 1000 << std::setw(w) << percentile(0.99) / 1000
+                     << std::setw(w) << m_latencies.back() / 1000);
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t threads = 4;
+    uint32_t events = 100000;
+    bool realtime = false;
+    Time poll = NanoSeconds(100);
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Measure the latency of the events scheduled from other threads.\n"
+              "\n"
+              "Each thread schedules its events with Simulator::ScheduleWithContext()\n"
+              "as fast as it can, while the main loop runs a polling event.  The latency\n"
+              "is the wall clock time between the scheduling of an event and its\n"
+              "execution.  With --realtime the main loop sleeps until it is signalled,\n"
+              "and the polling interval should be increased accordingly.");
+    cmd.AddValue("threads", "number of injecting threads", threads);
+    cmd.AddValue("events", "number of events injected by each thread", events);
+    cmd.AddValue("realtime", "use the RealtimeSimulatorImpl", realtime);
+    cmd.AddValue("poll", "simulation time between the polling events", poll);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(threads == 0 || events == 0, "No event to inject");
+
+    if (realtime)
+    {
+        GlobalValue::Bind("SimulatorImplementationType",
+                          StringValue("ns3::RealtimeSimulatorImpl"));
+    }
+
+    BenchInjection bench(threads, events, poll);
+    bench.Run();
+
+    return 0;
+}
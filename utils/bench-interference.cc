@@ -0,0 +1,283 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the tracking of the noise and
+// interference by the InterferenceHelper of a receiver in a dense deployment,
+// where the PPDUs of many overlapping BSSs are received on a wide channel.
+// It reports the wall clock time spent per frame received from the BSS of
+// the receiver, including the tracking of the interference from the other BSSs.
+// Sample usage:  ./ns3 run 'bench-interference --bss=32 --frames=10000'
+
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/he-phy.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/table-based-error-rate-model.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/wifi-phy-operating-channel.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-ppdu.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+#include "ns3/wifi-utils.h"
+
+#include <iostream>
+#include <set>
+#include <stdlib.h> // for exit ()
+#include <vector>
+
+using namespace ns3;
+
+/// Dense BSS scenario, seen from a receiver of the first BSS
+class DenseBssBench
+{
+  public:
+    /**
+     * Constructor
+     * @param nBss the number of BSSs
+     * @param width the width of the channel
+     * @param bandWidth the width of the bands tracked, from 20 MHz to the width of the channel
+     * @param gap the mean time between the end of a PPDU of a BSS and the start of the next one
+     * @param size the size of the PSDUs
+     */
+    DenseBssBench(uint32_t nBss, MHz_u width, MHz_u bandWidth, Time gap, uint32_t size);
+
+    /**
+     * Run the scenario.
+     * @param frames the number of frames to be received from the BSS of the receiver
+     */
+    void Run(uint32_t frames);
+
+    /// @return the number of frames received from the BSS of the receiver
+    uint32_t GetFrames() const;
+    /// @return the number of PPDUs added to the InterferenceHelper
+    uint32_t GetPpdus() const;
+    /// @return the number of bands tracked
+    std::size_t GetBands() const;
+
+  private:
+    /**
+     * Start the transmission of a PPDU by a BSS.
+     * @param bss the index of the BSS
+     */
+    void Transmit(uint32_t bss);
+    /**
+     * Compute the PER of the PHY header of a frame received.
+     * @param event the event of the frame
+     */
+    void EndPhyHeader(Ptr<Event> event);
+    /**
+     * Compute the PER of the payload of a frame received.
+     * @param event the event of the frame
+     */
+    void EndReceive(Ptr<Event> event);
+
+    Ptr<InterferenceHelper> m_interference;    //!< the interference helper of the receiver
+    std::vector<WifiSpectrumBandInfo> m_bands; //!< the bands tracked
+    std::vector<Watt_u> m_rxPowers;            //!< the power received from each BSS
+    Ptr<const WifiPpdu> m_ppdu;                //!< the PPDU sent by all the BSSs
+    Time m_duration;                           //!< the duration of the PPDU
+    Time m_header;                             //!< the duration of its preamble and PHY header
+    MHz_u m_width;                             //!< the width of the channel
+    Ptr<ExponentialRandomVariable> m_gap;      //!< the time between two PPDUs of a BSS
+    bool m_rxing{false};                       //!< whether a frame is being received
+    uint32_t m_frames{0};                      //!< the number of frames received
+    uint32_t m_maxFrames{0};                   //!< the number of frames to be received
+    uint32_t m_ppdus{0};                       //!< the number of PPDUs added
+};
+
+DenseBssBench::DenseBssBench(uint32_t nBss, MHz_u width, MHz_u bandWidth, Time gap, uint32_t size)
+    : m_width(width)
+{
+    m_interference = CreateObject<InterferenceHelper>();
+    m_interference->SetErrorRateModel(CreateObject<TableBasedErrorRateModel>());
+    m_interference->SetNoiseFigure(DbToRatio(dB_u{7}));
+
+    // the channels of 5 GHz which start at 5170 MHz, the bands from the narrowest to the widest
+    const MHz_u start{5170};
+    uint32_t index = 0;
+    for (auto w = bandWidth; w <= width; w *= 2)
+    {
+        for (auto f = start; f + w <= start + width; f += w)
+        {
+            const auto nTones = static_cast<uint32_t>(w / 20 * 64);
+            m_bands.push_back({{{index, index + nTones - 1}}, {{MHzToHz(f), MHzToHz(f + w)}}});
+            index += nTones;
+        }
+    }
+    m_interference->UpdateBands(m_bands, WHOLE_WIFI_SPECTRUM);
+
+    // the receiver is close to the AP of its BSS, the other BSSs are further away
+    auto power = CreateObject<UniformRandomVariable>();
+    m_rxPowers.push_back(DbmToW(dBm_u{-50}));
+    for (uint32_t bss = 1; bss < nBss; bss++)
+    {
+        m_rxPowers.push_back(DbmToW(dBm_u{power->GetValue(-95, -75)}));
+    }
+
+    WifiTxVector txVector(HePhy::GetHeMcs7(),
+                          0,
+                          WIFI_PREAMBLE_HE_SU,
+                          NanoSeconds(800),
+                          1,
+                          1,
+                          0,
+                          width,
+                          true);
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+    auto psdu = Create<WifiPsdu>(Create<Packet>(size), hdr);
+    m_ppdu = Create<WifiPpdu>(psdu, txVector, WifiPhyOperatingChannel());
+    m_duration = WifiPhy::CalculateTxDuration(psdu, txVector, WIFI_PHY_BAND_5GHZ);
+    m_header = WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector);
+
+    m_gap = CreateObject<ExponentialRandomVariable>();
+    m_gap->SetAttribute("Mean", DoubleValue(gap.GetSeconds()));
+}
+
+void
+DenseBssBench::Run(uint32_t frames)
+{
+    m_maxFrames = frames;
+    for (uint32_t bss = 0; bss < m_rxPowers.size(); bss++)
+    {
+        Simulator::Schedule(Seconds(m_gap->GetValue()), &DenseBssBench::Transmit, this, bss);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+void
+DenseBssBench::Transmit(uint32_t bss)
+{
+    RxPowerWattPerChannelBand rxPower;
+    for (const auto& band : m_bands)
+    {
+        rxPower.insert({band, m_rxPowers[bss]});
+    }
+    const auto receive = (bss == 0 && !m_rxing);
+    if (receive)
+    {
+        m_rxing = true;
+        m_interference->NotifyRxStart(WHOLE_WIFI_SPECTRUM);
+    }
+    auto event = m_interference->Add(m_ppdu, m_duration, rxPower, WHOLE_WIFI_SPECTRUM);
+    m_ppdus++;
+    if (receive)
+    {
+        Simulator::Schedule(m_header, &DenseBssBench::EndPhyHeader, this, event);
+        Simulator::Schedule(m_duration, &DenseBssBench::EndReceive, this, event);
+    }
+    Simulator::Schedule(m_duration + Seconds(m_gap->GetValue()),
+                        &DenseBssBench::Transmit,
+                        this,
+                        bss);
+}
+
+void
+DenseBssBench::EndPhyHeader(Ptr<Event> event)
+{
+    // the PHY headers are received on the primary 20 MHz channel, the first band
+    m_interference->CalculatePhyHeaderSnrPer(event,
+                                             MHz_u{20},
+                                             m_bands.front(),
+                                             WIFI_PPDU_FIELD_NON_HT_HEADER);
+    m_interference->CalculatePhyHeaderSnrPer(event,
+                                             MHz_u{20},
+                                             m_bands.front(),
+                                             WIFI_PPDU_FIELD_SIG_A);
+}
+
+void
+DenseBssBench::EndReceive(Ptr<Event> event)
+{
+    m_interference->CalculatePayloadSnrPer(event,
+                                           m_width,
+                                           m_bands.back(),
+                                           SU_STA_ID,
+                                           {Time{0}, m_duration - m_header});
+    m_interference->NotifyRxEnd(Simulator::Now(), WHOLE_WIFI_SPECTRUM);
+    m_rxing = false;
+    if (++m_frames == m_maxFrames)
+    {
+        Simulator::Stop();
+    }
+}
+
+uint32_t
+DenseBssBench::GetFrames() const
+{
+    return m_frames;
+}
+
+uint32_t
+DenseBssBench::GetPpdus() const
+{
+    return m_ppdus;
+}
+
+std::size_t
+DenseBssBench::GetBands() const
+{
+    return m_bands.size();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nBss = 16;
+    uint32_t frames = 0;
+    MHz_u width{160};
+    MHz_u bandWidth{20};
+    Time gap = MicroSeconds(2000);
+    uint32_t size = 1500;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the interference tracking of a receiver in a dense BSS deployment");
+    cmd.AddValue("bss", "number of overlapping BSSs", nBss);
+    cmd.AddValue("frames", "number of frames received from the BSS of the receiver", frames);
+    cmd.AddValue("width", "width of the channel in MHz", width);
+    cmd.AddValue("band-width", "width of the narrowest band tracked in MHz", bandWidth);
+    cmd.AddValue("gap", "mean time between the PPDUs of a BSS", gap);
+    cmd.AddValue("size", "size of the PSDUs in bytes", size);
+    cmd.Parse(argc, argv);
+
+    if (frames == 0)
+    {
+        std::cerr << "Error-- number of frames must be specified "
+                  << "by command-line argument --frames=(number of frames)" << std::endl;
+        exit(1);
+    }
+    if (nBss == 0)
+    {
+        std::cerr << "Error-- there must be at least one BSS" << std::endl;
+        exit(1);
+    }
+    const std::set<MHz_u> widths{20, 40, 80, 160};
+    if (!widths.contains(width) || !widths.contains(bandWidth) || bandWidth > width)
+    {
+        std::cerr << "Error-- the widths must be 20, 40, 80 or 160 MHz, "
+                  << "the band width being at most the channel width" << std::endl;
+        exit(1);
+    }
+
+    DenseBssBench bench(nBss, width, bandWidth, gap, size);
+    SystemWallClockMs clock;
+    clock.Start();
+    bench.Run(frames);
+    const auto elapsed = clock.End();
+
+    std::cout << "bss=" << nBss << " width=" << width << "MHz bands=" << bench.GetBands()
+              << " frames=" << bench.GetFrames() << " ppdus=" << bench.GetPpdus()
+              << " time=" << elapsed << "ms per-frame="
+              << (1000.0 * elapsed) / bench.GetFrames() << "us" << std::endl;
+
+    return 0;
+}
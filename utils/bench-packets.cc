@@ -11,9 +11,11 @@
 // Sample usage:  ./ns3 run 'bench-packets --n=10000'
 
 #include "ns3/command-line.h"
+#include "ns3/ethernet-header.h"
 #include "ns3/packet-metadata.h"
 #include "ns3/packet.h"
 #include "ns3/system-wall-clock-ms.h"
+#include "ns3/traced-callback.h"
 
 #include <algorithm>
 #include <iostream>
@@ -226,6 +228,40 @@ benchD(uint32_t n)
     }
 }
 
+static void
+benchPacketTags(uint32_t n)
+{
+    BenchHeader<25> ipv4;
+    // The sizes of FlowIdTag, TimestampTag, EpsBearerTag, AmpduTag and SnrTag
+    BenchTag<4> flowId;
+    BenchTag<8> timestamp;
+    BenchTag<3> bearer;
+    BenchTag<9> ampdu;
+    BenchTag<7> snr;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(1000);
+        p->AddPacketTag(flowId);
+        p->AddPacketTag(timestamp);
+        p->AddHeader(ipv4);
+        p->AddPacketTag(bearer);
+        p->ReplacePacketTag(bearer);
+        p->AddPacketTag(ampdu);
+        // Two receivers
+        for (uint32_t j = 0; j < 2; j++)
+        {
+            Ptr<Packet> copy = p->Copy();
+            copy->RemovePacketTag(ampdu);
+            copy->AddPacketTag(snr);
+            copy->PeekPacketTag(snr);
+            copy->PeekPacketTag(bearer);
+            copy->PeekPacketTag(timestamp);
+            copy->PeekPacketTag(flowId);
+        }
+    }
+}
+
 static void
 benchA(uint32_t n)
 {
@@ -261,6 +297,21 @@ benchB(uint32_t n)
     }
 }
 
+static void
+benchEthernet(uint32_t n)
+{
+    EthernetHeader ethernet;
+    ethernet.SetSource(Mac48Address("00:00:00:00:00:01"));
+    ethernet.SetDestination(Mac48Address("00:00:00:00:00:02"));
+    ethernet.SetLengthType(0x0800);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(1500);
+        p->AddHeader(ethernet);
+    }
+}
+
 static void
 C2(Ptr<Packet> p)
 {
@@ -321,6 +372,53 @@ benchFragment(uint32_t n)
     }
 }
 
+static void
+benchAggregation(uint32_t n)
+{
+    BenchHeader<14> subframe;
+    static uint8_t payload[1500] = {};
+    static uint8_t data[1500];
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> aggregate = Create<Packet>();
+        for (uint32_t j = 0; j < 8; j++)
+        {
+            Ptr<Packet> msdu = Create<Packet>(payload, sizeof(payload));
+            msdu->AddHeader(subframe);
+            aggregate->AddAtEnd(msdu);
+        }
+
+        uint32_t size = subframe.GetSerializedSize() + sizeof(payload);
+        for (uint32_t j = 0; j < 8; j++)
+        {
+            Ptr<Packet> msdu = aggregate->CreateFragment(j * size, size);
+            msdu->RemoveAtStart(subframe.GetSerializedSize());
+            msdu->CopyData(data, sizeof(data));
+        }
+    }
+}
+
+static void
+benchPadding(uint32_t n)
+{
+    BenchHeader<25> ipv4;
+    BenchHeader<8> udp;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(100);
+        p->AddHeader(udp);
+        p->AddPaddingAtEnd(1367);
+        p->AddHeader(ipv4);
+
+        Ptr<Packet> copy = p->Copy();
+        copy->AddPaddingAtEnd(100);
+        copy->RemoveHeader(ipv4);
+        copy->RemoveHeader(udp);
+    }
+}
+
 static void
 benchByteTags(uint32_t n)
 {
@@ -339,6 +437,71 @@ benchByteTags(uint32_t n)
     }
 }
 
+/// Trace sink counting the bytes of the traced packets
+class PacketCounter
+{
+  public:
+    /**
+     * Count a packet.
+     * @param p the packet
+     */
+    void Count(Ptr<const Packet> p)
+    {
+        m_bytes += p->GetSize();
+    }
+
+    uint64_t m_bytes{0}; //!< the number of bytes counted
+};
+
+/**
+ * Add and remove headers, firing a traced callback at each step.
+ * @param n the number of packets
+ * @param inlineSinks connect InlineCallbacks instead of Callbacks
+ */
+static void
+benchTrace(uint32_t n, bool inlineSinks)
+{
+    BenchHeader<25> ipv4;
+    BenchHeader<8> udp;
+    PacketCounter counters[4];
+    TracedCallback<Ptr<const Packet>> trace;
+    for (auto& counter : counters)
+    {
+        if (inlineSinks)
+        {
+            trace.ConnectWithoutContext(MakeInlineCallback(&PacketCounter::Count, &counter));
+        }
+        else
+        {
+            trace.ConnectWithoutContext(MakeCallback(&PacketCounter::Count, &counter));
+        }
+    }
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(2000);
+        p->AddHeader(udp);
+        trace(p);
+        p->AddHeader(ipv4);
+        trace(p);
+        p->RemoveHeader(ipv4);
+        trace(p);
+        p->RemoveHeader(udp);
+    }
+}
+
+static void
+benchTraceCallback(uint32_t n)
+{
+    benchTrace(n, false);
+}
+
+static void
+benchTraceInline(uint32_t n)
+{
+    benchTrace(n, true);
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -353,16 +516,28 @@ static void
 runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char* name)
 {
     uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    Buffer::ResetAllocationStatistics();
+    Buffer::ResetPoolStatistics();
+    PacketMetadata::ResetPoolStatistics();
     for (uint32_t i = 0; i < minIterations; i++)
     {
         uint64_t delay = runBenchOneIteration(bench, n);
         minDelay = std::min(minDelay, delay);
     }
+    Buffer::AllocationStatistics stats = Buffer::GetAllocationStatistics();
+    SizeClassPool::Statistics bufferPool = Buffer::GetPoolStatistics();
+    SizeClassPool::Statistics metadataPool = PacketMetadata::GetPoolStatistics();
+    double packets = static_cast<double>(n) * minIterations;
     double ps = n;
     ps *= 1000;
     ps /= minDelay;
     std::cout << ps << " packets/s"
-              << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+              << " (" << minDelay << " ms elapsed, " << stats.allocations / packets
+              << " allocations/packet, " << stats.heapAllocations / packets
+              << " heap allocations/packet, " << stats.zeroBytes / packets << " zero bytes/packet, "
+              << "buffer pool " << bufferPool.hits << " hits/" << bufferPool.misses
+              << " misses, metadata pool " << metadataPool.hits << " hits/"
+              << metadataPool.misses << " misses)\t" << name << std::endl;
 }
 
 int
@@ -371,6 +546,8 @@ main(int argc, char* argv[])
     uint32_t n = 0;
     uint32_t minIterations = 1;
     bool enablePrinting = false;
+    bool fixedWidth = false;
+    bool scatterGather = false;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark Packet class");
@@ -379,6 +556,12 @@ main(int argc, char* argv[])
                  "number of subiterations to minimize iteration time over",
                  minIterations);
     cmd.AddValue("enable-printing", "enable packet printing", enablePrinting);
+    cmd.AddValue("fixed-width",
+                 "store the packet metadata as fixed-width records, with --enable-printing",
+                 fixedWidth);
+    cmd.AddValue("scatter-gather",
+                 "chain the buffers aggregated instead of copying them",
+                 scatterGather);
     cmd.Parse(argc, argv);
 
     if (n == 0)
@@ -387,15 +570,34 @@ main(int argc, char* argv[])
                   << "by command-line argument --n=(number of packets)" << std::endl;
         exit(1);
     }
+    if (enablePrinting && fixedWidth)
+    {
+        PacketMetadata::EnableFixedWidth();
+    }
+    else if (enablePrinting)
+    {
+        PacketMetadata::Enable();
+    }
+    if (scatterGather)
+    {
+        Buffer::EnableScatterGather();
+    }
+
     std::cout << "Running bench-packets with n=" << n << std::endl;
     std::cout << "All tests begin by adding UDP and IPv4 headers." << std::endl;
 
     runBench(&benchA, n, minIterations, "Copy packet, remove headers");
     runBench(&benchB, n, minIterations, "Just add headers");
+    runBench(&benchEthernet, n, minIterations, "Add an Ethernet header");
     runBench(&benchC, n, minIterations, "Remove by func call");
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
+    runBench(&benchPacketTags, n, minIterations, "Packet tags of a wireless frame");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
+    runBench(&benchAggregation, n, minIterations, "Aggregation of 8 MSDUs");
+    runBench(&benchPadding, n, minIterations, "Padding of payload-less packets");
     runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchTraceCallback, n, minIterations, "Traced headers, Callback sinks");
+    runBench(&benchTraceInline, n, minIterations, "Traced headers, InlineCallback sinks");
 
     return 0;
 }
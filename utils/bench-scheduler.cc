@@ -8,15 +8,73 @@
 
 #include "ns3/core-module.h"
 
+#include <atomic>
 #include <cmath> // sqrt
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <new>
 #include <string.h>
 #include <vector>
 
 using namespace ns3;
 
+/** Number of calls to the global operator new. */
+std::atomic<uint64_t> g_allocations{0};
+
+// The counting operator new and delete replace the global ones.  GCC warns
+// when the replaced operator delete is inlined after a new expression: both
+// use malloc() and free(), so they do match.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+/**
+ * Count the heap allocations of the whole process.
+ *
+ * @param [in] size The size of the allocation.
+ * @returns The allocated memory.
+ */
+void*
+operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+/**
+ * Release memory allocated by the counting operator new.
+ *
+ * @param [in] p The memory to release.
+ */
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Release memory allocated by the counting operator new.
+ *
+ * @param [in] p The memory to release.
+ * @param [in] size The size of the allocation.
+ */
+void
+operator delete(void* p, std::size_t size) noexcept
+{
+    std::free(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
 /** Flag to write debugging output. */
 bool g_debug = false;
 
@@ -92,10 +150,12 @@ class Bench
     /** The output. */
     struct Result
     {
-        double init;     /**< Time (s) for initialization. */
-        double simu;     /**< Time (s) for simulation. */
-        uint64_t pop;    /**< Event population. */
-        uint64_t events; /**< Number of events executed. */
+        double init;         /**< Time (s) for initialization. */
+        double simu;         /**< Time (s) for simulation. */
+        uint64_t pop;        /**< Event population. */
+        uint64_t events;     /**< Number of events executed. */
+        uint64_t initAllocs; /**< Heap allocations during initialization. */
+        uint64_t simuAllocs; /**< Heap allocations during simulation. */
     };
 
     /**
@@ -129,6 +189,7 @@ Bench::Run()
     DEB("initializing");
     m_count = 0;
 
+    uint64_t allocs = g_allocations;
     timer.Start();
     for (uint64_t i = 0; i < m_population; ++i)
     {
@@ -136,17 +197,20 @@ Bench::Run()
         Simulator::Schedule(at, &Bench::Cb, this);
     }
     init = timer.End() / 1000.0;
+    uint64_t initAllocs = g_allocations - allocs;
     DEB("initialization took " << init << "s");
 
     DEB("running");
+    allocs = g_allocations;
     timer.Start();
     Simulator::Run();
     simu = timer.End() / 1000.0;
+    uint64_t simuAllocs = g_allocations - allocs;
     DEB("run took " << simu << "s");
 
     Simulator::Destroy();
 
-    return Result{init, simu, m_population, m_count};
+    return Result{init, simu, m_population, m_count, initAllocs, simuAllocs};
 }
 
 void
@@ -203,6 +267,7 @@ class BenchSuite
         double time;   /**< Phase run time time (s). */
         double rate;   /**< Phase event rate (events/s). */
         double period; /**< Phase period (s/event). */
+        double allocs; /**< Phase heap allocations per event. */
     };
 
     /** Results from initialization and execution of a single run. */
@@ -237,8 +302,8 @@ class BenchSuite
 BenchSuite::Result
 BenchSuite::Result::Bench(Bench::Result r)
 {
-    return Result{{r.init, r.pop / r.init, r.init / r.pop},
-                  {r.simu, r.events / r.simu, r.simu / r.events}};
+    return Result{{r.init, r.pop / r.init, r.init / r.pop, double(r.initAllocs) / r.pop},
+                  {r.simu, r.events / r.simu, r.simu / r.events, double(r.simuAllocs) / r.events}};
 }
 
 template <typename T>
@@ -249,8 +314,9 @@ BenchSuite::Result::Log(T label) const
 
     LOG(std::left << std::setw(g_fwidth) << label << std::setw(g_fwidth) << init.time
                   << std::setw(g_fwidth) << init.rate << std::setw(g_fwidth) << init.period
-                  << std::setw(g_fwidth) << run.time << std::setw(g_fwidth) << run.rate
-                  << std::setw(g_fwidth) << run.period);
+                  << std::setw(g_fwidth) << init.allocs << std::setw(g_fwidth) << run.time
+                  << std::setw(g_fwidth) << run.rate << std::setw(g_fwidth) << run.period
+                  << std::setw(g_fwidth) << run.allocs);
 }
 
 BenchSuite::BenchSuite(ObjectFactory& factory,
@@ -288,6 +354,8 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
     // Perform the actual runs
     for (uint64_t i = 0; i < runs; i++)
     {
+        // Bench::Run() destroys the simulator, which forgets the scheduler
+        Simulator::SetScheduler(factory);
         auto run = bench.Run();
         m_results.push_back(Result::Bench(run));
         m_results.back().Log(i);
@@ -303,18 +371,21 @@ BenchSuite::Header() const
     // table header
     LOG("");
     LOG(m_scheduler);
-    LOG(std::left << std::setw(g_fwidth) << "Run #" << std::left << std::setw(3 * g_fwidth)
+    LOG(std::left << std::setw(g_fwidth) << "Run #" << std::left << std::setw(4 * g_fwidth)
                   << "Initialization:" << std::left << "Simulation:");
     LOG(std::left << std::setw(g_fwidth) << "" << std::left << std::setw(g_fwidth) << "Time (s)"
                   << std::left << std::setw(g_fwidth) << "Rate (ev/s)" << std::left
                   << std::setw(g_fwidth) << "Per (s/ev)" << std::left << std::setw(g_fwidth)
-                  << "Time (s)" << std::left << std::setw(g_fwidth) << "Rate (ev/s)" << std::left
-                  << "Per (s/ev)");
+                  << "Allocs/ev" << std::left << std::setw(g_fwidth) << "Time (s)" << std::left
+                  << std::setw(g_fwidth) << "Rate (ev/s)" << std::left << std::setw(g_fwidth)
+                  << "Per (s/ev)" << std::left << "Allocs/ev");
     LOG(std::setfill('-') << std::right << std::setw(g_fwidth) << " " << std::right
                           << std::setw(g_fwidth) << " " << std::right << std::setw(g_fwidth) << " "
                           << std::right << std::setw(g_fwidth) << " " << std::right
                           << std::setw(g_fwidth) << " " << std::right << std::setw(g_fwidth) << " "
-                          << std::right << std::setw(g_fwidth) << " " << std::setfill(' '));
+                          << std::right << std::setw(g_fwidth) << " " << std::right
+                          << std::setw(g_fwidth) << " " << std::right << std::setw(g_fwidth) << " "
+                          << std::setfill(' '));
 }
 
 void
@@ -334,8 +405,8 @@ BenchSuite::Log() const
 
     uint64_t n{0};                // number of samples
     Result average{m_results[0]}; // average
-    Result moment2{{0, 0, 0},     // 2nd moment, to calculate stdev
-                   {0, 0, 0}};
+    Result moment2{{0, 0, 0, 0},  // 2nd moment, to calculate stdev
+                   {0, 0, 0, 0}};
 
     for (; n < m_results.size(); ++n)
     {
@@ -353,9 +424,11 @@ BenchSuite::Log() const
         ACCUMULATE(init, time);
         ACCUMULATE(init, rate);
         ACCUMULATE(init, period);
+        ACCUMULATE(init, allocs);
         ACCUMULATE(run, time);
         ACCUMULATE(run, rate);
         ACCUMULATE(run, period);
+        ACCUMULATE(run, allocs);
 
 #undef ACCUMULATE
     }
@@ -363,10 +436,12 @@ BenchSuite::Log() const
     auto stdev = Result{
         {std::sqrt(moment2.init.time / n),
          std::sqrt(moment2.init.rate / n),
-         std::sqrt(moment2.init.period / n)},
+         std::sqrt(moment2.init.period / n),
+         std::sqrt(moment2.init.allocs / n)},
         {std::sqrt(moment2.run.time / n),
          std::sqrt(moment2.run.rate / n),
-         std::sqrt(moment2.run.period / n)},
+         std::sqrt(moment2.run.period / n),
+         std::sqrt(moment2.run.allocs / n)},
     };
 
     average.Log("average");
@@ -440,12 +515,84 @@ GetRandomStream(std::string filename)
     return stream;
 }
 
+/**
+ *  Create a RandomVariableStream replaying the event delays of a simulation.
+ *
+ *  The \p filename is the output of a simulation run with
+ *  `NS_LOG="DefaultSimulatorImpl"`.  The delays
+ *  of the events passed to DefaultSimulatorImpl::Schedule() and
+ *  DefaultSimulatorImpl::ScheduleWithContext() are replayed in order.
+ *
+ *  @param [in] filename The log file name, or `-` for standard input.
+ *  @returns The RandomVariableStream.
+ */
+Ptr<RandomVariableStream>
+GetLogStream(std::string filename)
+{
+    std::istream* input;
+
+    if (filename == "-")
+    {
+        LOG("  Event time distribution:      replay of log from stdin");
+        input = &std::cin;
+    }
+    else
+    {
+        LOG("  Event time distribution:      replay of log " << filename);
+        input = new std::ifstream(filename);
+    }
+
+    // The delay is the second argument of Schedule(this, delay, event)
+    // and the third one of ScheduleWithContext(this, context, delay, event)
+    const std::vector<std::pair<std::string, std::size_t>> functions = {
+        {"DefaultSimulatorImpl:Schedule(", 1},
+        {"DefaultSimulatorImpl:ScheduleWithContext(", 2},
+    };
+
+    std::vector<double> nsValues;
+    std::string line;
+    while (std::getline(*input, line))
+    {
+        for (const auto& [function, argument] : functions)
+        {
+            auto start = line.find(function);
+            if (start == std::string::npos)
+            {
+                continue;
+            }
+            start += function.size();
+            for (std::size_t i = 0; i < argument && start != std::string::npos; ++i)
+            {
+                start = line.find(", ", start);
+                start = (start == std::string::npos) ? start : start + 2;
+            }
+            if (start != std::string::npos)
+            {
+                // Delays are logged in time steps, nanoseconds by default
+                nsValues.push_back(std::strtoull(line.c_str() + start, nullptr, 10));
+            }
+            break;
+        }
+    }
+    if (input != &std::cin)
+    {
+        delete input;
+    }
+
+    LOG("    Found " << nsValues.size() << " entries");
+    NS_ABORT_MSG_IF(nsValues.empty(), "No scheduled event found in " << filename);
+    auto drv = CreateObject<DeterministicRandomVariable>();
+    drv->SetValueArray(nsValues);
+    return drv;
+}
+
 int
 main(int argc, char* argv[])
 {
     bool allSched = false;
     bool schedCal = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -454,6 +601,7 @@ main(int argc, char* argv[])
     uint64_t total = 1000000;
     uint64_t runs = 1;
     std::string filename = "";
+    std::string logname = "";
     bool calRev = false;
 
     CommandLine cmd(__FILE__);
@@ -465,12 +613,20 @@ main(int argc, char* argv[])
               "  or standard input, by the argument --file=\"-\"\n"
               "In the case of either --file form, the input is expected\n"
               "to be ascii, giving the relative event times in ns.\n"
+              "The delays of the events scheduled by an actual simulation\n"
+              "can also be replayed with --log=\"<filename>\", where the\n"
+              "file is the output of the simulation run with\n"
+              "  NS_LOG=\"DefaultSimulatorImpl\"\n"
+              "\n"
+              "Allocs/ev is the number of heap allocations of the whole\n"
+              "process per scheduled (initialization) or executed event.\n"
               "\n"
               "If no scheduler is specified the MapScheduler will be run.");
     cmd.AddValue("all", "use all schedulers", allSched);
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -479,6 +635,7 @@ main(int argc, char* argv[])
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
+    cmd.AddValue("log", "simulation log of the event times to replay", logname);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
     cmd.Parse(argc, argv);
 
@@ -494,15 +651,15 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
 
-    auto eventStream = GetRandomStream(filename);
+    auto eventStream = logname.empty() ? GetRandomStream(filename) : GetLogStream(logname);
 
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
@@ -521,6 +678,11 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::HeapScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
     if (schedList)
     {
         factory.SetTypeId("ns3::ListScheduler");
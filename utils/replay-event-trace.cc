@@ -0,0 +1,306 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+/** Cache misses are counted with perf_event_open(2). */
+#define HAVE_PERF_EVENT_OPEN
+#endif
+
+/**
+ * @file
+ * @ingroup system-tests-perf
+ *
+ * Replay an event trace recorded by the DefaultSimulatorImpl on several
+ * schedulers.
+ */
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/**
+ * Count the hardware cache misses of the calling thread, when the
+ * performance counters are available.
+ */
+class CacheMissCounter
+{
+  public:
+    /** Open the counter, if possible. */
+    CacheMissCounter()
+        : m_fd(-1)
+    {
+#ifdef HAVE_PERF_EVENT_OPEN
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    /** Close the counter. */
+    ~CacheMissCounter()
+    {
+#ifdef HAVE_PERF_EVENT_OPEN
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+#endif
+    }
+
+    /** @returns \c true if the cache misses can be counted. */
+    bool IsAvailable() const
+    {
+        return m_fd >= 0;
+    }
+
+    /** Reset and start the counter. */
+    void Start()
+    {
+#ifdef HAVE_PERF_EVENT_OPEN
+        if (m_fd >= 0)
+        {
+            ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /**
+     * Stop the counter.
+     *
+     * @returns The cache misses since Start().
+     */
+    uint64_t Stop()
+    {
+        uint64_t count = 0;
+#ifdef HAVE_PERF_EVENT_OPEN
+        if (m_fd >= 0)
+        {
+            ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(m_fd, &count, sizeof(count)) != sizeof(count))
+            {
+                count = 0;
+            }
+        }
+#endif
+        return count;
+    }
+
+  private:
+    long m_fd; //!< The perf event file descriptor, or -1.
+};
+
+/** The result of the replay of a trace on a scheduler. */
+struct ReplayResult
+{
+    double time;          //!< Wall clock time, in s.
+    uint64_t operations;  //!< Insert, RemoveNext and Remove operations.
+    uint64_t peakSize;    //!< Largest number of events in the scheduler.
+    uint64_t cacheMisses; //!< Hardware cache misses.
+    uint64_t mismatches;  //!< Events executed out of the recorded order.
+};
+
+/**
+ * Read all the records of a trace file.
+ *
+ * @param [in] filename The trace file name.
+ * @returns The records.
+ */
+std::vector<EventTraceFile::Record>
+ReadTrace(const std::string& filename)
+{
+    EventTraceFile file;
+    file.Open(filename, std::ios::in);
+    std::vector<EventTraceFile::Record> records;
+    EventTraceFile::Record record;
+    while (file.Read(record))
+    {
+        records.push_back(record);
+    }
+    return records;
+}
+
+/**
+ * Replay a trace on a scheduler.
+ *
+ * @param [in] factory The factory of the scheduler.
+ * @param [in] records The records of the trace.
+ * @param [in] counter The cache miss counter.
+ * @returns The result of the replay.
+ */
+ReplayResult
+Replay(ObjectFactory& factory,
+       const std::vector<EventTraceFile::Record>& records,
+       CacheMissCounter& counter)
+{
+    Ptr<Scheduler> scheduler = factory.Create<Scheduler>();
+    ReplayResult result{0, 0, 0, 0, 0};
+    uint64_t size = 0;
+
+    counter.Start();
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& record : records)
+    {
+        Scheduler::Event ev{nullptr, {record.now + record.delay, record.uid, record.context}};
+        switch (record.operation)
+        {
+        case EventTraceFile::INSERT:
+            scheduler->Insert(ev);
+            result.peakSize = std::max(result.peakSize, ++size);
+            break;
+        case EventTraceFile::EXECUTE:
+            NS_ABORT_MSG_IF(size == 0, "Inconsistent trace: execution of an unknown event");
+            ev = scheduler->RemoveNext();
+            result.mismatches += (ev.key.m_uid != record.uid);
+            --size;
+            break;
+        case EventTraceFile::REMOVE:
+            scheduler->Remove(ev);
+            --size;
+            break;
+        case EventTraceFile::CANCEL:
+            // Cancelled events stay in the queue until they are executed
+            continue;
+        }
+        ++result.operations;
+    }
+    auto stop = std::chrono::steady_clock::now();
+    result.cacheMisses = counter.Stop();
+    result.time = std::chrono::duration<double>(stop - start).count();
+
+    // Schedulers do not own the events
+    while (!scheduler->IsEmpty())
+    {
+        scheduler->RemoveNext();
+    }
+    return result;
+}
+
+int
+main(int argc, char* argv[])
+{
+    bool allSched = false;
+    bool schedCal = false;
+    bool schedHeap = false;
+    bool schedLadder = false;
+    bool schedList = false;
+    bool schedMap = false;
+    bool schedPQ = false;
+    uint64_t runs = 1;
+    std::string filename;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Replay an event trace on the simulator schedulers.\n"
+              "\n"
+              "The trace is recorded by running a simulation with\n"
+              "  --ns3::DefaultSimulatorImpl::TraceFile=\"<filename>\"\n"
+              "and replayed with --trace=\"<filename>\".\n"
+              "\n"
+              "Cache misses are only counted when the performance counters\n"
+              "are available (see perf_event_paranoid on Linux).\n"
+              "\n"
+              "If no scheduler is specified all of them but the ListScheduler are run.");
+    cmd.AddValue("trace", "event trace file to replay", filename);
+    cmd.AddValue("all", "use all schedulers", allSched);
+    cmd.AddValue("cal", "use CalendarScheduler", schedCal);
+    cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
+    cmd.AddValue("list", "use ListScheduler", schedList);
+    cmd.AddValue("map", "use MapScheduler", schedMap);
+    cmd.AddValue("pri", "use PriorityQueueScheduler", schedPQ);
+    cmd.AddValue("runs", "number of runs per scheduler", runs);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(filename.empty(), "No trace file given, see --help");
+
+    if (allSched)
+    {
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
+    }
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
+    {
+        schedCal = schedHeap = schedLadder = schedMap = schedPQ = true;
+    }
+
+    std::vector<std::string> schedulers;
+    if (schedCal)
+    {
+        schedulers.emplace_back("ns3::CalendarScheduler");
+    }
+    if (schedHeap)
+    {
+        schedulers.emplace_back("ns3::HeapScheduler");
+    }
+    if (schedLadder)
+    {
+        schedulers.emplace_back("ns3::LadderScheduler");
+    }
+    if (schedList)
+    {
+        schedulers.emplace_back("ns3::ListScheduler");
+    }
+    if (schedMap)
+    {
+        schedulers.emplace_back("ns3::MapScheduler");
+    }
+    if (schedPQ)
+    {
+        schedulers.emplace_back("ns3::PriorityQueueScheduler");
+    }
+
+    auto records = ReadTrace(filename);
+    LOG("Trace " << filename << ": " << records.size() << " records");
+
+    CacheMissCounter counter;
+    const int w = 14;
+    LOG(std::left << std::setw(28) << "Scheduler" << std::right << std::setw(6) << "Run"
+                  << std::setw(w) << "Time (s)" << std::setw(w) << "ns/op" << std::setw(w)
+                  << "Peak size" << std::setw(w) << "Misses/op" << std::setw(w)
+                  << "Mismatches");
+
+    ObjectFactory factory;
+    for (const auto& scheduler : schedulers)
+    {
+        factory.SetTypeId(scheduler);
+        for (uint64_t run = 0; run < runs; ++run)
+        {
+            auto result = Replay(factory, records, counter);
+            std::ostringstream misses;
+            if (counter.IsAvailable())
+            {
+                misses << std::fixed << std::setprecision(3)
+                       << double(result.cacheMisses) / std::max<uint64_t>(result.operations, 1);
+            }
+            else
+            {
+                misses << "n/a";
+            }
+            LOG(std::left << std::setw(28) << scheduler << std::right << std::setw(6) << run
+                          << std::setw(w) << std::fixed << std::setprecision(3) << result.time
+                          << std::setw(w) << std::setprecision(1)
+                          << result.time * 1e9 / std::max<uint64_t>(result.operations, 1)
+                          << std::setw(w) << result.peakSize << std::setw(w) << misses.str()
+                          << std::setw(w) << result.mismatches);
+        }
+    }
+
+    return 0;
+}